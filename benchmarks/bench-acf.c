@@ -0,0 +1,255 @@
+/*
+ * Copyright (c) 2025, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file
+ * Benchmarks of the ACF message builders: Avtp_Can_CreateAcfMessage() and
+ * the serialization of ACF VSS data for every VSS datatype.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "avtp/acf/Can.h"
+#include "avtp/acf/custom/Vss.h"
+#include "bench-suite.h"
+
+#define BENCH(name, stmt)       BENCH_RUN(suite, name, options->iterations, stmt)
+
+/* Number of elements of the benchmarked VSS arrays */
+#define VSS_ARRAY_LEN           16
+
+/* Large enough for an ACF CAN FD message and a VSS message with an array */
+#define PDU_SIZE                256
+
+static const struct {
+    Vss_Datatype_t datatype;
+    const char* name;
+    /* Size of an element of the array datatypes in bytes */
+    uint16_t elementSize;
+} Bench_VssDatatypes[] = {
+    { VSS_UINT8, "uint8", 0 },
+    { VSS_INT8, "int8", 0 },
+    { VSS_UINT16, "uint16", 0 },
+    { VSS_INT16, "int16", 0 },
+    { VSS_UINT32, "uint32", 0 },
+    { VSS_INT32, "int32", 0 },
+    { VSS_UINT64, "uint64", 0 },
+    { VSS_INT64, "int64", 0 },
+    { VSS_BOOL, "bool", 0 },
+    { VSS_FLOAT, "float", 0 },
+    { VSS_DOUBLE, "double", 0 },
+    { VSS_STRING, "string", 0 },
+    { VSS_UINT8_ARRAY, "uint8[16]", sizeof(uint8_t) },
+    { VSS_INT8_ARRAY, "int8[16]", sizeof(int8_t) },
+    { VSS_UINT16_ARRAY, "uint16[16]", sizeof(uint16_t) },
+    { VSS_INT16_ARRAY, "int16[16]", sizeof(int16_t) },
+    { VSS_UINT32_ARRAY, "uint32[16]", sizeof(uint32_t) },
+    { VSS_INT32_ARRAY, "int32[16]", sizeof(int32_t) },
+    { VSS_UINT64_ARRAY, "uint64[16]", sizeof(uint64_t) },
+    { VSS_INT64_ARRAY, "int64[16]", sizeof(int64_t) },
+    { VSS_BOOL_ARRAY, "bool[16]", sizeof(uint8_t) },
+    { VSS_FLOAT_ARRAY, "float[16]", sizeof(float) },
+    { VSS_DOUBLE_ARRAY, "double[16]", sizeof(double) },
+    { VSS_STRING_ARRAY, "string[2]", 0 },
+};
+
+/* Backing storage of the string and array datatypes */
+typedef struct {
+    uint64_t buffer[VSS_ARRAY_LEN];
+    VssDataString_t string;
+    VssDataUint8Array_t uint8Array;
+    VssDataInt8Array_t int8Array;
+    VssDataUint16Array_t uint16Array;
+    VssDataInt16Array_t int16Array;
+    VssDataUint32Array_t uint32Array;
+    VssDataInt32Array_t int32Array;
+    VssDataUint64Array_t uint64Array;
+    VssDataInt64Array_t int64Array;
+    VssDataBoolArray_t boolArray;
+    VssDataFloatArray_t floatArray;
+    VssDataDoubleArray_t doubleArray;
+    VssDataStringArray_t stringArray;
+} Bench_VssStorage_t;
+
+static void vss_data_init(VssData_t* data, Bench_VssStorage_t* storage,
+                          Vss_Datatype_t datatype, uint16_t dataLength)
+{
+    void* buffer = storage->buffer;
+
+    switch (datatype) {
+        case VSS_STRING:
+            storage->string.data_length = dataLength;
+            storage->string.data = buffer;
+            data->data_string = &storage->string;
+            break;
+        case VSS_UINT8_ARRAY:
+            storage->uint8Array.data_length = dataLength;
+            storage->uint8Array.data = buffer;
+            data->data_uint8_array = &storage->uint8Array;
+            break;
+        case VSS_INT8_ARRAY:
+            storage->int8Array.data_length = dataLength;
+            storage->int8Array.data = buffer;
+            data->data_int8_array = &storage->int8Array;
+            break;
+        case VSS_UINT16_ARRAY:
+            storage->uint16Array.data_length = dataLength;
+            storage->uint16Array.data = buffer;
+            data->data_uint16_array = &storage->uint16Array;
+            break;
+        case VSS_INT16_ARRAY:
+            storage->int16Array.data_length = dataLength;
+            storage->int16Array.data = buffer;
+            data->data_int16_array = &storage->int16Array;
+            break;
+        case VSS_UINT32_ARRAY:
+            storage->uint32Array.data_length = dataLength;
+            storage->uint32Array.data = buffer;
+            data->data_uint32_array = &storage->uint32Array;
+            break;
+        case VSS_INT32_ARRAY:
+            storage->int32Array.data_length = dataLength;
+            storage->int32Array.data = buffer;
+            data->data_int32_array = &storage->int32Array;
+            break;
+        case VSS_UINT64_ARRAY:
+            storage->uint64Array.data_length = dataLength;
+            storage->uint64Array.data = buffer;
+            data->data_uint64_array = &storage->uint64Array;
+            break;
+        case VSS_INT64_ARRAY:
+            storage->int64Array.data_length = dataLength;
+            storage->int64Array.data = buffer;
+            data->data_int64_array = &storage->int64Array;
+            break;
+        case VSS_BOOL_ARRAY:
+            storage->boolArray.data_length = dataLength;
+            storage->boolArray.data = buffer;
+            data->data_bool_array = &storage->boolArray;
+            break;
+        case VSS_FLOAT_ARRAY:
+            storage->floatArray.data_length = dataLength;
+            storage->floatArray.data = buffer;
+            data->data_float_array = &storage->floatArray;
+            break;
+        case VSS_DOUBLE_ARRAY:
+            storage->doubleArray.data_length = dataLength;
+            storage->doubleArray.data = buffer;
+            data->data_double_array = &storage->doubleArray;
+            break;
+        case VSS_STRING_ARRAY:
+            storage->stringArray.data_length = dataLength;
+            storage->stringArray.data = buffer;
+            data->data_string_array = &storage->stringArray;
+            break;
+        default:
+            data->data_uint64 = 0x0102030405060708;
+            break;
+    }
+}
+
+void Bench_Acf(const Bench_Options_t* options)
+{
+    const char* suite = "acf";
+    uint64_t storage[PDU_SIZE / sizeof(uint64_t)];
+    Avtp_Can_t* pdu = (Avtp_Can_t*)storage;
+    uint8_t payload[64];
+
+    for (size_t i = 0; i < sizeof(payload); i++) {
+        payload[i] = (uint8_t)i;
+    }
+
+    BENCH("Avtp_Can_CreateAcfMessage CAN 8 bytes",
+        Avtp_Can_CreateAcfMessage(pdu, 0x123, payload, 8, AVTP_CAN_CLASSIC));
+    BENCH("Avtp_Can_CreateAcfMessage CAN extended 8 bytes",
+        Avtp_Can_CreateAcfMessage(pdu, 0x1ABCDEF5, payload, 8,
+                                  AVTP_CAN_CLASSIC));
+    BENCH("Avtp_Can_CreateAcfMessage CAN FD 64 bytes",
+        Avtp_Can_CreateAcfMessage(pdu, 0x123, payload, 64, AVTP_CAN_FD));
+    Bench_Sink += Avtp_Can_GetAcfMsgLength(pdu);
+}
+
+void Bench_Vss(const Bench_Options_t* options)
+{
+    const char* suite = "vss";
+    uint64_t storage[PDU_SIZE / sizeof(uint64_t)];
+    Avtp_Vss_t* pdu = (Avtp_Vss_t*)storage;
+    VssPath_t path = { .vss_static_id_path = 0xAABBCCDD };
+    Bench_VssStorage_t inStorage, outStorage;
+    char speed[] = "Vehicle.Speed";
+    char door[] = "Vehicle.Cabin.Door";
+    VssDataString_t strings[2] = {
+        { .data_length = sizeof(speed) - 1, .data = speed },
+        { .data_length = sizeof(door) - 1, .data = door },
+    };
+    VssDataString_t* stringPtrs[2] = { &strings[0], &strings[1] };
+    char name[64];
+
+    memset(&inStorage, 0, sizeof(inStorage));
+    memset(&outStorage, 0, sizeof(outStorage));
+    for (size_t i = 0; i < sizeof(inStorage.buffer); i++) {
+        ((uint8_t*)inStorage.buffer)[i] = (uint8_t)(i * 37 + 11);
+    }
+
+    for (size_t t = 0; t < sizeof(Bench_VssDatatypes) /
+                           sizeof(Bench_VssDatatypes[0]); t++) {
+        Vss_Datatype_t datatype = Bench_VssDatatypes[t].datatype;
+        uint16_t dataLength = VSS_ARRAY_LEN *
+                              Bench_VssDatatypes[t].elementSize;
+        VssData_t in, out;
+
+        if (datatype == VSS_STRING) {
+            dataLength = strings[0].data_length;
+            memcpy(inStorage.buffer, strings[0].data, dataLength);
+        }
+        vss_data_init(&in, &inStorage, datatype, dataLength);
+        vss_data_init(&out, &outStorage, datatype, dataLength);
+        if (datatype == VSS_STRING_ARRAY) {
+            Avtp_Vss_SerializeStringArray(in.data_string_array, stringPtrs, 2);
+        }
+
+        memset(storage, 0, sizeof(storage));
+        Avtp_Vss_Init(pdu);
+        Avtp_Vss_SetAddrMode(pdu, VSS_STATIC_ID_MODE);
+        Avtp_Vss_SetOpCode(pdu, PUBLISH_CURRENT_VALUE);
+        Avtp_Vss_SetVssPath(pdu, &path);
+        Avtp_Vss_SetDatatype(pdu, datatype);
+
+        snprintf(name, sizeof(name), "Avtp_Vss_SetVssData %s",
+                 Bench_VssDatatypes[t].name);
+        BENCH(name, Avtp_Vss_SetVssData(pdu, &in));
+        snprintf(name, sizeof(name), "Avtp_Vss_GetVssData %s",
+                 Bench_VssDatatypes[t].name);
+        BENCH(name, {
+            Avtp_Vss_GetVssData(pdu, &out);
+            Bench_Sink += out.data_uint64 + outStorage.buffer[0];
+        });
+    }
+}
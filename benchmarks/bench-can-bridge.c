@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2025, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file
+ * Benchmarks of can_to_avtp() and avtp_to_can() of the acf-can applications
+ * for 1 to MAX_CAN_FRAMES_IN_ACF CAN frames per AVTP PDU, with ACF CAN and ACF
+ * CAN Brief messages. The wire efficiency of both encodings is reported as the
+ * CAN frames per second that fit into 1 Gbit/s of Ethernet.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "acf-can-common.h"
+#include "bench-suite.h"
+
+#define BENCH(name, stmt)       BENCH_RUN(suite, name, options->iterations, stmt)
+
+#define STREAM_ID               0xAABBCCDDEEFF0001
+
+/* Ethernet header and FCS, and preamble, SFD and IFG on the wire */
+#define ETH_FRAME_OVERHEAD      (14 + 4)
+#define ETH_WIRE_OVERHEAD       (8 + 12)
+#define ETH_MIN_FRAME_SIZE      64
+#define GBIT                    1000000000.0
+
+/* CAN frames per second that 1 Gbit/s carries in PDUs of the given length */
+static double frames_per_gbit(int pduLength, uint8_t numFrames)
+{
+    int frameSize = pduLength + ETH_FRAME_OVERHEAD;
+
+    if (frameSize < ETH_MIN_FRAME_SIZE) {
+        frameSize = ETH_MIN_FRAME_SIZE;
+    }
+    return GBIT / ((frameSize + ETH_WIRE_OVERHEAD) * 8) * numFrames;
+}
+
+static void bench_variant(const Bench_Options_t* options,
+                          Avtp_CanVariant_t canVariant, int useTscf,
+                          int useBrief)
+{
+    const char* suite = "can-bridge";
+    const char* variantName = canVariant == AVTP_CAN_FD ? "CAN FD" : "CAN";
+    const char* cfName = useTscf ? "TSCF" : "NTSCF";
+    const char* encName = useBrief ? " brief" : "";
+    uint64_t storage[MAX_ETH_PDU_SIZE / sizeof(uint64_t)];
+    uint8_t* pdu = (uint8_t*)storage;
+    frame_t txFrames[MAX_CAN_FRAMES_IN_ACF];
+    frame_t rxFrames[MAX_CAN_FRAMES_IN_ACF];
+    Avtp_SeqTracker_t cfSeq, udpSeq;
+    can_talker_streams_t talkerStreams;
+    char name[64];
+    int pduLength;
+
+    memset(&talkerStreams, 0, sizeof(talkerStreams));
+    Avtp_SeqTracker_Init(&cfSeq);
+    Avtp_SeqTracker_Init(&udpSeq);
+    memset(txFrames, 0, sizeof(txFrames));
+    for (int f = 0; f < MAX_CAN_FRAMES_IN_ACF; f++) {
+        if (canVariant == AVTP_CAN_FD) {
+            txFrames[f].fd.can_id = 0x100 + f;
+            txFrames[f].fd.len = 64;
+            txFrames[f].fd.flags = CANFD_BRS;
+            memset(txFrames[f].fd.data, f, sizeof(txFrames[f].fd.data));
+        } else {
+            txFrames[f].cc.can_id = 0x100 + f;
+            txFrames[f].cc.len = 8;
+            memset(txFrames[f].cc.data, f, sizeof(txFrames[f].cc.data));
+        }
+    }
+
+    for (uint8_t n = 1; n <= MAX_CAN_FRAMES_IN_ACF; n++) {
+        snprintf(name, sizeof(name), "can_to_avtp %s %s%s %u frames",
+                 cfName, variantName, encName, n);
+        BENCH(name, Bench_Sink += can_to_avtp(txFrames, canVariant, pdu, 0,
+                                              useTscf, useBrief, &talkerStreams,
+                                              STREAM_ID, n, 0, 0));
+
+        pduLength = can_to_avtp(txFrames, canVariant, pdu, 0, useTscf,
+                                useBrief, &talkerStreams, STREAM_ID, n, 0, 0);
+
+        /* The PDU is not modified, so the tracker counts duplicates. */
+        snprintf(name, sizeof(name), "avtp_to_can %s %s%s %u frames",
+                 cfName, variantName, encName, n);
+        BENCH(name, Bench_Sink += avtp_to_can(pdu, pduLength, rxFrames,
+                                              canVariant, 0, STREAM_ID,
+                                              &cfSeq, &udpSeq));
+
+        snprintf(name, sizeof(name), "wire %s %s%s %u frames",
+                 cfName, variantName, encName, n);
+        Bench_ReportValue(suite, name, frames_per_gbit(pduLength, n),
+                          "frames/s/Gbit");
+    }
+}
+
+void Bench_CanBridge(const Bench_Options_t* options)
+{
+    for (int useBrief = 0; useBrief <= 1; useBrief++) {
+        bench_variant(options, AVTP_CAN_CLASSIC, 0, useBrief);
+        bench_variant(options, AVTP_CAN_CLASSIC, 1, useBrief);
+        bench_variant(options, AVTP_CAN_FD, 0, useBrief);
+        bench_variant(options, AVTP_CAN_FD, 1, useBrief);
+    }
+}
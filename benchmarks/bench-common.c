@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) 2025, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "bench-common.h"
+
+#define NSEC_PER_SEC            1000000000ULL
+
+#ifndef OPEN1722_VERSION
+#define OPEN1722_VERSION        "unknown"
+#endif
+
+volatile uint64_t Bench_Sink;
+
+static Bench_Output_t output;
+static const char* benchName;
+static unsigned int numResults;
+
+static void usage(const char* program)
+{
+    fprintf(stderr,
+            "Usage: %s [-n iterations] [-f text|csv|json] [-s suite]\n",
+            program);
+}
+
+static void print_json_string(const char* str)
+{
+    putchar('"');
+    for (; *str != '\0'; str++) {
+        if (*str == '"' || *str == '\\') {
+            putchar('\\');
+        }
+        putchar(*str);
+    }
+    putchar('"');
+}
+
+int Bench_ParseOutput(const char* name, Bench_Output_t* output)
+{
+    if (strcmp(name, "text") == 0) {
+        *output = BENCH_OUTPUT_TEXT;
+    } else if (strcmp(name, "csv") == 0) {
+        *output = BENCH_OUTPUT_CSV;
+    } else if (strcmp(name, "json") == 0) {
+        *output = BENCH_OUTPUT_JSON;
+    } else {
+        return -1;
+    }
+    return 0;
+}
+
+int Bench_ParseArgs(int argc, char* argv[], Bench_Options_t* options)
+{
+    static const struct option longOptions[] = {
+        { "iterations", required_argument, NULL, 'n' },
+        { "format", required_argument, NULL, 'f' },
+        { "suite", required_argument, NULL, 's' },
+        { "help", no_argument, NULL, 'h' },
+        { NULL, 0, NULL, 0 }
+    };
+    int opt;
+
+    options->iterations = BENCH_DEFAULT_ITERATIONS;
+    options->output = BENCH_OUTPUT_TEXT;
+    options->suite = NULL;
+
+    while ((opt = getopt_long(argc, argv, "n:f:s:h", longOptions, NULL)) != -1) {
+        switch (opt) {
+        case 'n':
+            options->iterations = strtoull(optarg, NULL, 0);
+            break;
+        case 'f':
+            if (Bench_ParseOutput(optarg, &options->output) < 0) {
+                usage(argv[0]);
+                return -1;
+            }
+            break;
+        case 's':
+            options->suite = optarg;
+            break;
+        default:
+            usage(argv[0]);
+            return -1;
+        }
+    }
+
+    if (optind < argc) {
+        options->iterations = strtoull(argv[optind], NULL, 0);
+    }
+    if (options->iterations == 0) {
+        usage(argv[0]);
+        return -1;
+    }
+
+    return 0;
+}
+
+int Bench_SuiteSelected(const Bench_Options_t* options, const char* suite)
+{
+    return options->suite == NULL || strcmp(options->suite, suite) == 0;
+}
+
+void Bench_Begin(const Bench_Options_t* options, const char* program)
+{
+    const char* name = strrchr(program, '/');
+    name = (name != NULL) ? name + 1 : program;
+
+    output = options->output;
+    benchName = name;
+    numResults = 0;
+
+    switch (output) {
+    case BENCH_OUTPUT_TEXT:
+        printf("%s (Open1722 %s), %llu iterations\n", name, OPEN1722_VERSION,
+               (unsigned long long)options->iterations);
+        break;
+    case BENCH_OUTPUT_CSV:
+        printf("benchmark,version,suite,name,iterations,total_ns,ns_per_op,value,unit\n");
+        break;
+    case BENCH_OUTPUT_JSON:
+        printf("{\n  \"benchmark\": ");
+        print_json_string(name);
+        printf(",\n  \"version\": ");
+        print_json_string(OPEN1722_VERSION);
+        printf(",\n  \"iterations\": %llu,\n  \"results\": [",
+               (unsigned long long)options->iterations);
+        break;
+    }
+}
+
+void Bench_Report(const char* suite, const char* name, uint64_t elapsedNs,
+                  uint64_t iterations)
+{
+    double nsPerOp = (double)elapsedNs / iterations;
+
+    switch (output) {
+    case BENCH_OUTPUT_TEXT:
+        printf("%-12s %-50s %10.2f ns/op\n", suite, name, nsPerOp);
+        break;
+    case BENCH_OUTPUT_CSV:
+        printf("%s,%s,%s,\"%s\",%llu,%llu,%.2f,%.2f,ns/op\n", benchName,
+               OPEN1722_VERSION, suite, name, (unsigned long long)iterations,
+               (unsigned long long)elapsedNs, nsPerOp, nsPerOp);
+        break;
+    case BENCH_OUTPUT_JSON:
+        printf("%s\n    { \"suite\": ", numResults > 0 ? "," : "");
+        print_json_string(suite);
+        printf(", \"name\": ");
+        print_json_string(name);
+        printf(", \"iterations\": %llu, \"total_ns\": %llu, \"ns_per_op\": %.2f }",
+               (unsigned long long)iterations, (unsigned long long)elapsedNs,
+               nsPerOp);
+        break;
+    }
+    numResults++;
+    fflush(stdout);
+}
+
+void Bench_ReportValue(const char* suite, const char* name, double value,
+                       const char* unit)
+{
+    switch (output) {
+    case BENCH_OUTPUT_TEXT:
+        printf("%-12s %-50s %10.0f %s\n", suite, name, value, unit);
+        break;
+    case BENCH_OUTPUT_CSV:
+        // Only the value columns apply to derived figures
+        printf("%s,%s,%s,\"%s\",,,,%.2f,%s\n", benchName, OPEN1722_VERSION,
+               suite, name, value, unit);
+        break;
+    case BENCH_OUTPUT_JSON:
+        printf("%s\n    { \"suite\": ", numResults > 0 ? "," : "");
+        print_json_string(suite);
+        printf(", \"name\": ");
+        print_json_string(name);
+        printf(", \"value\": %.2f, \"unit\": ", value);
+        print_json_string(unit);
+        printf(" }");
+        break;
+    }
+    numResults++;
+    fflush(stdout);
+}
+
+void Bench_End(void)
+{
+    if (output == BENCH_OUTPUT_JSON) {
+        printf("\n  ]\n}\n");
+    }
+}
+
+uint64_t Bench_NowNs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * NSEC_PER_SEC + ts.tv_nsec;
+}
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2025, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file
+ * Common harness of the Open1722 benchmarks. It times a statement in a loop
+ * and prints the results as a human readable table, CSV or JSON. The machine
+ * readable formats are meant to be archived to compare releases.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#define BENCH_DEFAULT_ITERATIONS    10000000ULL
+
+/* Forces the compiler to reload the PDU on every iteration. */
+#define BENCH_BARRIER()             __asm__ __volatile__("" ::: "memory")
+
+/**
+ * Runs stmt the given number of times and reports the average duration. The
+ * loop counter i can be used within stmt.
+ */
+#define BENCH_RUN(suite, name, iterations, stmt)                        \
+    do {                                                                \
+        uint64_t bench_start_ = Bench_NowNs();                          \
+        for (uint64_t i = 0; i < (iterations); i++) {                   \
+            stmt;                                                       \
+            BENCH_BARRIER();                                            \
+        }                                                               \
+        Bench_Report(suite, name, Bench_NowNs() - bench_start_,         \
+                     iterations);                                       \
+    } while (0)
+
+typedef enum {
+    BENCH_OUTPUT_TEXT = 0,
+    BENCH_OUTPUT_CSV,
+    BENCH_OUTPUT_JSON
+} Bench_Output_t;
+
+typedef struct {
+    uint64_t iterations;
+    Bench_Output_t output;
+    /* Only run the suite with this name, NULL runs all suites */
+    const char* suite;
+} Bench_Options_t;
+
+/* Results of benchmarked expressions are added here to keep them alive. */
+extern volatile uint64_t Bench_Sink;
+
+/**
+ * Parses the command line options shared by all benchmarks:
+ *
+ *   -n, --iterations N   Iterations per benchmark
+ *   -f, --format FMT     Output format: text, csv or json
+ *   -s, --suite NAME     Run a single suite
+ *
+ * A plain number is accepted as iteration count for compatibility.
+ *
+ * @returns 0 on success, -1 on invalid arguments (usage has been printed).
+ */
+int Bench_ParseArgs(int argc, char* argv[], Bench_Options_t* options);
+
+/**
+ * Parses an output format name (text, csv or json).
+ *
+ * @returns 0 on success, -1 if the name is unknown.
+ */
+int Bench_ParseOutput(const char* name, Bench_Output_t* output);
+
+/**
+ * Returns 1 if the given suite was selected on the command line.
+ */
+int Bench_SuiteSelected(const Bench_Options_t* options, const char* suite);
+
+/**
+ * Starts the report. Must be called before the first benchmark.
+ */
+void Bench_Begin(const Bench_Options_t* options, const char* program);
+
+/**
+ * Records the result of a single benchmark.
+ */
+void Bench_Report(const char* suite, const char* name, uint64_t elapsedNs,
+                  uint64_t iterations);
+
+/**
+ * Records a derived figure that is not a duration, e.g. a throughput.
+ *
+ * @param value Value of the figure
+ * @param unit Unit of the value, e.g. "frames/s/Gbit"
+ */
+void Bench_ReportValue(const char* suite, const char* name, double value,
+                       const char* unit);
+
+/**
+ * Completes the report.
+ */
+void Bench_End(void);
+
+uint64_t Bench_NowNs(void);
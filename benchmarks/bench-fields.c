@@ -0,0 +1,267 @@
+/*
+ * Copyright (c) 2025, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file
+ * Micro-benchmark for the field accessors. It compares the generic,
+ * descriptor-walking Avtp_GetField()/Avtp_SetField() against the inline
+ * accessors (Avtp_GetFieldInline()/Avtp_SetFieldInline()) which are used by
+ * the per-format getters and setters of the library. It also compares the
+ * accessors on quadlet-aligned and misaligned PDUs.
+ *
+ * Usage: bench-fields [-n iterations] [-f text|csv|json] [-s suite]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "avtp/Utils.h"
+#include "avtp/StreamTemplate.h"
+#include "avtp/acf/Can.h"
+#include "avtp/acf/Ntscf.h"
+#include "avtp/aaf/Pcm.h"
+#include "bench-common.h"
+
+#define PDU_SIZE                64
+
+#define BENCH(name, stmt)       BENCH_RUN(suite, name, options->iterations, stmt)
+
+/* Representative field layouts taken from the ACF CAN and NTSCF headers. */
+typedef enum {
+    BENCH_FIELD_FLAG = 0,
+    BENCH_FIELD_MSG_LENGTH,
+    BENCH_FIELD_CAN_IDENTIFIER,
+    BENCH_FIELD_STREAM_ID,
+    BENCH_FIELD_MAX
+} Bench_Fields_t;
+
+static const Avtp_FieldDescriptor_t Bench_FieldDesc[BENCH_FIELD_MAX] =
+{
+    [BENCH_FIELD_FLAG]            = { .quadlet = 0, .offset = 22, .bits =  1 },
+    [BENCH_FIELD_MSG_LENGTH]      = { .quadlet = 0, .offset =  7, .bits =  9 },
+    [BENCH_FIELD_CAN_IDENTIFIER]  = { .quadlet = 3, .offset =  3, .bits = 29 },
+    [BENCH_FIELD_STREAM_ID]       = { .quadlet = 1, .offset =  0, .bits = 64 },
+};
+
+static const char* const Bench_FieldNames[BENCH_FIELD_MAX] =
+{
+    [BENCH_FIELD_FLAG]            = "flag (1 bit)",
+    [BENCH_FIELD_MSG_LENGTH]      = "msg_length (9 bit)",
+    [BENCH_FIELD_CAN_IDENTIFIER]  = "can_identifier (29 bit)",
+    [BENCH_FIELD_STREAM_ID]       = "stream_id (64 bit)",
+};
+
+/* Generic vs. inline accessors for representative field layouts. */
+static void bench_accessors(const Bench_Options_t* options, uint8_t* pdu)
+{
+    const char* suite = "accessors";
+    char name[64];
+
+    /* The field index is a constant in each loop, just like in the getters. */
+#define BENCH_FIELD(field)                                                      \
+    do {                                                                        \
+        snprintf(name, sizeof(name), "get %s generic",                          \
+                 Bench_FieldNames[field]);                                      \
+        BENCH(name, Bench_Sink += Avtp_GetField(Bench_FieldDesc,                \
+                BENCH_FIELD_MAX, pdu, field));                                  \
+        snprintf(name, sizeof(name), "get %s inline", Bench_FieldNames[field]); \
+        BENCH(name, Bench_Sink += Avtp_GetFieldInline(Bench_FieldDesc,          \
+                BENCH_FIELD_MAX, pdu, field));                                  \
+        snprintf(name, sizeof(name), "set %s generic",                          \
+                 Bench_FieldNames[field]);                                      \
+        BENCH(name, Avtp_SetField(Bench_FieldDesc, BENCH_FIELD_MAX, pdu,        \
+                field, i));                                                     \
+        snprintf(name, sizeof(name), "set %s inline", Bench_FieldNames[field]); \
+        BENCH(name, Avtp_SetFieldInline(Bench_FieldDesc, BENCH_FIELD_MAX, pdu,  \
+                field, i));                                                     \
+    } while (0)
+
+    BENCH_FIELD(BENCH_FIELD_FLAG);
+    BENCH_FIELD(BENCH_FIELD_MSG_LENGTH);
+    BENCH_FIELD(BENCH_FIELD_CAN_IDENTIFIER);
+    BENCH_FIELD(BENCH_FIELD_STREAM_ID);
+}
+
+/* Unaligned-safe primitives and accessors on an aligned vs. misaligned PDU. */
+static void bench_alignment(const Bench_Options_t* options, uint8_t* pdu)
+{
+    const char* suite = "alignment";
+    uint8_t* misaligned = pdu + 1;
+
+    BENCH("Avtp_LoadBe32 aligned", Bench_Sink += Avtp_LoadBe32(pdu + 4));
+    BENCH("Avtp_LoadBe32 misaligned", Bench_Sink += Avtp_LoadBe32(misaligned + 4));
+    BENCH("Avtp_LoadBe64 aligned", Bench_Sink += Avtp_LoadBe64(pdu + 4));
+    BENCH("Avtp_LoadBe64 misaligned", Bench_Sink += Avtp_LoadBe64(misaligned + 4));
+    BENCH("Avtp_StoreBe32 aligned", Avtp_StoreBe32(pdu + 4, i));
+    BENCH("Avtp_StoreBe32 misaligned", Avtp_StoreBe32(misaligned + 4, i));
+    BENCH("get can_identifier generic misaligned",
+            Bench_Sink += Avtp_GetField(Bench_FieldDesc, BENCH_FIELD_MAX, misaligned,
+                    BENCH_FIELD_CAN_IDENTIFIER));
+    BENCH("get can_identifier inline misaligned",
+            Bench_Sink += Avtp_GetFieldInline(Bench_FieldDesc, BENCH_FIELD_MAX,
+                    misaligned, BENCH_FIELD_CAN_IDENTIFIER));
+    BENCH("set stream_id generic misaligned",
+            Avtp_SetField(Bench_FieldDesc, BENCH_FIELD_MAX, misaligned,
+                    BENCH_FIELD_STREAM_ID, i));
+    BENCH("set stream_id inline misaligned",
+            Avtp_SetFieldInline(Bench_FieldDesc, BENCH_FIELD_MAX, misaligned,
+                    BENCH_FIELD_STREAM_ID, i));
+}
+
+/* Public API of the library (includes the call into the shared object). */
+static void bench_api(const Bench_Options_t* options, uint8_t* pdu)
+{
+    const char* suite = "api";
+
+    BENCH("Avtp_Can_GetCanIdentifier", Bench_Sink += Avtp_Can_GetCanIdentifier((Avtp_Can_t*)pdu));
+    BENCH("Avtp_Can_SetCanIdentifier", Avtp_Can_SetCanIdentifier((Avtp_Can_t*)pdu, i));
+    BENCH("Avtp_Ntscf_GetStreamId", Bench_Sink += Avtp_Ntscf_GetStreamId((Avtp_Ntscf_t*)pdu));
+    BENCH("Avtp_Ntscf_SetStreamId", Avtp_Ntscf_SetStreamId((Avtp_Ntscf_t*)pdu, i));
+    BENCH("Avtp_Pcm_GetSequenceNum", Bench_Sink += Avtp_Pcm_GetSequenceNum((Avtp_Pcm_t*)pdu));
+    BENCH("Avtp_Pcm_SetSequenceNum", Avtp_Pcm_SetSequenceNum((Avtp_Pcm_t*)pdu, i));
+}
+
+/* Complete headers: per-field access vs. one pass per quadlet. */
+static void bench_headers(const Bench_Options_t* options, uint8_t* pdu)
+{
+    const char* suite = "headers";
+
+    /* Complete ACF CAN header: single setters vs. one pass per quadlet. */
+    Avtp_CanHeader_t header = {
+        .acf_msg_type = AVTP_ACF_TYPE_CAN,
+        .acf_msg_length = 6,
+        .pad = 0,
+        .mtv = 1,
+        .eff = 1,
+        .can_bus_id = 1,
+        .message_timestamp = 0x0102030405060708,
+        .can_identifier = 0x1ABCDEF5,
+    };
+    BENCH("CAN header with single setters", {
+        Avtp_Can_t* can = (Avtp_Can_t*)pdu;
+        Avtp_Can_SetAcfMsgType(can, header.acf_msg_type);
+        Avtp_Can_SetAcfMsgLength(can, header.acf_msg_length);
+        Avtp_Can_SetPad(can, header.pad);
+        Avtp_Can_EnableMtv(can);
+        Avtp_Can_DisableRtr(can);
+        Avtp_Can_EnableEff(can);
+        Avtp_Can_DisableBrs(can);
+        Avtp_Can_DisableFdf(can);
+        Avtp_Can_DisableEsi(can);
+        Avtp_Can_SetCanBusId(can, header.can_bus_id);
+        Avtp_Can_SetMessageTimestamp(can, header.message_timestamp + i);
+        Avtp_Can_SetCanIdentifier(can, header.can_identifier);
+    });
+    BENCH("CAN header with Avtp_Can_SetHeader", {
+        header.message_timestamp++;
+        Avtp_Can_SetHeader((Avtp_Can_t*)pdu, &header);
+    });
+
+    /* Complete AAF PCM header: single getters vs. one pass per quadlet. */
+    Avtp_PcmHeader_t pcm_header;
+    BENCH("AAF PCM header with single getters", {
+        const Avtp_Pcm_t* pcm = (const Avtp_Pcm_t*)pdu;
+        Bench_Sink += Avtp_Pcm_GetSubtype(pcm) + Avtp_Pcm_GetVersion(pcm) +
+                Avtp_Pcm_GetTv(pcm) + Avtp_Pcm_GetSequenceNum(pcm) +
+                Avtp_Pcm_GetStreamId(pcm) + Avtp_Pcm_GetAvtpTimestamp(pcm) +
+                Avtp_Pcm_GetFormat(pcm) + Avtp_Pcm_GetNsr(pcm) +
+                Avtp_Pcm_GetChannelsPerFrame(pcm) + Avtp_Pcm_GetBitDepth(pcm) +
+                Avtp_Pcm_GetStreamDataLength(pcm) + Avtp_Pcm_GetSp(pcm);
+    });
+    BENCH("AAF PCM header with Avtp_Pcm_Unpack", {
+        Avtp_Pcm_Unpack((const Avtp_Pcm_t*)pdu, &pcm_header);
+        Bench_Sink += pcm_header.subtype + pcm_header.version +
+                pcm_header.tv + pcm_header.sequence_num +
+                pcm_header.stream_id + pcm_header.avtp_timestamp +
+                pcm_header.format + pcm_header.nsr +
+                pcm_header.channels_per_frame + pcm_header.bit_depth +
+                pcm_header.stream_data_length + pcm_header.sp;
+    });
+
+    /* Per-packet AAF PCM header: full initialization vs. stream template. */
+    Avtp_StreamTemplate_t pcm_template;
+    Avtp_Pcm_Init((Avtp_Pcm_t*)pdu);
+    Avtp_Pcm_EnableTv((Avtp_Pcm_t*)pdu);
+    Avtp_Pcm_SetStreamId((Avtp_Pcm_t*)pdu, 0xAABBCCDDEEFF0001);
+    Avtp_Pcm_SetFormat((Avtp_Pcm_t*)pdu, AVTP_AAF_FORMAT_INT_16BIT);
+    Avtp_Pcm_SetNsr((Avtp_Pcm_t*)pdu, AVTP_AAF_PCM_NSR_48KHZ);
+    Avtp_Pcm_SetChannelsPerFrame((Avtp_Pcm_t*)pdu, 2);
+    Avtp_Pcm_SetBitDepth((Avtp_Pcm_t*)pdu, 16);
+    Avtp_Pcm_InitTemplate(&pcm_template, (Avtp_Pcm_t*)pdu);
+    BENCH("AAF PCM header with Init and setters", {
+        Avtp_Pcm_t* pcm = (Avtp_Pcm_t*)pdu;
+        Avtp_Pcm_Init(pcm);
+        Avtp_Pcm_EnableTv(pcm);
+        Avtp_Pcm_SetStreamId(pcm, 0xAABBCCDDEEFF0001);
+        Avtp_Pcm_SetFormat(pcm, AVTP_AAF_FORMAT_INT_16BIT);
+        Avtp_Pcm_SetNsr(pcm, AVTP_AAF_PCM_NSR_48KHZ);
+        Avtp_Pcm_SetChannelsPerFrame(pcm, 2);
+        Avtp_Pcm_SetBitDepth(pcm, 16);
+        Avtp_Pcm_SetSequenceNum(pcm, i);
+        Avtp_Pcm_SetAvtpTimestamp(pcm, i);
+        Avtp_Pcm_SetStreamDataLength(pcm, 192);
+    });
+    BENCH("AAF PCM header with Avtp_StreamTemplate_Render", {
+        Avtp_StreamTemplate_Render(&pcm_template, pdu, i, i, 192);
+    });
+}
+
+int main(int argc, char* argv[])
+{
+    Bench_Options_t options;
+    /* One spare quadlet so the PDU can be shifted for the misaligned runs. */
+    uint64_t storage[PDU_SIZE / sizeof(uint64_t) + 1];
+    uint8_t* pdu = (uint8_t*)storage;
+
+    if (Bench_ParseArgs(argc, argv, &options) < 0) {
+        return EXIT_FAILURE;
+    }
+
+    for (size_t i = 0; i < sizeof(storage); i++) {
+        pdu[i] = (uint8_t)(i * 37 + 11);
+    }
+
+    Bench_Begin(&options, argv[0]);
+    if (Bench_SuiteSelected(&options, "accessors")) {
+        bench_accessors(&options, pdu);
+    }
+    if (Bench_SuiteSelected(&options, "alignment")) {
+        bench_alignment(&options, pdu);
+    }
+    if (Bench_SuiteSelected(&options, "api")) {
+        bench_api(&options, pdu);
+    }
+    if (Bench_SuiteSelected(&options, "headers")) {
+        bench_headers(&options, pdu);
+    }
+    Bench_End();
+
+    return 0;
+}
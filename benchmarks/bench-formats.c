@@ -0,0 +1,231 @@
+/*
+ * Copyright (c) 2025, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file
+ * Benchmarks of every format in the library: access to a single field, a
+ * complete header build (init and set all fields) and a complete header
+ * parse (get all fields). Formats with a one-pass Unpack() or SetHeader() are
+ * timed with those as well.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "avtp/CommonHeader.h"
+#include "avtp/Crf.h"
+#include "avtp/Rvf.h"
+#include "avtp/Udp.h"
+#include "avtp/aaf/Aaf.h"
+#include "avtp/aaf/Pcm.h"
+#include "avtp/acf/AcfCommon.h"
+#include "avtp/acf/Can.h"
+#include "avtp/acf/CanBrief.h"
+#include "avtp/acf/FlexRay.h"
+#include "avtp/acf/Gpc.h"
+#include "avtp/acf/Lin.h"
+#include "avtp/acf/Most.h"
+#include "avtp/acf/Ntscf.h"
+#include "avtp/acf/Sensor.h"
+#include "avtp/acf/SensorBrief.h"
+#include "avtp/acf/Tscf.h"
+#include "avtp/acf/custom/Vss.h"
+#include "avtp/acf/custom/VssBrief.h"
+#include "avtp/cvf/Cvf.h"
+#include "avtp/cvf/H264.h"
+#include "avtp/cvf/Jpeg2000.h"
+#include "avtp/cvf/Mjpeg.h"
+#include "bench-suite.h"
+
+#define BENCH(name, stmt)       BENCH_RUN(suite, name, options->iterations, stmt)
+
+#define PDU_SIZE                64
+
+/*
+ * Pcm.h maps the legacy AVTP_AAF_FIELD_* names to the PCM fields, so the
+ * number of AAF fields is derived from the last field that is not remapped.
+ */
+#define BENCH_AAF_FIELD_MAX     (AVTP_AAF_FIELD_AAF_FORMAT_SPECIFIC_DATA_2 + 1)
+
+/*
+ * Times a format through its generic accessors. The single-field benchmarks
+ * access the field in the middle of the field table, init is the statement
+ * that initializes the header before all fields are set.
+ */
+#define BENCH_FORMAT(fmt, fieldMax, init)                                   \
+    do {                                                                    \
+        Avtp_##fmt##_t* p = (Avtp_##fmt##_t*)pdu;                           \
+        BENCH(#fmt " get field",                                            \
+            Bench_Sink += Avtp_##fmt##_GetField(p, (fieldMax) / 2));        \
+        BENCH(#fmt " set field",                                            \
+            Avtp_##fmt##_SetField(p, (fieldMax) / 2, i));                   \
+        BENCH(#fmt " build header", {                                       \
+            init;                                                           \
+            for (int f = 0; f < (fieldMax); f++) {                          \
+                Avtp_##fmt##_SetField(p, f, i);                             \
+            }                                                               \
+        });                                                                 \
+        BENCH(#fmt " parse header", {                                       \
+            for (int f = 0; f < (fieldMax); f++) {                          \
+                Bench_Sink += Avtp_##fmt##_GetField(p, f);                  \
+            }                                                               \
+        });                                                                 \
+    } while (0)
+
+/* Times the one-pass Unpack() of a format, member keeps the result alive. */
+#define BENCH_UNPACK(fmt, headerType, member)                               \
+    do {                                                                    \
+        headerType header;                                                  \
+        BENCH(#fmt " parse header with Unpack", {                           \
+            Avtp_##fmt##_Unpack((const Avtp_##fmt##_t*)pdu, &header);       \
+            Bench_Sink += header.member;                                    \
+        });                                                                 \
+    } while (0)
+
+#define BENCH_ZERO(len)         memset(pdu, 0, (len))
+
+static void bench_can(const Bench_Options_t* options, uint8_t* pdu)
+{
+    const char* suite = "formats";
+    Avtp_Can_t* can = (Avtp_Can_t*)pdu;
+    Avtp_CanHeader_t header = {
+        .acf_msg_type = AVTP_ACF_TYPE_CAN,
+        .acf_msg_length = 6,
+        .mtv = 1,
+        .eff = 1,
+        .can_bus_id = 1,
+        .message_timestamp = 0x0102030405060708,
+        .can_identifier = 0x1ABCDEF5,
+    };
+
+    BENCH("Can get field", Bench_Sink += Avtp_Can_GetCanIdentifier(can));
+    BENCH("Can set field", Avtp_Can_SetCanIdentifier(can, i));
+    BENCH("Can build header", {
+        Avtp_Can_Init(can);
+        Avtp_Can_SetAcfMsgLength(can, header.acf_msg_length);
+        Avtp_Can_SetPad(can, header.pad);
+        Avtp_Can_EnableMtv(can);
+        Avtp_Can_EnableEff(can);
+        Avtp_Can_SetCanBusId(can, header.can_bus_id);
+        Avtp_Can_SetMessageTimestamp(can, i);
+        Avtp_Can_SetCanIdentifier(can, header.can_identifier);
+    });
+    BENCH("Can build header with SetHeader", {
+        header.message_timestamp = i;
+        Avtp_Can_SetHeader(can, &header);
+    });
+    BENCH("Can parse header", {
+        Bench_Sink += Avtp_Can_GetAcfMsgType(can) +
+                Avtp_Can_GetAcfMsgLength(can) + Avtp_Can_GetPad(can) +
+                Avtp_Can_GetMtv(can) + Avtp_Can_GetRtr(can) +
+                Avtp_Can_GetEff(can) + Avtp_Can_GetBrs(can) +
+                Avtp_Can_GetFdf(can) + Avtp_Can_GetEsi(can) +
+                Avtp_Can_GetCanBusId(can) +
+                Avtp_Can_GetMessageTimestamp(can) +
+                Avtp_Can_GetCanIdentifier(can);
+    });
+    BENCH("Can parse header with Unpack", {
+        Avtp_Can_Unpack(can, &header);
+        Bench_Sink += header.can_identifier;
+    });
+}
+
+void Bench_Formats(const Bench_Options_t* options)
+{
+    const char* suite = "formats";
+    uint64_t storage[PDU_SIZE / sizeof(uint64_t)];
+    uint8_t* pdu = (uint8_t*)storage;
+
+    for (size_t i = 0; i < sizeof(storage); i++) {
+        pdu[i] = (uint8_t)(i * 37 + 11);
+    }
+
+    BENCH_FORMAT(CommonHeader, AVTP_COMMON_HEADER_FIELD_MAX,
+                 BENCH_ZERO(AVTP_COMMON_HEADER_LEN));
+    BENCH_UNPACK(CommonHeader, Avtp_CommonHeaderHeader_t, subtype);
+    BENCH_FORMAT(Udp, AVTP_UDP_FIELD_MAX, Avtp_Udp_Init(p));
+    BENCH_FORMAT(Crf, AVTP_CRF_FIELD_MAX, Avtp_Crf_Init(p));
+    BENCH_UNPACK(Crf, Avtp_CrfHeader_t, subtype);
+    BENCH_FORMAT(Rvf, AVTP_RVF_FIELD_MAX, Avtp_Rvf_Init(p));
+    BENCH_UNPACK(Rvf, Avtp_RvfHeader_t, subtype);
+
+    BENCH_FORMAT(Aaf, BENCH_AAF_FIELD_MAX, BENCH_ZERO(AVTP_AAF_HEADER_LEN));
+    BENCH_FORMAT(Pcm, AVTP_PCM_FIELD_MAX, Avtp_Pcm_Init(p));
+    BENCH_UNPACK(Pcm, Avtp_PcmHeader_t, subtype);
+
+    BENCH_FORMAT(Cvf, AVTP_CVF_FIELD_MAX, Avtp_Cvf_Init(p));
+    BENCH_UNPACK(Cvf, Avtp_CvfHeader_t, subtype);
+    BENCH_FORMAT(H264, AVTP_H264_FIELD_MAX, Avtp_H264_Init(p));
+    BENCH_FORMAT(Jpeg2000, AVTP_JPEG2000_FIELD_MAX, Avtp_Jpeg2000_Init(p));
+    BENCH_FORMAT(Mjpeg, AVTP_MJPEG_FIELD_MAX, Avtp_Mjpeg_Init(p));
+
+    BENCH_FORMAT(Ntscf, AVTP_NTSCF_FIELD_MAX, Avtp_Ntscf_Init(p));
+    BENCH_UNPACK(Ntscf, Avtp_NtscfHeader_t, subtype);
+    {
+        Avtp_NtscfHeader_t header = {
+            .subtype = AVTP_SUBTYPE_NTSCF,
+            .sv = 1,
+            .stream_id = 0xAABBCCDDEEFF0001,
+        };
+        BENCH("Ntscf build header with SetHeader", {
+            header.sequence_num = i;
+            Avtp_Ntscf_SetHeader((Avtp_Ntscf_t*)pdu, &header);
+        });
+    }
+    BENCH_FORMAT(Tscf, AVTP_TSCF_FIELD_MAX, Avtp_Tscf_Init(p));
+    BENCH_UNPACK(Tscf, Avtp_TscfHeader_t, subtype);
+    {
+        Avtp_TscfHeader_t header = {
+            .subtype = AVTP_SUBTYPE_TSCF,
+            .sv = 1,
+            .tv = 1,
+            .stream_id = 0xAABBCCDDEEFF0001,
+        };
+        BENCH("Tscf build header with SetHeader", {
+            header.sequence_num = i;
+            header.avtp_timestamp = i;
+            Avtp_Tscf_SetHeader((Avtp_Tscf_t*)pdu, &header);
+        });
+    }
+
+    BENCH_FORMAT(AcfCommon, AVTP_ACF_COMMON_FIELD_MAX,
+                 BENCH_ZERO(AVTP_ACF_COMMON_HEADER_LEN));
+    bench_can(options, pdu);
+    BENCH_FORMAT(CanBrief, AVTP_CAN_BRIEF_FIELD_MAX, Avtp_CanBrief_Init(p));
+    BENCH_UNPACK(CanBrief, Avtp_CanBriefHeader_t, acf_msg_type);
+    BENCH_FORMAT(FlexRay, AVTP_FLEXRAY_FIELD_MAX, Avtp_FlexRay_Init(p));
+    BENCH_FORMAT(Gpc, AVTP_GPC_FIELD_MAX, Avtp_Gpc_Init(p));
+    BENCH_FORMAT(Lin, AVTP_LIN_FIELD_MAX, Avtp_Lin_Init(p));
+    BENCH_FORMAT(Most, AVTP_MOST_FIELD_MAX, Avtp_Most_Init(p));
+    BENCH_FORMAT(Sensor, AVTP_SENSOR_FIELD_MAX, Avtp_Sensor_Init(p));
+    BENCH_FORMAT(SensorBrief, AVTP_SENSOR_BRIEF_FIELD_MAX,
+                 Avtp_SensorBrief_Init(p));
+    BENCH_FORMAT(Vss, AVTP_VSS_FIELD_MAX, Avtp_Vss_Init(p));
+    BENCH_FORMAT(VssBrief, AVTP_VSS_BRIEF_FIELD_MAX, Avtp_VssBrief_Init(p));
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2025, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file
+ * Benchmark suite covering all formats of the library, the ACF message
+ * builders and the CAN conversion of the acf-can applications. Results can be
+ * printed as CSV or JSON to be archived and compared across releases.
+ *
+ * Usage: bench-suite [-n iterations] [-f text|csv|json] [-s suite]
+ *
+ * Suites: formats, acf, vss, can-bridge
+ */
+
+#include <stdlib.h>
+
+#include "bench-suite.h"
+
+int main(int argc, char* argv[])
+{
+    Bench_Options_t options;
+
+    if (Bench_ParseArgs(argc, argv, &options) < 0) {
+        return EXIT_FAILURE;
+    }
+
+    Bench_Begin(&options, argv[0]);
+    if (Bench_SuiteSelected(&options, "formats")) {
+        Bench_Formats(&options);
+    }
+    if (Bench_SuiteSelected(&options, "acf")) {
+        Bench_Acf(&options);
+    }
+    if (Bench_SuiteSelected(&options, "vss")) {
+        Bench_Vss(&options);
+    }
+#ifdef __linux__
+    if (Bench_SuiteSelected(&options, "can-bridge")) {
+        Bench_CanBridge(&options);
+    }
+#endif
+    Bench_End();
+
+    return 0;
+}
@@ -0,0 +1,339 @@
+/*
+ * Copyright (c) 2025, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file
+ * Loopback benchmark of the raw Ethernet transport of the examples. Packets
+ * are sent on one end of a veth pair and received on the other with
+ * sendmmsg()/recv() on plain AF_PACKET sockets, with the PACKET_MMAP TX and
+ * RX rings and with AF_XDP sockets in copy mode. Packets per second and CPU
+ * time per packet are reported for each transport.
+ *
+ * Usage: bench-transport -t TX_IF -r RX_IF [-n packets] [-l length]
+ *                        [-f text|csv|json] [-s socket|mmap|xdp]
+ *
+ * Needs CAP_NET_RAW, and CAP_BPF and CAP_NET_ADMIN for AF_XDP. A veth pair can be set up with:
+ *
+ *   ip link add veth0 type veth peer name veth1
+ *   ip link set veth0 up && ip link set veth1 up
+ */
+
+#include <getopt.h>
+#include <linux/if.h>
+#include <linux/if_ether.h>
+#include <linux/if_packet.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "avtp/acf/Ntscf.h"
+#include "bench-common.h"
+#include "common/common.h"
+#include "common/xdp.h"
+
+#define DEFAULT_PACKETS         1000000ULL
+#define DEFAULT_PDU_LENGTH      64
+#define STREAM_ID               0xAABBCCDDEEFF0001
+/* The receiver stops if no packet arrived for this time after the last one
+ * was sent. */
+#define RX_IDLE_TIMEOUT_MS      200
+
+typedef enum {
+    TRANSPORT_SOCKET = 0,
+    TRANSPORT_MMAP,
+    TRANSPORT_XDP
+} Transport_t;
+
+typedef struct {
+    Transport_t transport;
+    int fd;
+    packet_ring_t* ring;
+    xdp_socket_t* xsk;
+    uint64_t expected;
+    volatile int txDone;
+    /* Results */
+    uint64_t received;
+    uint64_t lastRxNs;
+    uint64_t cpuNs;
+} RxContext_t;
+
+static const uint8_t streamAddr[ETH_ALEN] = { 0x91, 0xe0, 0xf0, 0x00, 0xfe, 0x00 };
+
+static uint64_t thread_cpu_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static void usage(const char* program)
+{
+    fprintf(stderr,
+            "Usage: %s -t TX_IF -r RX_IF [-n packets] [-l length] "
+            "[-f text|csv|json] [-s socket|mmap|xdp]\n", program);
+}
+
+static void* receive_packets(void* arg)
+{
+    RxContext_t* ctx = arg;
+    uint8_t buffer[TX_BATCH_PDU_SIZE];
+    uint8_t* pdu = buffer;
+    uint64_t cpuStart = thread_cpu_ns();
+    int res;
+
+    while (ctx->received < ctx->expected) {
+        if (ctx->transport == TRANSPORT_MMAP) {
+            res = packet_ring_recv(ctx->ring, &pdu, RX_IDLE_TIMEOUT_MS);
+        } else if (ctx->transport == TRANSPORT_XDP) {
+            res = xdp_socket_recv(ctx->xsk, &pdu, RX_IDLE_TIMEOUT_MS);
+        } else {
+            res = recv(ctx->fd, buffer, sizeof(buffer), 0);
+            if (res < 0) {
+                res = 0;
+            }
+        }
+        if (res > 0) {
+            Bench_Sink += pdu[0];
+            ctx->received++;
+            ctx->lastRxNs = Bench_NowNs();
+        } else if (res == 0 && ctx->txDone) {
+            break;
+        } else if (res < 0) {
+            break;
+        }
+    }
+    ctx->cpuNs = thread_cpu_ns() - cpuStart;
+
+    return NULL;
+}
+
+static int run(const char* suite, Transport_t transport, char* txIf,
+               char* rxIf, uint64_t packets, size_t pduLength)
+{
+    static packet_ring_t rxRing, txRing;
+    static xdp_socket_t rxXsk, txXsk;
+    static tx_batch_t batch;
+    struct timeval timeout = { 0, RX_IDLE_TIMEOUT_MS * 1000 };
+    uint8_t macaddr[ETH_ALEN];
+    uint8_t templ[TX_BATCH_PDU_SIZE];
+    struct sockaddr_ll addr;
+    RxContext_t ctx;
+    pthread_t rxThread;
+    uint64_t start, txEnd, cpuStart, txCpu;
+    int txFd, res;
+
+    memcpy(macaddr, streamAddr, ETH_ALEN);
+    memset(templ, 0, sizeof(templ));
+    Avtp_Ntscf_Init((Avtp_Ntscf_t*)templ);
+    Avtp_Ntscf_SetStreamId((Avtp_Ntscf_t*)templ, STREAM_ID);
+    Avtp_Ntscf_SetNtscfDataLength((Avtp_Ntscf_t*)templ,
+                                  pduLength - AVTP_NTSCF_HEADER_LEN);
+
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.transport = transport;
+    ctx.expected = packets;
+
+    if (transport == TRANSPORT_XDP) {
+        if (create_xdp_socket(&rxXsk, rxIf, macaddr, 0, 1) < 0) {
+            return -1;
+        }
+        ctx.fd = rxXsk.fd;
+        ctx.xsk = &rxXsk;
+        if (create_xdp_socket(&txXsk, txIf, macaddr, 0, 0) < 0) {
+            xdp_socket_close(&rxXsk);
+            return -1;
+        }
+        txFd = txXsk.fd;
+    } else if (transport == TRANSPORT_MMAP) {
+        if (create_listener_ring(&rxRing, rxIf, macaddr, ETH_P_TSN) < 0) {
+            return -1;
+        }
+        ctx.fd = rxRing.fd;
+        ctx.ring = &rxRing;
+        if (create_talker_ring(&txRing, -1) < 0) {
+            packet_ring_close(&rxRing);
+            return -1;
+        }
+        txFd = txRing.fd;
+    } else {
+        ctx.fd = create_listener_socket(rxIf, macaddr, ETH_P_TSN);
+        if (ctx.fd < 0) {
+            return -1;
+        }
+        setsockopt(ctx.fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        txFd = create_talker_socket(-1);
+        if (txFd < 0) {
+            close(ctx.fd);
+            return -1;
+        }
+    }
+
+    if (transport == TRANSPORT_XDP) {
+        res = tx_batch_init_xdp(&batch, &txXsk, TX_BATCH_MAX_PDUS);
+    } else {
+        res = setup_socket_address(txFd, txIf, macaddr, ETH_P_TSN, &addr);
+    }
+    if (res == 0 && transport != TRANSPORT_XDP) {
+        if (transport == TRANSPORT_MMAP) {
+            res = tx_batch_init_ring(&batch, &txRing, (struct sockaddr*)&addr,
+                                     sizeof(addr), TX_BATCH_MAX_PDUS);
+        } else {
+            res = tx_batch_init(&batch, txFd, (struct sockaddr*)&addr,
+                                sizeof(addr), TX_BATCH_MAX_PDUS);
+        }
+    }
+    if (res == 0) {
+        res = pthread_create(&rxThread, NULL, receive_packets, &ctx);
+    }
+    if (res != 0) {
+        goto out;
+    }
+
+    start = Bench_NowNs();
+    cpuStart = thread_cpu_ns();
+    for (uint64_t i = 0; i < packets && res == 0; i++) {
+        uint8_t* pdu = tx_batch_next(&batch);
+        if (pdu == NULL) {
+            res = -1;
+            break;
+        }
+        memcpy(pdu, templ, pduLength);
+        Avtp_Ntscf_SetSequenceNum((Avtp_Ntscf_t*)pdu, (uint8_t)i);
+        res = tx_batch_queue(&batch, pduLength);
+    }
+    if (res == 0) {
+        res = tx_batch_flush(&batch);
+    }
+    txEnd = Bench_NowNs();
+    txCpu = thread_cpu_ns() - cpuStart;
+    ctx.txDone = 1;
+    pthread_join(rxThread, NULL);
+
+    if (res == 0) {
+        Bench_Report(suite, "tx wall time per packet", txEnd - start, packets);
+        Bench_Report(suite, "tx cpu time per packet", txCpu, packets);
+        if (ctx.received > 0) {
+            Bench_Report(suite, "rx wall time per packet",
+                         ctx.lastRxNs - start, ctx.received);
+            Bench_Report(suite, "rx cpu time per packet", ctx.cpuNs,
+                         ctx.received);
+        }
+        fprintf(stderr, "%s: %llu packets sent, %llu received (%.0f packets/s)\n",
+                suite, (unsigned long long)packets,
+                (unsigned long long)ctx.received,
+                ctx.received ? ctx.received * 1e9 / (ctx.lastRxNs - start) : 0.0);
+    }
+
+out:
+    if (transport == TRANSPORT_XDP) {
+        xdp_socket_close(&txXsk);
+        xdp_socket_close(&rxXsk);
+    } else if (transport == TRANSPORT_MMAP) {
+        packet_ring_close(&txRing);
+        packet_ring_close(&rxRing);
+    } else {
+        close(txFd);
+        close(ctx.fd);
+    }
+    return res;
+}
+
+int main(int argc, char* argv[])
+{
+    static const struct option longOptions[] = {
+        { "tx-ifname", required_argument, NULL, 't' },
+        { "rx-ifname", required_argument, NULL, 'r' },
+        { "packets", required_argument, NULL, 'n' },
+        { "length", required_argument, NULL, 'l' },
+        { "format", required_argument, NULL, 'f' },
+        { "suite", required_argument, NULL, 's' },
+        { "help", no_argument, NULL, 'h' },
+        { NULL, 0, NULL, 0 }
+    };
+    static const char* suites[] = { "socket", "mmap", "xdp" };
+    char txIf[IFNAMSIZ] = "";
+    char rxIf[IFNAMSIZ] = "";
+    size_t pduLength = DEFAULT_PDU_LENGTH;
+    Bench_Options_t options;
+    int opt;
+
+    options.iterations = DEFAULT_PACKETS;
+    options.output = BENCH_OUTPUT_TEXT;
+    options.suite = NULL;
+
+    while ((opt = getopt_long(argc, argv, "t:r:n:l:f:s:h", longOptions, NULL)) != -1) {
+        switch (opt) {
+        case 't':
+            snprintf(txIf, sizeof(txIf), "%s", optarg);
+            break;
+        case 'r':
+            snprintf(rxIf, sizeof(rxIf), "%s", optarg);
+            break;
+        case 'n':
+            options.iterations = strtoull(optarg, NULL, 0);
+            break;
+        case 'l':
+            pduLength = strtoul(optarg, NULL, 0);
+            break;
+        case 'f':
+            if (Bench_ParseOutput(optarg, &options.output) < 0) {
+                usage(argv[0]);
+                return EXIT_FAILURE;
+            }
+            break;
+        case 's':
+            options.suite = optarg;
+            break;
+        default:
+            usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    if (txIf[0] == '\0' || rxIf[0] == '\0' || options.iterations == 0 ||
+            pduLength < AVTP_NTSCF_HEADER_LEN || pduLength > TX_BATCH_PDU_SIZE) {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    Bench_Begin(&options, argv[0]);
+    for (int i = 0; i < (int)(sizeof(suites) / sizeof(suites[0])); i++) {
+        if (Bench_SuiteSelected(&options, suites[i]) &&
+                run(suites[i], (Transport_t)i, txIf, rxIf, options.iterations,
+                    pduLength) < 0) {
+            return EXIT_FAILURE;
+        }
+    }
+    Bench_End();
+
+    return 0;
+}
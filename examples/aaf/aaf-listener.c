@@ -39,6 +39,7 @@
  *
  * TSN stream parameters such as destination mac address are passed via
  * command-line arguments. Run 'aaf-listener --help' for more information.
+ * Sending SIGUSR1 prints the lost, reordered and duplicated packets.
  *
  * This example relies on the system clock to schedule PCM samples for
  * playback. So make sure the system clock is synchronized with the PTP
@@ -56,6 +57,7 @@
 
 #include <assert.h>
 #include <argp.h>
+#include <errno.h>
 #include <arpa/inet.h>
 #include <linux/if.h>
 #include <linux/if_ether.h>
@@ -71,6 +73,8 @@
 
 #include "avtp/aaf/Pcm.h"
 #include "common/common.h"
+#include "common/xdp.h"
+#include "common/seqstats.h"
 #include "avtp/CommonHeader.h"
 
 #define STREAM_ID		0xAABBCCDDEEFF0001
@@ -79,6 +83,8 @@
 #define DATA_LEN		(SAMPLE_SIZE * NUM_CHANNELS)
 #define PDU_SIZE		(sizeof(struct avtp_stream_pdu) + DATA_LEN)
 #define NSEC_PER_SEC		1000000000ULL
+#define ARGPARSE_MMAP_OPTION	500
+#define ARGPARSE_XDP_OPTION	501
 
 struct sample_entry {
     STAILQ_ENTRY(sample_entry) entries;
@@ -90,11 +96,17 @@ struct sample_entry {
 static STAILQ_HEAD(sample_queue, sample_entry) samples;
 static char ifname[IFNAMSIZ];
 static uint8_t macaddr[ETH_ALEN];
-static uint8_t expected_seq;
+static Avtp_SeqTracker_t seq_tracker;
+static seq_stats_timer_t stats_timer;
+static uint8_t use_mmap;
+static uint8_t use_xdp;
+static uint32_t xdp_queue;
 
 static struct argp_option options[] = {
     {"dst-addr", 'd', "MACADDR", 0, "Stream Destination MAC address" },
     {"ifname", 'i', "IFNAME", 0, "Network Interface" },
+    {"mmap", ARGPARSE_MMAP_OPTION, 0, 0, "Receive PDUs through a PACKET_MMAP RX ring" },
+    {"xdp", ARGPARSE_XDP_OPTION, "QUEUE", OPTION_ARG_OPTIONAL, "Receive PDUs through an AF_XDP socket on QUEUE (Default: 0)" },
     { 0 }
 };
 
@@ -116,6 +128,13 @@ static error_t parser(int key, char *arg, struct argp_state *state)
     case 'i':
         strncpy(ifname, arg, sizeof(ifname) - 1);
         break;
+    case ARGPARSE_MMAP_OPTION:
+        use_mmap = 1;
+        break;
+    case ARGPARSE_XDP_OPTION:
+        use_xdp = 1;
+        xdp_queue = arg ? atoi(arg) : 0;
+        break;
     }
 
     return 0;
@@ -157,172 +176,95 @@ static int schedule_sample(int fd, struct timespec *tspec, uint8_t *pcm_sample)
     return 0;
 }
 
-static bool is_valid_packet(struct avtp_stream_pdu *pdu)
+static bool is_valid_packet(const Avtp_PcmHeader_t *hdr)
 {
-    struct avtp_common_pdu *common = (struct avtp_common_pdu *) pdu;
-    uint64_t val64;
-    uint32_t val32;
-    int res;
-
-    res = avtp_pdu_get(common, AVTP_FIELD_SUBTYPE, &val32);
-    if (res < 0) {
-        fprintf(stderr, "Failed to get subtype field: %d\n", res);
-        return false;
-    }
-    if (val32 != AVTP_SUBTYPE_AAF) {
+    if (hdr->subtype != AVTP_SUBTYPE_AAF) {
         fprintf(stderr, "Subtype mismatch: expected %u, got %u\n",
-                        AVTP_SUBTYPE_AAF, val32);
+                        AVTP_SUBTYPE_AAF, hdr->subtype);
         return false;
     }
 
-    res = avtp_pdu_get(common, AVTP_FIELD_VERSION, &val32);
-    if (res < 0) {
-        fprintf(stderr, "Failed to get version field: %d\n", res);
-        return false;
-    }
-    if (val32 != 0) {
+    if (hdr->version != 0) {
         fprintf(stderr, "Version mismatch: expected %u, got %u\n",
-                                0, val32);
+                                0, hdr->version);
         return false;
     }
 
-    res = avtp_aaf_pdu_get(pdu, AVTP_AAF_FIELD_TV, &val64);
-    if (res < 0) {
-        fprintf(stderr, "Failed to get tv field: %d\n", res);
-        return false;
-    }
-    if (val64 != 1) {
-        fprintf(stderr, "tv mismatch: expected %u, got %" PRIu64 "\n",
-                                1, val64);
+    if (hdr->tv != 1) {
+        fprintf(stderr, "tv mismatch: expected %u, got %u\n",
+                                1, hdr->tv);
         return false;
     }
 
-    res = avtp_aaf_pdu_get(pdu, AVTP_AAF_FIELD_SP, &val64);
-    if (res < 0) {
-        fprintf(stderr, "Failed to get sp field: %d\n", res);
-        return false;
-    }
-    if (val64 != AVTP_AAF_PCM_SP_NORMAL) {
-        fprintf(stderr, "sp mismatch: expected %u, got %" PRIu64 "\n",
-                        AVTP_AAF_PCM_SP_NORMAL, val64);
+    if (hdr->sp != AVTP_AAF_PCM_SP_NORMAL) {
+        fprintf(stderr, "sp mismatch: expected %u, got %u\n",
+                        AVTP_AAF_PCM_SP_NORMAL, hdr->sp);
         return false;
     }
 
-    res = avtp_aaf_pdu_get(pdu, AVTP_AAF_FIELD_STREAM_ID, &val64);
-    if (res < 0) {
-        fprintf(stderr, "Failed to get stream ID field: %d\n", res);
-        return false;
-    }
-    if (val64 != STREAM_ID) {
+    if (hdr->stream_id != STREAM_ID) {
         fprintf(stderr, "Stream ID mismatch: expected %" PRIu64 ", got %" PRIu64 "\n",
-                            STREAM_ID, val64);
-        return false;
-    }
-
-    res = avtp_aaf_pdu_get(pdu, AVTP_AAF_FIELD_SEQ_NUM, &val64);
-    if (res < 0) {
-        fprintf(stderr, "Failed to get sequence num field: %d\n", res);
+                            STREAM_ID, hdr->stream_id);
         return false;
     }
 
-    if (val64 != expected_seq) {
-        /* If we have a sequence number mismatch, we simply log the
-         * issue and continue to process the packet. We don't want to
-         * invalidate it since it is a valid packet after all.
-         */
-        fprintf(stderr, "Sequence number mismatch: expected %u, got %" PRIu64 "\n",
-                            expected_seq, val64);
-        expected_seq = val64;
-    }
-
-    expected_seq++;
+    /* Sequence number mismatches are only counted, the packet is valid
+     * after all. The statistics are printed on SIGUSR1.
+     */
+    Avtp_SeqTracker_Update(&seq_tracker, hdr->sequence_num);
 
-    res = avtp_aaf_pdu_get(pdu, AVTP_AAF_FIELD_FORMAT, &val64);
-    if (res < 0) {
-        fprintf(stderr, "Failed to get format field: %d\n", res);
-        return false;
-    }
-    if (val64 != AVTP_AAF_FORMAT_INT_16BIT) {
-        fprintf(stderr, "Format mismatch: expected %u, got %" PRIu64 "\n",
-                    AVTP_AAF_FORMAT_INT_16BIT, val64);
+    if (hdr->format != AVTP_AAF_FORMAT_INT_16BIT) {
+        fprintf(stderr, "Format mismatch: expected %u, got %u\n",
+                    AVTP_AAF_FORMAT_INT_16BIT, hdr->format);
         return false;
     }
 
-    res = avtp_aaf_pdu_get(pdu, AVTP_AAF_FIELD_NSR, &val64);
-    if (res < 0) {
-        fprintf(stderr, "Failed to get sample rate field: %d\n", res);
-        return false;
-    }
-    if (val64 != AVTP_AAF_PCM_NSR_48KHZ) {
-        fprintf(stderr, "Sample rate mismatch: expected %u, got %" PRIu64 "\n",
-                        AVTP_AAF_PCM_NSR_48KHZ, val64);
+    if (hdr->nsr != AVTP_AAF_PCM_NSR_48KHZ) {
+        fprintf(stderr, "Sample rate mismatch: expected %u, got %u\n",
+                        AVTP_AAF_PCM_NSR_48KHZ, hdr->nsr);
         return false;
     }
 
-    res = avtp_aaf_pdu_get(pdu, AVTP_AAF_FIELD_CHAN_PER_FRAME, &val64);
-    if (res < 0) {
-        fprintf(stderr, "Failed to get channels field: %d\n", res);
-        return false;
-    }
-    if (val64 != NUM_CHANNELS) {
-        fprintf(stderr, "Channels mismatch: expected %u, got %" PRIu64 "\n",
-                            NUM_CHANNELS, val64);
+    if (hdr->channels_per_frame != NUM_CHANNELS) {
+        fprintf(stderr, "Channels mismatch: expected %u, got %u\n",
+                            NUM_CHANNELS, hdr->channels_per_frame);
         return false;
     }
 
-    res = avtp_aaf_pdu_get(pdu, AVTP_AAF_FIELD_BIT_DEPTH, &val64);
-    if (res < 0) {
-        fprintf(stderr, "Failed to get depth field: %d\n", res);
-        return false;
-    }
-    if (val64 != 16) {
-        fprintf(stderr, "Depth mismatch: expected %u, got %" PRIu64 "\n",
-                                16, val64);
+    if (hdr->bit_depth != 16) {
+        fprintf(stderr, "Depth mismatch: expected %u, got %u\n",
+                                16, hdr->bit_depth);
         return false;
     }
 
-    res = avtp_aaf_pdu_get(pdu, AVTP_AAF_FIELD_STREAM_DATA_LEN, &val64);
-    if (res < 0) {
-        fprintf(stderr, "Failed to get data_len field: %d\n", res);
-        return false;
-    }
-    if (val64 != DATA_LEN) {
-        fprintf(stderr, "Data len mismatch: expected %u, got %" PRIu64 "\n",
-                            DATA_LEN, val64);
+    if (hdr->stream_data_length != DATA_LEN) {
+        fprintf(stderr, "Data len mismatch: expected %u, got %u\n",
+                            DATA_LEN, hdr->stream_data_length);
         return false;
     }
 
     return true;
 }
 
-static int new_packet(int sk_fd, int timer_fd)
+static int handle_pdu(struct avtp_stream_pdu *pdu, ssize_t n, int timer_fd)
 {
     int res;
-    ssize_t n;
-    uint64_t avtp_time;
     struct timespec tspec;
-    struct avtp_stream_pdu *pdu = alloca(PDU_SIZE);
-
-    memset(pdu, 0, PDU_SIZE);
+    Avtp_PcmHeader_t hdr;
 
-    n = recv(sk_fd, pdu, PDU_SIZE, 0);
-    if (n < 0 || n != PDU_SIZE) {
-        perror("Failed to receive data");
+    if (n != PDU_SIZE) {
+        fprintf(stderr, "Failed to receive data\n");
         return -1;
     }
 
-    if (!is_valid_packet(pdu)) {
+    Avtp_Pcm_Unpack((Avtp_Pcm_t*)pdu, &hdr);
+
+    if (!is_valid_packet(&hdr)) {
         fprintf(stderr, "Dropping packet\n");
         return 0;
     }
 
-    res = avtp_aaf_pdu_get(pdu, AVTP_AAF_FIELD_TIMESTAMP, &avtp_time);
-    if (res < 0) {
-        fprintf(stderr, "Failed to get AVTP time from PDU\n");
-        return -1;
-    }
-
-    res = get_presentation_time(avtp_time, &tspec);
+    res = get_presentation_time(hdr.avtp_timestamp, &tspec);
     if (res < 0)
         return -1;
 
@@ -333,6 +275,52 @@ static int new_packet(int sk_fd, int timer_fd)
     return 0;
 }
 
+static int new_packet(int sk_fd, int timer_fd)
+{
+    ssize_t n;
+    struct avtp_stream_pdu *pdu = alloca(PDU_SIZE);
+
+    memset(pdu, 0, PDU_SIZE);
+
+    n = recv(sk_fd, pdu, PDU_SIZE, 0);
+    if (n < 0) {
+        perror("Failed to receive data");
+        return -1;
+    }
+
+    return handle_pdu(pdu, n, timer_fd);
+}
+
+/* Handle all packets waiting in the RX ring without copying them. */
+static int new_ring_packets(packet_ring_t *ring, int timer_fd)
+{
+    int n, res;
+    uint8_t *pdu;
+
+    while ((n = packet_ring_recv(ring, &pdu, 0)) > 0) {
+        res = handle_pdu((struct avtp_stream_pdu *) pdu, n, timer_fd);
+        if (res < 0)
+            return -1;
+    }
+
+    return n;
+}
+
+/* Handle all packets waiting on the AF_XDP socket without copying them. */
+static int new_xdp_packets(xdp_socket_t *xsk, int timer_fd)
+{
+    int n, res;
+    uint8_t *pdu;
+
+    while ((n = xdp_socket_recv(xsk, &pdu, 0)) > 0) {
+        res = handle_pdu((struct avtp_stream_pdu *) pdu, n, timer_fd);
+        if (res < 0)
+            return -1;
+    }
+
+    return n;
+}
+
 static int timeout(int fd)
 {
     int res;
@@ -373,21 +361,43 @@ int main(int argc, char *argv[])
 {
     int sk_fd, timer_fd, res;
     struct pollfd fds[2];
+    static packet_ring_t ring;
+    static xdp_socket_t xsk;
 
     argp_parse(&argp, argc, argv, 0, NULL, NULL);
 
     STAILQ_INIT(&samples);
 
-    sk_fd = create_listener_socket(ifname, macaddr, ETH_P_TSN);
-    if (sk_fd < 0)
+    if (seq_stats_init_signal() < 0)
         return 1;
 
-    timer_fd = timerfd_create(CLOCK_REALTIME, 0);
-    if (timer_fd < 0) {
-        close(sk_fd);
+    if (use_mmap) {
+        res = create_listener_ring(&ring, ifname, macaddr, ETH_P_TSN);
+        sk_fd = res < 0 ? -1 : ring.fd;
+    } else if (use_xdp) {
+        res = create_xdp_socket(&xsk, ifname, macaddr, xdp_queue, 1);
+        sk_fd = res < 0 ? -1 : xsk.fd;
+    } else {
+        sk_fd = create_listener_socket(ifname, macaddr, ETH_P_TSN);
+    }
+    if (sk_fd < 0)
         return 1;
+
+    /* Other streams are dropped in the kernel. AF_XDP sockets only get
+     * the frames redirected by the XDP program, so they are not filtered.
+     */
+    if (!use_xdp) {
+        res = attach_stream_filter(sk_fd, 0,
+                                   (uint8_t[]) { AVTP_SUBTYPE_AAF }, 1,
+                                   (uint64_t[]) { STREAM_ID }, 1);
+        if (res < 0)
+            goto err_close;
     }
 
+    timer_fd = timerfd_create(CLOCK_REALTIME, 0);
+    if (timer_fd < 0)
+        goto err_close;
+
     fds[0].fd = sk_fd;
     fds[0].events = POLLIN;
     fds[1].fd = timer_fd;
@@ -395,13 +405,22 @@ int main(int argc, char *argv[])
 
     while (1) {
         res = poll(fds, 2, -1);
+        if (seq_stats_due(&stats_timer, 0))
+            seq_stats_print("AAF", &seq_tracker.stats);
         if (res < 0) {
+            if (errno == EINTR)
+                continue;
             perror("Failed to poll() fds");
             goto err;
         }
 
         if (fds[0].revents & POLLIN) {
-            res = new_packet(sk_fd, timer_fd);
+            if (use_mmap)
+                res = new_ring_packets(&ring, timer_fd);
+            else if (use_xdp)
+                res = new_xdp_packets(&xsk, timer_fd);
+            else
+                res = new_packet(sk_fd, timer_fd);
             if (res < 0)
                 goto err;
         }
@@ -416,7 +435,13 @@ int main(int argc, char *argv[])
     return 0;
 
 err:
-    close(sk_fd);
     close(timer_fd);
+err_close:
+    if (use_mmap)
+        packet_ring_close(&ring);
+    else if (use_xdp)
+        xdp_socket_close(&xsk);
+    else
+        close(sk_fd);
     return 1;
 }
\ No newline at end of file
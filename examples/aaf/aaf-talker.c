@@ -73,19 +73,24 @@
 #define NUM_CHANNELS		2
 #define DATA_LEN		(SAMPLE_SIZE * NUM_CHANNELS)
 #define PDU_SIZE		(sizeof(struct avtp_stream_pdu) + DATA_LEN)
+#define SAMPLE_RATE		48000
+#define SAMPLES_PER_PDU		(DATA_LEN / (SAMPLE_SIZE * NUM_CHANNELS))
 #define NSEC_PER_SEC		1000000000ULL
 #define NSEC_PER_MSEC		1000000ULL
+#define ARGPARSE_MMAP_OPTION	500
 
 static char ifname[IFNAMSIZ];
 static uint8_t macaddr[ETH_ALEN];
 static int priority = -1;
 static int max_transit_time;
+static uint8_t use_mmap;
 
 static struct argp_option options[] = {
     {"dst-addr", 'd', "MACADDR", 0, "Stream Destination MAC address" },
     {"ifname", 'i', "IFNAME", 0, "Network Interface" },
     {"max-transit-time", 'm', "MSEC", 0, "Maximum Transit Time in ms" },
     {"prio", 'p', "NUM", 0, "SO_PRIORITY to be set in socket" },
+    {"mmap", ARGPARSE_MMAP_OPTION, 0, 0, "Send PDUs through a PACKET_MMAP TX ring" },
     { 0 }
 };
 
@@ -113,6 +118,9 @@ static error_t parser(int key, char *arg, struct argp_state *state)
     case 'p':
         priority = atoi(arg);
         break;
+    case ARGPARSE_MMAP_OPTION:
+        use_mmap = 1;
+        break;
     }
 
     return 0;
@@ -120,7 +128,7 @@ static error_t parser(int key, char *arg, struct argp_state *state)
 
 static struct argp argp = { options, parser };
 
-static int init_pdu(struct avtp_stream_pdu *pdu)
+static int init_pdu(struct avtp_stream_pdu *pdu, Avtp_StreamTemplate_t *tmpl)
 {
     int res;
 
@@ -163,19 +171,59 @@ static int init_pdu(struct avtp_stream_pdu *pdu)
     if (res < 0)
         return -1;
 
+    res = Avtp_Pcm_InitTemplate(tmpl, (Avtp_Pcm_t*)pdu);
+    if (res < 0)
+        return -1;
+
     return 0;
 }
 
+/* Presentation time of the PDU at index in a batch, relative to the first
+ * PDU of the batch. The PDUs of a batch carry consecutive samples.
+ */
+static uint32_t pdu_time_offset(size_t index)
+{
+    return (uint32_t) (index * SAMPLES_PER_PDU * NSEC_PER_SEC / SAMPLE_RATE);
+}
+
+/* Queue an AAF PDU carrying DATA_LEN bytes of data. */
+static int queue_pdu(tx_batch_t *batch, Avtp_StreamTemplate_t *tmpl,
+                     const uint8_t *data, uint8_t seq_num, uint32_t avtp_time)
+{
+    struct avtp_stream_pdu *pdu;
+
+    pdu = (struct avtp_stream_pdu *) tx_batch_next(batch);
+    if (pdu == NULL)
+        return -1;
+    Avtp_StreamTemplate_Render(tmpl, (uint8_t *) pdu, seq_num, avtp_time,
+                               DATA_LEN);
+    memcpy(pdu->avtp_payload, data, DATA_LEN);
+
+    return tx_batch_queue(batch, PDU_SIZE);
+}
+
 int main(int argc, char *argv[])
 {
     int fd, res;
     struct sockaddr_ll sk_addr;
     struct avtp_stream_pdu *pdu = alloca(PDU_SIZE);
+    Avtp_StreamTemplate_t tmpl;
     uint8_t seq_num = 0;
+    static tx_batch_t batch;
+    static packet_ring_t ring;
+    /* Data for up to one batch of PDUs is read from stdin at once. */
+    static uint8_t data[TX_BATCH_MAX_PDUS * DATA_LEN];
+    size_t data_len = 0;
+    uint32_t avtp_time;
 
     argp_parse(&argp, argc, argv, 0, NULL, NULL);
 
-    fd = create_talker_socket(priority);
+    if (use_mmap) {
+        res = create_talker_ring(&ring, priority);
+        fd = res < 0 ? -1 : ring.fd;
+    } else {
+        fd = create_talker_socket(priority);
+    }
     if (fd < 0)
         return 1;
 
@@ -183,57 +231,87 @@ int main(int argc, char *argv[])
     if (res < 0)
         goto err;
 
-    res = init_pdu(pdu);
+    res = init_pdu(pdu, &tmpl);
+    if (res < 0)
+        goto err;
+
+    if (use_mmap)
+        res = tx_batch_init_ring(&batch, &ring, (struct sockaddr *) &sk_addr,
+                                 sizeof(sk_addr), TX_BATCH_MAX_PDUS);
+    else
+        res = tx_batch_init(&batch, fd, (struct sockaddr *) &sk_addr,
+                            sizeof(sk_addr), TX_BATCH_MAX_PDUS);
     if (res < 0)
         goto err;
 
     while (1) {
         ssize_t n;
-        uint32_t avtp_time;
+        size_t offset = 0;
+        size_t index = 0;
 
-        memset(pdu->avtp_payload, 0, DATA_LEN);
-
-        n = read(STDIN_FILENO, pdu->avtp_payload, DATA_LEN);
+        n = read(STDIN_FILENO, data + data_len, sizeof(data) - data_len);
+        if (n < 0) {
+            perror("Failed to read data");
+            goto err;
+        }
         if (n == 0)
             break;
+        data_len += n;
 
-        if (n != DATA_LEN) {
-            fprintf(stderr, "read %zd bytes, expected %d\n",
-                                n, DATA_LEN);
-        }
-
+        /* Every complete PDU that is available is sent in one batch. The
+         * presentation time is taken once per batch, the following PDUs
+         * are paced by their sample period.
+         */
         res = calculate_avtp_time(&avtp_time, max_transit_time);
         if (res < 0) {
             fprintf(stderr, "Failed to calculate avtp time\n");
             goto err;
         }
+        while (data_len - offset >= DATA_LEN) {
+            res = queue_pdu(&batch, &tmpl, data + offset, seq_num++,
+                            avtp_time + pdu_time_offset(index++));
+            if (res < 0)
+                goto err;
+            offset += DATA_LEN;
+        }
 
-        res = avtp_aaf_pdu_set(pdu, AVTP_AAF_FIELD_TIMESTAMP,
-                                avtp_time);
+        res = tx_batch_flush(&batch);
         if (res < 0)
             goto err;
 
-        res = avtp_aaf_pdu_set(pdu, AVTP_AAF_FIELD_SEQ_NUM, seq_num++);
-        if (res < 0)
-            goto err;
+        memmove(data, data + offset, data_len - offset);
+        data_len -= offset;
+    }
 
-        n = sendto(fd, pdu, PDU_SIZE, 0,
-                (struct sockaddr *) &sk_addr, sizeof(sk_addr));
-        if (n < 0) {
-            perror("Failed to send data");
+    /* Send the remaining data padded with zeros. */
+    if (data_len > 0) {
+        fprintf(stderr, "read %zu bytes, expected %d\n", data_len, DATA_LEN);
+        memset(data + data_len, 0, DATA_LEN - data_len);
+        res = calculate_avtp_time(&avtp_time, max_transit_time);
+        if (res < 0) {
+            fprintf(stderr, "Failed to calculate avtp time\n");
             goto err;
         }
-
-        if (n != PDU_SIZE) {
-            fprintf(stderr, "wrote %zd bytes, expected %zd\n",
-                                n, PDU_SIZE);
-        }
+        res = queue_pdu(&batch, &tmpl, data, seq_num++, avtp_time);
+        if (res < 0)
+            goto err;
+        res = tx_batch_flush(&batch);
+        if (res < 0)
+            goto err;
     }
 
-    close(fd);
+    tx_batch_print_stats(&batch, 0);
+
+    if (use_mmap)
+        packet_ring_close(&ring);
+    else
+        close(fd);
     return 0;
 
 err:
-    close(fd);
+    if (use_mmap)
+        packet_ring_close(&ring);
+    else
+        close(fd);
     return 1;
-}
\ No newline at end of file
+}
@@ -28,11 +28,19 @@
  */
 
 #ifdef __linux__
+#define _GNU_SOURCE
+#include <sys/socket.h>
+#include <sys/timerfd.h>
+#include <sys/epoll.h>
+#include <poll.h>
+#include <errno.h>
 #include <linux/if_packet.h>
 #include <arpa/inet.h>
 #include <linux/if.h>
 #include <linux/can.h>
 #include <linux/can/raw.h>
+#include <linux/net_tstamp.h>
+#include <linux/sockios.h>
 #include <sys/ioctl.h>
 #elif defined(__ZEPHYR__)
 #include <zephyr/kernel.h>
@@ -46,14 +54,19 @@ LOG_MODULE_REGISTER(acf_can_common, LOG_LEVEL_DBG);
 #endif
 
 #include <unistd.h>
+#include <errno.h>
+#include <stdlib.h>
 #include <string.h>
 #include <time.h>
 #include <stdio.h>
+#include <inttypes.h>
 
 #include "avtp/Udp.h"
 #include "avtp/CommonHeader.h"
 #include "avtp/acf/Ntscf.h"
 #include "avtp/acf/Tscf.h"
+#include "avtp/acf/CanBrief.h"
+#include "avtp/StreamTemplate.h"
 #include "acf-can-common.h"
 
 #ifdef __linux__
@@ -72,10 +85,330 @@ LOG_MODULE_REGISTER(acf_can_common, LOG_LEVEL_DBG);
 
 #endif
 
+#define NSEC_PER_SEC                1000000000ULL
+#define NSEC_PER_USEC               1000ULL
+#define USEC_PER_SEC                1000000UL
+
 #ifdef __ZEPHYR__
 typedef uint32_t canid_t;
 #endif
 
+void can_route_table_init(can_route_table_t* routes, uint8_t default_action,
+                          uint8_t default_stream) {
+
+    memset(routes, 0, sizeof(*routes));
+    routes->default_route.action = default_action;
+    routes->default_route.stream = default_stream;
+}
+
+static uint32_t eff_slot(uint32_t id) {
+
+    // Multiplicative hashing, the top bits of the product are mixed best
+    return (id * 2654435761U) >> (32 - CAN_ROUTE_EFF_SLOT_BITS);
+}
+
+static int route_matches(const can_route_t* route, uint32_t id) {
+
+    return (route->id & CAN_EFF_FLAG) == (id & CAN_EFF_FLAG) &&
+           ((route->id ^ id) & route->mask) == 0;
+}
+
+int can_route_table_add(can_route_table_t* routes, uint32_t id, uint32_t mask,
+                        uint8_t action, uint8_t stream) {
+
+    uint32_t id_mask = (id & CAN_EFF_FLAG) ? CAN_EFF_MASK : CAN_SFF_MASK;
+    uint8_t index = routes->num_rules;
+    uint8_t mask_index = 0;
+    can_route_t* route;
+
+    if (routes->num_rules == CAN_ROUTE_MAX_RULES) {
+        return -ENOSPC;
+    }
+    if ((id & ~CAN_EFF_FLAG & ~id_mask) || (mask & ~id_mask) ||
+        action > CAN_ROUTE_PRIORITY || stream >= CAN_ROUTE_MAX_STREAMS) {
+        return -EINVAL;
+    }
+
+    // 29 bit IDs with a mask are hashed per mask, which bounds the lookup
+    if ((id & CAN_EFF_FLAG) && mask != CAN_EFF_MASK) {
+        for (mask_index = 0; mask_index < routes->num_eff_masks; mask_index++) {
+            if (routes->eff_masks[mask_index] == mask) {
+                break;
+            }
+        }
+        if (mask_index == CAN_ROUTE_EFF_MAX_MASKS) {
+            return -ENOSPC;
+        }
+    }
+
+    route = &routes->rules[index];
+    route->id = id & (CAN_EFF_FLAG | mask);
+    route->mask = mask;
+    route->action = action;
+    route->stream = stream;
+    routes->num_rules++;
+
+    // 11 bit IDs: mark all IDs matched first by this rule
+    if (!(id & CAN_EFF_FLAG)) {
+        for (uint32_t i = 0; i < CAN_ROUTE_SFF_IDS; i++) {
+            uint64_t bit = 1ULL << (i % 64);
+            if ((routes->sff_matched[i / 64] & bit) ||
+                !route_matches(route, i)) {
+                continue;
+            }
+            routes->sff_matched[i / 64] |= bit;
+            routes->sff_rules[i] = index;
+        }
+        return 0;
+    }
+
+    // 29 bit IDs with a mask are looked up after the exact IDs. A masked ID
+    // keeps the first rule matching it.
+    if (mask != CAN_EFF_MASK) {
+        routes->eff_masked[routes->num_eff_masked++] = index;
+        if (mask_index == routes->num_eff_masks) {
+            routes->eff_masks[routes->num_eff_masks++] = mask;
+        }
+        for (uint32_t slot = eff_slot(route->id + mask_index); ;
+             slot = (slot + 1) % CAN_ROUTE_EFF_SLOTS) {
+            if (routes->eff_masked_masks[slot] == mask_index + 1 &&
+                routes->eff_masked_ids[slot] == route->id) {
+                return 0;
+            }
+            if (routes->eff_masked_masks[slot] == 0) {
+                routes->eff_masked_ids[slot] = route->id;
+                routes->eff_masked_masks[slot] = mask_index + 1;
+                routes->eff_masked_rules[slot] = index;
+                return 0;
+            }
+        }
+    }
+
+    // An exact ID keeps the first rule matching it, which may be an earlier
+    // rule with a mask
+    for (uint8_t i = 0; i < routes->num_eff_masked; i++) {
+        if (route_matches(&routes->rules[routes->eff_masked[i]], route->id)) {
+            index = routes->eff_masked[i];
+            break;
+        }
+    }
+    for (uint32_t slot = eff_slot(route->id); ;
+         slot = (slot + 1) % CAN_ROUTE_EFF_SLOTS) {
+        if (routes->eff_ids[slot] == route->id) {
+            return 0;
+        }
+        if (routes->eff_ids[slot] == 0) {
+            routes->eff_ids[slot] = route->id;
+            routes->eff_rules[slot] = index;
+            return 0;
+        }
+    }
+}
+
+int can_route_parse_action(const char* str, uint8_t* action, uint8_t* stream) {
+
+    const char* arg;
+    char* end;
+    unsigned long value;
+
+    if (strcmp(str, "drop") == 0) {
+        *action = CAN_ROUTE_DROP;
+        *stream = 0;
+        return 0;
+    }
+    if (strncmp(str, "fwd", 3) == 0) {
+        *action = CAN_ROUTE_FORWARD;
+        arg = str + 3;
+    } else if (strncmp(str, "prio", 4) == 0) {
+        *action = CAN_ROUTE_PRIORITY;
+        arg = str + 4;
+    } else {
+        return -EINVAL;
+    }
+
+    *stream = 0;
+    if (*arg == '\0') {
+        return 0;
+    }
+    if (*arg != '=') {
+        return -EINVAL;
+    }
+    value = strtoul(arg + 1, &end, 0);
+    if (end == arg + 1 || *end != '\0' || value >= CAN_ROUTE_MAX_STREAMS) {
+        return -EINVAL;
+    }
+    *stream = value;
+
+    return 0;
+}
+
+int can_route_parse(can_route_table_t* routes, const char* rule) {
+
+    const char* id_str = rule;
+    const char* end;
+    char* num_end;
+    uint32_t id, mask;
+    uint8_t action, stream;
+    int res;
+
+    end = strchr(rule, ':');
+    if (end == NULL) {
+        return -EINVAL;
+    }
+    res = can_route_parse_action(end + 1, &action, &stream);
+    if (res < 0) {
+        return res;
+    }
+
+    // Like for cansend, IDs with more than 3 digits are 29 bit IDs
+    if (strncmp(id_str, "0x", 2) == 0 || strncmp(id_str, "0X", 2) == 0) {
+        id_str += 2;
+    }
+    id = strtoul(id_str, &num_end, 16);
+    if (num_end == id_str) {
+        return -EINVAL;
+    }
+    if (num_end - id_str > 3) {
+        id |= CAN_EFF_FLAG;
+        mask = CAN_EFF_MASK;
+    } else {
+        mask = CAN_SFF_MASK;
+    }
+    if (*num_end == '/') {
+        const char* mask_str = num_end + 1;
+        mask = strtoul(mask_str, &num_end, 16);
+        if (num_end == mask_str) {
+            return -EINVAL;
+        }
+    }
+    if (num_end != end) {
+        return -EINVAL;
+    }
+
+    return can_route_table_add(routes, id, mask, action, stream);
+}
+
+int can_route_check_streams(const can_route_table_t* routes,
+                            uint8_t num_streams) {
+
+    if (routes->default_route.action != CAN_ROUTE_DROP &&
+        routes->default_route.stream >= num_streams) {
+        return -EINVAL;
+    }
+    for (uint8_t i = 0; i < routes->num_rules; i++) {
+        if (routes->rules[i].action != CAN_ROUTE_DROP &&
+            routes->rules[i].stream >= num_streams) {
+            return -EINVAL;
+        }
+    }
+
+    return 0;
+}
+
+const can_route_t* can_route_lookup(const can_route_table_t* routes,
+                                    const frame_t* frame) {
+
+    uint32_t id;
+    uint8_t rule;
+
+#ifdef __linux__
+    // CAN and CAN FD frames share the layout of the ID
+    id = frame->cc.can_id & (CAN_EFF_FLAG | CAN_EFF_MASK);
+#elif defined(__ZEPHYR__)
+    id = frame->cc.id | ((frame->cc.flags & CAN_FRAME_IDE) ? CAN_EFF_FLAG : 0);
+#endif
+
+    if (!(id & CAN_EFF_FLAG)) {
+        id &= CAN_SFF_MASK;
+        if (routes->sff_matched[id / 64] & (1ULL << (id % 64))) {
+            return &routes->rules[routes->sff_rules[id]];
+        }
+        return &routes->default_route;
+    }
+
+    for (uint32_t slot = eff_slot(id); routes->eff_ids[slot] != 0;
+         slot = (slot + 1) % CAN_ROUTE_EFF_SLOTS) {
+        if (routes->eff_ids[slot] == id) {
+            return &routes->rules[routes->eff_rules[slot]];
+        }
+    }
+
+    // The first rule is the one with the lowest index over all masks
+    rule = CAN_ROUTE_MAX_RULES;
+    for (uint8_t i = 0; i < routes->num_eff_masks; i++) {
+        uint32_t masked_id = id & (CAN_EFF_FLAG | routes->eff_masks[i]);
+        for (uint32_t slot = eff_slot(masked_id + i);
+             routes->eff_masked_masks[slot] != 0;
+             slot = (slot + 1) % CAN_ROUTE_EFF_SLOTS) {
+            if (routes->eff_masked_masks[slot] == i + 1 &&
+                routes->eff_masked_ids[slot] == masked_id) {
+                if (routes->eff_masked_rules[slot] < rule) {
+                    rule = routes->eff_masked_rules[slot];
+                }
+                break;
+            }
+        }
+    }
+    if (rule < CAN_ROUTE_MAX_RULES) {
+        return &routes->rules[rule];
+    }
+
+    return &routes->default_route;
+}
+
+int can_route_filters(const can_route_table_t* routes,
+                      can_route_filter_t* filters, int max_filters) {
+
+    int num_sff = 0, num_eff = 0;
+    int pass_all_sff, pass_all_eff;
+    int num_filters = 0;
+
+    for (uint8_t i = 0; i < routes->num_rules; i++) {
+        if (routes->rules[i].action == CAN_ROUTE_DROP) {
+            continue;
+        }
+        if (routes->rules[i].id & CAN_EFF_FLAG) {
+            num_eff++;
+        } else {
+            num_sff++;
+        }
+    }
+
+    // Rules that do not fit are replaced by filters passing the whole format
+    pass_all_sff = routes->default_route.action != CAN_ROUTE_DROP;
+    pass_all_eff = pass_all_sff;
+    if (!pass_all_eff && num_sff + num_eff > max_filters) {
+        pass_all_eff = 1;
+        if (num_sff + 1 > max_filters) {
+            pass_all_sff = 1;
+        }
+    }
+
+    if (pass_all_sff) {
+        filters[num_filters].id = 0;
+        filters[num_filters].mask = 0;
+        num_filters++;
+    }
+    if (pass_all_eff) {
+        filters[num_filters].id = CAN_EFF_FLAG;
+        filters[num_filters].mask = 0;
+        num_filters++;
+    }
+    for (uint8_t i = 0; i < routes->num_rules; i++) {
+        const can_route_t* route = &routes->rules[i];
+        int eff = (route->id & CAN_EFF_FLAG) != 0;
+        if (route->action == CAN_ROUTE_DROP ||
+            (eff ? pass_all_eff : pass_all_sff)) {
+            continue;
+        }
+        filters[num_filters].id = route->id;
+        filters[num_filters].mask = route->mask;
+        num_filters++;
+    }
+
+    return num_filters;
+}
+
 #ifdef __linux__
 int setup_can_socket(const char* can_ifname,
                      Avtp_CanVariant_t can_variant) {
@@ -113,72 +446,885 @@ int setup_can_socket(const char* can_ifname,
 
     return can_socket;
 }
-#endif
 
-static int is_valid_acf_packet(uint8_t* acf_pdu)
-{
-    Avtp_AcfCommon_t *pdu = (Avtp_AcfCommon_t*) acf_pdu;
-    uint8_t acf_msg_type = Avtp_AcfCommon_GetAcfMsgType(pdu);
-    if (acf_msg_type != AVTP_ACF_TYPE_CAN) {
+int set_can_route_filters(int can_socket, const can_route_table_t* routes) {
+
+    can_route_filter_t route_filters[CAN_ROUTE_MAX_RULES];
+    struct can_filter filters[CAN_ROUTE_MAX_RULES];
+    int num_filters;
+
+    // All rules fit into CAN_RAW_FILTER_MAX filters
+    num_filters = can_route_filters(routes, route_filters, CAN_ROUTE_MAX_RULES);
+    for (int i = 0; i < num_filters; i++) {
+        filters[i].can_id = route_filters[i].id;
+        filters[i].can_mask = route_filters[i].mask | CAN_EFF_FLAG;
+    }
+
+    if (setsockopt(can_socket, SOL_CAN_RAW, CAN_RAW_FILTER, filters,
+                   num_filters * sizeof(struct can_filter)) < 0) {
+        perror("Failed to set CAN filters");
+        return -errno;
+    }
+
+    return 0;
+}
+
+static const char* const can_flush_reason_names[CAN_FLUSH_REASON_MAX] = {
+    [CAN_FLUSH_COUNT] = "count",
+    [CAN_FLUSH_MTU] = "mtu",
+    [CAN_FLUSH_DEADLINE] = "deadline",
+    [CAN_FLUSH_STREAM] = "stream",
+    [CAN_FLUSH_PRIORITY] = "priority",
+};
+
+uint16_t acf_can_msg_length(const frame_t* frame,
+                            Avtp_CanVariant_t can_variant, int use_brief) {
+
+    uint8_t payload_length;
+
+    if (can_variant == AVTP_CAN_FD) {
+        payload_length = frame->fd.len;
+    } else {
+        payload_length = frame->cc.len;
+    }
+
+    // ACF messages are padded to a multiple of quadlets
+    return (use_brief ? AVTP_CAN_BRIEF_HEADER_LEN : AVTP_CAN_HEADER_LEN) +
+           ((payload_length + AVTP_QUADLET_SIZE - 1) & ~(AVTP_QUADLET_SIZE - 1));
+}
+
+static uint64_t monotonic_ns(void) {
+
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * NSEC_PER_SEC + now.tv_nsec;
+}
+
+static int arm_deadline(can_aggregator_t* agg, uint32_t timeout_us) {
+
+    struct itimerspec its;
+
+    memset(&its, 0, sizeof(its));
+    its.it_value.tv_sec = timeout_us / USEC_PER_SEC;
+    its.it_value.tv_nsec = (timeout_us % USEC_PER_SEC) * NSEC_PER_USEC;
+
+    if (timerfd_settime(agg->timer_fd, 0, &its, NULL) < 0) {
+        perror("Failed to arm aggregation timer");
+        return -errno;
+    }
+
+    return 0;
+}
+
+int can_aggregator_init(can_aggregator_t* agg, int can_socket,
+                        Avtp_CanVariant_t can_variant, uint8_t max_frames,
+                        uint32_t deadline_us, int use_udp, int use_tscf) {
+
+    if (max_frames < 1 || max_frames > MAX_CAN_FRAMES_IN_ACF) {
+        return -EINVAL;
+    }
+
+    memset(agg, 0, sizeof(*agg));
+    agg->can_socket = can_socket;
+    if (can_socket >= 0) {
+        agg->can_sockets[0] = can_socket;
+        agg->num_buses = 1;
+    }
+    agg->epoll_fd = -1;
+    agg->can_variant = can_variant;
+    agg->max_frames = max_frames;
+    agg->deadline_us = deadline_us;
+    agg->max_payload = MAX_ETH_PDU_SIZE -
+            (use_tscf ? AVTP_TSCF_HEADER_LEN : AVTP_NTSCF_HEADER_LEN) -
+            (use_udp ? AVTP_UDP_HEADER_LEN : 0);
+    agg->timer_fd = -1;
+
+    if (deadline_us) {
+        agg->timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+        if (agg->timer_fd < 0) {
+            perror("Failed to create aggregation timer");
+            return -errno;
+        }
+    }
+
+    return 0;
+}
+
+/* Marks the deadline timer in the epoll set of an aggregator */
+#define EPOLL_TIMER_INDEX           CAN_AGGREGATOR_MAX_BUSES
+
+static int epoll_add(can_aggregator_t* agg, int fd, uint32_t index) {
+
+    struct epoll_event event;
+
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.u32 = index;
+    if (epoll_ctl(agg->epoll_fd, EPOLL_CTL_ADD, fd, &event) < 0) {
+        perror("Failed to add to epoll set");
+        return -errno;
+    }
+
+    return 0;
+}
+
+int can_aggregator_add_bus(can_aggregator_t* agg, int can_socket,
+                           uint8_t bus_id) {
+
+    int res;
+
+    if (agg->num_buses == CAN_AGGREGATOR_MAX_BUSES || agg->ring) {
+        return -EINVAL;
+    }
+
+    agg->can_sockets[agg->num_buses] = can_socket;
+    agg->bus_ids[agg->num_buses] = bus_id;
+    agg->num_buses++;
+    if (agg->num_buses == 1) {
+        agg->can_socket = can_socket;
+        return 0;
+    }
+
+    // The second bus switches from blocking reads and poll() to epoll
+    if (agg->epoll_fd < 0) {
+        agg->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+        if (agg->epoll_fd < 0) {
+            perror("Failed to create epoll set");
+            return -errno;
+        }
+        res = epoll_add(agg, agg->can_sockets[0], 0);
+        if (res < 0) {
+            return res;
+        }
+        if (agg->timer_fd >= 0) {
+            res = epoll_add(agg, agg->timer_fd, EPOLL_TIMER_INDEX);
+            if (res < 0) {
+                return res;
+            }
+        }
+    }
+
+    return epoll_add(agg, can_socket, agg->num_buses - 1);
+}
+int can_timestamp_parse_source(const char* str, can_timestamp_source_t* source) {
+
+    if (strcmp(str, "none") == 0) {
+        *source = CAN_TIMESTAMP_NONE;
+    } else if (strcmp(str, "software") == 0) {
+        *source = CAN_TIMESTAMP_SOFTWARE;
+    } else if (strcmp(str, "hardware") == 0) {
+        *source = CAN_TIMESTAMP_HARDWARE;
+    } else {
+        return -EINVAL;
+    }
+
+    return 0;
+}
+
+int set_can_timestamping(int can_socket, const char* can_ifname,
+                         can_timestamp_source_t source) {
+
+    struct hwtstamp_config hwts_config;
+    struct ifreq ifr;
+    int enable = 1;
+    int flags;
+    int res;
+
+    if (source == CAN_TIMESTAMP_NONE) {
+        return 0;
+    }
+
+    if (source == CAN_TIMESTAMP_SOFTWARE) {
+        res = setsockopt(can_socket, SOL_SOCKET, SO_TIMESTAMPNS,
+                         &enable, sizeof(enable));
+    } else {
+        // CAN drivers only accept stamping of all frames in both directions.
+        // Some stamp all frames anyway and refuse the request.
+        memset(&hwts_config, 0, sizeof(hwts_config));
+        hwts_config.tx_type = HWTSTAMP_TX_ON;
+        hwts_config.rx_filter = HWTSTAMP_FILTER_ALL;
+        memset(&ifr, 0, sizeof(ifr));
+        strncpy(ifr.ifr_name, can_ifname, IFNAMSIZ - 1);
+        ifr.ifr_data = (void*)&hwts_config;
+        if (ioctl(can_socket, SIOCSHWTSTAMP, &ifr) < 0) {
+            LOG_INF("Hardware timestamps of %s not enabled: %s\n",
+                    can_ifname, strerror(errno));
+        }
+
+        flags = SOF_TIMESTAMPING_RX_HARDWARE | SOF_TIMESTAMPING_RAW_HARDWARE;
+        res = setsockopt(can_socket, SOL_SOCKET, SO_TIMESTAMPING,
+                         &flags, sizeof(flags));
+    }
+    if (res < 0) {
+        perror("Failed to enable CAN RX timestamps");
+        return -errno;
+    }
+
+    return 0;
+}
+
+uint64_t can_rx_timestamp(struct msghdr* msg) {
+
+    struct scm_timestamping tss;
+    struct timespec ts;
+    struct cmsghdr* cmsg;
+
+    for (cmsg = CMSG_FIRSTHDR(msg); cmsg; cmsg = CMSG_NXTHDR(msg, cmsg)) {
+        if (cmsg->cmsg_level != SOL_SOCKET) {
+            continue;
+        }
+        if (cmsg->cmsg_type == SCM_TIMESTAMPNS) {
+            memcpy(&ts, CMSG_DATA(cmsg), sizeof(ts));
+        } else if (cmsg->cmsg_type == SCM_TIMESTAMPING) {
+            // The raw hardware timestamp is the third one
+            memcpy(&tss, CMSG_DATA(cmsg), sizeof(tss));
+            ts = tss.ts[2];
+        } else {
+            continue;
+        }
+        return (uint64_t)ts.tv_sec * NSEC_PER_SEC + ts.tv_nsec;
+    }
+
+    return 0;
+}
+
+/*
+ * Receives up to num_frames queued CAN frames with one recvmmsg() call, along
+ * with their RX timestamps if enabled on the socket. If wait is set, blocks
+ * until at least one frame is available. In busy poll mode it spins instead
+ * of blocking.
+ */
+static int recv_can_frames(int can_socket, Avtp_CanVariant_t can_variant,
+                           frame_t* frames, uint64_t* timestamps,
+                           int num_frames, int wait, int busy_poll,
+                           can_rx_stats_t* stats) {
+
+    struct mmsghdr msgs[CAN_AGGREGATOR_MAX_FRAMES];
+    struct iovec iovs[CAN_AGGREGATOR_MAX_FRAMES];
+    uint8_t controls[CAN_AGGREGATOR_MAX_FRAMES][CAN_TIMESTAMP_CMSG_SPACE];
+    size_t frame_size;
+    int flags;
+    int res;
+
+    if (can_variant == AVTP_CAN_FD) {
+        frame_size = sizeof(struct canfd_frame);
+    } else {
+        frame_size = sizeof(struct can_frame);
+    }
+
+    memset(msgs, 0, sizeof(msgs));
+    for (int i = 0; i < num_frames; i++) {
+        iovs[i].iov_base = &frames[i];
+        iovs[i].iov_len = frame_size;
+        msgs[i].msg_hdr.msg_iov = &iovs[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+        msgs[i].msg_hdr.msg_control = controls[i];
+        msgs[i].msg_hdr.msg_controllen = CAN_TIMESTAMP_CMSG_SPACE;
+    }
+
+    if (wait && !busy_poll) {
+        flags = MSG_WAITFORONE;
+    } else {
+        flags = MSG_DONTWAIT;
+    }
+
+    for (;;) {
+        res = recvmmsg(can_socket, msgs, num_frames, flags, NULL);
+        if (res < 0 && errno == EINTR) {
+            continue;
+        }
+        // Busy polling spins until a frame arrives
+        if (res < 0 && wait && busy_poll &&
+            (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            continue;
+        }
+        break;
+    }
+
+    if (res < 0) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            return 0;
+        }
+        perror("Error reading CAN frames");
+        return -errno;
+    }
+
+    for (int i = 0; i < res; i++) {
+        timestamps[i] = can_rx_timestamp(&msgs[i].msg_hdr);
+    }
+
+    stats->syscalls++;
+    stats->frames += res;
+
+    return res;
+}
+
+/*
+ * Receives the queued CAN frames of all buses that are ready into the free
+ * slots of the aggregator. If wait is set, blocks until at least one bus or
+ * the deadline timer is ready. An expired deadline is flagged in the
+ * aggregator.
+ */
+static int receive_frames_multi_bus(can_aggregator_t* agg, int wait) {
+
+    struct epoll_event events[CAN_AGGREGATOR_MAX_BUSES + 1];
+    int num_free = CAN_AGGREGATOR_MAX_FRAMES - agg->num_pending;
+    int timeout = (wait && !agg->busy_poll) ? -1 : 0;
+    int num_received = 0;
+    int num_events;
+    uint64_t expirations;
+    int res;
+
+    do {
+        num_events = epoll_wait(agg->epoll_fd, events, agg->num_buses + 1,
+                                timeout);
+        if (num_events < 0) {
+            if (errno != EINTR) {
+                perror("Failed to wait for CAN sockets");
+                return -errno;
+            }
+            num_events = 0;
+        }
+        agg->stats.syscalls++;
+    } while (wait && num_events == 0);
+
+    for (int i = 0; i < num_events; i++) {
+        uint32_t index = events[i].data.u32;
+        uint8_t* bus_ids;
+
+        if (index == EPOLL_TIMER_INDEX) {
+            if (read(agg->timer_fd, &expirations, sizeof(expirations)) > 0 &&
+                agg->num_pending) {
+                agg->deadline_expired = 1;
+            }
+            continue;
+        }
+
+        // Buses not served now stay ready for the next call
+        if (num_received == num_free) {
+            continue;
+        }
+        res = recv_can_frames(agg->can_sockets[index], agg->can_variant,
+                              &agg->frames[agg->num_pending + num_received],
+                              &agg->frame_timestamps[agg->num_pending +
+                                                     num_received],
+                              num_free - num_received, 0, 0, &agg->stats);
+        if (res < 0) {
+            return res;
+        }
+        bus_ids = &agg->frame_bus_ids[agg->num_pending + num_received];
+        memset(bus_ids, agg->bus_ids[index], res);
+        num_received += res;
+    }
+
+    return num_received;
+}
+
+/*
+ * Looks up the routes of the frames received last, drops the frames the
+ * routing table drops and tags the others with their talker stream.
+ * Returns the number of frames kept.
+ */
+static int route_frames(can_aggregator_t* agg, int num_received) {
+
+    frame_t* frames = &agg->frames[agg->num_pending];
+    uint8_t* bus_ids = &agg->frame_bus_ids[agg->num_pending];
+    uint64_t* timestamps = &agg->frame_timestamps[agg->num_pending];
+    uint64_t* arrivals = &agg->frame_arrivals[agg->num_pending];
+    uint8_t* streams = &agg->frame_streams[agg->num_pending];
+    uint8_t* priority = &agg->frame_priority[agg->num_pending];
+    int num_kept = 0;
+
+    for (int i = 0; i < num_received; i++) {
+        const can_route_t* route = can_route_lookup(agg->routes, &frames[i]);
+        if (route->action == CAN_ROUTE_DROP) {
+            agg->stats.dropped++;
+            continue;
+        }
+        if (num_kept != i) {
+            frames[num_kept] = frames[i];
+            bus_ids[num_kept] = bus_ids[i];
+            timestamps[num_kept] = timestamps[i];
+            arrivals[num_kept] = arrivals[i];
+        }
+        streams[num_kept] = route->stream;
+        priority[num_kept] = route->action == CAN_ROUTE_PRIORITY;
+        num_kept++;
+    }
+
+    return num_kept;
+}
+
+/*
+ * Receives all queued CAN frames into the free slots of the aggregator, from
+ * the CAN socket or the ring. If wait is set, blocks until at least one frame
+ * is available.
+ */
+static int receive_frames(can_aggregator_t* agg, int wait) {
+
+    int num_free = CAN_AGGREGATOR_MAX_FRAMES - agg->num_pending;
+    can_ring_frame_t ring_frames[CAN_AGGREGATOR_MAX_FRAMES];
+    struct timespec no_wait = { 0, 0 };
+    int res;
+
+    if (agg->epoll_fd >= 0) {
+        res = receive_frames_multi_bus(agg, wait);
+    } else if (!agg->ring) {
+        res = recv_can_frames(agg->can_socket, agg->can_variant,
+                              &agg->frames[agg->num_pending],
+                              &agg->frame_timestamps[agg->num_pending],
+                              num_free, wait, agg->busy_poll, &agg->stats);
+    } else {
+        for (;;) {
+            res = spsc_ring_pop(agg->ring, ring_frames, num_free);
+            if (res > 0 || !wait) {
+                break;
+            }
+            spsc_ring_wait(agg->ring, agg->busy_poll ? &no_wait : NULL);
+        }
+        for (int i = 0; i < res; i++) {
+            agg->frames[agg->num_pending + i] = ring_frames[i].frame;
+            agg->frame_timestamps[agg->num_pending + i] =
+                    ring_frames[i].timestamp;
+            agg->frame_arrivals[agg->num_pending + i] = ring_frames[i].arrival;
+        }
+        agg->stats.frames += res;
+    }
+
+    // Frames read from the sockets arrived when the receive call returned
+    if (res > 0 && !agg->ring) {
+        uint64_t now_ns = monotonic_ns();
+        for (int i = 0; i < res; i++) {
+            agg->frame_arrivals[agg->num_pending + i] = now_ns;
+        }
+    }
+
+    if (res > 0 && agg->epoll_fd < 0) {
+        memset(&agg->frame_bus_ids[agg->num_pending], agg->bus_ids[0], res);
+    }
+    if (res > 0 && agg->routes) {
+        res = route_frames(agg, res);
+    }
+
+    return res;
+}
+
+/*
+ * Waits until the ring has frames or the deadline expired.
+ * Returns 1 if frames are available, 0 if the deadline expired.
+ */
+static int wait_ring_deadline(can_aggregator_t* agg) {
+
+    struct itimerspec its;
+
+    if (timerfd_gettime(agg->timer_fd, &its) < 0) {
+        perror("Failed to read aggregation timer");
+        return -errno;
+    }
+    if (its.it_value.tv_sec == 0 && its.it_value.tv_nsec == 0) {
         return 0;
     }
+    if (agg->busy_poll) {
+        its.it_value.tv_sec = 0;
+        its.it_value.tv_nsec = 0;
+    }
+    spsc_ring_wait(agg->ring, &its.it_value);
 
     return 1;
 }
 
-static int init_cf_pdu(uint8_t* pdu, uint64_t stream_id, int use_tscf, int seq_num)
-{
+/* Hands out the first num_frames pending frames and keeps the rest queued. */
+static int flush_frames(can_aggregator_t* agg, frame_t* can_frames,
+                        uint8_t* bus_ids, uint64_t* timestamps, int num_frames,
+                        can_flush_reason_t reason) {
+
+    int num_left = agg->num_pending - num_frames;
+
+    memcpy(can_frames, agg->frames, num_frames * sizeof(frame_t));
+    memmove(agg->frames, &agg->frames[num_frames], num_left * sizeof(frame_t));
+    if (bus_ids) {
+        memcpy(bus_ids, agg->frame_bus_ids, num_frames);
+    }
+    memmove(agg->frame_bus_ids, &agg->frame_bus_ids[num_frames], num_left);
+    if (timestamps) {
+        memcpy(timestamps, agg->frame_timestamps,
+               num_frames * sizeof(uint64_t));
+    }
+    memmove(agg->frame_timestamps, &agg->frame_timestamps[num_frames],
+            num_left * sizeof(uint64_t));
+    memmove(agg->frame_arrivals, &agg->frame_arrivals[num_frames],
+            num_left * sizeof(uint64_t));
+    agg->stream = agg->frame_streams[0];
+    agg->arrival = agg->frame_arrivals[0];
+    memmove(agg->frame_streams, &agg->frame_streams[num_frames], num_left);
+    memmove(agg->frame_priority, &agg->frame_priority[num_frames], num_left);
+    agg->deadline_expired = 0;
+    agg->num_pending = num_left;
+    agg->num_accounted = 0;
+    agg->pending_length = 0;
+    agg->flush_reason = reason;
+    agg->stats.flushes[reason]++;
+
+    // Frames that are carried over keep the deadline of the oldest one
+    if (agg->deadline_us && num_left) {
+        uint64_t waited_us = (monotonic_ns() - agg->frame_arrivals[0]) /
+                             NSEC_PER_USEC;
+        if (waited_us >= agg->deadline_us) {
+            agg->deadline_expired = 1;
+            arm_deadline(agg, 0);
+        } else {
+            arm_deadline(agg, agg->deadline_us - waited_us);
+        }
+    } else if (agg->deadline_us) {
+        arm_deadline(agg, 0);
+    }
+
+    return num_frames;
+}
+
+int can_aggregator_collect(can_aggregator_t* agg, frame_t* can_frames,
+                           uint8_t* bus_ids, uint64_t* timestamps) {
+
+    struct pollfd fds[2];
+    uint64_t expirations;
+    int res;
+
+    for (;;) {
+        // Account the frames received last and check if they still fit
+        while (agg->num_accounted < agg->num_pending &&
+               agg->num_accounted < agg->max_frames) {
+            uint8_t index = agg->num_accounted;
+            uint16_t length = acf_can_msg_length(&agg->frames[index],
+                                                 agg->can_variant, agg->brief);
+            // A PDU only carries the frames of one talker stream
+            if (agg->frame_streams[index] != agg->frame_streams[0]) {
+                return flush_frames(agg, can_frames, bus_ids, timestamps,
+                                    index, CAN_FLUSH_STREAM);
+            }
+            if (agg->pending_length + length > agg->max_payload) {
+                return flush_frames(agg, can_frames, bus_ids, timestamps,
+                                    index, CAN_FLUSH_MTU);
+            }
+            agg->pending_length += length;
+            agg->num_accounted++;
+            if (agg->frame_priority[index]) {
+                return flush_frames(agg, can_frames, bus_ids, timestamps,
+                                    index + 1, CAN_FLUSH_PRIORITY);
+            }
+        }
+        if (agg->num_accounted == agg->max_frames) {
+            return flush_frames(agg, can_frames, bus_ids, timestamps,
+                                agg->max_frames, CAN_FLUSH_COUNT);
+        }
+        if (agg->deadline_expired) {
+            return flush_frames(agg, can_frames, bus_ids, timestamps,
+                                agg->num_pending, CAN_FLUSH_DEADLINE);
+        }
+
+        // Without a deadline or pending frames there is nothing to time out
+        if (!agg->deadline_us || !agg->num_pending) {
+            int was_empty = !agg->num_pending;
+            res = receive_frames(agg, 1);
+            if (res < 0) {
+                return res;
+            }
+            agg->num_pending += res;
+            if (was_empty && agg->num_pending && agg->deadline_us) {
+                arm_deadline(agg, agg->deadline_us);
+            }
+            continue;
+        }
+
+        // With several buses the timer is part of the epoll set
+        if (agg->epoll_fd >= 0) {
+            res = receive_frames(agg, 1);
+            if (res < 0) {
+                return res;
+            }
+            agg->num_pending += res;
+            continue;
+        }
+
+        // A ring has no file descriptor, so it is waited on for the time
+        // left until the deadline
+        if (agg->ring) {
+            res = wait_ring_deadline(agg);
+            if (res < 0) {
+                return res;
+            }
+            if (res == 0) {
+                return flush_frames(agg, can_frames, bus_ids, timestamps,
+                                    agg->num_pending, CAN_FLUSH_DEADLINE);
+            }
+            agg->num_pending += receive_frames(agg, 0);
+            continue;
+        }
+
+        fds[0].fd = agg->can_socket;
+        fds[0].events = POLLIN;
+        fds[1].fd = agg->timer_fd;
+        fds[1].events = POLLIN;
+        res = poll(fds, 2, agg->busy_poll ? 0 : -1);
+        if (res < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            perror("Failed to poll CAN socket");
+            return -errno;
+        }
+        if (res == 0) {
+            continue;
+        }
+
+        if (fds[0].revents & POLLIN) {
+            res = receive_frames(agg, 0);
+            if (res < 0) {
+                return res;
+            }
+            agg->num_pending += res;
+            continue;
+        }
+
+        if (fds[1].revents & POLLIN) {
+            if (read(agg->timer_fd, &expirations, sizeof(expirations)) < 0) {
+                perror("Failed to read aggregation timer");
+            }
+            return flush_frames(agg, can_frames, bus_ids, timestamps,
+                                agg->num_pending, CAN_FLUSH_DEADLINE);
+        }
+    }
+}
+
+int can_drain_frames(int can_socket, Avtp_CanVariant_t can_variant,
+                     spsc_ring_t* ring, int busy_poll, can_rx_stats_t* stats) {
+
+    frame_t frames[CAN_AGGREGATOR_MAX_FRAMES];
+    uint64_t timestamps[CAN_AGGREGATOR_MAX_FRAMES];
+    can_ring_frame_t ring_frames[CAN_AGGREGATOR_MAX_FRAMES];
+    uint64_t now_ns;
     int res;
+
+    res = recv_can_frames(can_socket, can_variant, frames, timestamps,
+                          CAN_AGGREGATOR_MAX_FRAMES, 1, busy_poll, stats);
+    now_ns = monotonic_ns();
+    for (int i = 0; i < res; i++) {
+        ring_frames[i].frame = frames[i];
+        ring_frames[i].timestamp = timestamps[i];
+        ring_frames[i].arrival = now_ns;
+    }
+    if (res > 0) {
+        spsc_ring_push(ring, ring_frames, res);
+    }
+
+    return res;
+}
+
+int can_aggregator_ready(const can_aggregator_t* agg) {
+
+    uint16_t length = 0;
+
+    if (agg->num_pending >= agg->max_frames) {
+        return 1;
+    }
+    for (int i = 0; i < agg->num_pending; i++) {
+        length += acf_can_msg_length(&agg->frames[i], agg->can_variant,
+                                     agg->brief);
+        if (length > agg->max_payload || agg->frame_priority[i] ||
+            agg->frame_streams[i] != agg->frame_streams[0]) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+void print_can_rx_stats(can_rx_stats_t* stats, uint32_t interval_s) {
+
+    struct timespec now;
+    uint64_t now_ns;
+    uint64_t num_flushes = 0;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    now_ns = now.tv_sec * NSEC_PER_SEC + now.tv_nsec;
+    if (stats->last_print_ns == 0) {
+        stats->last_print_ns = now_ns;
+        return;
+    }
+    if (now_ns - stats->last_print_ns < interval_s * NSEC_PER_SEC) {
+        return;
+    }
+    stats->last_print_ns = now_ns;
+
+    // An aggregator reading from a ring does not do the syscalls itself and
+    // can_drain_frames() does not flush, so skip what was not counted
+    if (stats->syscalls) {
+        LOG_INF("CAN RX: %" PRIu64 " frames in %" PRIu64 " syscalls "
+                "(%.2f frames/syscall)\n", stats->frames, stats->syscalls,
+                (double)stats->frames / stats->syscalls);
+    }
+    for (int i = 0; i < CAN_FLUSH_REASON_MAX; i++) {
+        num_flushes += stats->flushes[i];
+    }
+    if (num_flushes) {
+        LOG_INF("CAN RX flushes:");
+        for (int i = 0; i < CAN_FLUSH_REASON_MAX; i++) {
+            fprintf(stderr, " %s %" PRIu64, can_flush_reason_names[i],
+                    stats->flushes[i]);
+        }
+        fprintf(stderr, "\n");
+    }
+    if (stats->dropped) {
+        LOG_INF("CAN RX: %" PRIu64 " frames dropped by routes\n",
+                stats->dropped);
+    }
+}
+
+void print_stream_seq_stats(const Avtp_StreamTable_t* streams,
+                            seq_stats_timer_t* timer, uint32_t interval_s) {
+
+    char name[32];
+
+    if (!seq_stats_due(timer, interval_s)) {
+        return;
+    }
+    for (uint32_t i = 0; i <= streams->mask; i++) {
+        const Avtp_StreamEntry_t* entry = &streams->entries[i];
+        if (!streams->tags[i] || !entry->seq.stats.received) {
+            continue;
+        }
+        snprintf(name, sizeof(name), "Stream 0x%" PRIx64, entry->streamId);
+        seq_stats_print(name, &entry->seq.stats);
+        if (entry->udpSeq.stats.received) {
+            snprintf(name, sizeof(name), "UDP 0x%" PRIx64, entry->streamId);
+            seq_stats_print(name, &entry->udpSeq.stats);
+        }
+    }
+}
+#endif
+
+static int init_cf_template(Avtp_StreamTemplate_t* template, uint64_t stream_id,
+                            int use_tscf)
+{
+    uint8_t pdu[AVTP_TSCF_HEADER_LEN];
+
     if (use_tscf) {
         Avtp_Tscf_t* tscf_pdu = (Avtp_Tscf_t*) pdu;
+        Avtp_TscfHeader_t header = {
+            .subtype = AVTP_SUBTYPE_TSCF,
+            .sv = 1,
+            .tu = 0,
+            .stream_id = stream_id,
+        };
         memset(tscf_pdu, 0, AVTP_TSCF_HEADER_LEN);
-        Avtp_Tscf_Init(tscf_pdu);
-        Avtp_Tscf_SetField(tscf_pdu, AVTP_TSCF_FIELD_TU, 0U);
-        Avtp_Tscf_SetField(tscf_pdu, AVTP_TSCF_FIELD_SEQUENCE_NUM, seq_num);
-        Avtp_Tscf_SetField(tscf_pdu, AVTP_TSCF_FIELD_STREAM_ID, stream_id);
-        res = AVTP_TSCF_HEADER_LEN;
+        Avtp_Tscf_SetHeader(tscf_pdu, &header);
+        return Avtp_Tscf_InitTemplate(template, tscf_pdu);
     } else {
         Avtp_Ntscf_t* ntscf_pdu = (Avtp_Ntscf_t*) pdu;
+        Avtp_NtscfHeader_t header = {
+            .subtype = AVTP_SUBTYPE_NTSCF,
+            .sv = 1,
+            .stream_id = stream_id,
+        };
         memset(ntscf_pdu, 0, AVTP_NTSCF_HEADER_LEN);
-        Avtp_Ntscf_Init(ntscf_pdu);
-        Avtp_Ntscf_SetField(ntscf_pdu, AVTP_NTSCF_FIELD_SEQUENCE_NUM, seq_num);
-        Avtp_Ntscf_SetField(ntscf_pdu, AVTP_NTSCF_FIELD_STREAM_ID, stream_id);
-        res = AVTP_NTSCF_HEADER_LEN;
+        Avtp_Ntscf_SetHeader(ntscf_pdu, &header);
+        return Avtp_Ntscf_InitTemplate(template, ntscf_pdu);
     }
-    return res;
 }
 
-static int update_cf_length(uint8_t* cf_pdu, uint64_t length, int use_tscf)
-{
-    if (use_tscf) {
-        uint64_t payloadLen = length - AVTP_TSCF_HEADER_LEN;
-        Avtp_Tscf_SetField((Avtp_Tscf_t*)cf_pdu, AVTP_TSCF_FIELD_STREAM_DATA_LENGTH, payloadLen);
-    } else {
-        uint64_t payloadLen = length - AVTP_NTSCF_HEADER_LEN;
-        Avtp_Ntscf_SetField((Avtp_Ntscf_t*)cf_pdu, AVTP_NTSCF_FIELD_NTSCF_DATA_LENGTH, payloadLen);
+int can_talker_streams_init(can_talker_streams_t* streams,
+                            const uint64_t* stream_ids, uint8_t num_streams,
+                            int use_tscf) {
+
+    int res;
+
+    if (num_streams > CAN_ROUTE_MAX_STREAMS) {
+        return -EINVAL;
     }
+
+    streams->num_streams = 0;
+    for (uint8_t i = 0; i < num_streams; i++) {
+        res = init_cf_template(&streams->templates[i], stream_ids[i], use_tscf);
+        if (res < 0) {
+            return res;
+        }
+        streams->stream_ids[i] = stream_ids[i];
+    }
+    streams->num_streams = num_streams;
+    streams->use_tscf = use_tscf;
+
     return 0;
 }
 
+static uint64_t realtime_ns(void) {
+
+    struct timespec now;
+
+    clock_gettime(CLOCK_REALTIME, &now);
+    return (uint64_t)now.tv_sec * NSEC_PER_SEC + now.tv_nsec;
+}
+
+static int prepare_acf_brief_packet(uint8_t* acf_pdu,
+                                    frame_t* frame,
+                                    Avtp_CanVariant_t can_variant,
+                                    uint8_t can_bus_id) {
+
+    canid_t can_id;
+    uint8_t can_payload_length;
+    uint8_t* can_payload;
+    Avtp_CanBriefHeader_t header;
+
+    Avtp_CanBrief_t* pdu = (Avtp_CanBrief_t*) acf_pdu;
+
+#ifdef __linux__
+    can_id = (can_variant == AVTP_CAN_FD) ? (*frame).fd.can_id : (*frame).cc.can_id;
+    can_payload_length = (can_variant == AVTP_CAN_FD) ? (*frame).fd.len : (*frame).cc.len;
+#elif defined(__ZEPHYR__)
+    can_id = (can_variant == AVTP_CAN_FD) ? (*frame).fd.id : (*frame).cc.id;
+    can_payload_length = (can_variant == AVTP_CAN_FD) ? (*frame).fd.dlc : (*frame).cc.dlc;
+#endif
+    can_payload = (can_variant == AVTP_CAN_FD) ? frame->fd.data : frame->cc.data;
+
+    // Same as prepare_acf_packet(), but without the message timestamp
+    memset(&header, 0, sizeof(header));
+    header.acf_msg_type = AVTP_ACF_TYPE_CAN_BRIEF;
+    header.pad = (AVTP_QUADLET_SIZE - (can_payload_length % AVTP_QUADLET_SIZE))
+                    % AVTP_QUADLET_SIZE;
+    header.acf_msg_length = (AVTP_CAN_BRIEF_HEADER_LEN + can_payload_length + header.pad)
+                                / AVTP_QUADLET_SIZE;
+    header.can_identifier = can_id & CAN_EFF_MASK;
+    header.eff = (can_id & CAN_EFF_FLAG) || header.can_identifier > 0x7FF;
+    header.rtr = (can_id & CAN_RTR_FLAG) ? 1 : 0;
+    header.can_bus_id = can_bus_id;
+
+    if (can_variant == AVTP_CAN_FD) {
+        header.brs = (frame->fd.flags & CANFD_BRS) ? 1 : 0;
+        header.fdf = 1;
+        header.esi = (frame->fd.flags & CANFD_ESI) ? 1 : 0;
+    }
+
+    memset(pdu, 0, AVTP_CAN_BRIEF_HEADER_LEN);
+    Avtp_CanBrief_SetHeader(pdu, &header);
+
+    memcpy(pdu->payload, can_payload, can_payload_length);
+    memset(pdu->payload + can_payload_length, 0, header.pad);
+
+    return header.acf_msg_length * AVTP_QUADLET_SIZE;
+}
+
 static int prepare_acf_packet(uint8_t* acf_pdu,
                               frame_t* frame,
-                              Avtp_CanVariant_t can_variant) {
+                              Avtp_CanVariant_t can_variant,
+                              uint8_t can_bus_id,
+                              uint64_t timestamp) {
 
-    struct timespec now;
     canid_t can_id;
     uint8_t can_payload_length;
+    uint8_t* can_payload;
+    Avtp_CanHeader_t header;
 
-    // Clear bits
     Avtp_Can_t* pdu = (Avtp_Can_t*) acf_pdu;
-    memset(pdu, 0, AVTP_CAN_HEADER_LEN);
-
-    // Prepare ACF PDU for CAN
-    Avtp_Can_Init(pdu);
-    clock_gettime(CLOCK_REALTIME, &now);
-    Avtp_Can_SetMessageTimestamp(pdu, (uint64_t)now.tv_nsec + (uint64_t)(now.tv_sec * 1e9));
-    Avtp_Can_EnableMtv(pdu);
 
-    // Set required CAN Flags
 #ifdef __linux__
     can_id = (can_variant == AVTP_CAN_FD) ? (*frame).fd.can_id : (*frame).cc.can_id;
     can_payload_length = (can_variant == AVTP_CAN_FD) ? (*frame).fd.len : (*frame).cc.len;
@@ -186,43 +1332,73 @@ static int prepare_acf_packet(uint8_t* acf_pdu,
     can_id = (can_variant == AVTP_CAN_FD) ? (*frame).fd.id : (*frame).cc.id;
     can_payload_length = (can_variant == AVTP_CAN_FD) ? (*frame).fd.dlc : (*frame).cc.dlc;
 #endif
-    if (can_id & CAN_EFF_FLAG) {
-        Avtp_Can_EnableEff(pdu);
-    }
-    if (can_id & CAN_RTR_FLAG) {
-        Avtp_Can_EnableRtr(pdu);
-    }
+    can_payload = (can_variant == AVTP_CAN_FD) ? frame->fd.data : frame->cc.data;
+
+    // Collect all ACF CAN header fields and write them in one pass
+    memset(&header, 0, sizeof(header));
+    header.acf_msg_type = AVTP_ACF_TYPE_CAN;
+    header.pad = (AVTP_QUADLET_SIZE - (can_payload_length % AVTP_QUADLET_SIZE))
+                    % AVTP_QUADLET_SIZE;
+    header.acf_msg_length = (AVTP_CAN_HEADER_LEN + can_payload_length + header.pad)
+                                / AVTP_QUADLET_SIZE;
+    header.message_timestamp = timestamp;
+    header.mtv = 1;
+    header.can_identifier = can_id & CAN_EFF_MASK;
+    header.eff = (can_id & CAN_EFF_FLAG) || header.can_identifier > 0x7FF;
+    header.rtr = (can_id & CAN_RTR_FLAG) ? 1 : 0;
+    header.can_bus_id = can_bus_id;
 
     if (can_variant == AVTP_CAN_FD) {
-        if (frame->fd.flags & CANFD_BRS) {
-            Avtp_Can_EnableBrs(pdu);
-        }
-        if (frame->fd.flags & CANFD_FDF) {
-            Avtp_Can_EnableFdf(pdu);
-        }
-        if (frame->fd.flags & CANFD_ESI) {
-            Avtp_Can_EnableEsi(pdu);
-        }
+        header.brs = (frame->fd.flags & CANFD_BRS) ? 1 : 0;
+        header.fdf = 1;
+        header.esi = (frame->fd.flags & CANFD_ESI) ? 1 : 0;
     }
 
-    // Copy payload to ACF CAN PDU
-    if(can_variant == AVTP_CAN_FD)
-        Avtp_Can_CreateAcfMessage(pdu, can_id & CAN_EFF_MASK, frame->fd.data,
-                                         can_payload_length, can_variant);
-    else
-        Avtp_Can_CreateAcfMessage(pdu, can_id & CAN_EFF_MASK, frame->cc.data,
-                                         can_payload_length, can_variant);
+    memset(pdu, 0, AVTP_CAN_HEADER_LEN);
+    Avtp_Can_SetHeader(pdu, &header);
+
+    // Copy payload to ACF CAN PDU and zero the padding bytes
+    memcpy(pdu->payload, can_payload, can_payload_length);
+    memset(pdu->payload + can_payload_length, 0, header.pad);
 
-    return Avtp_Can_GetAcfMsgLength(pdu)*4;
+    return header.acf_msg_length * AVTP_QUADLET_SIZE;
 }
 
 int can_to_avtp(frame_t* can_frames, Avtp_CanVariant_t can_variant, uint8_t* pdu,
-                     int use_udp, int use_tscf, uint64_t stream_id,
+                     int use_udp, int use_tscf, int use_brief,
+                     can_talker_streams_t* streams, uint64_t stream_id,
                      uint8_t num_acf_msgs, uint8_t cf_seq_num, uint32_t udp_seq_num) {
 
+    int res;
+
+    // A single stream, which is only rendered again when it changes
+    if (streams->num_streams != 1 || streams->use_tscf != use_tscf ||
+        streams->stream_ids[0] != stream_id) {
+        res = can_talker_streams_init(streams, &stream_id, 1, use_tscf);
+        if (res < 0) {
+            return res;
+        }
+    }
+
+    return can_to_avtp_multi_bus(can_frames, NULL, NULL, can_variant, pdu,
+                                 use_udp, use_brief, streams, 0,
+                                 num_acf_msgs, cf_seq_num, udp_seq_num);
+}
+
+int can_to_avtp_multi_bus(frame_t* can_frames, const uint8_t* bus_ids,
+                          const uint64_t* timestamps,
+                          Avtp_CanVariant_t can_variant, uint8_t* pdu,
+                          int use_udp, int use_brief,
+                          const can_talker_streams_t* streams, uint8_t stream,
+                          uint8_t num_acf_msgs, uint8_t cf_seq_num,
+                          uint32_t udp_seq_num) {
+
     // Pack into control formats
+    const Avtp_StreamTemplate_t* cf_template;
     uint8_t *cf_pdu;
     uint16_t pdu_length = 0, cf_length = 0;
+    uint64_t now_ns = 0;
+    uint64_t timestamp;
     int res;
 
     // Usage of UDP means the PDU needs an encapsulation
@@ -233,61 +1409,100 @@ int can_to_avtp(frame_t* can_frames, Avtp_CanVariant_t can_variant, uint8_t* pdu
         pdu_length +=  sizeof(Avtp_Udp_t);
     }
 
-    // Prepare the control format: TSCF/NTSCF
+    // Prepare the control format: TSCF/NTSCF. The constant header fields
+    // were rendered by can_talker_streams_init().
+    if (stream >= streams->num_streams) {
+        return -EINVAL;
+    }
+    cf_template = &streams->templates[stream];
     cf_pdu = pdu + pdu_length;
-    res = init_cf_pdu(cf_pdu, stream_id, use_tscf, cf_seq_num++);
-    pdu_length += res;
-    cf_length += res;
+    pdu_length += cf_template->len;
+    cf_length += cf_template->len;
 
     int i = 0;
     while (i < num_acf_msgs) {
         uint8_t* acf_pdu = pdu + pdu_length;
-        res = prepare_acf_packet(acf_pdu, &(can_frames[i]), can_variant);
+        if (use_brief) {
+            res = prepare_acf_brief_packet(acf_pdu, &(can_frames[i]),
+                                           can_variant, bus_ids ? bus_ids[i] : 0);
+            pdu_length += res;
+            cf_length += res;
+            i++;
+            continue;
+        }
+        // Frames without RX timestamp share one clock read per PDU
+        timestamp = timestamps ? timestamps[i] : 0;
+        if (timestamp == 0) {
+            if (now_ns == 0) {
+                now_ns = realtime_ns();
+            }
+            timestamp = now_ns;
+        }
+        res = prepare_acf_packet(acf_pdu, &(can_frames[i]), can_variant,
+                                 bus_ids ? bus_ids[i] : 0, timestamp);
         pdu_length += res;
         cf_length += res;
         i++;
     }
 
-    // Update the length of the PDU
-    update_cf_length(cf_pdu, cf_length, use_tscf);
+    // Copy the control format header and patch sequence number and length
+    Avtp_StreamTemplate_Render(cf_template, cf_pdu, cf_seq_num, 0,
+                               cf_length - cf_template->len);
 
     return pdu_length;
 
 }
 
-int avtp_to_can(uint8_t* pdu, frame_t* can_frames, Avtp_CanVariant_t can_variant,
-                int use_udp, uint64_t stream_id, uint8_t* exp_cf_seqnum,
-                uint32_t* exp_udp_seqnum) {
+/*
+ * Decodes the CAN frames of an NTSCF or TSCF PDU of the given stream or, if
+ * streams is set, of any stream in the table. Streams in the table keep
+ * their own sequence trackers, which are updated here. The headers and the
+ * stream data must lie within the pdu_len received bytes.
+ */
+static int decode_cf_pdu(uint8_t* pdu, uint16_t pdu_len, frame_t* can_frames,
+                         uint8_t* bus_ids,
+                         Avtp_CanVariant_t can_variant, int use_udp,
+                         uint64_t stream_id, const Avtp_StreamTable_t* streams,
+                         Avtp_StreamEntry_t** entry, Avtp_SeqTracker_t* cf_seq,
+                         Avtp_SeqTracker_t* udp_seq) {
 
     uint8_t *cf_pdu, *acf_pdu, *udp_pdu, seq_num, i = 0;
-    uint32_t udp_seq_num;
+    uint32_t udp_seq_num = 0;
     uint16_t proc_bytes = 0, msg_length = 0;
     uint64_t s_id;
+    Avtp_StreamEntry_t* stream = NULL;
 
     // Check for UDP encapsulation
     if (use_udp) {
+        if (pdu_len < AVTP_UDP_HEADER_LEN) {
+            return -1;
+        }
         udp_pdu = pdu;
         udp_seq_num = Avtp_Udp_GetEncapsulationSeqNo((Avtp_Udp_t *)udp_pdu);
         cf_pdu = pdu + AVTP_UDP_HEADER_LEN;
         proc_bytes += AVTP_UDP_HEADER_LEN;
         msg_length += AVTP_UDP_HEADER_LEN;
-        if (udp_seq_num != *exp_udp_seqnum) {
-            LOG_ERR("Incorrect UDP sequence num. Expected: %d Recd.: %d\n",
-                                                *exp_udp_seqnum, udp_seq_num);
-            *exp_udp_seqnum = udp_seq_num;
-        }
     } else {
         cf_pdu = pdu;
     }
 
     // Only NTSCF and TSCF formats allowed
+    if (pdu_len - proc_bytes < AVTP_COMMON_HEADER_LEN) {
+        return -1;
+    }
     uint8_t subtype = Avtp_CommonHeader_GetSubtype((Avtp_CommonHeader_t*)cf_pdu);
     if (subtype == AVTP_SUBTYPE_TSCF) {
+        if (pdu_len - proc_bytes < AVTP_TSCF_HEADER_LEN) {
+            return -1;
+        }
         proc_bytes += AVTP_TSCF_HEADER_LEN;
         msg_length += Avtp_Tscf_GetStreamDataLength((Avtp_Tscf_t*)cf_pdu) + AVTP_TSCF_HEADER_LEN;
         s_id = Avtp_Tscf_GetStreamId((Avtp_Tscf_t*)cf_pdu);
         seq_num = Avtp_Tscf_GetSequenceNum((Avtp_Tscf_t*)cf_pdu);
     } else if (subtype == AVTP_SUBTYPE_NTSCF) {
+        if (pdu_len - proc_bytes < AVTP_NTSCF_HEADER_LEN) {
+            return -1;
+        }
         proc_bytes += AVTP_NTSCF_HEADER_LEN;
         msg_length += Avtp_Ntscf_GetNtscfDataLength((Avtp_Ntscf_t*)cf_pdu) + AVTP_NTSCF_HEADER_LEN;
         s_id = Avtp_Ntscf_GetStreamId((Avtp_Ntscf_t*)cf_pdu);
@@ -296,35 +1511,95 @@ int avtp_to_can(uint8_t* pdu, frame_t* can_frames, Avtp_CanVariant_t can_variant
         return -1;
     }
 
+    // A truncated frame would decode stale buffer bytes as CAN payload
+    if (msg_length > pdu_len) {
+        return -1;
+    }
+
     // Check for stream id
-    if (s_id != stream_id) {
+    if (streams) {
+        stream = Avtp_StreamTable_Find(streams, s_id);
+        if (stream == NULL) {
+            return -1;
+        }
+        cf_seq = &stream->seq;
+        udp_seq = &stream->udpSeq;
+        *entry = stream;
+    } else if (s_id != stream_id) {
         return -1;
     }
 
-    // Check sequence numbers.
-    if (seq_num != *exp_cf_seqnum) {
-        LOG_ERR("Incorrect sequence num. Expected: %d Recd.: %d\n",
-                                            *exp_cf_seqnum, seq_num);
-        *exp_cf_seqnum = seq_num;
+    // Only count the sequence numbers, the caller reports the statistics
+    if (use_udp && udp_seq) {
+        Avtp_SeqTracker_UpdateUdp(udp_seq, udp_seq_num);
+    }
+    if (cf_seq) {
+        Avtp_SeqTracker_Update(cf_seq, seq_num);
     }
 
     while (proc_bytes < msg_length) {
 
+        uint8_t acf_msg_type, can_bus_id, header_length;
+        uint16_t acf_msg_length, can_payload_length;
+        canid_t can_id;
+        Avtp_CanHeader_t header;
+        Avtp_CanBriefHeader_t brief;
+
         acf_pdu = &pdu[proc_bytes];
 
-        if (!is_valid_acf_packet(acf_pdu)) {
+        // ACF CAN and ACF CAN Brief messages may be mixed in one PDU. Both
+        // share the layout of the first quadlet except the timestamp.
+        if (msg_length - proc_bytes < AVTP_CAN_BRIEF_HEADER_LEN ||
+            i >= MAX_CAN_FRAMES_IN_ACF) {
+            return -1;
+        }
+        acf_msg_type = Avtp_AcfCommon_GetAcfMsgType((Avtp_AcfCommon_t*)acf_pdu);
+        if (acf_msg_type == AVTP_ACF_TYPE_CAN) {
+            if (msg_length - proc_bytes < AVTP_CAN_HEADER_LEN) {
+                return -1;
+            }
+            Avtp_Can_Unpack((Avtp_Can_t*)acf_pdu, &header);
+            header_length = AVTP_CAN_HEADER_LEN;
+        } else if (acf_msg_type == AVTP_ACF_TYPE_CAN_BRIEF) {
+            Avtp_CanBrief_Unpack((Avtp_CanBrief_t*)acf_pdu, &brief);
+            header.acf_msg_length = brief.acf_msg_length;
+            header.pad = brief.pad;
+            header.rtr = brief.rtr;
+            header.eff = brief.eff;
+            header.brs = brief.brs;
+            header.fdf = brief.fdf;
+            header.esi = brief.esi;
+            header.can_bus_id = brief.can_bus_id;
+            header.can_identifier = brief.can_identifier;
+            header_length = AVTP_CAN_BRIEF_HEADER_LEN;
+        } else {
+            return -1;
+        }
+
+        // The message and its payload must lie within the PDU
+        acf_msg_length = header.acf_msg_length * AVTP_QUADLET_SIZE;
+        if (acf_msg_length < header_length + header.pad ||
+            acf_msg_length > msg_length - proc_bytes) {
+            return -1;
+        }
+        can_payload_length = acf_msg_length - header_length - header.pad;
+        if (can_payload_length > (can_variant == AVTP_CAN_FD ?
+                                  sizeof(can_frames[i].fd.data) :
+                                  sizeof(can_frames[i].cc.data))) {
             return -1;
         }
 
-        canid_t can_id = Avtp_Can_GetCanIdentifier((Avtp_Can_t*)acf_pdu);
-        const uint8_t* can_payload = Avtp_Can_GetPayload((Avtp_Can_t*)acf_pdu);
-        uint16_t acf_msg_length = Avtp_Can_GetAcfMsgLength((Avtp_Can_t*)acf_pdu)*4;
-        uint16_t can_payload_length = Avtp_Can_GetCanPayloadLength((Avtp_Can_t*)acf_pdu);
+        const uint8_t* can_payload = acf_pdu + header_length;
+        can_id = header.can_identifier;
+        can_bus_id = header.can_bus_id;
         proc_bytes += acf_msg_length;
+        if (bus_ids) {
+            bus_ids[i] = can_bus_id;
+        }
         frame_t* frame = &(can_frames[i++]);
 
         // Handle EFF Flag
-        if (Avtp_Can_GetEff((Avtp_Can_t*)acf_pdu)) {
+        if (header.eff) {
             can_id |= CAN_EFF_FLAG;
         } else if (can_id > 0x7FF) {
             LOG_ERR("Error: CAN ID is > 0x7FF but the EFF bit is not set.\n");
@@ -332,18 +1607,18 @@ int avtp_to_can(uint8_t* pdu, frame_t* can_frames, Avtp_CanVariant_t can_variant
         }
 
         // Handle RTR Flag
-        if (Avtp_Can_GetRtr((Avtp_Can_t*)acf_pdu)) {
+        if (header.rtr) {
             can_id |= CAN_RTR_FLAG;
         }
 
         if (can_variant == AVTP_CAN_FD) {
-            if (Avtp_Can_GetBrs((Avtp_Can_t*)acf_pdu)) {
+            if (header.brs) {
                 frame->fd.flags |= CANFD_BRS;
             }
-            if (Avtp_Can_GetFdf((Avtp_Can_t*)acf_pdu)) {
+            if (header.fdf) {
                 frame->fd.flags |= CANFD_FDF;
             }
-            if (Avtp_Can_GetEsi((Avtp_Can_t*)acf_pdu)) {
+            if (header.esi) {
                 frame->fd.flags |= CANFD_ESI;
             }
 #ifdef __linux__
@@ -367,4 +1642,31 @@ int avtp_to_can(uint8_t* pdu, frame_t* can_frames, Avtp_CanVariant_t can_variant
     }
 
     return i;
+}
+
+int avtp_to_can(uint8_t* pdu, uint16_t pdu_len, frame_t* can_frames,
+                Avtp_CanVariant_t can_variant, int use_udp, uint64_t stream_id,
+                Avtp_SeqTracker_t* cf_seq, Avtp_SeqTracker_t* udp_seq) {
+
+    return avtp_to_can_multi_bus(pdu, pdu_len, can_frames, NULL, can_variant,
+                                 use_udp, stream_id, cf_seq, udp_seq);
+}
+
+int avtp_to_can_multi_bus(uint8_t* pdu, uint16_t pdu_len, frame_t* can_frames,
+                          uint8_t* bus_ids, Avtp_CanVariant_t can_variant,
+                          int use_udp, uint64_t stream_id,
+                          Avtp_SeqTracker_t* cf_seq, Avtp_SeqTracker_t* udp_seq) {
+
+    return decode_cf_pdu(pdu, pdu_len, can_frames, bus_ids, can_variant,
+                         use_udp, stream_id, NULL, NULL, cf_seq, udp_seq);
+}
+
+int avtp_to_can_stream_table(uint8_t* pdu, uint16_t pdu_len,
+                             frame_t* can_frames, uint8_t* bus_ids,
+                             Avtp_CanVariant_t can_variant, int use_udp,
+                             const Avtp_StreamTable_t* streams,
+                             Avtp_StreamEntry_t** entry) {
+
+    return decode_cf_pdu(pdu, pdu_len, can_frames, bus_ids, can_variant,
+                         use_udp, 0, streams, entry, NULL, NULL);
 }
\ No newline at end of file
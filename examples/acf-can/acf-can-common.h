@@ -28,7 +28,12 @@
  */
 
 #ifdef __linux__
+#include <sys/socket.h>
+#include <time.h>
 #include <linux/can.h>
+#include <linux/errqueue.h>
+#include "common/spsc.h"
+#include "common/seqstats.h"
 #elif defined(__ZEPHYR__)
 #include <zephyr/drivers/can.h>
 
@@ -38,9 +43,12 @@
 #define CAN_RTR_FLAG 0x40000000U
 #define CAN_ERR_FLAG 0x20000000U
 #define CAN_EFF_MASK 0x1FFFFFFFU
+#define CAN_SFF_MASK 0x000007FFU
 #endif
 
 #include "avtp/acf/Can.h"
+#include "avtp/StreamTable.h"
+#include "avtp/StreamTemplate.h"
 
 #define MAX_ETH_PDU_SIZE                1500
 #define MAX_CAN_FRAMES_IN_ACF           15
@@ -62,6 +70,171 @@ typedef union {
     canfd_frame_t fd;
 } frame_t;
 
+/* Actions of the CAN routes */
+typedef enum {
+    /* Drop the frame */
+    CAN_ROUTE_DROP = 0,
+    /* Aggregate the frame into the next PDU of its talker stream */
+    CAN_ROUTE_FORWARD,
+    /* Send the frame without waiting for aggregation, together with the
+       frames queued before it */
+    CAN_ROUTE_PRIORITY,
+} can_route_action_t;
+
+/* Rules of a routing table */
+#define CAN_ROUTE_MAX_RULES             64
+/* Talker streams a routing table can send frames to */
+#define CAN_ROUTE_MAX_STREAMS           8
+/* Number of 11 bit CAN IDs */
+#define CAN_ROUTE_SFF_IDS               (CAN_SFF_MASK + 1)
+/* Hash slots for exact 29 bit CAN IDs, twice the maximum number of rules */
+#define CAN_ROUTE_EFF_SLOT_BITS         7
+#define CAN_ROUTE_EFF_SLOTS             (1 << CAN_ROUTE_EFF_SLOT_BITS)
+/* Distinct masks of the 29 bit rules with a mask */
+#define CAN_ROUTE_EFF_MAX_MASKS         4
+
+/* Route of the CAN frames matching an ID and mask */
+typedef struct {
+    /* CAN ID, with CAN_EFF_FLAG for 29 bit IDs */
+    uint32_t id;
+    /* Bits of the CAN ID that have to match */
+    uint32_t mask;
+    /* can_route_action_t */
+    uint8_t action;
+    /* Index of the talker stream that sends the frames */
+    uint8_t stream;
+} can_route_t;
+
+/* Routing table of the CAN frames sent over AVTP. The first matching rule
+   routes a frame. Zero-initialize or use can_route_table_init(). */
+typedef struct {
+    can_route_t rules[CAN_ROUTE_MAX_RULES];
+    uint8_t num_rules;
+    /* Route of the frames no rule matches */
+    can_route_t default_route;
+    /* 11 bit IDs matched by a rule and the first rule matching them */
+    uint64_t sff_matched[CAN_ROUTE_SFF_IDS / 64];
+    uint8_t sff_rules[CAN_ROUTE_SFF_IDS];
+    /* Exact 29 bit IDs with CAN_EFF_FLAG, 0 marks free slots, and the first
+       rule matching them. Collisions are resolved by linear probing. */
+    uint32_t eff_ids[CAN_ROUTE_EFF_SLOTS];
+    uint8_t eff_rules[CAN_ROUTE_EFF_SLOTS];
+    /* Rules matching 29 bit IDs with a mask, in order */
+    uint8_t eff_masked[CAN_ROUTE_MAX_RULES];
+    uint8_t num_eff_masked;
+    /* Distinct masks of these rules. Their masked IDs are hashed per mask,
+       so a lookup probes the hash once per mask. */
+    uint32_t eff_masks[CAN_ROUTE_EFF_MAX_MASKS];
+    uint8_t num_eff_masks;
+    /* Masked 29 bit IDs with CAN_EFF_FLAG, the index of their mask plus one
+       (0 marks free slots) and the first rule matching them */
+    uint32_t eff_masked_ids[CAN_ROUTE_EFF_SLOTS];
+    uint8_t eff_masked_masks[CAN_ROUTE_EFF_SLOTS];
+    uint8_t eff_masked_rules[CAN_ROUTE_EFF_SLOTS];
+} can_route_table_t;
+
+/* Pre-rendered TSCF/NTSCF headers of the talker streams, indexed by stream.
+   Set up with can_talker_streams_init() and owned by the caller, so
+   talkers with different streams or formats do not interfere. */
+typedef struct {
+    Avtp_StreamTemplate_t templates[CAN_ROUTE_MAX_STREAMS];
+    uint64_t stream_ids[CAN_ROUTE_MAX_STREAMS];
+    uint8_t num_streams;
+    /* 1: TSCF, 0: NTSCF */
+    int use_tscf;
+} can_talker_streams_t;
+
+/* Acceptance filter for the CAN socket or controller. A frame passes if
+   (frame ID & mask) == (id & mask) and the frame format matches. */
+typedef struct {
+    /* CAN ID, with CAN_EFF_FLAG for 29 bit IDs */
+    uint32_t id;
+    uint32_t mask;
+} can_route_filter_t;
+
+/**
+ * Initializes an empty CAN routing table.
+ *
+ * @param routes Routing table
+ * @param default_action can_route_action_t of the frames no rule matches
+ * @param default_stream Talker stream of the frames no rule matches
+ */
+void can_route_table_init(can_route_table_t* routes, uint8_t default_action,
+                          uint8_t default_stream);
+
+/**
+ * Appends a rule to a CAN routing table. Rules added earlier take
+ * precedence.
+ *
+ * @param routes Routing table
+ * @param id CAN ID, with CAN_EFF_FLAG for 29 bit IDs
+ * @param mask Bits of the CAN ID that have to match, CAN_SFF_MASK or
+ *             CAN_EFF_MASK for a single ID
+ * @param action can_route_action_t of the matching frames
+ * @param stream Talker stream of the matching frames
+ * @returns 0 on success, -ENOSPC if the table is full or the rules of 29 bit
+ *          IDs would use more than CAN_ROUTE_EFF_MAX_MASKS distinct masks,
+ *          -EINVAL for invalid arguments
+ */
+int can_route_table_add(can_route_table_t* routes, uint32_t id, uint32_t mask,
+                        uint8_t action, uint8_t stream);
+
+/**
+ * Parses a route action: "drop", "fwd[=STREAM]" or "prio[=STREAM]".
+ *
+ * @param str Action to parse
+ * @param action Returns the can_route_action_t
+ * @param stream Returns the talker stream, 0 if not given
+ * @returns 0 on success, -EINVAL if the action is invalid
+ */
+int can_route_parse_action(const char* str, uint8_t* action, uint8_t* stream);
+
+/**
+ * Parses a rule "ID[/MASK]:ACTION" and appends it to a CAN routing table.
+ * ID and MASK are hexadecimal, IDs with more than 3 digits are 29 bit IDs.
+ * See can_route_parse_action() for ACTION.
+ *
+ * @param routes Routing table
+ * @param rule Rule to parse
+ * @returns 0 on success, negative errno on error
+ */
+int can_route_parse(can_route_table_t* routes, const char* rule);
+
+/**
+ * Checks that all routes of a routing table send to existing talker streams.
+ *
+ * @param routes Routing table
+ * @param num_streams Number of talker streams
+ * @returns 0 on success, -EINVAL if a route refers to another stream
+ */
+int can_route_check_streams(const can_route_table_t* routes,
+                            uint8_t num_streams);
+
+/**
+ * Looks up the route of a CAN frame.
+ *
+ * @param routes Routing table
+ * @param frame CAN frame
+ * @returns Route of the frame, never NULL
+ */
+const can_route_t* can_route_lookup(const can_route_table_t* routes,
+                                    const frame_t* frame);
+
+/**
+ * Builds acceptance filters passing all frames the routing table does not
+ * drop, so that the CAN socket or controller discards the other frames.
+ * Filters may pass more frames than needed: if the rules do not fit, the
+ * filters of 29 bit and then of 11 bit IDs are replaced by one that passes
+ * all IDs of that format. Unless the default route drops, all frames pass.
+ *
+ * @param routes Routing table
+ * @param filters Array receiving the filters
+ * @param max_filters Size of the array, at least 2
+ * @returns Number of filters
+ */
+int can_route_filters(const can_route_table_t* routes,
+                      can_route_filter_t* filters, int max_filters);
+
 #ifdef __linux__
 /**
  * Creates a CAN socket.
@@ -71,38 +244,376 @@ typedef union {
  * @returns CAN socket on success else the error
  */
 int setup_can_socket(const char* can_ifname, Avtp_CanVariant_t can_variant);
+
+/**
+ * Sets CAN_RAW_FILTER on a CAN socket from a routing table, so that the
+ * kernel drops the frames the table would drop.
+ *
+ * @param can_socket CAN socket created with setup_can_socket()
+ * @param routes Routing table, see can_route_filters()
+ * @returns 0 on success, negative errno on error
+ */
+int set_can_route_filters(int can_socket, const can_route_table_t* routes);
+
+/* Source of the RX timestamps of CAN frames, which become the message
+   timestamps of their ACF CAN messages */
+typedef enum {
+    /* No RX timestamps, the clock is read once per AVTP PDU instead */
+    CAN_TIMESTAMP_NONE = 0,
+    /* Taken by the kernel on reception (SO_TIMESTAMPNS), CLOCK_REALTIME */
+    CAN_TIMESTAMP_SOFTWARE,
+    /* Taken by the CAN controller (SO_TIMESTAMPING), in the time base of the
+       controller's clock */
+    CAN_TIMESTAMP_HARDWARE,
+} can_timestamp_source_t;
+
+/* Control message space for the RX timestamp of one CAN frame */
+#define CAN_TIMESTAMP_CMSG_SPACE    CMSG_SPACE(sizeof(struct scm_timestamping))
+
+/**
+ * Parses a CAN RX timestamp source: "none", "software" or "hardware".
+ *
+ * @param str String to parse
+ * @param source Returns the timestamp source
+ * @returns 0 on success, -EINVAL if str is not a timestamp source
+ */
+int can_timestamp_parse_source(const char* str, can_timestamp_source_t* source);
+
+/**
+ * Enables RX timestamps on a CAN socket. Hardware timestamps are also enabled
+ * on the CAN interface, which needs CAP_NET_ADMIN. Frames the controller does
+ * not stamp are treated as frames without timestamp.
+ *
+ * @param can_socket CAN socket created with setup_can_socket()
+ * @param can_ifname CAN interface of the socket
+ * @param source Timestamp source
+ * @returns 0 on success, negative errno on error
+ */
+int set_can_timestamping(int can_socket, const char* can_ifname,
+                         can_timestamp_source_t source);
+
+/**
+ * Extracts the RX timestamp of a received CAN frame from the control
+ * messages of its msghdr.
+ *
+ * @param msg Message header of the received frame, with at least
+ *            CAN_TIMESTAMP_CMSG_SPACE bytes of control messages
+ * @returns Timestamp in nanoseconds, 0 if there is none
+ */
+uint64_t can_rx_timestamp(struct msghdr* msg);
+
+/**
+ * Returns the length of the ACF CAN message a CAN frame is packed into,
+ * including the padding to a multiple of quadlets.
+ *
+ * @param frame CAN frame
+ * @param can_variant AVTP_CAN_CLASSIC or AVTP_CAN_FD
+ * @param use_brief 1: ACF CAN Brief message, 0: ACF CAN message
+ * @returns Length of the ACF message in bytes
+ */
+uint16_t acf_can_msg_length(const frame_t* frame, Avtp_CanVariant_t can_variant,
+                            int use_brief);
+
+/* Reasons for handing aggregated CAN frames to can_to_avtp() */
+typedef enum {
+    /* The configured number of frames per AVTP PDU is queued */
+    CAN_FLUSH_COUNT = 0,
+    /* The next frame would not fit into the AVTP PDU anymore */
+    CAN_FLUSH_MTU,
+    /* The deadline since the first queued frame expired */
+    CAN_FLUSH_DEADLINE,
+    /* The next frame is routed to another talker stream */
+    CAN_FLUSH_STREAM,
+    /* A frame with a CAN_ROUTE_PRIORITY route is queued */
+    CAN_FLUSH_PRIORITY,
+    CAN_FLUSH_REASON_MAX
+} can_flush_reason_t;
+
+/* Statistics of the CAN frame aggregation */
+typedef struct {
+    uint64_t syscalls;
+    uint64_t frames;
+    uint64_t flushes[CAN_FLUSH_REASON_MAX];
+    /* Frames dropped by the routing table */
+    uint64_t dropped;
+    uint64_t last_print_ns;
+} can_rx_stats_t;
+
+/* Frames an aggregator receives from the CAN socket in advance */
+#define CAN_AGGREGATOR_MAX_FRAMES       (4 * MAX_CAN_FRAMES_IN_ACF)
+/* CAN sockets an aggregator can read from */
+#define CAN_AGGREGATOR_MAX_BUSES        16
+/* Number of ACF CAN bus IDs, the field has 5 bits */
+#define CAN_MAX_BUS_IDS                 32
+
+/* Element of the ring filled by can_drain_frames() */
+typedef struct {
+    frame_t frame;
+    /* RX timestamp in ns, 0 if not available */
+    uint64_t timestamp;
+    /* CLOCK_MONOTONIC time in ns when can_drain_frames() received the frame */
+    uint64_t arrival;
+} can_ring_frame_t;
+
+/* Aggregates CAN frames read from one or more CAN sockets into AVTP PDUs */
+typedef struct {
+    int can_socket;
+    int timer_fd;
+    /* CAN sockets and the ACF CAN bus IDs of their frames */
+    int can_sockets[CAN_AGGREGATOR_MAX_BUSES];
+    uint8_t bus_ids[CAN_AGGREGATOR_MAX_BUSES];
+    uint8_t num_buses;
+    /* Waits for all CAN sockets and the deadline timer with several buses */
+    int epoll_fd;
+    int deadline_expired;
+    Avtp_CanVariant_t can_variant;
+    uint8_t max_frames;
+    uint32_t deadline_us;
+    /* Space for ACF messages in the AVTP PDU */
+    uint16_t max_payload;
+    /* Received frames, may hold frames for several AVTP PDUs */
+    frame_t frames[CAN_AGGREGATOR_MAX_FRAMES];
+    uint8_t frame_bus_ids[CAN_AGGREGATOR_MAX_FRAMES];
+    /* RX timestamps of the received frames in ns, 0 if not available */
+    uint64_t frame_timestamps[CAN_AGGREGATOR_MAX_FRAMES];
+    /* CLOCK_MONOTONIC times in ns when the frames were received, the
+       deadline runs from the arrival of the oldest pending frame */
+    uint64_t frame_arrivals[CAN_AGGREGATOR_MAX_FRAMES];
+    /* Talker streams of the received frames and if they are urgent */
+    uint8_t frame_streams[CAN_AGGREGATOR_MAX_FRAMES];
+    uint8_t frame_priority[CAN_AGGREGATOR_MAX_FRAMES];
+    uint8_t num_pending;
+    /* Number of pending frames included in pending_length */
+    uint8_t num_accounted;
+    uint16_t pending_length;
+    /* Spin on the non-blocking CAN socket instead of sleeping. Can be set
+       after can_aggregator_init(). */
+    int busy_poll;
+    /* Take the frames from this ring of can_ring_frame_t, filled by
+       can_drain_frames() in another thread, instead of the CAN socket. Can
+       be set after can_aggregator_init(). */
+    spsc_ring_t* ring;
+    /* Drops the frames or routes them to talker streams, all frames go to
+       stream 0 if NULL. Can be set after can_aggregator_init(). */
+    const can_route_table_t* routes;
+    /* The frames are packed into ACF CAN Brief messages, which are shorter.
+       Can be set after can_aggregator_init(). */
+    int brief;
+    /* Talker stream of the frames returned by can_aggregator_collect() */
+    uint8_t stream;
+    /* Why can_aggregator_collect() returned the frames. Frames returned for
+       CAN_FLUSH_PRIORITY should be sent at once. */
+    can_flush_reason_t flush_reason;
+    /* CLOCK_MONOTONIC time in ns when the first frame returned by
+       can_aggregator_collect() was received */
+    uint64_t arrival;
+    can_rx_stats_t stats;
+} can_aggregator_t;
+
+/**
+ * Initializes a CAN frame aggregator.
+ *
+ * @param agg Aggregator to initialize
+ * @param can_socket CAN socket created with setup_can_socket(), with bus ID
+ *                   0. -1 to add all CAN sockets with can_aggregator_add_bus().
+ * @param can_variant AVTP_CAN_CLASSIC or AVTP_CAN_FD
+ * @param max_frames Number of frames per AVTP PDU, at most
+ *                   MAX_CAN_FRAMES_IN_ACF
+ * @param deadline_us Maximum time a frame is held back in microseconds,
+ *                    0 waits until max_frames frames are queued.
+ * @param use_udp 1: UDP encapsulation, 0: Ethernet
+ * @param use_tscf 1: TSCF, 0: NTSCF
+ * @returns 0 on success, negative errno on error
+ */
+int can_aggregator_init(can_aggregator_t* agg, int can_socket,
+                        Avtp_CanVariant_t can_variant, uint8_t max_frames,
+                        uint32_t deadline_us, int use_udp, int use_tscf);
+
+/**
+ * Adds a CAN socket to an aggregator. Frames of all CAN sockets of an
+ * aggregator share the AVTP PDUs and are tagged with the bus ID of their
+ * socket. With more than one socket, the aggregator waits for all of them
+ * with epoll.
+ *
+ * @param agg Aggregator initialized with can_aggregator_init()
+ * @param can_socket CAN socket created with setup_can_socket()
+ * @param bus_id ACF CAN bus ID of the frames of this socket
+ * @returns 0 on success, negative errno on error
+ */
+int can_aggregator_add_bus(can_aggregator_t* agg, int can_socket,
+                           uint8_t bus_id);
+
+/**
+ * Collects CAN frames for the next AVTP PDU. Returns when max_frames frames
+ * are queued, when the next frame would exceed the AVTP PDU or when the
+ * deadline since the first queued frame expires, whichever comes first. The
+ * CAN socket is drained with recvmmsg(), so all queued frames are received
+ * with one syscall. With a routing table, the returned frames all belong to
+ * the talker stream in agg->stream, and the PDU is also completed when the
+ * next frame belongs to another stream or a priority frame is queued.
+ *
+ * @param agg Aggregator initialized with can_aggregator_init()
+ * @param can_frames Array of at least max_frames CAN frames
+ * @param bus_ids Array of at least max_frames bus IDs of the frames, or NULL
+ * @param timestamps Array of at least max_frames RX timestamps of the frames,
+ *                   0 for frames without one, or NULL
+ * @returns Number of frames to send, negative errno on error
+ */
+int can_aggregator_collect(can_aggregator_t* agg, frame_t* can_frames,
+                           uint8_t* bus_ids, uint64_t* timestamps);
+
+/**
+ * Checks if the CAN frames already received are sufficient for another AVTP
+ * PDU, i.e. if can_aggregator_collect() returns without waiting. This can be
+ * used to defer the transmission of the previous PDU.
+ *
+ * @param agg Aggregator initialized with can_aggregator_init()
+ * @returns 1 if another PDU is ready, 0 otherwise
+ */
+int can_aggregator_ready(const can_aggregator_t* agg);
+
+/**
+ * Receives all queued CAN frames with one recvmmsg() call and pushes them
+ * with their RX timestamps into a ring of can_ring_frame_t. Frames that do not fit into the ring are dropped
+ * and counted by the ring. Running this in a dedicated thread keeps the CAN
+ * socket drained while the thread consuming the ring is blocked, e.g. in a
+ * slow send.
+ *
+ * @param can_socket CAN socket created with setup_can_socket()
+ * @param can_variant AVTP_CAN_CLASSIC or AVTP_CAN_FD
+ * @param ring Ring of can_ring_frame_t
+ * @param busy_poll 1: spin on the non-blocking socket, 0: block
+ * @param stats Statistics, only syscalls and frames are counted
+ * @returns Number of frames received, negative errno on error
+ */
+int can_drain_frames(int can_socket, Avtp_CanVariant_t can_variant,
+                     spsc_ring_t* ring, int busy_poll, can_rx_stats_t* stats);
+
+/**
+ * Prints the average number of CAN frames per syscall and the number of
+ * flushes per reason if at least interval_s seconds have passed since the
+ * last print.
+ *
+ * @param stats Statistics of a CAN frame aggregator
+ * @param interval_s Minimum interval between two prints in seconds
+ */
+void print_can_rx_stats(can_rx_stats_t* stats, uint32_t interval_s);
+
+/**
+ * Prints the sequence statistics of all streams of a stream table that
+ * received packets, if the interval elapsed or SIGUSR1 was received.
+ *
+ * @param streams Table of the received streams
+ * @param timer Print timer, see seq_stats_due()
+ * @param interval_s Print interval in seconds, 0 to print on SIGUSR1 only
+ */
+void print_stream_seq_stats(const Avtp_StreamTable_t* streams,
+                            seq_stats_timer_t* timer, uint32_t interval_s);
 #endif
 
 /**
- * Function that converts AVTP Frames to CAN
+ * Function that converts AVTP Frames to CAN. ACF CAN and ACF CAN Brief
+ * messages are detected per message and may be mixed within one PDU.
  *
  * @param pdu: Start of the AVTP Frame
+ * @param pdu_len: Number of received bytes at pdu, PDUs whose headers or
+ *                 stream data exceed it are rejected
  * @param can_frames: Array of CAM Frames to be recovered from AVTP Frames
  * @param can_variant: AVTP_CAN_CLASSIC or AVTP_CAN_FD
  * @param use_udp 1: UDP encapsulation, 0: Ethernet
  * @param stream_id: AVTP stream ID of interest
- * @param exp_cf_seqnum: Expected Control format sequence num.
- * @param exp_udp_seqnum: Expected UDP Encapsulation sequence num.
+ * @param cf_seq: Tracker of the Control format sequence num., may be NULL
+ * @param udp_seq: Tracker of the UDP Encapsulation sequence num., may be NULL
+ * @return Number of CAN messages received, -1 for invalid PDUs
+ */
+int avtp_to_can(uint8_t* pdu, uint16_t pdu_len, frame_t* can_frames,
+                Avtp_CanVariant_t can_variant, int use_udp, uint64_t stream_id,
+                Avtp_SeqTracker_t* cf_seq, Avtp_SeqTracker_t* udp_seq);
+
+/**
+ * Function that converts AVTP Frames to CAN frames of several CAN buses.
+ * Same as avtp_to_can(), but also returns the ACF CAN bus ID of every frame.
+ *
+ * @param bus_ids: Array receiving the bus IDs of the CAN frames
  * @return Number of CAN messages received
  */
-int avtp_to_can(uint8_t* pdu, frame_t* can_frames, Avtp_CanVariant_t can_variant,
-                int use_udp, uint64_t stream_id, uint8_t* exp_cf_seqnum,
-                uint32_t* exp_udp_seqnum);
+int avtp_to_can_multi_bus(uint8_t* pdu, uint16_t pdu_len, frame_t* can_frames,
+                          uint8_t* bus_ids, Avtp_CanVariant_t can_variant,
+                          int use_udp, uint64_t stream_id,
+                          Avtp_SeqTracker_t* cf_seq, Avtp_SeqTracker_t* udp_seq);
+
+/**
+ * Function that converts AVTP Frames of any stream in a stream table to CAN
+ * frames. Same as avtp_to_can_multi_bus(), but the sequence trackers of
+ * every stream are kept in its table entry.
+ *
+ * @param streams: Table of the accepted streams
+ * @param entry: Returns the table entry of the received stream
+ * @return Number of CAN messages received, -1 for unknown streams
+ */
+int avtp_to_can_stream_table(uint8_t* pdu, uint16_t pdu_len,
+                             frame_t* can_frames, uint8_t* bus_ids,
+                             Avtp_CanVariant_t can_variant, int use_udp,
+                             const Avtp_StreamTable_t* streams,
+                             Avtp_StreamEntry_t** entry);
+
+/**
+ * Renders the constant TSCF/NTSCF header fields of the talker streams once,
+ * for can_to_avtp_multi_bus(). Replaces the streams set up before.
+ *
+ * @param streams: Talker streams to set up
+ * @param stream_ids: Stream IDs of the talker streams, indexed by stream
+ * @param num_streams: Number of talker streams, at most CAN_ROUTE_MAX_STREAMS
+ * @param use_tscf 1: TSCF, 0: NTSCF
+ * @return 0 on success, negative errno on error
+ */
+int can_talker_streams_init(can_talker_streams_t* streams,
+                            const uint64_t* stream_ids, uint8_t num_streams,
+                            int use_tscf);
+
+/**
+ * Function that converts CAN frames of several CAN buses to AVTP Frames.
+ * Same as can_to_avtp(), but sets the ACF CAN bus ID and the message
+ * timestamp of every frame, and packs them into a talker stream set up with
+ * can_talker_streams_init(). The format (TSCF or NTSCF) is the one of the
+ * talker streams.
+ *
+ * @param bus_ids: Bus IDs of the CAN frames, NULL for bus ID 0
+ * @param timestamps: RX timestamps of the CAN frames in ns. Frames without
+ *                    one (0), or all if NULL, get the time of packing.
+ *                    Ignored for ACF CAN Brief messages.
+ * @param streams: Talker streams
+ * @param stream: Index of the talker stream
+ * @return Length of the PDU, negative on error
+ */
+int can_to_avtp_multi_bus(frame_t* can_frames, const uint8_t* bus_ids,
+                          const uint64_t* timestamps,
+                          Avtp_CanVariant_t can_variant, uint8_t* pdu,
+                          int use_udp, int use_brief,
+                          const can_talker_streams_t* streams, uint8_t stream,
+                          uint8_t num_acf_msgs, uint8_t cf_seq_num,
+                          uint32_t udp_seq_num);
 
 /**
  * Function that converts AVTP Frames to CAN
  *
+ * The header of stream_id is rendered into streams again whenever it
+ * changes, replacing the talker streams set up before.
+ *
  * @param can_frames: Array of CAM Frames to be translated to AVTP Frames
  * @param can_variant: AVTP_CAN_CLASSIC or AVTP_CAN_FD
  * @param pdu: Start of AVTP Frame
  * @param use_udp 1: UDP encapsulation, 0: Ethernet
  * @param use_tscf 1: TSCF, 0: NTSCF
+ * @param use_brief 1: ACF CAN Brief messages without timestamp, 0: ACF CAN
+ * @param streams: Talker streams of the caller, zero-initialized at first
  * @param stream_id: AVTP stream ID of interest
  * @param num_acf_msgs: No. of ACF CAN messages to aggregate
  * @param cf_seq_num: Control format sequence num.
  * @param udp_seq_num: UDP Encapsulation sequence num.
- * @return Length of the PDU
+ * @return Length of the PDU, negative on error
  */
 int can_to_avtp(frame_t* can_frames, Avtp_CanVariant_t can_variant, uint8_t* pdu,
-                     int use_udp, int use_tscf, uint64_t stream_id,
+                     int use_udp, int use_tscf, int use_brief,
+                     can_talker_streams_t* streams, uint64_t stream_id,
                      uint8_t num_acf_msgs, uint8_t cf_seq_num, uint32_t udp_seq_num);
\ No newline at end of file
@@ -177,13 +177,13 @@ func main() {
 				if err != nil {
 					fmt.Println("Error opening executable: ", err)
 				}
-				uprobeCantoAvtp, err := exTalker.Uprobe("can_to_avtp", objs.UprobeCanToAvtp, &link.UprobeOptions{})
+				uprobeCantoAvtp, err := exTalker.Uprobe("can_to_avtp_multi_bus", objs.UprobeCanToAvtp, &link.UprobeOptions{})
 				if err != nil {
 					fmt.Println("Error attaching eBPF program to UprobeCanToAvtp: ", err)
 				}
 				defer uprobeCantoAvtp.Close()
 
-				uprobeRetCantoAvtp, err := exTalker.Uretprobe("can_to_avtp", objs.UprobeRetCanToAvtp, &link.UprobeOptions{})
+				uprobeRetCantoAvtp, err := exTalker.Uretprobe("can_to_avtp_multi_bus", objs.UprobeRetCanToAvtp, &link.UprobeOptions{})
 				if err != nil {
 					fmt.Println("Error attaching eBPF program to UprobeRetAvtpToCan: ", err)
 				}
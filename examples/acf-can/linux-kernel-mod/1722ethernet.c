@@ -45,59 +45,63 @@
 #include <linux/can/core.h>
 #include <linux/if_ether.h>
 #include <linux/timekeeping.h>
+#include <linux/percpu.h>
+#include <linux/minmax.h>
+#include <linux/net.h>
+#include <linux/version.h>
 
 void prepare_ntscf_header(Avtp_Ntscf_t *ntscf_header, struct acfcan_cfg *cfg)
 {
     Avtp_Ntscf_Init(ntscf_header);
     Avtp_Ntscf_SetVersion(ntscf_header, 0);
-    Avtp_Ntscf_SetSequenceNum(ntscf_header, cfg->sequenceNum++); // This can't be right. Increase?
+    // The NTSCF frames of all CPUs share the sequence number
+    Avtp_Ntscf_SetSequenceNum(ntscf_header, (uint8_t)(atomic_inc_return(&cfg->sequenceNum) - 1));
     Avtp_Ntscf_SetStreamId(ntscf_header, cfg->tx_streamid);
 }
 
-void prepare_can_header(Avtp_Can_t *can_header, struct acfcan_cfg *cfg, const struct sk_buff *skb)
+// Collects the header fields shared by ACF CAN and ACF CAN Brief messages
+static void fill_can_header(Avtp_CanHeader_t *header, struct acfcan_cfg *cfg, const struct sk_buff *skb,
+                            uint8_t header_len)
 {
     struct canfd_frame *cfd = (struct canfd_frame *)skb->data; // this also works work can_frame struct, as the beginning is similar
 
-    Avtp_Can_Init(can_header);
-    Avtp_Can_SetCanBusId(can_header, cfg->canbusId);
-    if (cfd->can_id & CAN_RTR_FLAG)
-    {
-        Avtp_Can_EnableRtr(can_header);
-    }
-    if (cfd->can_id & CAN_EFF_FLAG)
-    {
-        Avtp_Can_EnableEff(can_header);
-    }
+    memset(header, 0, sizeof(*header));
+    header->can_bus_id = cfg->canbusId;
+    header->rtr = (cfd->can_id & CAN_RTR_FLAG) ? 1 : 0;
+    header->eff = (cfd->can_id & CAN_EFF_FLAG) ? 1 : 0;
 
     if (cfd->can_id & CAN_EFF_FLAG)
     {
-        Avtp_Can_SetCanIdentifier(can_header, cfd->can_id & CAN_EFF_MASK);
+        header->can_identifier = cfd->can_id & CAN_EFF_MASK;
     }
     else
     {
-        Avtp_Can_SetCanIdentifier(can_header, cfd->can_id & CAN_SFF_MASK);
+        header->can_identifier = cfd->can_id & CAN_SFF_MASK;
     }
 
     if (can_is_canfd_skb(skb))
     {
-        if (cfd->flags & CANFD_BRS)
-        {
-            Avtp_Can_EnableBrs(can_header);
-        }
-        if (cfd->flags & CANFD_FDF)
-        {
-            Avtp_Can_EnableFdf(can_header);
-        }
-        if (cfd->flags & CANFD_ESI)
-        {
-            Avtp_Can_GetEsi(can_header);
-        }
+        header->brs = (cfd->flags & CANFD_BRS) ? 1 : 0;
+        header->fdf = (cfd->flags & CANFD_FDF) ? 1 : 0;
+        header->esi = (cfd->flags & CANFD_ESI) ? 1 : 0;
     }
 
     // 1722 is a mess. Here we need to pad to quadlets
-    uint8_t padSize = (AVTP_QUADLET_SIZE - ((AVTP_CAN_HEADER_LEN + cfd->len) % AVTP_QUADLET_SIZE)) % AVTP_QUADLET_SIZE;
-    Avtp_Can_SetAcfMsgLength(can_header, (AVTP_CAN_HEADER_LEN + cfd->len + padSize) / AVTP_QUADLET_SIZE);
-    Avtp_Can_SetPad(can_header, padSize);
+    header->pad = (AVTP_QUADLET_SIZE - ((header_len + cfd->len) % AVTP_QUADLET_SIZE)) % AVTP_QUADLET_SIZE;
+    header->acf_msg_length = (header_len + cfd->len + header->pad) / AVTP_QUADLET_SIZE;
+}
+
+void prepare_can_header(Avtp_Can_t *can_header, struct acfcan_cfg *cfg, const struct sk_buff *skb)
+{
+    struct canfd_frame *cfd = (struct canfd_frame *)skb->data;
+    Avtp_CanHeader_t header;
+
+    fill_can_header(&header, cfg, skb, AVTP_CAN_HEADER_LEN);
+    header.acf_msg_type = AVTP_ACF_TYPE_CAN;
+
+    // Write the whole header in one pass
+    memset(can_header, 0, sizeof(Avtp_Can_t));
+    Avtp_Can_SetHeader(can_header, &header);
 
     pr_debug("Prepared AVTP ACFCAN msg for can id 0x%08x, len %i\n", Avtp_Can_GetCanIdentifier(can_header), cfd->len);
     /*
@@ -111,173 +115,340 @@ void prepare_can_header(Avtp_Can_t *can_header, struct acfcan_cfg *cfg, const st
     */
 }
 
-void calculate_and_set_ntscf_size(ACFCANPdu_t *pdu)
+void prepare_can_brief_header(Avtp_CanBrief_t *can_header, struct acfcan_cfg *cfg, const struct sk_buff *skb)
 {
-    // 1722 is a mess. Bytes, lukicly we have padded quadlets in can already....
-    uint16_t canandpadinbytes = Avtp_Can_GetAcfMsgLength(&pdu->can) * AVTP_QUADLET_SIZE;
-    Avtp_Ntscf_SetNtscfDataLength(&pdu->ntscf, canandpadinbytes);
+    struct canfd_frame *cfd = (struct canfd_frame *)skb->data;
+    Avtp_CanHeader_t header;
+    Avtp_CanBriefHeader_t brief;
+
+    fill_can_header(&header, cfg, skb, AVTP_CAN_BRIEF_HEADER_LEN);
+
+    memset(&brief, 0, sizeof(brief));
+    brief.acf_msg_type = AVTP_ACF_TYPE_CAN_BRIEF;
+    brief.acf_msg_length = header.acf_msg_length;
+    brief.pad = header.pad;
+    brief.rtr = header.rtr;
+    brief.eff = header.eff;
+    brief.brs = header.brs;
+    brief.fdf = header.fdf;
+    brief.esi = header.esi;
+    brief.can_bus_id = header.can_bus_id;
+    brief.can_identifier = header.can_identifier;
+
+    memset(can_header, 0, sizeof(Avtp_CanBrief_t));
+    Avtp_CanBrief_SetHeader(can_header, &brief);
+
+    pr_debug("Prepared AVTP ACFCAN brief msg for can id 0x%08x, len %i\n", brief.can_identifier, cfd->len);
 }
 
-int forward_can_frame(struct net_device *can_dev, const struct sk_buff *skb_can)
+// Length of the NTSCF frames a device sends at most, without Ethernet header
+static unsigned int acfcan_tx_max_len(struct acfcan_cfg *cfg)
 {
-    struct acfcan_cfg *cfg = get_acfcan_cfg(can_dev);
-    if (cfg->eth_netdev == NULL)
-    {
-        printk(KERN_INFO "No ethernet device set for ACFCAN device %s\n", can_dev->name);
-        return -1;
-    }
+    unsigned int len = AVTP_NTSCF_HEADER_LEN + cfg->tx_max_frames * (AVTP_CAN_HEADER_LEN + CANFD_MAX_DLEN);
 
-    ACFCANPdu_t pdu;
-    // Init TSCF header
-    prepare_ntscf_header(&pdu.ntscf, cfg);
-    prepare_can_header(&pdu.can, cfg, skb_can);
-    calculate_and_set_ntscf_size(&pdu);
+    return min3(len, cfg->eth_netdev->mtu, (unsigned int)(AVTP_NTSCF_HEADER_LEN + ACFCAN_NTSCF_MAX_DATA_LEN));
+}
 
-    // Prepare ethernet
-    struct sk_buff *skb_eth;
-    struct canfd_frame *cfd = (struct canfd_frame *)skb_can->data;
+// Completes the staged NTSCF frame and takes it from the stage. Called with the stage lock held.
+static struct sk_buff *acfcan_tx_stage_take(struct acfcan_tx_stage *stage, enum acfcan_tx_flush reason)
+{
+    struct sk_buff *skb = stage->skb;
 
-    // Allocate a socket buffer
-    skb_eth = alloc_skb(ETH_HLEN + sizeof(ACFCANPdu_t) + cfd->len + Avtp_Can_GetPad(&pdu.can), GFP_KERNEL);
-    pr_debug("ACFCAN: Allocating skb for ethernet frame: 0x%p\n", (void *)skb_eth->data);
-    if (!skb_eth)
+    if (!skb)
     {
-        printk(KERN_ERR "Failed to allocate skb\n");
-        return -ENOMEM;
+        return NULL;
     }
 
-    skb_reserve(skb_eth, ETH_HLEN);                      // Reserve space for Ethernet header
-    unsigned char *data = skb_put(skb_eth, sizeof(pdu)); // Add Headers
-    memcpy(data, (uint8_t *)&pdu, sizeof(pdu));          // Fill payload with avtp +  acf-can header
-    data = skb_put(skb_eth, cfd->len);                   // Add payload data
-    memcpy(data, (uint8_t *)cfd->data, cfd->len);        // Fill payload with avtp +  acf-can header
+    prepare_ntscf_header((Avtp_Ntscf_t *)skb->data, stage->cfg);
+    Avtp_Ntscf_SetNtscfDataLength((Avtp_Ntscf_t *)skb->data, skb->len - AVTP_NTSCF_HEADER_LEN);
 
-    data = skb_put(skb_eth, Avtp_Can_GetPad(&pdu.can)); // Add payload data
-    memset(data, 0, Avtp_Can_GetPad(&pdu.can));
+    stage->flushes[reason]++;
+    stage->frames += stage->num_frames;
+    stage->skb = NULL;
+    stage->num_frames = 0;
 
-    // Set up the Ethernet header
+    return skb;
+}
+
+static void acfcan_tx_send(struct acfcan_cfg *cfg, struct sk_buff *skb_eth)
+{
+    // Set up the Ethernet header in the reserved headroom
     struct ethhdr *eth = (struct ethhdr *)skb_push(skb_eth, sizeof(struct ethhdr));
 
     memcpy(eth->h_dest, cfg->dstmac, ETH_ALEN);
     memcpy(eth->h_source, cfg->eth_netdev->dev_addr, ETH_ALEN);
-    eth->h_proto = htons(0x22F0);
+    eth->h_proto = htons(IEEE1722_PROTO);
 
     // Set the network device
     skb_eth->dev = cfg->eth_netdev;
     skb_eth->protocol = eth->h_proto;
     skb_eth->ip_summed = CHECKSUM_NONE;
 
-    // Send the frame
+    // Send the frame, dev_queue_xmit() consumes the skb in any case
     pr_debug("ACFCAN sending ethernet frame\n");
     int ret = dev_queue_xmit(skb_eth);
     if (ret != NET_XMIT_SUCCESS)
     {
         printk(KERN_ERR "Failed to send ethernet frame: %d\n", ret);
-        kfree_skb(skb_eth);
-        return -1;
     }
+}
 
-    return 0;
+static enum hrtimer_restart acfcan_tx_deadline(struct hrtimer *timer)
+{
+    struct acfcan_tx_stage *stage = container_of(timer, struct acfcan_tx_stage, deadline);
+    struct sk_buff *skb;
+
+    // Soft hrtimers expire in softirq context, where sending is allowed
+    spin_lock(&stage->lock);
+    skb = acfcan_tx_stage_take(stage, ACFCAN_TX_FLUSH_DEADLINE);
+    spin_unlock(&stage->lock);
+
+    if (skb)
+    {
+        acfcan_tx_send(stage->cfg, skb);
+    }
+
+    return HRTIMER_NORESTART;
 }
 
-extern struct list_head acfcaninterface_list;
+int acfcan_tx_stage_alloc(struct acfcan_cfg *cfg)
+{
+    int cpu;
 
-int ieee1722_packet_handdler(struct sk_buff *skb, struct net_device *dev,
-                             struct packet_type *pt, struct net_device *orig_dev)
+    cfg->tx_stage = alloc_percpu(struct acfcan_tx_stage);
+    if (!cfg->tx_stage)
+    {
+        return -ENOMEM;
+    }
+
+    for_each_possible_cpu(cpu)
+    {
+        struct acfcan_tx_stage *stage = per_cpu_ptr(cfg->tx_stage, cpu);
+
+        memset(stage, 0, sizeof(*stage));
+        spin_lock_init(&stage->lock);
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(6, 13, 0)
+        hrtimer_setup(&stage->deadline, acfcan_tx_deadline, CLOCK_MONOTONIC, HRTIMER_MODE_REL_PINNED_SOFT);
+#else
+        hrtimer_init(&stage->deadline, CLOCK_MONOTONIC, HRTIMER_MODE_REL_PINNED_SOFT);
+        stage->deadline.function = acfcan_tx_deadline;
+#endif
+        stage->cfg = cfg;
+    }
+
+    return 0;
+}
+
+void acfcan_tx_stage_free(struct acfcan_cfg *cfg)
 {
+    uint64_t frames = 0, pdus = 0, flushes[ACFCAN_TX_FLUSH_MAX] = {0};
+    int cpu;
 
-    struct ethhdr *eth = eth_hdr(skb);
-    if (ntohs(eth->h_proto) != IEEE1722_PROTO)
+    if (!cfg->tx_stage)
     {
-        kfree_skb(skb);
-        return NET_RX_DROP;
+        return;
     }
 
-    // Ignore packets not destined for us
-    if (skb->pkt_type != PACKET_HOST && skb->pkt_type != PACKET_BROADCAST)
+    // Send the frames still staged, no more frames are queued while the device goes down
+    for_each_possible_cpu(cpu)
     {
-        kfree_skb(skb);
-        return NET_RX_DROP;
+        struct acfcan_tx_stage *stage = per_cpu_ptr(cfg->tx_stage, cpu);
+        struct sk_buff *skb;
+
+        hrtimer_cancel(&stage->deadline);
+        spin_lock_bh(&stage->lock);
+        skb = acfcan_tx_stage_take(stage, ACFCAN_TX_FLUSH_DEADLINE);
+        spin_unlock_bh(&stage->lock);
+        if (skb)
+        {
+            local_bh_disable();
+            acfcan_tx_send(cfg, skb);
+            local_bh_enable();
+        }
+
+        frames += stage->frames;
+        for (int i = 0; i < ACFCAN_TX_FLUSH_MAX; i++)
+        {
+            flushes[i] += stage->flushes[i];
+            pdus += stage->flushes[i];
+        }
     }
 
-    pr_debug("ETH Received 1722 packet: src=%pM, dst=%pM, proto=0x%04x, type %i, buf is %p with %i refs\n",
-             eth->h_source, eth->h_dest, ntohs(eth->h_proto), skb->pkt_type, (void *)skb->data, refcount_read(&skb->users));
+    pr_info("ACFCAN: %s sent %llu CAN frames in %llu NTSCF frames, flushed on count %llu mtu %llu deadline %llu\n",
+            cfg->can_netdev->name, frames, pdus, flushes[ACFCAN_TX_FLUSH_COUNT],
+            flushes[ACFCAN_TX_FLUSH_MTU], flushes[ACFCAN_TX_FLUSH_DEADLINE]);
 
-    /*
-    printk(KERN_CONT "Data: ");
-    for (int i = 0; i < skb->len; i++)
+    free_percpu(cfg->tx_stage);
+    cfg->tx_stage = NULL;
+}
+
+int forward_can_frame(struct net_device *can_dev, const struct sk_buff *skb_can)
+{
+    struct acfcan_cfg *cfg = get_acfcan_cfg(can_dev);
+    if (cfg->eth_netdev == NULL || cfg->tx_stage == NULL)
     {
-        printk(KERN_CONT "%02x ", skb->data[i]);
+        printk(KERN_INFO "No ethernet device set for ACFCAN device %s\n", can_dev->name);
+        return -1;
     }
-    printk(KERN_CONT "\n");
-    */
 
-    // Check if this is an ACF-CAN packet
-    if (skb->len < sizeof(Avtp_Ntscf_t) + sizeof(Avtp_Can_t))
+    struct canfd_frame *cfd = (struct canfd_frame *)skb_can->data;
+    uint8_t header_len = cfg->brief ? AVTP_CAN_BRIEF_HEADER_LEN : AVTP_CAN_HEADER_LEN;
+    unsigned int msg_len = header_len + round_up(cfd->len, AVTP_QUADLET_SIZE);
+    unsigned int max_len = acfcan_tx_max_len(cfg);
+    struct sk_buff *skb_full = NULL, *skb_send = NULL;
+    struct acfcan_tx_stage *stage;
+    uint8_t *data;
+
+    if (AVTP_NTSCF_HEADER_LEN + msg_len > max_len)
+    {
+        printk(KERN_ERR "ACFCAN: CAN frame does not fit into the MTU of %s\n", cfg->eth_netdev->name);
+        return -EMSGSIZE;
+    }
+
+    // Collect the ACF messages in the NTSCF frame staged on this CPU
+    stage = get_cpu_ptr(cfg->tx_stage);
+    spin_lock_bh(&stage->lock);
+
+    // A message that does not fit anymore starts the next NTSCF frame
+    if (stage->skb && stage->skb->len + msg_len > max_len)
     {
-        printk(KERN_INFO "ACFCAN short packet, %u > %li\n", skb->len, sizeof(Avtp_Ntscf_t) + sizeof(Avtp_Can_t));
-        kfree_skb(skb);
-        return NET_RX_DROP;
+        skb_full = acfcan_tx_stage_take(stage, ACFCAN_TX_FLUSH_MTU);
+    }
+    if (!stage->skb)
+    {
+        stage->skb = alloc_skb(ETH_HLEN + max_len, GFP_ATOMIC);
+        if (!stage->skb)
+        {
+            spin_unlock_bh(&stage->lock);
+            put_cpu_ptr(cfg->tx_stage);
+            printk(KERN_ERR "Failed to allocate skb\n");
+            if (skb_full)
+            {
+                acfcan_tx_send(cfg, skb_full);
+            }
+            return -ENOMEM;
+        }
+        skb_reserve(stage->skb, ETH_HLEN);           // Reserve space for Ethernet header
+        skb_put(stage->skb, AVTP_NTSCF_HEADER_LEN); // Filled in when the frame is sent
     }
 
-    Avtp_CommonHeader_t *common = (Avtp_CommonHeader_t *)skb->data;
-    if (Avtp_CommonHeader_GetSubtype(common) != AVTP_SUBTYPE_NTSCF)
+    data = skb_put(stage->skb, msg_len);
+    if (cfg->brief)
     {
-        printk(KERN_INFO "ACFCAN: Drop non NTSCF-type %i\n", Avtp_CommonHeader_GetSubtype(common));
-        kfree_skb(skb);
-        return NET_RX_DROP;
+        prepare_can_brief_header((Avtp_CanBrief_t *)data, cfg, skb_can);
     }
+    else
+    {
+        prepare_can_header((Avtp_Can_t *)data, cfg, skb_can);
+    }
+    memcpy(data + header_len, cfd->data, cfd->len);                    // Add payload data
+    memset(data + header_len + cfd->len, 0, msg_len - header_len - cfd->len); // and padding
+    stage->num_frames++;
 
-    Avtp_Ntscf_t *ntscf = (Avtp_Ntscf_t *)skb->data;
-    Avtp_Can_t *can = (Avtp_Can_t *)(skb->data + sizeof(Avtp_Ntscf_t));
+    if (stage->num_frames >= cfg->tx_max_frames)
+    {
+        skb_send = acfcan_tx_stage_take(stage, ACFCAN_TX_FLUSH_COUNT);
+        // A deadline that already fires finds the stage empty or sends the next frame early
+        hrtimer_try_to_cancel(&stage->deadline);
+    }
+    else if (stage->num_frames == 1 && cfg->tx_deadline_us)
+    {
+        hrtimer_start(&stage->deadline, us_to_ktime(cfg->tx_deadline_us), HRTIMER_MODE_REL_PINNED_SOFT);
+    }
 
-    // This is bytes, not quadlets
-    uint16_t msg_length = Avtp_Ntscf_GetNtscfDataLength(ntscf);
+    spin_unlock_bh(&stage->lock);
+    put_cpu_ptr(cfg->tx_stage);
 
-    // seq_num = Avtp_Ntscf_GetSequenceNum((Avtp_Ntscf_t*)cf_pdu);
-    if (msg_length > skb->len - sizeof(Avtp_Ntscf_t))
+    if (skb_full)
     {
-        printk(KERN_INFO "ACFCAN: Drop short packet. NTSCF length %i, packet bytes: %li\n", msg_length, skb->len - sizeof(Avtp_Ntscf_t));
-        kfree_skb(skb);
-        return NET_RX_DROP;
+        acfcan_tx_send(cfg, skb_full);
+    }
+    if (skb_send)
+    {
+        acfcan_tx_send(cfg, skb_send);
     }
 
-    uint64_t stream_id = Avtp_Ntscf_GetStreamId(ntscf);
-    uint8_t busid = Avtp_Can_GetCanBusId(can);
+    return 0;
+}
+
+// Parses the ACF CAN or ACF CAN Brief message at acf, with len bytes of stream
+// data left. Returns the length of the message in bytes, or -1 if it is not a
+// valid CAN message within the stream data.
+static int acfcan_parse_msg(uint8_t *acf, uint16_t len, Avtp_CanHeader_t *header,
+                            uint8_t *header_len, uint16_t *payload_len)
+{
+    Avtp_CanBriefHeader_t brief;
 
-    pr_debug("ACFCAN: Received valid ACFCAN packet, stream_id=%016llx, busid=%i , msg_length=%i on %s\n", stream_id, busid, msg_length, dev->name);
+    // ACF CAN Brief messages are the shortest
+    if (len < AVTP_CAN_BRIEF_HEADER_LEN)
+    {
+        net_dbg_ratelimited("ACFCAN: Drop truncated ACF message, %i bytes left\n", len);
+        return -1;
+    }
 
-    // Iterate over all active devices
-    struct list_head *pos = NULL;
-    struct acfcan_cfg *cfg = NULL;
-    struct net_device *can_dev = NULL;
-    list_for_each(pos, &acfcaninterface_list)
+    // ACF CAN and ACF CAN Brief messages are told apart by their type
+    switch (Avtp_AcfCommon_GetAcfMsgType((Avtp_AcfCommon_t *)acf))
     {
-        cfg = list_entry(pos, struct acfcan_cfg, list);
-        if (cfg->rx_streamid == stream_id && cfg->canbusId == busid && strcmp(cfg->ethif, dev->name) == 0)
+    case AVTP_ACF_TYPE_CAN:
+        if (len < AVTP_CAN_HEADER_LEN)
         {
-            pr_debug("ACFCAN Found match, if=%s, stream=%016llx, busid %i\n", cfg->ethif, cfg->rx_streamid, cfg->canbusId);
-            can_dev = cfg->can_netdev;
-            break; // Only first match
+            net_dbg_ratelimited("ACFCAN: Drop truncated ACF CAN message, %i bytes left\n", len);
+            return -1;
         }
+        Avtp_Can_Unpack((Avtp_Can_t *)acf, header);
+        *header_len = AVTP_CAN_HEADER_LEN;
+        break;
+    case AVTP_ACF_TYPE_CAN_BRIEF:
+        Avtp_CanBrief_Unpack((Avtp_CanBrief_t *)acf, &brief);
+        memset(header, 0, sizeof(*header));
+        header->acf_msg_length = brief.acf_msg_length;
+        header->pad = brief.pad;
+        header->rtr = brief.rtr;
+        header->eff = brief.eff;
+        header->brs = brief.brs;
+        header->fdf = brief.fdf;
+        header->esi = brief.esi;
+        header->can_bus_id = brief.can_bus_id;
+        header->can_identifier = brief.can_identifier;
+        *header_len = AVTP_CAN_BRIEF_HEADER_LEN;
+        break;
+    default:
+        net_dbg_ratelimited("ACFCAN: Drop unsupported ACF message type %i\n", Avtp_AcfCommon_GetAcfMsgType((Avtp_AcfCommon_t *)acf));
+        return -1;
     }
 
-    if (can_dev == NULL)
+    // The message and its payload must lie within the stream data
+    uint16_t acf_msg_length = header->acf_msg_length * AVTP_QUADLET_SIZE;
+    if (acf_msg_length < *header_len + header->pad || acf_msg_length > len)
     {
-        printk(KERN_WARNING "No receiving ACFCAN for stream=%016llx, busid %i\n", stream_id, busid);
-        kfree_skb(skb);
-        return NET_RX_DROP;
+        net_dbg_ratelimited("ACFCAN: Drop invalid ACF message length %i, %i bytes left\n", acf_msg_length, len);
+        return -1;
+    }
+    *payload_len = acf_msg_length - *header_len - header->pad;
+
+    if (header->fdf && *payload_len > CANFD_MAX_DLEN)
+    {
+        net_dbg_ratelimited("ACFCAN: Drop ACF CAN message, DLC too large for CAN FD\n");
+        return -1;
+    }
+    else if (!header->fdf && *payload_len > CAN_MAX_DLEN)
+    {
+        net_dbg_ratelimited("ACFCAN: Drop ACF CAN message, DLC too large for CAN\n");
+        return -1;
     }
 
-    uint8_t is_fd = Avtp_Can_GetFdf(can);
+    return acf_msg_length;
+}
+
+// Allocates the CAN skb for a received ACF CAN message on can_dev
+static struct sk_buff *acfcan_alloc_can_skb(struct net_device *can_dev, const Avtp_CanHeader_t *header,
+                                            const uint8_t *payload, uint16_t payload_len)
+{
     struct sk_buff *can_skb;
     struct can_frame *cf;
     struct canfd_frame *cfd;
 
-    int err;
-
-    // Allocate a CAN skb
-    if (is_fd)
+    if (header->fdf)
     {
         pr_debug("ACFCAN: Allocating CAN FD skb\n");
         can_skb = alloc_canfd_skb(can_dev, &cfd);
@@ -290,77 +461,253 @@ int ieee1722_packet_handdler(struct sk_buff *skb, struct net_device *dev,
     }
     if (!can_skb)
     {
-        printk(KERN_ERR "Failed to allocate CAN skb\n");
-        kfree_skb(skb);
-        return NET_RX_DROP;
+        return NULL;
     }
 
-    cf->can_id = Avtp_Can_GetCanIdentifier(can);
-    if (Avtp_Can_GetEff(can))
+    cf->can_id = header->can_identifier;
+    if (header->eff)
     {
         cf->can_id |= CAN_EFF_FLAG;
     }
-    if (Avtp_Can_GetRtr(can))
+    if (header->rtr)
     {
         cf->can_id |= CAN_RTR_FLAG;
     }
 
-    if (is_fd)
+    if (header->fdf)
     {
-        cfd->flags = 0;
-        if (Avtp_Can_GetBrs(can))
+        cfd->flags = CANFD_FDF;
+        if (header->brs)
         {
             cfd->flags |= CANFD_BRS;
         }
-        if (Avtp_Can_GetFdf(can))
-        {
-            cfd->flags |= CANFD_FDF;
-        }
-        if (Avtp_Can_GetEsi(can))
+        if (header->esi)
         {
             cfd->flags |= CANFD_ESI;
         }
-        cfd->len = msg_length - AVTP_CAN_HEADER_LEN - Avtp_Can_GetPad(can);
+        cfd->len = payload_len;
+        memcpy(cfd->data, payload, cfd->len);
     }
     else
     {
-        cf->len = msg_length - AVTP_CAN_HEADER_LEN - Avtp_Can_GetPad(can);
+        cf->len = payload_len;
+        memcpy(cf->data, payload, cf->len);
     }
 
-    if (is_fd && cfd->len > CANFD_MAX_DLEN)
+    can_skb->cb[SKB_CB_LOCATION] |= SKB_CB_MINE; // Mark the skb as our own
+    return can_skb;
+}
+
+// Drops a received frame that is malformed or not an ACF CAN stream. Anyone on
+// the link can send those, so they are counted on the receiving ethernet
+// device and only logged as rate limited debug messages.
+static int ieee1722_rx_drop(struct sk_buff *skb, struct net_device *dev)
+{
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(5, 18, 0)
+    dev_core_stats_rx_dropped_inc(dev);
+#else
+    atomic_long_inc(&dev->rx_dropped);
+#endif
+    kfree_skb(skb);
+    return NET_RX_DROP;
+}
+
+int ieee1722_packet_handdler(struct sk_buff *skb, struct net_device *dev,
+                             struct packet_type *pt, struct net_device *orig_dev)
+{
+
+    struct ethhdr *eth = eth_hdr(skb);
+    if (ntohs(eth->h_proto) != IEEE1722_PROTO)
     {
-        printk(KERN_ERR "DLC too large for CAN FD\n");
         kfree_skb(skb);
         return NET_RX_DROP;
     }
-    else if (!is_fd && cf->len > CAN_MAX_DLEN)
+
+    // Ignore packets not destined for us
+    if (skb->pkt_type != PACKET_HOST && skb->pkt_type != PACKET_BROADCAST)
     {
-        printk(KERN_ERR "DLC too large for CAN\n");
         kfree_skb(skb);
         return NET_RX_DROP;
     }
 
-    if (is_fd)
+    pr_debug("ETH Received 1722 packet: src=%pM, dst=%pM, proto=0x%04x, type %i, buf is %p with %i refs\n",
+             eth->h_source, eth->h_dest, ntohs(eth->h_proto), skb->pkt_type, (void *)skb->data, refcount_read(&skb->users));
+
+    /*
+    printk(KERN_CONT "Data: ");
+    for (int i = 0; i < skb->len; i++)
+    {
+        printk(KERN_CONT "%02x ", skb->data[i]);
+    }
+    printk(KERN_CONT "\n");
+    */
+
+    // The headers and the ACF messages may sit in paged fragments, they are
+    // pulled into the linear area before parsing. Pulling changes the skb,
+    // so it must not be shared.
+    skb = skb_share_check(skb, GFP_ATOMIC);
+    if (!skb)
+    {
+        return NET_RX_DROP;
+    }
+
+    if (!pskb_may_pull(skb, AVTP_COMMON_HEADER_LEN))
     {
-        memcpy(cfd->data, skb->data + sizeof(Avtp_Ntscf_t) + sizeof(Avtp_Can_t), cfd->len);
+        net_dbg_ratelimited("ACFCAN short packet, %u < %i\n", skb->len, AVTP_COMMON_HEADER_LEN);
+        return ieee1722_rx_drop(skb, dev);
+    }
+
+    // Both NTSCF and TSCF frames carry ACF messages
+    Avtp_CommonHeader_t *common = (Avtp_CommonHeader_t *)skb->data;
+    uint8_t subtype = Avtp_CommonHeader_GetSubtype(common);
+    unsigned int pdu_header_len;
+
+    if (subtype == AVTP_SUBTYPE_NTSCF)
+    {
+        pdu_header_len = AVTP_NTSCF_HEADER_LEN;
+    }
+    else if (subtype == AVTP_SUBTYPE_TSCF)
+    {
+        pdu_header_len = AVTP_TSCF_HEADER_LEN;
     }
     else
     {
-        memcpy(cf->data, skb->data + sizeof(Avtp_Ntscf_t) + sizeof(Avtp_Can_t), cf->len);
+        net_dbg_ratelimited("ACFCAN: Drop non NTSCF or TSCF-type %i\n", subtype);
+        return ieee1722_rx_drop(skb, dev);
     }
 
-    can_skb->cb[SKB_CB_LOCATION] |= SKB_CB_MINE; // Mark the skb as our own
-    // Send the CAN skb, disable loop (otherwise the module would receive and forward
-    // it's own frame)
-    // TODO: Do we need to free can_skb?
-    err = can_send(can_skb, 1);
-    if (err)
+    if (!pskb_may_pull(skb, pdu_header_len))
     {
-        printk(KERN_ERR "Failed to send CAN skb: %d\n", err);
-        kfree_skb(skb);
-        return NET_RX_DROP;
+        net_dbg_ratelimited("ACFCAN short packet, %u < %u\n", skb->len, pdu_header_len);
+        return ieee1722_rx_drop(skb, dev);
+    }
+
+    uint64_t stream_id;
+    uint8_t seq_num;
+    uint16_t data_len; // This is bytes, not quadlets
+
+    if (subtype == AVTP_SUBTYPE_NTSCF)
+    {
+        Avtp_Ntscf_t *ntscf = (Avtp_Ntscf_t *)skb->data;
+        stream_id = Avtp_Ntscf_GetStreamId(ntscf);
+        seq_num = Avtp_Ntscf_GetSequenceNum(ntscf);
+        data_len = Avtp_Ntscf_GetNtscfDataLength(ntscf);
+    }
+    else
+    {
+        // The presentation time is not used, frames are delivered when received
+        Avtp_Tscf_t *tscf = (Avtp_Tscf_t *)skb->data;
+        stream_id = Avtp_Tscf_GetStreamId(tscf);
+        seq_num = Avtp_Tscf_GetSequenceNum(tscf);
+        data_len = Avtp_Tscf_GetStreamDataLength(tscf);
+    }
+
+    if (data_len > skb->len - pdu_header_len)
+    {
+        net_dbg_ratelimited("ACFCAN: Drop short packet. Stream data length %i, packet bytes: %u\n", data_len, skb->len - pdu_header_len);
+        return ieee1722_rx_drop(skb, dev);
+    }
+    if (data_len == 0)
+    {
+        net_dbg_ratelimited("ACFCAN: Drop packet without ACF message\n");
+        return ieee1722_rx_drop(skb, dev);
+    }
+
+    if (!pskb_may_pull(skb, pdu_header_len + data_len))
+    {
+        net_dbg_ratelimited("ACFCAN: Drop packet, cannot pull %u bytes\n", pdu_header_len + data_len);
+        return ieee1722_rx_drop(skb, dev);
+    }
+
+    // skb->data may have moved while pulling
+    uint8_t *acf = skb->data + pdu_header_len;
+    struct sk_buff_head frames;
+    struct sk_buff *can_skb;
+    struct acfcan_cfg *rx_cfg = NULL;
+    int rx_busid = -1;
+    bool counted = false;
+    unsigned int unrouted = 0;
+    uint16_t offset = 0;
+
+    __skb_queue_head_init(&frames);
+
+    // Convert all messages first, so a malformed frame is dropped as a whole.
+    // Packet handlers run within an RCU read side critical section, which
+    // keeps the receiving devices valid until we are done.
+    while (offset < data_len)
+    {
+        Avtp_CanHeader_t header;
+        uint8_t header_len;
+        uint16_t payload_len;
+        int len = acfcan_parse_msg(acf + offset, data_len - offset, &header, &header_len, &payload_len);
+
+        if (len < 0)
+        {
+            __skb_queue_purge(&frames);
+            return ieee1722_rx_drop(skb, dev);
+        }
+
+        pr_debug("ACFCAN: Received ACF CAN message, stream_id=%016llx, busid=%i, msg_length=%i on %s\n", stream_id, header.can_bus_id, len, dev->name);
+
+        // Consecutive messages usually go to the same bus
+        if (header.can_bus_id != rx_busid)
+        {
+            rx_cfg = acfcan_streams_lookup(dev, stream_id, header.can_bus_id);
+            rx_busid = header.can_bus_id;
+        }
+
+        if (rx_cfg == NULL)
+        {
+            unrouted++;
+        }
+        else
+        {
+            // All devices of the stream share its sequence number statistics
+            if (!counted)
+            {
+                acfcan_streams_count_seq(rx_cfg, seq_num);
+                counted = true;
+            }
+
+            can_skb = acfcan_alloc_can_skb(rx_cfg->can_netdev, &header, acf + offset + header_len, payload_len);
+            if (!can_skb)
+            {
+                printk(KERN_ERR "Failed to allocate CAN skb\n");
+                __skb_queue_purge(&frames);
+                kfree_skb(skb);
+                return NET_RX_DROP;
+            }
+            __skb_queue_tail(&frames, can_skb);
+        }
+
+        offset += len;
     }
 
     kfree_skb(skb);
-    return NET_RX_SUCCESS;
+
+    if (unrouted)
+    {
+        // Foreign streams on a shared link would log every frame otherwise
+        pr_warn_ratelimited("No receiving ACFCAN for stream=%016llx, dropped %u of its CAN frames\n", stream_id, unrouted);
+    }
+    if (skb_queue_empty(&frames))
+    {
+        return NET_RX_DROP;
+    }
+
+    // Send the CAN skbs in their order in the frame. Loop them back (otherwise
+    // the module would receive and forward its own frames). can_send() frees
+    // the skb on errors as well.
+    int ret = NET_RX_SUCCESS;
+    while ((can_skb = __skb_dequeue(&frames)) != NULL)
+    {
+        int err = can_send(can_skb, 1);
+        if (err)
+        {
+            printk(KERN_ERR "Failed to send CAN skb: %d\n", err);
+            ret = NET_RX_DROP;
+        }
+    }
+
+    return ret;
 }
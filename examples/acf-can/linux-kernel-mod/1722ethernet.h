@@ -44,22 +44,26 @@
 #include "acfcandev.h"
 
 #include "avtp/acf/Ntscf.h"
+#include "avtp/acf/Tscf.h"
 #include "avtp/acf/Can.h"
+#include "avtp/acf/CanBrief.h"
 #include "avtp/CommonHeader.h"
 
 #define CAN_PAYLOAD_LEN 64
-typedef struct
-{
-    // IEEE 1722 NTSCF header
-    Avtp_Ntscf_t ntscf;
-    // IEEE 1722 ACF message #1
-    Avtp_Can_t can;
-} __attribute__((packed)) ACFCANPdu_t;
+
+// The NTSCF data length field has 11 bits and counts whole quadlets of ACF messages
+#define ACFCAN_NTSCF_MAX_DATA_LEN (0x7ff & ~(AVTP_QUADLET_SIZE - 1))
 
 void prepare_ntscf_header(Avtp_Ntscf_t *ntscf_header, struct acfcan_cfg *cfg);
 void prepare_can_header(Avtp_Can_t *can_header, struct acfcan_cfg *cfg, const struct sk_buff *skb);
-void calculate_and_set_ntscf_size(ACFCANPdu_t *pdu);
+void prepare_can_brief_header(Avtp_CanBrief_t *can_header, struct acfcan_cfg *cfg, const struct sk_buff *skb);
+
+// Per-CPU staging of the sent NTSCF frames of a device, see forward_can_frame()
+int acfcan_tx_stage_alloc(struct acfcan_cfg *cfg);
+void acfcan_tx_stage_free(struct acfcan_cfg *cfg);
 
+// Adds a CAN frame to the NTSCF frame staged on this CPU, which is sent when it holds
+// tx_max_frames messages, the next message exceeds the MTU or tx_deadline_us expired
 int forward_can_frame(struct net_device *can_dev, const struct sk_buff *skb);
 
 int ieee1722_packet_handdler(struct sk_buff *skb, struct net_device *dev,
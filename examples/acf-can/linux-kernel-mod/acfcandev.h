@@ -41,9 +41,14 @@
 #pragma once
 
 #include <linux/types.h>
+#include <linux/atomic.h>
+#include <linux/hrtimer.h>
+#include <linux/spinlock.h>
+#include <linux/rcupdate.h>
 #include <linux/can/can-ml.h>
 #include <net/net_trackers.h>
-#include <linux/list.h>
+
+#include "avtp/SeqTracker.h"
 
 #define IEEE1722_PROTO 0x22f0
 
@@ -56,16 +61,66 @@
 #define SKB_CB_LOCATION 4
 #define SKB_CB_MINE (1 << 7)
 
+// log2 of the number of buckets of the tables of the receiving devices and streams
+#define ACFCAN_RX_HASH_BITS 10
+
+// Max. number of ACF messages per sent NTSCF frame, as accepted by the user space listeners
+#define ACFCAN_TX_MAX_FRAMES 15
+// Larger tx_deadline_us settings are clamped to this
+#define ACFCAN_TX_MAX_DEADLINE_US 1000000
+// The bus ID of ACF CAN messages is 5 bits wide
+#define ACFCAN_MAX_BUSID 31
+
+// Reasons for sending a staged NTSCF frame
+enum acfcan_tx_flush
+{
+    ACFCAN_TX_FLUSH_COUNT = 0, // tx_max_frames messages are staged
+    ACFCAN_TX_FLUSH_MTU,       // the next message would exceed the MTU
+    ACFCAN_TX_FLUSH_DEADLINE,  // tx_deadline_us expired or the device goes down
+    ACFCAN_TX_FLUSH_MAX
+};
+
+struct acfcan_cfg;
+
+/* NTSCF frame a device is filling on one CPU */
+struct acfcan_tx_stage
+{
+    spinlock_t lock;
+    struct sk_buff *skb;     // staged frame with headroom for the Ethernet header, NULL if none
+    __u8 num_frames;         // ACF messages in skb
+    struct hrtimer deadline; // sends skb tx_deadline_us after its first message
+    struct acfcan_cfg *cfg;
+    __u64 frames;            // sent CAN frames
+    __u64 flushes[ACFCAN_TX_FLUSH_MAX];
+};
+
+/* Stream received on an ethernet device, shared by the devices receiving it */
+struct acfcan_rx_stream
+{
+    struct hlist_node node;
+    int ifindex;
+    __u64 stream_id;
+    unsigned int users;     // devices receiving the stream
+    spinlock_t lock;        // protects seq
+    Avtp_SeqTracker_t seq;
+};
+
 /* Private per-device configuration */
 struct acfcan_cfg
 {
-    struct list_head list; // we need a list so we can map received ethernet packets
+    struct hlist_node rx_node;           // in the table of the receiving devices while up
+    struct acfcan_rx_stream *rx_stream;  // set while up
+    int rx_ifindex;                      // of eth_netdev while up
     __u8 dstmac[6];        // send acf-can frames to this mac
     __u64 rx_streamid;     // listen to this acf-can stream-id
     __u64 tx_streamid;     // send acf-can frames with this stream-id
     __u8 flags;
-    __u8 sequenceNum;
+    atomic_t sequenceNum;  // of the sent ntscf frames, only the low 8 bits are used
     __u8 canbusId;
+    __u8 brief;            // send acf-can brief messages without timestamp
+    __u8 tx_max_frames;    // send up to this many acf-can messages per ntscf frame
+    __u32 tx_deadline_us;  // max. time a can frame waits for more frames, 0 waits for tx_max_frames
+    struct acfcan_tx_stage __percpu *tx_stage; // allocated while the device is up
     char ethif[IFNAMSIZ];
     struct net_device *eth_netdev; // this is the eth if used for sending and receiving
     struct net_device *can_netdev; // this is the (virtual) can if
@@ -74,3 +129,11 @@ struct acfcan_cfg
 
 // get the acfcan_cfg struct from the device
 #define get_acfcan_cfg(dev) ((struct acfcan_cfg *)((char *)(can_get_ml_priv(dev)) + sizeof(struct can_ml_priv)))
+
+// Maps received streams to the devices listening to them. The lookup is
+// lock-free and must be called within an RCU read side critical section.
+int acfcan_streams_add(struct acfcan_cfg *cfg);
+void acfcan_streams_remove(struct acfcan_cfg *cfg);
+struct acfcan_cfg *acfcan_streams_lookup(const struct net_device *eth_dev, uint64_t stream_id,
+                                         uint8_t busid);
+void acfcan_streams_count_seq(struct acfcan_cfg *cfg, uint8_t seq_num);
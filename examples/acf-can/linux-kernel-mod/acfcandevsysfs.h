@@ -39,6 +39,7 @@
 
 #pragma once
 
+#include <linux/kernel.h>
 #include <linux/sysfs.h>
 
 #define NOCHANGE_IF_UP(what) ({                                                                       \
@@ -193,10 +194,10 @@ static ssize_t busid_store(struct device *dev, struct device_attribute *attr, co
 	struct acfcan_cfg *cfg = get_acfcan_cfg(net_dev);
 
 	__u8 busid;
-	int rc = sscanf(buf, "%hhu", &busid);
-	if (!rc)
+	int rc = kstrtou8(buf, 10, &busid);
+	if (rc || busid > ACFCAN_MAX_BUSID)
 	{
-		printk(KERN_WARNING "ACFCAN: Invalid bus id\n");
+		printk(KERN_WARNING "ACFCAN: Invalid bus id, use 0 to %i\n", ACFCAN_MAX_BUSID);
 		return -EINVAL;
 	}
 
@@ -206,6 +207,88 @@ static ssize_t busid_store(struct device *dev, struct device_attribute *attr, co
 	return count;
 }
 
+static ssize_t brief_store(struct device *dev, struct device_attribute *attr, const char *buf, size_t count)
+{
+	if (count == 1 && *buf == '\n')
+	{
+		return 1;
+	}
+
+	struct net_device *net_dev = to_net_dev(dev);
+
+	NOCHANGE_IF_UP("brief");
+
+	struct acfcan_cfg *cfg = get_acfcan_cfg(net_dev);
+
+	__u8 brief;
+	int rc = kstrtou8(buf, 10, &brief);
+	if (rc || brief > 1)
+	{
+		printk(KERN_WARNING "ACFCAN: Invalid brief setting, use 0 or 1\n");
+		return -EINVAL;
+	}
+
+	cfg->brief = brief;
+
+	pr_debug("ACFCAN setting brief to %u for %s\n", brief, net_dev->name);
+	return count;
+}
+
+static ssize_t tx_max_frames_store(struct device *dev, struct device_attribute *attr, const char *buf, size_t count)
+{
+	if (count == 1 && *buf == '\n')
+	{
+		return 1;
+	}
+
+	struct net_device *net_dev = to_net_dev(dev);
+
+	NOCHANGE_IF_UP("tx max frames");
+
+	struct acfcan_cfg *cfg = get_acfcan_cfg(net_dev);
+
+	__u8 tx_max_frames;
+	int rc = kstrtou8(buf, 10, &tx_max_frames);
+	if (rc || tx_max_frames < 1 || tx_max_frames > ACFCAN_TX_MAX_FRAMES)
+	{
+		printk(KERN_WARNING "ACFCAN: Invalid number of frames per TX frame, use 1 to %i\n", ACFCAN_TX_MAX_FRAMES);
+		return -EINVAL;
+	}
+
+	cfg->tx_max_frames = tx_max_frames;
+
+	pr_debug("ACFCAN setting tx_max_frames to %u for %s\n", tx_max_frames, net_dev->name);
+	return count;
+}
+
+static ssize_t tx_deadline_us_store(struct device *dev, struct device_attribute *attr, const char *buf, size_t count)
+{
+	if (count == 1 && *buf == '\n')
+	{
+		return 1;
+	}
+
+	struct net_device *net_dev = to_net_dev(dev);
+
+	NOCHANGE_IF_UP("tx deadline");
+
+	struct acfcan_cfg *cfg = get_acfcan_cfg(net_dev);
+
+	__u32 tx_deadline_us;
+	int rc = kstrtou32(buf, 10, &tx_deadline_us);
+	if (rc)
+	{
+		printk(KERN_WARNING "ACFCAN: Invalid TX deadline\n");
+		return -EINVAL;
+	}
+
+	// The deadline becomes an hrtimer period, keep it reasonable
+	cfg->tx_deadline_us = min_t(__u32, tx_deadline_us, ACFCAN_TX_MAX_DEADLINE_US);
+
+	pr_debug("ACFCAN setting tx_deadline_us to %u for %s\n", cfg->tx_deadline_us, net_dev->name);
+	return count;
+}
+
 static ssize_t rx_streamid_show(struct device *dev, struct device_attribute *attr, char *buf)
 {
 	struct net_device *net_dev = to_net_dev(dev);
@@ -230,11 +313,38 @@ static ssize_t busid_show(struct device *dev, struct device_attribute *attr, cha
 	return sprintf(buf, "%i", cfg->canbusId);
 }
 
+static ssize_t tx_max_frames_show(struct device *dev, struct device_attribute *attr, char *buf)
+{
+	struct net_device *net_dev = to_net_dev(dev);
+	struct acfcan_cfg *cfg = get_acfcan_cfg(net_dev);
+
+	return sprintf(buf, "%i", cfg->tx_max_frames);
+}
+
+static ssize_t tx_deadline_us_show(struct device *dev, struct device_attribute *attr, char *buf)
+{
+	struct net_device *net_dev = to_net_dev(dev);
+	struct acfcan_cfg *cfg = get_acfcan_cfg(net_dev);
+
+	return sprintf(buf, "%u", cfg->tx_deadline_us);
+}
+
+static ssize_t brief_show(struct device *dev, struct device_attribute *attr, char *buf)
+{
+	struct net_device *net_dev = to_net_dev(dev);
+	struct acfcan_cfg *cfg = get_acfcan_cfg(net_dev);
+
+	return sprintf(buf, "%i", cfg->brief);
+}
+
 static DEVICE_ATTR_RW(dstmac);
 static DEVICE_ATTR_RW(ethif);
 static DEVICE_ATTR_RW(rx_streamid);
 static DEVICE_ATTR_RW(tx_streamid);
 static DEVICE_ATTR_RW(busid);
+static DEVICE_ATTR_RW(brief);
+static DEVICE_ATTR_RW(tx_max_frames);
+static DEVICE_ATTR_RW(tx_deadline_us);
 
 static struct attribute *dev_attrs[] = {
 	&dev_attr_dstmac.attr,
@@ -242,6 +352,9 @@ static struct attribute *dev_attrs[] = {
 	&dev_attr_tx_streamid.attr,
 	&dev_attr_rx_streamid.attr,
 	&dev_attr_busid.attr,
+	&dev_attr_brief.attr,
+	&dev_attr_tx_max_frames.attr,
+	&dev_attr_tx_deadline_us.attr,
 	NULL, /* NULL-terminated list */
 };
 
@@ -47,7 +47,11 @@
 #include <linux/can.h>
 #include <linux/can/can-ml.h>
 #include <linux/can/dev.h>
-#include <linux/list.h>
+#include <linux/spinlock.h>
+#include <linux/mutex.h>
+#include <linux/hashtable.h>
+#include <linux/jhash.h>
+#include <linux/slab.h>
 
 #include <linux/can/skb.h>
 #include <net/rtnetlink.h>
@@ -63,7 +67,128 @@ char *version = "2016";
 
 static struct packet_type ieee1722_packet_type;
 
-LIST_HEAD(acfcaninterface_list);
+// Devices receiving a stream on an ethernet device with a bus ID, see
+// acfcan_streams_lookup(). Readers only hold the RCU read lock, changes are
+// serialized by acfcan_streams_lock.
+static DEFINE_HASHTABLE(acfcan_rx_devices, ACFCAN_RX_HASH_BITS);
+// Streams received by the devices, only used with acfcan_streams_lock held
+static DEFINE_HASHTABLE(acfcan_rx_streams, ACFCAN_RX_HASH_BITS);
+static DEFINE_MUTEX(acfcan_streams_lock);
+
+static u32 acfcan_rx_device_key(int ifindex, uint64_t stream_id, uint8_t busid)
+{
+	return jhash_3words((u32)stream_id, (u32)(stream_id >> 32),
+			    ((u32)ifindex << 8) | busid, 0);
+}
+
+static u32 acfcan_rx_stream_key(int ifindex, uint64_t stream_id)
+{
+	return jhash_3words((u32)stream_id, (u32)(stream_id >> 32), (u32)ifindex, 0);
+}
+
+int acfcan_streams_add(struct acfcan_cfg *cfg)
+{
+	int ifindex = cfg->eth_netdev->ifindex;
+	u32 stream_key = acfcan_rx_stream_key(ifindex, cfg->rx_streamid);
+	u32 device_key = acfcan_rx_device_key(ifindex, cfg->rx_streamid, cfg->canbusId);
+	struct acfcan_rx_stream *stream;
+	struct acfcan_cfg *other;
+
+	mutex_lock(&acfcan_streams_lock);
+	hash_for_each_possible(acfcan_rx_devices, other, rx_node, device_key)
+	{
+		if (other->rx_ifindex == ifindex && other->rx_streamid == cfg->rx_streamid &&
+		    other->canbusId == cfg->canbusId)
+		{
+			mutex_unlock(&acfcan_streams_lock);
+			return -EEXIST;
+		}
+	}
+
+	hash_for_each_possible(acfcan_rx_streams, stream, node, stream_key)
+	{
+		if (stream->ifindex == ifindex && stream->stream_id == cfg->rx_streamid)
+			break;
+	}
+	if (!stream)
+	{
+		stream = kzalloc(sizeof(*stream), GFP_KERNEL);
+		if (!stream)
+		{
+			mutex_unlock(&acfcan_streams_lock);
+			return -ENOMEM;
+		}
+		stream->ifindex = ifindex;
+		stream->stream_id = cfg->rx_streamid;
+		spin_lock_init(&stream->lock);
+		Avtp_SeqTracker_Init(&stream->seq);
+		hash_add(acfcan_rx_streams, &stream->node, stream_key);
+	}
+	stream->users++;
+
+	cfg->rx_stream = stream;
+	cfg->rx_ifindex = ifindex;
+	hash_add_rcu(acfcan_rx_devices, &cfg->rx_node, device_key);
+	mutex_unlock(&acfcan_streams_lock);
+
+	return 0;
+}
+
+void acfcan_streams_remove(struct acfcan_cfg *cfg)
+{
+	struct acfcan_rx_stream *stream = cfg->rx_stream;
+
+	if (!stream)
+		return;
+
+	mutex_lock(&acfcan_streams_lock);
+	hash_del_rcu(&cfg->rx_node);
+	if (--stream->users == 0)
+		hash_del(&stream->node);
+	else
+		stream = NULL;
+	mutex_unlock(&acfcan_streams_lock);
+
+	// Receivers may still use cfg and its stream, their configuration
+	// must not change before they are done
+	synchronize_rcu();
+	cfg->rx_stream = NULL;
+
+	if (stream)
+	{
+		pr_info("ACFCAN: Stream %016llx received %llu lost %llu reordered %llu duplicates %llu late %llu\n",
+			stream->stream_id, stream->seq.stats.received, stream->seq.stats.lost,
+			stream->seq.stats.reordered, stream->seq.stats.duplicates,
+			stream->seq.stats.late);
+		kfree(stream);
+	}
+}
+
+struct acfcan_cfg *acfcan_streams_lookup(const struct net_device *eth_dev, uint64_t stream_id,
+					 uint8_t busid)
+{
+	struct acfcan_cfg *cfg;
+
+	hash_for_each_possible_rcu(acfcan_rx_devices, cfg, rx_node,
+				   acfcan_rx_device_key(eth_dev->ifindex, stream_id, busid))
+	{
+		if (cfg->rx_ifindex == eth_dev->ifindex && cfg->rx_streamid == stream_id &&
+		    cfg->canbusId == busid)
+			return cfg;
+	}
+
+	return NULL;
+}
+
+void acfcan_streams_count_seq(struct acfcan_cfg *cfg, uint8_t seq_num)
+{
+	struct acfcan_rx_stream *stream = cfg->rx_stream;
+
+	// Counted only, the statistics are printed when the stream is removed
+	spin_lock(&stream->lock);
+	Avtp_SeqTracker_Update(&stream->seq, seq_num);
+	spin_unlock(&stream->lock);
+}
 
 static void acfcan_rx(struct sk_buff *skb, struct net_device *dev)
 {
@@ -161,6 +286,7 @@ static int acfcan_up(struct net_device *dev)
 
 	// chek we have an a valid ethernet device
 	struct net_device *ethif;
+	int err;
 
 	ethif = netdev_get_by_name(&init_net, cfg->ethif, &cfg->tracker, GFP_KERNEL);
 
@@ -172,20 +298,40 @@ static int acfcan_up(struct net_device *dev)
 
 	cfg->eth_netdev = ethif;
 
-	list_add(&cfg->list, &acfcaninterface_list);
+	err = acfcan_streams_add(cfg);
+	if (err)
+	{
+		if (err == -EEXIST)
+			printk(KERN_WARNING "ACFCAN Stream 0x%llX bus-id %i on %s is already received\n",
+			       cfg->rx_streamid, cfg->canbusId, cfg->ethif);
+		netdev_put(ethif, &cfg->tracker);
+		cfg->eth_netdev = NULL;
+		return err;
+	}
+
+	if (acfcan_tx_stage_alloc(cfg))
+	{
+		printk(KERN_WARNING "ACFCAN Can not allocate TX staging for %s\n", dev->name);
+		acfcan_streams_remove(cfg);
+		netdev_put(ethif, &cfg->tracker);
+		cfg->eth_netdev = NULL;
+		return -ENOMEM;
+	}
 
-	printk(KERN_INFO "ACFCAN interface %s on %s up.  TX-streamid 0x%llX, RX-streamid 0x%0llX, bus-id %i.\n", dev->name, cfg->ethif, cfg->tx_streamid, cfg->rx_streamid, cfg->canbusId);
+	printk(KERN_INFO "ACFCAN interface %s on %s up.  TX-streamid 0x%llX, RX-streamid 0x%0llX, bus-id %i, up to %i frames per TX frame, TX deadline %u us.\n", dev->name, cfg->ethif, cfg->tx_streamid, cfg->rx_streamid, cfg->canbusId, cfg->tx_max_frames, cfg->tx_deadline_us);
 	return 0;
 }
 
 static int acfcan_down(struct net_device *dev)
 {
 	struct acfcan_cfg *cfg = get_acfcan_cfg(dev);
+	acfcan_tx_stage_free(cfg);
+	acfcan_streams_remove(cfg);
 	if (cfg->eth_netdev)
 	{
 		netdev_put(cfg->eth_netdev, &cfg->tracker);
+		cfg->eth_netdev = NULL;
 	}
-	list_del(&cfg->list);
 	printk(KERN_INFO "ACFCAN interface %s down\n", dev->name);
 	return 0;
 }
@@ -236,7 +382,13 @@ static void acfcan_setup(struct net_device *dev)
 	cfg->eth_netdev = NULL;
 	cfg->can_netdev = dev;
 	cfg->ethif[0] = '\0'; // this is a string so setting first byte to 0 is fine
-	cfg->sequenceNum = 0;
+	atomic_set(&cfg->sequenceNum, 0);
+	cfg->brief = 0;
+	cfg->tx_max_frames = 1;
+	cfg->tx_deadline_us = 0;
+	cfg->tx_stage = NULL;
+	cfg->rx_stream = NULL;
+	INIT_HLIST_NODE(&cfg->rx_node);
 	cfg->canbusId = 0;
 	cfg->flags = TX_ENABLE | RX_ENABLE; // todo: Make configurable
 }
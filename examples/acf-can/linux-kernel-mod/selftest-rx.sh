@@ -0,0 +1,64 @@
+#!/bin/sh
+#
+# Measures the RX throughput of the acfcan module while the number of acfcan
+# devices grows. Receiving devices are looked up in a hashtable, so the rate
+# should stay flat. Needs root, the loaded module and cangen from can-utils.
+#
+# Usage: ./selftest-rx.sh [device counts...]
+#   FRAMES=<n> frames sent per measurement (default 100000)
+
+COUNTS=${*:-"1 16 256 1024"}
+FRAMES=${FRAMES:-100000}
+
+cleanup() {
+	# The acfcan devices hold a reference to their ethernet device, remove them first
+	for dev in $(ls /sys/class/net | grep -E '^acfst([0-9]+|snd)$'); do
+		ip link del dev "$dev" || true
+	done
+	ip link del dev acfstmon1 2>/dev/null || true
+}
+trap cleanup EXIT
+
+set -e
+
+ip link add dev acfstmon1 type veth peer name acfstmon2
+ip link set dev acfstmon1 up
+ip link set dev acfstmon2 up
+
+ip link add dev acfstsnd type acfcan
+echo -n "acfstmon1" > /sys/class/net/acfstsnd/acfcan/ethif
+echo -n "$(cat /sys/class/net/acfstmon2/address)" > /sys/class/net/acfstsnd/acfcan/dstmac
+
+created=0
+for count in $COUNTS; do
+	while [ "$created" -lt "$count" ]; do
+		created=$((created + 1))
+		dev="acfst$created"
+		ip link add dev "$dev" type acfcan
+		echo -n "acfstmon2" > "/sys/class/net/$dev/acfcan/ethif"
+		echo -n "$(printf '%x' "$created")" > "/sys/class/net/$dev/acfcan/rx_streamid"
+		ip link set up "$dev"
+	done
+
+	# Target the device created last
+	ip link set down acfstsnd
+	echo -n "$(printf '%x' "$created")" > /sys/class/net/acfstsnd/acfcan/tx_streamid
+	ip link set up acfstsnd
+
+	# Received frames are sent on the receiving CAN device
+	stat="/sys/class/net/acfst$created/statistics/tx_packets"
+	target=$(($(cat "$stat") + FRAMES))
+
+	start=$(date +%s%N)
+	cangen acfstsnd -g 0 -p 10 -I 123 -L 8 -D i -n "$FRAMES"
+	tries=0
+	while [ "$(cat "$stat")" -lt "$target" ] && [ "$tries" -lt 500 ]; do
+		sleep 0.01
+		tries=$((tries + 1))
+	done
+	end=$(date +%s%N)
+
+	received=$((FRAMES - (target - $(cat "$stat"))))
+	ns=$((end - start))
+	echo "devices $count: received $received/$FRAMES, $((received * 1000000000 / ns)) frames/s"
+done
@@ -43,6 +43,9 @@
 #include <pthread.h>
 
 #include "common/common.h"
+#include "common/xdp.h"
+#include "common/rt.h"
+#include "common/spsc.h"
 #include "avtp/Udp.h"
 #include "avtp/acf/Ntscf.h"
 #include "avtp/acf/Tscf.h"
@@ -50,30 +53,84 @@
 #include "avtp/acf/Can.h"
 #include "avtp/CommonHeader.h"
 #include "acf-can-common.h"
+#include "acf-can-uring.h"
 
 #define ARGPARSE_CAN_FD_OPTION      500
 #define ARGPARSE_CAN_IF_OPTION      501
 #define ARGPARSE_TALKER_ID_OPTION      502
 #define ARGPARSE_LISTENER_ID_OPTION     503
+#define ARGPARSE_STATS_OPTION       504
+#define ARGPARSE_DEADLINE_OPTION    505
+#define ARGPARSE_MMAP_OPTION        506
+#define ARGPARSE_XDP_OPTION         507
+#define ARGPARSE_ENGINE_OPTION      508
+#define ARGPARSE_RT_PRIO_OPTION     509
+#define ARGPARSE_TX_CPU_OPTION      510
+#define ARGPARSE_RX_CPU_OPTION      511
+#define ARGPARSE_MLOCK_OPTION       512
+#define ARGPARSE_BUSY_POLL_OPTION   513
+#define ARGPARSE_LATENCY_HIST_OPTION 514
+#define ARGPARSE_DRAIN_THREAD_OPTION 515
+#define ARGPARSE_DRAIN_CPU_OPTION   516
+#define ARGPARSE_ROUTE_OPTION       517
+#define ARGPARSE_DEFAULT_ROUTE_OPTION 518
+#define ARGPARSE_TIMESTAMPS_OPTION  519
+#define ARGPARSE_BRIEF_OPTION       520
+#define CAN_RING_SIZE               1024
 #define TALKER_STREAM_ID            0xAABBCCDDEEFF0001
 #define LISTENER_STREAM_ID  	    0xAABBCCDDEEFF0001
+#define LISTENER_MAX_STREAMS        256
+#define LISTENER_STREAM_SLOTS       512
 
 static char ifname[IFNAMSIZ];
 static uint8_t macaddr[ETH_ALEN];
 static uint8_t ip_addr[sizeof(struct in_addr)];
 static int priority = -1;
 static uint8_t use_tscf = 0;
+static uint8_t use_brief = 0;
 static uint8_t use_udp = 0;
 static uint32_t udp_listen_port = 17220;
 static uint32_t udp_send_port = 17220;
 static Avtp_CanVariant_t can_variant = AVTP_CAN_CLASSIC;
 static uint8_t num_acf_msgs = 1;
-static char can_ifname[IFNAMSIZ];
-static uint64_t talker_stream_id = TALKER_STREAM_ID;
-static uint64_t listener_stream_id = LISTENER_STREAM_ID;
+static char can_ifnames[CAN_AGGREGATOR_MAX_BUSES][IFNAMSIZ];
+static uint8_t can_bus_ids[CAN_AGGREGATOR_MAX_BUSES];
+static int num_can_ifs = 0;
+static uint64_t talker_stream_ids[CAN_ROUTE_MAX_STREAMS];
+static int num_talker_streams = 0;
+static can_route_table_t routes;
+static can_talker_streams_t talker_streams;
+static uint8_t use_routes = 0;
+static uint64_t listener_stream_ids[LISTENER_MAX_STREAMS];
+static int num_listener_streams = 0;
+static Avtp_StreamTable_t listener_streams;
+static uint8_t listener_stream_tags[LISTENER_STREAM_SLOTS];
+static Avtp_StreamEntry_t listener_stream_entries[LISTENER_STREAM_SLOTS];
 static char ip_addr_str[100];
+static uint32_t stats_interval = 0;
+static uint32_t deadline_us = 0;
+static uint8_t use_mmap = 0;
+static tx_batch_t tx_batch;
+static packet_ring_t rx_ring, tx_ring;
+static uint8_t use_xdp = 0;
+static uint32_t xdp_queue = 0;
+static xdp_socket_t xsk;
+static uint8_t use_uring = 0;
+static int rt_priority = 0;
+static int tx_cpu = -1;
+static int rx_cpu = -1;
+static uint8_t use_mlock = 0;
+static int busy_poll_us = 0;
+static uint32_t latency_hist_interval = 0;
+static uint8_t use_drain_thread = 0;
+static int drain_cpu = -1;
+static can_timestamp_source_t timestamp_source = CAN_TIMESTAMP_NONE;
+static spsc_ring_t can_ring;
 
 int eth_socket, can_socket;
+int can_sockets[CAN_AGGREGATOR_MAX_BUSES];
+// Maps the ACF CAN bus IDs to the CAN sockets, -1 for unknown buses
+int bus_sockets[CAN_MAX_BUS_IDS];
 struct sockaddr* dest_addr;
 
 static char doc[] =
@@ -82,23 +139,76 @@ static char doc[] =
         acf-can-bridge -i eth0 -d aa:bb:cc:dd:ee:ff --canif can1\n\
         \t(Bridge eth0 with can1 using Open1722 using Ethernet)\n\
         acf-can-bridge --canif can1 -u -p 17220\n\
-        \t(Bridge eth0 with can1 using Open1722 over UDP)";
+        \t(Bridge eth0 with can1 using Open1722 over UDP)\n\
+        acf-can-bridge -i eth0 -d aa:bb:cc:dd:ee:ff --canif can1 --engine=uring\n\
+        \t(Bridge eth0 with can1 in a single thread using io_uring)\n\
+        acf-can-bridge -i eth0 -d aa:bb:cc:dd:ee:ff --canif can0:1 --canif can1:2\n\
+        \t(Bridge eth0 with can0 as bus ID 1 and can1 as bus ID 2 in one stream)";
 
 static struct argp_option options[] = {
     {"tscf", 't', 0, 0, "Use TSCF"},
     {"udp", 'u', 0, 0, "Use UDP" },
     {"fd", ARGPARSE_CAN_FD_OPTION, 0, 0, "Use CAN-FD"},
     {"count", 'c', "COUNT", 0, "Set count of CAN messages per Ethernet frame"},
-    {"canif", ARGPARSE_CAN_IF_OPTION, "CAN_IF", 0, "CAN interface"},
+    {"canif", ARGPARSE_CAN_IF_OPTION, "CAN_IF[:BUS_ID]", 0, "CAN interface and its ACF CAN bus ID (Default: position in the list). Repeat for several CAN buses."},
     {"ifname", 'i', "IFNAME", 0, "Network interface (If Ethernet)"},
     {"dst-addr", 'd', "MACADDR", 0, "Stream destination MAC address (If Ethernet)"},
     {"dst-nw-addr", 'n', "NW_ADDR", 0, "Stream destination network address and port (If UDP)"},
     {"udp-port", 'p', "UDP_PORT", 0, "UDP Port to listen on (if UDP)"},
-    {"listener-stream-id", ARGPARSE_LISTENER_ID_OPTION, "STREAM_ID", 0, "Stream ID for listener stream"},
-    {"talker-stream-id", ARGPARSE_TALKER_ID_OPTION, "STREAM_ID", 0, "Stream ID for talker stream"},
+    {"listener-stream-id", ARGPARSE_LISTENER_ID_OPTION, "STREAM_ID", 0, "Stream ID for listener stream. Repeat to receive several streams."},
+    {"talker-stream-id", ARGPARSE_TALKER_ID_OPTION, "STREAM_ID", 0, "Stream ID for talker stream. Repeat to send several streams, numbered from 0."},
+    {"route", ARGPARSE_ROUTE_OPTION, "ID[/MASK]:ACTION", 0, "Route the CAN IDs matching ID and MASK (hex, 29 bit IDs with more than 3 digits). ACTION: drop, fwd[=STREAM] or prio[=STREAM]. Repeat for several routes, the first match applies."},
+    {"default-route", ARGPARSE_DEFAULT_ROUTE_OPTION, "ACTION", 0, "Route of the CAN IDs no route matches (Default: fwd=0)"},
+    {"stats", ARGPARSE_STATS_OPTION, "SECONDS", 0, "Print CAN RX and TX batching and sequence number statistics every SECONDS"},
+    {"deadline", ARGPARSE_DEADLINE_OPTION, "USEC", 0, "Max. time in USEC a CAN message waits for aggregation (Default: until COUNT messages)"},
+    {"mmap", ARGPARSE_MMAP_OPTION, 0, 0, "Use PACKET_MMAP RX and TX rings (If Ethernet)"},
+    {"xdp", ARGPARSE_XDP_OPTION, "QUEUE", OPTION_ARG_OPTIONAL, "Use an AF_XDP socket on QUEUE (Default: 0) (If Ethernet)"},
+    {"engine", ARGPARSE_ENGINE_OPTION, "ENGINE", 0, "threads: one thread per direction (Default), uring: single thread using io_uring"},
+    {"rt-prio", ARGPARSE_RT_PRIO_OPTION, "PRIO", 0, "Run the bridge threads with SCHED_FIFO priority PRIO"},
+    {"tx-cpu", ARGPARSE_TX_CPU_OPTION, "CPU", 0, "Pin the CAN to AVTP thread (or the io_uring engine) to CPU"},
+    {"rx-cpu", ARGPARSE_RX_CPU_OPTION, "CPU", 0, "Pin the AVTP to CAN thread to CPU"},
+    {"mlock", ARGPARSE_MLOCK_OPTION, 0, 0, "Lock all memory and prefault the thread stacks"},
+    {"busy-poll", ARGPARSE_BUSY_POLL_OPTION, "USEC", OPTION_ARG_OPTIONAL, "Busy poll the network socket for USEC (Default: 50) and spin on the CAN socket"},
+    {"latency-hist", ARGPARSE_LATENCY_HIST_OPTION, "SECONDS", 0, "Print a histogram of the forwarding latency every SECONDS"},
+    {"drain-thread", ARGPARSE_DRAIN_THREAD_OPTION, 0, 0, "Drain the CAN socket in a separate thread, decoupled from the encoding and sending by a lock-free ring"},
+    {"drain-cpu", ARGPARSE_DRAIN_CPU_OPTION, "CPU", 0, "Pin the CAN drain thread to CPU"},
+    {"timestamps", ARGPARSE_TIMESTAMPS_OPTION, "SOURCE", 0, "Stamp the ACF CAN messages with the CAN RX timestamps of SOURCE: software or hardware (Default: none, time of packing)"},
+    {"brief", ARGPARSE_BRIEF_OPTION, 0, 0, "Send ACF CAN Brief messages without timestamp (Default: ACF CAN). Both are accepted on receive."},
     { 0 }
 };
 
+/* Parses IF[:BUS_ID] and checks that the bus ID is not used yet */
+static int parse_can_if(const char* arg, char* name, uint8_t* bus_id,
+                        int index) {
+
+    const char* sep = strchr(arg, ':');
+    size_t len = sep ? (size_t)(sep - arg) : strlen(arg);
+    int id = index;
+
+    if (len == 0 || len >= IFNAMSIZ) {
+        fprintf(stderr, "Invalid CAN interface %s\n", arg);
+        return -1;
+    }
+    if (sep && (sscanf(sep + 1, "%d", &id) != 1 || id < 0 ||
+                id >= CAN_MAX_BUS_IDS)) {
+        fprintf(stderr, "Invalid CAN bus ID in %s (0 to %d)\n", arg,
+                CAN_MAX_BUS_IDS - 1);
+        return -1;
+    }
+    for (int i = 0; i < index; i++) {
+        if (can_bus_ids[i] == id) {
+            fprintf(stderr, "CAN bus ID %d is used twice\n", id);
+            return -1;
+        }
+    }
+
+    memcpy(name, arg, len);
+    name[len] = '\0';
+    *bus_id = id;
+
+    return 0;
+}
+
 static error_t parser(int key, char *arg, struct argp_state *state)
 {
     int res;
@@ -124,7 +234,17 @@ static error_t parser(int key, char *arg, struct argp_state *state)
         can_variant = AVTP_CAN_FD;
         break;
     case ARGPARSE_CAN_IF_OPTION:
-        strncpy(can_ifname, arg, sizeof(can_ifname) - 1);
+        if (num_can_ifs == CAN_AGGREGATOR_MAX_BUSES) {
+            fprintf(stderr, "At most %d CAN interfaces are supported.\n",
+                    CAN_AGGREGATOR_MAX_BUSES);
+            exit(EXIT_FAILURE);
+        }
+        res = parse_can_if(arg, can_ifnames[num_can_ifs],
+                           &can_bus_ids[num_can_ifs], num_can_ifs);
+        if (res < 0) {
+            exit(EXIT_FAILURE);
+        }
+        num_can_ifs++;
         break;
     case 'i':
         strncpy(ifname, arg, sizeof(ifname) - 1);
@@ -151,18 +271,102 @@ static error_t parser(int key, char *arg, struct argp_state *state)
         }
         break;
     case ARGPARSE_LISTENER_ID_OPTION:
-        res = sscanf(arg, "%lx", &listener_stream_id);
+        if (num_listener_streams == LISTENER_MAX_STREAMS) {
+            fprintf(stderr, "At most %d listener streams are supported.\n",
+                    LISTENER_MAX_STREAMS);
+            exit(EXIT_FAILURE);
+        }
+        res = sscanf(arg, "%lx", &listener_stream_ids[num_listener_streams]);
         if (res != 1) {
-            fprintf(stderr, "Invalid talker stream id\n");
+            fprintf(stderr, "Invalid listener stream id\n");
             exit(EXIT_FAILURE);
         }
+        num_listener_streams++;
         break;
     case ARGPARSE_TALKER_ID_OPTION:
-        res = sscanf(arg, "%lx", &talker_stream_id);
+        if (num_talker_streams == CAN_ROUTE_MAX_STREAMS) {
+            fprintf(stderr, "Too many talker streams\n");
+            exit(EXIT_FAILURE);
+        }
+        res = sscanf(arg, "%lx", &talker_stream_ids[num_talker_streams]);
         if (res != 1) {
             fprintf(stderr, "Invalid talker stream id\n");
             exit(EXIT_FAILURE);
         }
+        num_talker_streams++;
+        break;
+    case ARGPARSE_ROUTE_OPTION:
+        if (can_route_parse(&routes, arg) < 0) {
+            fprintf(stderr, "Invalid or too many routes: %s\n", arg);
+            exit(EXIT_FAILURE);
+        }
+        use_routes = 1;
+        break;
+    case ARGPARSE_DEFAULT_ROUTE_OPTION:
+        if (can_route_parse_action(arg, &routes.default_route.action,
+                                   &routes.default_route.stream) < 0) {
+            fprintf(stderr, "Invalid default route: %s\n", arg);
+            exit(EXIT_FAILURE);
+        }
+        use_routes = 1;
+        break;
+    case ARGPARSE_STATS_OPTION:
+        stats_interval = atoi(arg);
+        break;
+    case ARGPARSE_DEADLINE_OPTION:
+        deadline_us = atoi(arg);
+        break;
+    case ARGPARSE_MMAP_OPTION:
+        use_mmap = 1;
+        break;
+    case ARGPARSE_XDP_OPTION:
+        use_xdp = 1;
+        xdp_queue = arg ? atoi(arg) : 0;
+        break;
+    case ARGPARSE_ENGINE_OPTION:
+        if (strcmp(arg, "uring") == 0) {
+            use_uring = 1;
+        } else if (strcmp(arg, "threads") != 0) {
+            fprintf(stderr, "Invalid engine %s\n", arg);
+            exit(EXIT_FAILURE);
+        }
+        break;
+    case ARGPARSE_RT_PRIO_OPTION:
+        rt_priority = atoi(arg);
+        if (rt_priority < 1 || rt_priority > 99) {
+            fprintf(stderr, "Invalid SCHED_FIFO priority.\n");
+            exit(EXIT_FAILURE);
+        }
+        break;
+    case ARGPARSE_TX_CPU_OPTION:
+        tx_cpu = atoi(arg);
+        break;
+    case ARGPARSE_RX_CPU_OPTION:
+        rx_cpu = atoi(arg);
+        break;
+    case ARGPARSE_MLOCK_OPTION:
+        use_mlock = 1;
+        break;
+    case ARGPARSE_BUSY_POLL_OPTION:
+        busy_poll_us = arg ? atoi(arg) : RT_BUSY_POLL_USEC;
+        break;
+    case ARGPARSE_LATENCY_HIST_OPTION:
+        latency_hist_interval = atoi(arg);
+        break;
+    case ARGPARSE_DRAIN_THREAD_OPTION:
+        use_drain_thread = 1;
+        break;
+    case ARGPARSE_DRAIN_CPU_OPTION:
+        drain_cpu = atoi(arg);
+        break;
+    case ARGPARSE_TIMESTAMPS_OPTION:
+        if (can_timestamp_parse_source(arg, &timestamp_source) < 0) {
+            fprintf(stderr, "Invalid timestamp source: %s\n", arg);
+            exit(EXIT_FAILURE);
+        }
+        break;
+    case ARGPARSE_BRIEF_OPTION:
+        use_brief = 1;
         break;
     }
 
@@ -171,53 +375,143 @@ static error_t parser(int key, char *arg, struct argp_state *state)
 
 static struct argp argp = { options, parser, NULL, doc};
 
+void* can_drain_runnable(void* args) {
+
+    can_rx_stats_t stats;
+
+    if (rt_setup_thread(rt_priority, drain_cpu) < 0) {
+        return NULL;
+    }
+    memset(&stats, 0, sizeof(stats));
+
+    // Keep draining the CAN socket, no matter how long sending takes
+    for(;;) {
+        can_drain_frames(can_socket, can_variant, &can_ring,
+                         busy_poll_us > 0, &stats);
+        if (stats_interval) {
+            print_can_rx_stats(&stats, stats_interval);
+            spsc_ring_print_stats(&can_ring, "CAN", stats_interval);
+        }
+    }
+
+    return NULL;
+}
+
 void* can_to_avtp_runnable(void* args) {
 
-    uint8_t cf_seq_num = 0;
-    uint32_t udp_seq_num = 0;
+    uint8_t cf_seq_nums[CAN_ROUTE_MAX_STREAMS] = { 0 };
+    uint32_t udp_seq_nums[CAN_ROUTE_MAX_STREAMS] = { 0 };
+    uint8_t stream;
 
-    uint8_t pdu[MAX_ETH_PDU_SIZE];
-    uint16_t pdu_length = 0;
+    uint8_t* pdu;
+    int pdu_length = 0;
     frame_t can_frames[num_acf_msgs];
+    uint8_t bus_ids[num_acf_msgs];
+    uint64_t timestamps[num_acf_msgs];
+    can_aggregator_t aggregator;
+    latency_hist_t hist;
+    uint64_t rx_time_ns = 0;
     int res;
 
+    if (rt_setup_thread(rt_priority, tx_cpu) < 0) {
+        return NULL;
+    }
+    latency_hist_init(&hist);
+
+    if (use_mmap) {
+        res = tx_batch_init_ring(&tx_batch, &tx_ring, dest_addr,
+                                 sizeof(struct sockaddr_ll), TX_BATCH_MAX_PDUS);
+    } else if (use_xdp) {
+        res = tx_batch_init_xdp(&tx_batch, &xsk, TX_BATCH_MAX_PDUS);
+    } else {
+        res = tx_batch_init(&tx_batch, eth_socket, dest_addr,
+                            use_udp ? sizeof(struct sockaddr_in) : sizeof(struct sockaddr_ll),
+                            TX_BATCH_MAX_PDUS);
+    }
+    if (res < 0) {
+        return NULL;
+    }
+
+    res = can_aggregator_init(&aggregator, -1, can_variant,
+                              num_acf_msgs, deadline_us, use_udp, use_tscf);
+    if (res < 0) {
+        return NULL;
+    }
+    // The frames of all CAN buses share the talker stream
+    for (int i = 0; i < num_can_ifs; i++) {
+        res = can_aggregator_add_bus(&aggregator, can_sockets[i],
+                                     can_bus_ids[i]);
+        if (res < 0) {
+            return NULL;
+        }
+    }
+    aggregator.busy_poll = busy_poll_us > 0;
+    aggregator.brief = use_brief;
+    if (use_drain_thread) {
+        aggregator.ring = &can_ring;
+    }
+    if (use_routes) {
+        aggregator.routes = &routes;
+    }
+
     // Start an infinite loop to keep converting CAN frames to AVTP frames
     for(;;) {
 
-        // Read acf_num_msgs number of CAN frames from the CAN socket
-        int i = 0;
-        while (i < num_acf_msgs) {
-            // Get payload -- will 'spin' here until we get the requested number
-            //                of CAN frames.
-            if(can_variant == AVTP_CAN_FD){
-                res = read(can_socket, &(can_frames[i].fd), sizeof(struct canfd_frame));
-            } else {
-                res = read(can_socket, &(can_frames[i].cc), sizeof(struct can_frame));
-            }
-            if (!res) {
-                perror("Error reading CAN frames");
-                continue;
-            }
-            i++;
+        // Collect up to num_acf_msgs CAN frames. Fewer frames are sent if
+        // the deadline expires or the AVTP frame is full.
+        res = can_aggregator_collect(&aggregator, can_frames, bus_ids,
+                                     timestamps);
+        if (res <= 0) {
+            continue;
+        }
+        if (stats_interval) {
+            print_can_rx_stats(&aggregator.stats, stats_interval);
         }
 
-        // Pack all the read frames into an AVTP frame
-        pdu_length = can_to_avtp(can_frames, can_variant, pdu, use_udp, use_tscf,
-                                    talker_stream_id, num_acf_msgs, cf_seq_num++, udp_seq_num++);
+        // The latency of a batch is measured from the reception of the
+        // first frame of its first PDU, so it includes the aggregation
+        if (tx_batch.num_pdus == 0) {
+            rx_time_ns = aggregator.arrival;
+        }
 
-        // Send the packed frame out
-        if (use_udp) {
-            res = sendto(eth_socket, pdu, pdu_length, 0,
-                    (struct sockaddr *) dest_addr, sizeof(struct sockaddr_in));
-        } else {
-            res = sendto(eth_socket, pdu, pdu_length, 0,
-                         (struct sockaddr *) dest_addr, sizeof(struct sockaddr_ll));
+        // Pack all the read frames into an AVTP frame
+        pdu = tx_batch_next(&tx_batch);
+        if (pdu == NULL) {
+            return NULL;
         }
-        if (res < 0) {
-            perror("Failed to send data");
+        stream = aggregator.stream;
+        pdu_length = can_to_avtp_multi_bus(can_frames, bus_ids, timestamps,
+                                           can_variant, pdu, use_udp,
+                                           use_brief, &talker_streams, stream,
+                                           res,
+                                           cf_seq_nums[stream]++,
+                                           udp_seq_nums[stream]++);
+        if (pdu_length < 0) {
+            fprintf(stderr, "Failed to pack CAN frames: %s\n",
+                    strerror(-pdu_length));
+            continue;
+        }
+        tx_batch_queue(&tx_batch, pdu_length);
+
+        // Send the packed frames out, unless the CAN frames for the next
+        // AVTP frame are already queued. They are sent with one syscall then.
+        // Priority frames are sent at once.
+        if (aggregator.flush_reason == CAN_FLUSH_PRIORITY ||
+            !can_aggregator_ready(&aggregator)) {
+            tx_batch_flush(&tx_batch);
+            if (latency_hist_interval) {
+                latency_hist_add(&hist, rt_now_ns() - rx_time_ns);
+            }
+        }
+        if (stats_interval) {
+            tx_batch_print_stats(&tx_batch, stats_interval);
+        }
+        if (latency_hist_interval) {
+            latency_hist_print(&hist, "CAN to AVTP", latency_hist_interval);
         }
     }
 
+
     return NULL;
 }
 
@@ -225,40 +519,77 @@ void* avtp_to_can_runnable(void* args) {
 
     uint16_t pdu_length = 0, cf_length = 0;
     int8_t num_can_msgs = 0;
-    uint8_t exp_cf_seqnum = 0;
-    uint32_t exp_udp_seqnum = 0;
-    uint8_t pdu[MAX_ETH_PDU_SIZE];
+    Avtp_StreamEntry_t* stream;
+    uint8_t pdu_buf[MAX_ETH_PDU_SIZE];
+    uint8_t* pdu = pdu_buf;
     frame_t can_frames[MAX_CAN_FRAMES_IN_ACF];
+    uint8_t bus_ids[MAX_CAN_FRAMES_IN_ACF];
+    uint8_t warned[CAN_MAX_BUS_IDS] = { 0 };
+    latency_hist_t hist;
+    seq_stats_timer_t seq_timer = { 0 };
+    uint64_t rx_time_ns;
+    // Busy polling spins on the rings, sockets poll in the kernel
+    int timeout = busy_poll_us ? 0 : -1;
+
+    if (rt_setup_thread(rt_priority, rx_cpu) < 0) {
+        return NULL;
+    }
+    latency_hist_init(&hist);
 
     // Start an infinite loop to keep converting AVTP frames to CAN frames
     for(;;) {
 
-        pdu_length = recv(eth_socket, pdu, MAX_ETH_PDU_SIZE, 0);
+        // The ring and AF_XDP hand out the PDU in place, without copying it
+        if (use_mmap)
+            pdu_length = packet_ring_recv(&rx_ring, &pdu, timeout);
+        else if (use_xdp)
+            pdu_length = xdp_socket_recv(&xsk, &pdu, timeout);
+        else
+            pdu_length = recv(eth_socket, pdu, MAX_ETH_PDU_SIZE, 0);
+        if (pdu_length == 0) {
+            continue;
+        }
         if (pdu_length < 0 || pdu_length > MAX_ETH_PDU_SIZE) {
             perror("Failed to receive data");
             continue;
         }
+        rx_time_ns = rt_now_ns();
 
-        num_can_msgs = avtp_to_can(pdu, can_frames, can_variant, use_udp,
-                             listener_stream_id, &exp_cf_seqnum, &exp_udp_seqnum);
+        // The stream table tracks the sequence numbers of every stream
+        num_can_msgs = avtp_to_can_stream_table(pdu, pdu_length, can_frames,
+                                                bus_ids, can_variant, use_udp,
+                                                &listener_streams, &stream);
         if (num_can_msgs <= 0) {
             continue;
         }
-        exp_cf_seqnum++;
-        exp_udp_seqnum++;
 
         for (int8_t i = 0; i < num_can_msgs; i++) {
             int res;
+            // A single CAN interface gets the frames of all buses
+            int fd = (num_can_ifs == 1) ? can_socket : bus_sockets[bus_ids[i]];
+            if (fd < 0) {
+                if (!warned[bus_ids[i]]) {
+                    fprintf(stderr, "Dropping frames for unknown CAN bus ID %d\n",
+                            bus_ids[i]);
+                    warned[bus_ids[i]] = 1;
+                }
+                continue;
+            }
             if (can_variant == AVTP_CAN_FD)
-                res = write(can_socket, &can_frames[i].fd, sizeof(struct canfd_frame));
+                res = write(fd, &can_frames[i].fd, sizeof(struct canfd_frame));
             else if (can_variant == AVTP_CAN_CLASSIC)
-                res = write(can_socket, &can_frames[i].cc, sizeof(struct can_frame));
+                res = write(fd, &can_frames[i].cc, sizeof(struct can_frame));
 
             if(res < 0)
             {
                 perror("Failed to write to CAN bus");
             }
         }
+        if (latency_hist_interval) {
+            latency_hist_add(&hist, rt_now_ns() - rx_time_ns);
+            latency_hist_print(&hist, "AVTP to CAN", latency_hist_interval);
+        }
+        print_stream_seq_stats(&listener_streams, &seq_timer, stats_interval);
     }
 
     return NULL;
@@ -270,7 +601,10 @@ int main(int argc, char *argv[])
 
     struct sockaddr_ll sk_ll_addr;
     struct sockaddr_in sk_udp_addr;
+    uint8_t cf_subtypes[] = { AVTP_SUBTYPE_NTSCF, AVTP_SUBTYPE_TSCF };
 
+    // The rules are added while parsing, all CAN IDs go to stream 0 by default
+    can_route_table_init(&routes, CAN_ROUTE_FORWARD, 0);
     argp_parse(&argp, argc, argv, 0, NULL, NULL);
 
     // Print current configuration
@@ -279,21 +613,111 @@ int main(int argc, char *argv[])
         printf("\tUsing TSCF\n");
     else
         printf("\tUsing NTSCF\n");
-    if(can_variant == AVTP_CAN_CLASSIC)
-        printf("\tUsing Classic CAN interface: %s\n", can_ifname);
-    else if(can_variant == AVTP_CAN_FD)
-        printf("\tUsing CAN FD interface: %s\n", can_ifname);
+    if(use_brief)
+        printf("\tSending ACF CAN Brief messages\n");
+    for (int i = 0; i < num_can_ifs; i++) {
+        if(can_variant == AVTP_CAN_CLASSIC)
+            printf("\tUsing Classic CAN interface: %s, bus ID %d\n",
+                   can_ifnames[i], can_bus_ids[i]);
+        else if(can_variant == AVTP_CAN_FD)
+            printf("\tUsing CAN FD interface: %s, bus ID %d\n",
+                   can_ifnames[i], can_bus_ids[i]);
+    }
     if(use_udp) {
         printf("\tUsing UDP\n");
         printf("\tDestination IP: %s, Send port: %d, listening port: %d\n", ip_addr_str, udp_send_port, udp_listen_port);
     } else {
         printf("\tUsing Ethernet\n");
         printf("\tNetwork Interface: %s\n", ifname);
+        if (use_mmap)
+            printf("\tUsing PACKET_MMAP RX and TX rings\n");
+        if (use_xdp)
+            printf("\tUsing AF_XDP socket on queue %u\n", xdp_queue);
         printf("\tDestination MAC Address: %02x:%02x:%02x:%02x:%02x:%02x\n", macaddr[0], macaddr[1], macaddr[2],
                                                         macaddr[3], macaddr[4], macaddr[5]);
     }
-    printf("\tListener Stream ID: 0x%lx, Talker Stream ID: 0x%lx\n", listener_stream_id, talker_stream_id);
+    if (num_listener_streams == 0) {
+        listener_stream_ids[num_listener_streams++] = LISTENER_STREAM_ID;
+    }
+    for (int i = 0; i < num_listener_streams; i++)
+        printf("\tListener Stream ID: 0x%lx\n", listener_stream_ids[i]);
+    if (num_talker_streams == 0) {
+        talker_stream_ids[num_talker_streams++] = TALKER_STREAM_ID;
+    }
+    for (int i = 0; i < num_talker_streams; i++)
+        printf("\tTalker Stream ID %d: 0x%lx\n", i, talker_stream_ids[i]);
+    if (use_routes)
+        printf("\tCAN routes: %d\n", routes.num_rules);
+    if (timestamp_source == CAN_TIMESTAMP_SOFTWARE)
+        printf("\tUsing software CAN RX timestamps\n");
+    else if (timestamp_source == CAN_TIMESTAMP_HARDWARE)
+        printf("\tUsing hardware CAN RX timestamps\n");
     printf("\tNumber of ACF messages per AVTP frame in talker stream: %d\n", num_acf_msgs);
+    if (use_uring)
+        printf("\tUsing the io_uring engine\n");
+    if (use_drain_thread)
+        printf("\tDraining CAN in a separate thread\n");
+    if (rt_priority)
+        printf("\tSCHED_FIFO priority: %d\n", rt_priority);
+    if (busy_poll_us)
+        printf("\tBusy polling for %d us\n", busy_poll_us);
+
+    if (use_udp && (use_mmap || use_xdp)) {
+        fprintf(stderr, "The PACKET_MMAP rings and AF_XDP require Ethernet\n");
+        return 1;
+    }
+    if (use_mmap && use_xdp) {
+        fprintf(stderr, "Select either the PACKET_MMAP rings or AF_XDP\n");
+        return 1;
+    }
+    if (use_brief && timestamp_source != CAN_TIMESTAMP_NONE) {
+        fprintf(stderr, "ACF CAN Brief messages carry no timestamps\n");
+        return 1;
+    }
+    if (use_uring && (use_mmap || use_xdp)) {
+        fprintf(stderr, "The io_uring engine uses regular sockets\n");
+        return 1;
+    }
+    if (use_uring && use_drain_thread) {
+        fprintf(stderr, "The io_uring engine runs in a single thread\n");
+        return 1;
+    }
+    if (num_can_ifs == 0) {
+        fprintf(stderr, "No CAN interface given\n");
+        return 1;
+    }
+    if (use_uring && (num_can_ifs > 1 || can_bus_ids[0] != 0)) {
+        fprintf(stderr, "The io_uring engine bridges a single CAN bus with ID 0\n");
+        return 1;
+    }
+    if (use_drain_thread && num_can_ifs > 1) {
+        fprintf(stderr, "The drain thread reads a single CAN interface\n");
+        return 1;
+    }
+    if (can_route_check_streams(&routes, num_talker_streams) < 0) {
+        fprintf(stderr, "A route refers to an undefined talker stream\n");
+        return 1;
+    }
+    if (can_talker_streams_init(&talker_streams, talker_stream_ids,
+                                num_talker_streams, use_tscf) < 0) {
+        fprintf(stderr, "Failed to set up the talker streams\n");
+        return 1;
+    }
+
+    Avtp_StreamTable_Init(&listener_streams, listener_stream_tags,
+                          listener_stream_entries, LISTENER_STREAM_SLOTS);
+    for (int i = 0; i < num_listener_streams; i++) {
+        Avtp_StreamTable_Add(&listener_streams, listener_stream_ids[i]);
+    }
+    if (seq_stats_init_signal() < 0) {
+        return 1;
+    }
+
+    // Lock the memory before the sockets map their rings, so these are
+    // resident as well
+    if (use_mlock && rt_lock_memory() < 0) {
+        return 1;
+    }
 
     // Create an appropriate sockets: UDP or Ethernet raw
     // Setup the socket for sending to the destination
@@ -305,6 +729,34 @@ int main(int argc, char *argv[])
         res = setup_udp_socket_address((struct in_addr*) ip_addr,
                                        udp_send_port, &sk_udp_addr);
         dest_addr = (struct sockaddr*) &sk_udp_addr;
+    } else if (use_mmap) {
+        res = create_listener_ring(&rx_ring, ifname, macaddr, ETH_P_TSN);
+        if (res < 0) return 1;
+        eth_socket = rx_ring.fd;
+
+        // The rings use separate sockets. Skip the frames sent by the TX
+        // ring, which the RX socket would otherwise see as well.
+        int ignore = 1;
+        res = setsockopt(eth_socket, SOL_PACKET, PACKET_IGNORE_OUTGOING,
+                         &ignore, sizeof(ignore));
+        if (res < 0) {
+            perror("Failed to set PACKET_IGNORE_OUTGOING");
+            return 1;
+        }
+
+        res = create_talker_ring(&tx_ring, priority);
+        if (res < 0) return 1;
+
+        // Prepare socket for sending
+        res = setup_socket_address(tx_ring.fd, ifname, macaddr,
+                                   ETH_P_TSN, &sk_ll_addr);
+        dest_addr = (struct sockaddr*) &sk_ll_addr;
+    } else if (use_xdp) {
+        // One AF_XDP socket receives and sends. Frames sent by it do not
+        // pass the XDP program, so they are not received again.
+        res = create_xdp_socket(&xsk, ifname, macaddr, xdp_queue, 1);
+        if (res < 0) return 1;
+        eth_socket = xsk.fd;
     } else {
         eth_socket = create_listener_socket(ifname, macaddr, ETH_P_TSN);
         if (eth_socket < 0) return 1;
@@ -316,11 +768,71 @@ int main(int argc, char *argv[])
     }
     if (res < 0) return 1;
 
-    // Open a CAN socket for reading frames
-    can_socket = setup_can_socket(can_ifname, can_variant);
-    if (can_socket < 0) return 1;
+    // Drop other streams in the kernel. AF_XDP sockets only get the frames
+    // redirected by the XDP program, so they are not filtered.
+    if (!use_xdp) {
+        res = attach_stream_filter(eth_socket, use_udp, cf_subtypes,
+                                   sizeof(cf_subtypes), listener_stream_ids,
+                                   num_listener_streams);
+        if (res < 0) return 1;
+    }
+
+    // Open a CAN socket for reading frames from every CAN interface
+    for (int i = 0; i < CAN_MAX_BUS_IDS; i++) {
+        bus_sockets[i] = -1;
+    }
+    for (int i = 0; i < num_can_ifs; i++) {
+        can_sockets[i] = setup_can_socket(can_ifnames[i], can_variant);
+        if (can_sockets[i] < 0) return 1;
+        // Let the kernel drop the CAN IDs that are not routed
+        if (use_routes && set_can_route_filters(can_sockets[i], &routes) < 0)
+            return 1;
+        if (set_can_timestamping(can_sockets[i], can_ifnames[i],
+                                 timestamp_source) < 0)
+            return 1;
+        bus_sockets[can_bus_ids[i]] = can_sockets[i];
+    }
+    can_socket = can_sockets[0];
+
+    if (busy_poll_us && rt_set_busy_poll(eth_socket, busy_poll_us) < 0) {
+        return 1;
+    }
+
+    if (use_uring) {
+        acf_can_uring_config_t cfg = {
+            .eth_socket = eth_socket,
+            .can_socket = can_socket,
+            .dest_addr = dest_addr,
+            .dest_addr_len = use_udp ? sizeof(struct sockaddr_in) : sizeof(struct sockaddr_ll),
+            .can_variant = can_variant,
+            .use_udp = use_udp,
+            .use_tscf = use_tscf,
+            .use_brief = use_brief,
+            .num_acf_msgs = num_acf_msgs,
+            .deadline_us = deadline_us,
+            .talker_streams = &talker_streams,
+            .routes = use_routes ? &routes : NULL,
+            .use_timestamps = timestamp_source != CAN_TIMESTAMP_NONE,
+            .listener_streams = &listener_streams,
+            .stats_interval = stats_interval,
+        };
+        if (rt_setup_thread(rt_priority, tx_cpu) < 0) {
+            return 1;
+        }
+        acf_can_uring_run(&cfg);
+        return 1;
+    }
+
+    pthread_t can_to_avtp_thread, avtp_to_can_thread, can_drain_thread;
 
-    pthread_t can_to_avtp_thread, avtp_to_can_thread;
+    // The drain thread hands the CAN frames to the CAN to AVTP thread
+    if (use_drain_thread) {
+        if (spsc_ring_init(&can_ring, sizeof(can_ring_frame_t),
+                           CAN_RING_SIZE) < 0) {
+            return 1;
+        }
+        pthread_create(&can_drain_thread, NULL, can_drain_runnable, NULL);
+    }
 
     // Start the threads for the bridge
     pthread_create(&can_to_avtp_thread, NULL, can_to_avtp_runnable, NULL);
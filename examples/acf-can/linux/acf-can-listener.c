@@ -40,6 +40,7 @@
 #include <sys/ioctl.h>
 
 #include "common/common.h"
+#include "common/xdp.h"
 #include "avtp/Udp.h"
 #include "avtp/acf/Ntscf.h"
 #include "avtp/acf/Tscf.h"
@@ -51,6 +52,9 @@
 #define ARGPARSE_CAN_FD_OPTION          500
 #define ARGPARSE_CAN_IF_OPTION          501
 #define ARGPARSE_LISTENER_ID_OPTION     503
+#define ARGPARSE_MMAP_OPTION            504
+#define ARGPARSE_XDP_OPTION             505
+#define ARGPARSE_STATS_OPTION           506
 #define STREAM_ID                       0xAABBCCDDEEFF0001
 
 static char ifname[IFNAMSIZ];
@@ -60,6 +64,10 @@ static uint32_t udp_port = 17220;
 static Avtp_CanVariant_t can_variant = AVTP_CAN_CLASSIC;
 static char can_ifname[IFNAMSIZ];
 static uint64_t listener_stream_id = STREAM_ID;
+static uint8_t use_mmap;
+static uint8_t use_xdp;
+static uint32_t xdp_queue;
+static uint32_t stats_interval;
 
 static char doc[] =
         "\nacf-can-listener -- a program to receive CAN messages from a remote CAN bus over Ethernet using Open1722.\
@@ -77,6 +85,9 @@ static struct argp_option options[] = {
     {"dst-addr", 'd', "MACADDR", 0, "Stream destination MAC address (If Ethernet)"},
     {"udp-port", 'p', "UDP_PORT", 0, "UDP Port to listen on (if UDP)"},
     {"stream-id", ARGPARSE_LISTENER_ID_OPTION, "STREAM_ID", 0, "Stream ID for listener stream"},
+    {"mmap", ARGPARSE_MMAP_OPTION, 0, 0, "Receive through a PACKET_MMAP RX ring (If Ethernet)"},
+    {"xdp", ARGPARSE_XDP_OPTION, "QUEUE", OPTION_ARG_OPTIONAL, "Receive through an AF_XDP socket on QUEUE (Default: 0) (If Ethernet)"},
+    {"stats", ARGPARSE_STATS_OPTION, "SECONDS", 0, "Print sequence number statistics every SECONDS (Default: on SIGUSR1 only)"},
     { 0 }
 };
 
@@ -116,6 +127,16 @@ static error_t parser(int key, char *arg, struct argp_state *state)
             exit(EXIT_FAILURE);
         }
         break;
+    case ARGPARSE_MMAP_OPTION:
+        use_mmap = 1;
+        break;
+    case ARGPARSE_XDP_OPTION:
+        use_xdp = 1;
+        xdp_queue = arg ? atoi(arg) : 0;
+        break;
+    case ARGPARSE_STATS_OPTION:
+        stats_interval = atoi(arg);
+        break;
     }
 
     return 0;
@@ -131,10 +152,14 @@ int main(int argc, char *argv[])
     struct ifreq ifr;
     uint16_t pdu_length = 0, cf_length = 0;
     uint8_t num_can_msgs = 0;
-    uint8_t exp_cf_seqnum = 0;
-    uint32_t exp_udp_seqnum = 0;
-    uint8_t pdu[MAX_ETH_PDU_SIZE];
+    Avtp_SeqTracker_t cf_seq, udp_seq;
+    seq_stats_timer_t stats_timer = { 0 };
+    uint8_t pdu_buf[MAX_ETH_PDU_SIZE];
+    uint8_t *pdu = pdu_buf;
     frame_t can_frames[MAX_CAN_FRAMES_IN_ACF];
+    static packet_ring_t rx_ring;
+    static xdp_socket_t xsk;
+    uint8_t cf_subtypes[] = { AVTP_SUBTYPE_NTSCF, AVTP_SUBTYPE_TSCF };
 
     argp_parse(&argp, argc, argv, 0, NULL, NULL);
     // Print current configuration
@@ -149,12 +174,31 @@ int main(int argc, char *argv[])
     } else {
         printf("\tUsing Ethernet\n");
         printf("\tNetwork Interface: %s\n", ifname);
+        if (use_mmap)
+            printf("\tUsing PACKET_MMAP RX ring\n");
+        if (use_xdp)
+            printf("\tUsing AF_XDP socket on queue %u\n", xdp_queue);
     }
     printf("\tListener Stream ID: 0x%lx\n", listener_stream_id);
 
+    if (use_udp && (use_mmap || use_xdp)) {
+        fprintf(stderr, "The PACKET_MMAP RX ring and AF_XDP require Ethernet\n");
+        return 1;
+    }
+    if (use_mmap && use_xdp) {
+        fprintf(stderr, "Select either the PACKET_MMAP RX ring or AF_XDP\n");
+        return 1;
+    }
+
     // Configure an appropriate socket: UDP or Ethernet Raw
     if (use_udp) {
         fd = create_listener_socket_udp(udp_port);
+    } else if (use_mmap) {
+        res = create_listener_ring(&rx_ring, ifname, macaddr, ETH_P_TSN);
+        fd = res < 0 ? -1 : rx_ring.fd;
+    } else if (use_xdp) {
+        res = create_xdp_socket(&xsk, ifname, macaddr, xdp_queue, 1);
+        fd = res < 0 ? -1 : xsk.fd;
     } else {
         fd = create_listener_socket(ifname, macaddr, ETH_P_TSN);
     }
@@ -162,23 +206,39 @@ int main(int argc, char *argv[])
     if (fd < 0)
         return 1;
 
+    // Drop other streams in the kernel. AF_XDP sockets only get the frames
+    // redirected by the XDP program, so they are not filtered.
+    if (!use_xdp) {
+        res = attach_stream_filter(fd, use_udp, cf_subtypes,
+                                   sizeof(cf_subtypes), &listener_stream_id, 1);
+        if (res < 0) goto err;
+    }
+
     // Open a CAN socket for reading frames
     can_socket = setup_can_socket(can_ifname, can_variant);
     if (can_socket < 0) goto err;
 
+    Avtp_SeqTracker_Init(&cf_seq);
+    Avtp_SeqTracker_Init(&udp_seq);
+    if (seq_stats_init_signal() < 0) goto err;
+
     // Start an infinite loop to keep converting AVTP frames to CAN frames
     for(;;) {
 
-        pdu_length = recv(fd, pdu, MAX_ETH_PDU_SIZE, 0);
+        // The ring and AF_XDP hand out the PDU in place, without copying it
+        if (use_mmap)
+            pdu_length = packet_ring_recv(&rx_ring, &pdu, -1);
+        else if (use_xdp)
+            pdu_length = xdp_socket_recv(&xsk, &pdu, -1);
+        else
+            pdu_length = recv(fd, pdu, MAX_ETH_PDU_SIZE, 0);
         if (pdu_length < 0 || pdu_length > MAX_ETH_PDU_SIZE) {
             perror("Failed to receive data");
             continue;
         }
 
-        num_can_msgs = avtp_to_can(pdu, can_frames, can_variant, use_udp,
-                             listener_stream_id, &exp_cf_seqnum, &exp_udp_seqnum);
-        exp_cf_seqnum++;
-        exp_udp_seqnum++;
+        num_can_msgs = avtp_to_can(pdu, pdu_length, can_frames, can_variant,
+                                   use_udp, listener_stream_id, &cf_seq, &udp_seq);
 
         for (int i = 0; i < num_can_msgs; i++) {
             int res;
@@ -193,12 +253,23 @@ int main(int argc, char *argv[])
                 continue;
             }
         }
+
+        if (seq_stats_due(&stats_timer, stats_interval)) {
+            seq_stats_print("AVTP", &cf_seq.stats);
+            if (use_udp)
+                seq_stats_print("UDP", &udp_seq.stats);
+        }
     }
 
     return 0;
 
 err:
-    close(fd);
+    if (use_mmap)
+        packet_ring_close(&rx_ring);
+    else if (use_xdp)
+        xdp_socket_close(&xsk);
+    else
+        close(fd);
     return 1;
 
 }
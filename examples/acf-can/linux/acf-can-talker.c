@@ -40,6 +40,7 @@
 #include <stdio.h>
 
 #include "common/common.h"
+#include "common/rt.h"
 #include "acf-can-common.h"
 
 #define STREAM_ID                   0xAABBCCDDEEFF0001
@@ -47,6 +48,18 @@
 #define ARGPARSE_CAN_FD_OPTION      500
 #define ARGPARSE_CAN_IF_OPTION      501
 #define ARGPARSE_TALKER_ID_OPTION      502
+#define ARGPARSE_STATS_OPTION       503
+#define ARGPARSE_DEADLINE_OPTION    504
+#define ARGPARSE_MMAP_OPTION        505
+#define ARGPARSE_RT_PRIO_OPTION     506
+#define ARGPARSE_CPU_OPTION         507
+#define ARGPARSE_MLOCK_OPTION       508
+#define ARGPARSE_BUSY_POLL_OPTION   509
+#define ARGPARSE_LATENCY_HIST_OPTION 510
+#define ARGPARSE_ROUTE_OPTION       511
+#define ARGPARSE_DEFAULT_ROUTE_OPTION 512
+#define ARGPARSE_TIMESTAMPS_OPTION  513
+#define ARGPARSE_BRIEF_OPTION       514
 
 static char ifname[IFNAMSIZ];
 static uint8_t macaddr[ETH_ALEN];
@@ -54,12 +67,28 @@ static uint8_t ip_addr[sizeof(struct in_addr)];
 static uint32_t udp_port=17220;
 static int priority = -1;
 static uint8_t use_tscf = 0;
+static uint8_t use_brief = 0;
 static uint8_t use_udp = 0;
 static Avtp_CanVariant_t can_variant = AVTP_CAN_CLASSIC;
 static uint8_t num_acf_msgs = 1;
 static char can_ifname[IFNAMSIZ];
-static uint64_t talker_stream_id = STREAM_ID;
+static uint64_t talker_stream_ids[CAN_ROUTE_MAX_STREAMS];
+static int num_talker_streams = 0;
+static can_route_table_t routes;
+static can_talker_streams_t talker_streams;
+static uint8_t use_routes = 0;
 static char ip_addr_str[100];
+static uint32_t stats_interval = 0;
+static uint32_t deadline_us = 0;
+static uint8_t use_mmap = 0;
+static tx_batch_t tx_batch;
+static packet_ring_t tx_ring;
+static int rt_priority = 0;
+static int cpu = -1;
+static uint8_t use_mlock = 0;
+static uint8_t use_busy_poll = 0;
+static uint32_t latency_hist_interval = 0;
+static can_timestamp_source_t timestamp_source = CAN_TIMESTAMP_NONE;
 
 static char doc[] =
         "\nacf-can-talker -- a program to send CAN messages to a remote CAN bus over Ethernet using Open1722.\
@@ -73,12 +102,24 @@ static struct argp_option options[] = {
     {"tscf", 't', 0, 0, "Use TSCF (Default: NTSCF)"},
     {"udp", 'u', 0, 0, "Use UDP (Default: Ethernet)" },
     {"fd", ARGPARSE_CAN_FD_OPTION, 0, 0, "Use CAN-FD"},
+    {"brief", ARGPARSE_BRIEF_OPTION, 0, 0, "Send ACF CAN Brief messages without timestamp (Default: ACF CAN)"},
     {"count", 'c', "COUNT", 0, "Set count of CAN messages per Ethernet frame"},
     {"canif", ARGPARSE_CAN_IF_OPTION, "CAN_IF", 0, "CAN interface"},
     {"ifname", 'i', "IFNAME", 0, "Network interface (If Ethernet)"},
     {"dst-addr", 'd', "MACADDR", 0, "Stream destination MAC address (If Ethernet)"},
     {"dst-nw-addr", 'n', "NW_ADDR", 0, "Stream destination network address and port (If UDP)"},
-    {"stream-id", ARGPARSE_TALKER_ID_OPTION, "STREAM_ID", 0, "Stream ID for talker stream"},
+    {"stream-id", ARGPARSE_TALKER_ID_OPTION, "STREAM_ID", 0, "Stream ID for talker stream. Repeat to send several streams, numbered from 0."},
+    {"route", ARGPARSE_ROUTE_OPTION, "ID[/MASK]:ACTION", 0, "Route the CAN IDs matching ID and MASK (hex, 29 bit IDs with more than 3 digits). ACTION: drop, fwd[=STREAM] or prio[=STREAM]. Repeat for several routes, the first match applies."},
+    {"default-route", ARGPARSE_DEFAULT_ROUTE_OPTION, "ACTION", 0, "Route of the CAN IDs no route matches (Default: fwd=0)"},
+    {"stats", ARGPARSE_STATS_OPTION, "SECONDS", 0, "Print CAN RX and TX batching statistics every SECONDS"},
+    {"deadline", ARGPARSE_DEADLINE_OPTION, "USEC", 0, "Max. time in USEC a CAN message waits for aggregation (Default: until COUNT messages)"},
+    {"mmap", ARGPARSE_MMAP_OPTION, 0, 0, "Send through a PACKET_MMAP TX ring (If Ethernet)"},
+    {"rt-prio", ARGPARSE_RT_PRIO_OPTION, "PRIO", 0, "Run with SCHED_FIFO priority PRIO"},
+    {"cpu", ARGPARSE_CPU_OPTION, "CPU", 0, "Pin the talker to CPU"},
+    {"mlock", ARGPARSE_MLOCK_OPTION, 0, 0, "Lock all memory and prefault the stack"},
+    {"busy-poll", ARGPARSE_BUSY_POLL_OPTION, 0, 0, "Spin on the CAN socket instead of sleeping"},
+    {"latency-hist", ARGPARSE_LATENCY_HIST_OPTION, "SECONDS", 0, "Print a histogram of the CAN to AVTP latency every SECONDS"},
+    {"timestamps", ARGPARSE_TIMESTAMPS_OPTION, "SOURCE", 0, "Stamp the ACF CAN messages with the CAN RX timestamps of SOURCE: software or hardware (Default: none, time of packing)"},
     { 0 }
 };
 
@@ -131,11 +172,68 @@ static error_t parser(int key, char *arg, struct argp_state *state)
         }
         break;
     case ARGPARSE_TALKER_ID_OPTION:
-        res = sscanf(arg, "%lx", &talker_stream_id);
+        if (num_talker_streams == CAN_ROUTE_MAX_STREAMS) {
+            fprintf(stderr, "Too many talker streams\n");
+            exit(EXIT_FAILURE);
+        }
+        res = sscanf(arg, "%lx", &talker_stream_ids[num_talker_streams]);
         if (res != 1) {
             fprintf(stderr, "Invalid talker stream id\n");
             exit(EXIT_FAILURE);
         }
+        num_talker_streams++;
+        break;
+    case ARGPARSE_ROUTE_OPTION:
+        if (can_route_parse(&routes, arg) < 0) {
+            fprintf(stderr, "Invalid or too many routes: %s\n", arg);
+            exit(EXIT_FAILURE);
+        }
+        use_routes = 1;
+        break;
+    case ARGPARSE_DEFAULT_ROUTE_OPTION:
+        if (can_route_parse_action(arg, &routes.default_route.action,
+                                   &routes.default_route.stream) < 0) {
+            fprintf(stderr, "Invalid default route: %s\n", arg);
+            exit(EXIT_FAILURE);
+        }
+        use_routes = 1;
+        break;
+    case ARGPARSE_STATS_OPTION:
+        stats_interval = atoi(arg);
+        break;
+    case ARGPARSE_DEADLINE_OPTION:
+        deadline_us = atoi(arg);
+        break;
+    case ARGPARSE_MMAP_OPTION:
+        use_mmap = 1;
+        break;
+    case ARGPARSE_RT_PRIO_OPTION:
+        rt_priority = atoi(arg);
+        if (rt_priority < 1 || rt_priority > 99) {
+            fprintf(stderr, "Invalid SCHED_FIFO priority.\n");
+            exit(EXIT_FAILURE);
+        }
+        break;
+    case ARGPARSE_CPU_OPTION:
+        cpu = atoi(arg);
+        break;
+    case ARGPARSE_MLOCK_OPTION:
+        use_mlock = 1;
+        break;
+    case ARGPARSE_BUSY_POLL_OPTION:
+        use_busy_poll = 1;
+        break;
+    case ARGPARSE_LATENCY_HIST_OPTION:
+        latency_hist_interval = atoi(arg);
+        break;
+    case ARGPARSE_TIMESTAMPS_OPTION:
+        if (can_timestamp_parse_source(arg, &timestamp_source) < 0) {
+            fprintf(stderr, "Invalid timestamp source: %s\n", arg);
+            exit(EXIT_FAILURE);
+        }
+        break;
+    case ARGPARSE_BRIEF_OPTION:
+        use_brief = 1;
         break;
     }
 
@@ -150,19 +248,31 @@ int main(int argc, char *argv[])
     struct sockaddr_ll sk_ll_addr;
     struct sockaddr_in sk_udp_addr;
     struct sockaddr* dest_addr;
-    uint8_t cf_seq_num = 0;
-    uint32_t udp_seq_num = 0;
+    uint8_t cf_seq_nums[CAN_ROUTE_MAX_STREAMS] = { 0 };
+    uint32_t udp_seq_nums[CAN_ROUTE_MAX_STREAMS] = { 0 };
+    uint8_t stream;
 
-    uint8_t pdu[MAX_ETH_PDU_SIZE];
-    uint16_t pdu_length = 0;
-    frame_t can_frames[num_acf_msgs];
+    uint8_t* pdu;
+    int pdu_length = 0;
+    frame_t can_frames[MAX_CAN_FRAMES_IN_ACF];
+    uint64_t timestamps[MAX_CAN_FRAMES_IN_ACF];
+    can_aggregator_t aggregator;
+    latency_hist_t hist;
+    uint64_t rx_time_ns = 0;
 
+    // The rules are added while parsing, all CAN IDs go to stream 0 by default
+    can_route_table_init(&routes, CAN_ROUTE_FORWARD, 0);
     argp_parse(&argp, argc, argv, 0, NULL, NULL);
+    if (num_talker_streams == 0) {
+        talker_stream_ids[num_talker_streams++] = STREAM_ID;
+    }
     printf("acf-talker-configuration:\n");
     if(use_tscf)
         printf("\tUsing TSCF\n");
     else
         printf("\tUsing NTSCF\n");
+    if(use_brief)
+        printf("\tUsing ACF CAN Brief messages\n");
     if(can_variant == AVTP_CAN_CLASSIC)
         printf("\tUsing Classic CAN interface: %s\n", can_ifname);
     else if(can_variant == AVTP_CAN_FD)
@@ -173,12 +283,48 @@ int main(int argc, char *argv[])
     } else {
         printf("\tUsing Ethernet\n");
         printf("\tNetwork Interface: %s\n", ifname);
+        if (use_mmap)
+            printf("\tUsing PACKET_MMAP TX ring\n");
         printf("\tDestination MAC Address: %02x:%02x:%02x:%02x:%02x:%02x\n", macaddr[0], macaddr[1], macaddr[2],
                                                         macaddr[3], macaddr[4], macaddr[5]);
     }
-    printf("\tTalker Stream ID: 0x%lx\n", talker_stream_id);
+    for (int i = 0; i < num_talker_streams; i++)
+        printf("\tTalker Stream ID %d: 0x%lx\n", i, talker_stream_ids[i]);
+    if (use_routes)
+        printf("\tCAN routes: %d\n", routes.num_rules);
+    if (timestamp_source == CAN_TIMESTAMP_SOFTWARE)
+        printf("\tUsing software CAN RX timestamps\n");
+    else if (timestamp_source == CAN_TIMESTAMP_HARDWARE)
+        printf("\tUsing hardware CAN RX timestamps\n");
     printf("\tNumber of ACF messages per AVTP frame in talker stream: %d\n", num_acf_msgs);
 
+    if (use_udp && use_mmap) {
+        fprintf(stderr, "The PACKET_MMAP TX ring requires Ethernet\n");
+        return 1;
+    }
+    if (use_brief && timestamp_source != CAN_TIMESTAMP_NONE) {
+        fprintf(stderr, "ACF CAN Brief messages carry no timestamps\n");
+        return 1;
+    }
+    if (can_route_check_streams(&routes, num_talker_streams) < 0) {
+        fprintf(stderr, "A route refers to an undefined talker stream\n");
+        return 1;
+    }
+    if (can_talker_streams_init(&talker_streams, talker_stream_ids,
+                                num_talker_streams, use_tscf) < 0) {
+        fprintf(stderr, "Failed to set up the talker streams\n");
+        return 1;
+    }
+
+    // Lock the memory before the TX ring is mapped, so it is resident as well
+    if (use_mlock && rt_lock_memory() < 0) {
+        return 1;
+    }
+    if (rt_setup_thread(rt_priority, cpu) < 0) {
+        return 1;
+    }
+    latency_hist_init(&hist);
+
     // Create an appropriate talker socket: UDP or Ethernet raw
     // Setup the socket for sending to the destination
     if (use_udp) {
@@ -188,6 +334,13 @@ int main(int argc, char *argv[])
         res = setup_udp_socket_address((struct in_addr*) ip_addr,
                                        udp_port, &sk_udp_addr);
         dest_addr = (struct sockaddr*) &sk_udp_addr;
+    } else if (use_mmap) {
+        res = create_talker_ring(&tx_ring, priority);
+        if (res < 0) return 1;
+        fd = tx_ring.fd;
+        res = setup_socket_address(fd, ifname, macaddr,
+                                   ETH_P_TSN, &sk_ll_addr);
+        dest_addr = (struct sockaddr*) &sk_ll_addr;
     } else {
         fd = create_talker_socket(priority);
         if (fd < 0) return fd;
@@ -201,45 +354,95 @@ int main(int argc, char *argv[])
     can_socket = setup_can_socket(can_ifname, can_variant);
     if (can_socket < 0) goto err;
 
+    // Let the kernel drop the CAN IDs that are not routed
+    if (use_routes && set_can_route_filters(can_socket, &routes) < 0) goto err;
+
+    if (set_can_timestamping(can_socket, can_ifname, timestamp_source) < 0) goto err;
+
+    if (use_mmap) {
+        res = tx_batch_init_ring(&tx_batch, &tx_ring, dest_addr,
+                                 sizeof(struct sockaddr_ll), TX_BATCH_MAX_PDUS);
+    } else {
+        res = tx_batch_init(&tx_batch, fd, dest_addr,
+                            use_udp ? sizeof(struct sockaddr_in) : sizeof(struct sockaddr_ll),
+                            TX_BATCH_MAX_PDUS);
+    }
+    if (res < 0) {
+        goto err;
+    }
+
+    res = can_aggregator_init(&aggregator, can_socket, can_variant,
+                              num_acf_msgs, deadline_us, use_udp, use_tscf);
+    if (res < 0) {
+        goto err;
+    }
+    aggregator.busy_poll = use_busy_poll;
+    aggregator.brief = use_brief;
+    if (use_routes) {
+        aggregator.routes = &routes;
+    }
+
     // Start an infinite loop to keep converting CAN frames to AVTP frames
     for(;;) {
 
-        // Read acf_num_msgs number of CAN frames from the CAN socket
-        int i = 0;
-        while (i < num_acf_msgs) {
-            // Get payload -- will 'spin' here until we get the requested number
-            //                of CAN frames.
-            if(can_variant == AVTP_CAN_FD){
-                res = read(can_socket, &(can_frames[i].fd), sizeof(struct canfd_frame));
-            } else {
-                res = read(can_socket, &(can_frames[i].cc), sizeof(struct can_frame));
-            }
-            if (!res) {
-                perror("Error reading CAN frames");
-                continue;
-            }
-            i++;
+        // Collect up to num_acf_msgs CAN frames. Fewer frames are sent if
+        // the deadline expires or the AVTP frame is full.
+        res = can_aggregator_collect(&aggregator, can_frames, NULL, timestamps);
+        if (res <= 0) {
+            continue;
+        }
+        if (stats_interval) {
+            print_can_rx_stats(&aggregator.stats, stats_interval);
+        }
+
+        // The latency of a batch is measured from the reception of the
+        // first frame of its first PDU, so it includes the aggregation
+        if (tx_batch.num_pdus == 0) {
+            rx_time_ns = aggregator.arrival;
         }
 
         // Pack all the read frames into an AVTP frame
-        pdu_length = can_to_avtp(can_frames, can_variant, pdu, use_udp, use_tscf,
-                                    talker_stream_id, num_acf_msgs, cf_seq_num++, udp_seq_num++);
+        pdu = tx_batch_next(&tx_batch);
+        if (pdu == NULL) {
+            goto err;
+        }
+        stream = aggregator.stream;
+        pdu_length = can_to_avtp_multi_bus(can_frames, NULL, timestamps,
+                                           can_variant, pdu, use_udp,
+                                           use_brief, &talker_streams, stream,
+                                           res,
+                                           cf_seq_nums[stream]++,
+                                           udp_seq_nums[stream]++);
+        if (pdu_length < 0) {
+            fprintf(stderr, "Failed to pack CAN frames: %s\n",
+                    strerror(-pdu_length));
+            continue;
+        }
+        tx_batch_queue(&tx_batch, pdu_length);
 
-        // Send the packed frame out
-        if (use_udp) {
-            res = sendto(fd, pdu, pdu_length, 0,
-                    (struct sockaddr *) dest_addr, sizeof(struct sockaddr_in));
-        } else {
-            res = sendto(fd, pdu, pdu_length, 0,
-                         (struct sockaddr *) dest_addr, sizeof(struct sockaddr_ll));
+        // Send the packed frames out, unless the CAN frames for the next
+        // AVTP frame are already queued. They are sent with one syscall then.
+        // Priority frames are sent at once.
+        if (aggregator.flush_reason == CAN_FLUSH_PRIORITY ||
+            !can_aggregator_ready(&aggregator)) {
+            tx_batch_flush(&tx_batch);
+            if (latency_hist_interval) {
+                latency_hist_add(&hist, rt_now_ns() - rx_time_ns);
+            }
+        }
+        if (stats_interval) {
+            tx_batch_print_stats(&tx_batch, stats_interval);
         }
-        if (res < 0) {
-            perror("Failed to send data");
+        if (latency_hist_interval) {
+            latency_hist_print(&hist, "CAN to AVTP", latency_hist_interval);
         }
     }
 
 err:
-    close(fd);
+    if (use_mmap)
+        packet_ring_close(&tx_ring);
+    else
+        close(fd);
     return 1;
 
 }
@@ -0,0 +1,588 @@
+/*
+ * Copyright (c) 2025, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <linux/can.h>
+
+#include "common/uring.h"
+#include "avtp/Udp.h"
+#include "avtp/acf/Ntscf.h"
+#include "avtp/acf/Tscf.h"
+#include "acf-can-common.h"
+#include "acf-can-uring.h"
+
+#define URING_SQ_ENTRIES            256
+#define URING_CQ_ENTRIES            4096
+#define ETH_RX_BUFS                 256
+#define CAN_RX_BUFS                 1024
+#define ETH_TX_SLOTS                64
+#define CAN_TX_SLOTS                1024
+/* SQEs kept free for re-arming the receives and the deadline timer */
+#define SQE_RESERVE                 8
+
+#define ETH_RX_BGID                 0
+#define CAN_RX_BGID                 1
+
+#define NSEC_PER_SEC                1000000000ULL
+#define NSEC_PER_USEC               1000ULL
+#define USEC_PER_SEC                1000000UL
+
+/* Kinds of operations, stored in the user data of the SQEs */
+enum {
+    OP_ETH_RECV = 1,
+    OP_CAN_RECV,
+    OP_ETH_SEND,
+    OP_CAN_WRITE,
+    OP_DEADLINE,
+    OP_DEADLINE_REMOVE,
+};
+
+/*
+ * TX slots are used in FIFO order. Slots in [done, submitted) are owned by the
+ * kernel, slots in [submitted, queued) wait until the running chain is
+ * complete, so a new chain never overtakes an older one.
+ */
+typedef struct {
+    uint32_t queued;
+    uint32_t submitted;
+    uint32_t done;
+    uint32_t num_slots;
+} tx_fifo_t;
+
+/*
+ * Multishot receive into a provided buffer ring. Completions are processed in
+ * order, so a buffer that cannot be handled because the TX side is busy is
+ * kept in the backlog. Once all buffers are held back, the receive ends with
+ * -ENOBUFS and the kernel queues the packets in the socket instead.
+ */
+typedef struct {
+    int fd;
+    int op;
+    int armed;
+    uring_buf_ring_t br;
+    uint32_t backlog_flags[CAN_RX_BUFS];
+    int backlog_len[CAN_RX_BUFS];
+    uint32_t head;
+    uint32_t tail;
+} rx_queue_t;
+
+typedef struct {
+    uint64_t pdus_rx;
+    uint64_t pdus_tx;
+    uint64_t can_tx;
+    uint64_t tx_errors;
+    uint64_t drops;
+    uint64_t last_print_ns;
+} uring_stats_t;
+
+typedef struct {
+    const acf_can_uring_config_t* cfg;
+    uring_t ring;
+    rx_queue_t eth_rx;
+    rx_queue_t can_rx;
+    size_t can_frame_size;
+    /* Receives CAN frames with control messages, see use_timestamps */
+    struct msghdr can_rx_msg;
+
+    /* AVTP to CAN: CAN frames to write, registered with the ring */
+    frame_t can_tx_frames[CAN_TX_SLOTS];
+    tx_fifo_t can_tx;
+
+    /* CAN to AVTP: frames aggregated for the next PDU */
+    frame_t pending[MAX_CAN_FRAMES_IN_ACF];
+    uint64_t pending_timestamps[MAX_CAN_FRAMES_IN_ACF];
+    uint8_t num_pending;
+    uint8_t pending_stream;
+    uint16_t pending_length;
+    uint16_t max_payload;
+    uint8_t cf_seq_nums[CAN_ROUTE_MAX_STREAMS];
+    uint32_t udp_seq_nums[CAN_ROUTE_MAX_STREAMS];
+    struct __kernel_timespec deadline_ts;
+    uint32_t deadline_gen;
+    int deadline_armed;
+
+    /* AVTP PDUs to send */
+    uint8_t eth_tx_pdus[ETH_TX_SLOTS][MAX_ETH_PDU_SIZE];
+    struct iovec eth_tx_iovs[ETH_TX_SLOTS];
+    struct msghdr eth_tx_msgs[ETH_TX_SLOTS];
+    tx_fifo_t eth_tx;
+
+    can_rx_stats_t can_stats;
+    uring_stats_t stats;
+    seq_stats_timer_t seq_timer;
+} uring_bridge_t;
+
+static uring_bridge_t bridge;
+
+static uint32_t fifo_space(const tx_fifo_t* fifo) {
+    return fifo->num_slots - (fifo->queued - fifo->done);
+}
+
+/* Gets an SQE, submitting the prepared ones first if the queue is full. */
+static struct io_uring_sqe* get_sqe(uring_bridge_t* b) {
+
+    struct io_uring_sqe* sqe = uring_get_sqe(&b->ring);
+
+    if (sqe == NULL) {
+        uring_submit(&b->ring, 0);
+        sqe = uring_get_sqe(&b->ring);
+    }
+
+    return sqe;
+}
+
+static void arm_recv(uring_bridge_t* b, rx_queue_t* rxq) {
+
+    struct io_uring_sqe* sqe = get_sqe(b);
+
+    // One multishot receive posts a completion per packet until it runs out
+    // of provided buffers. RX timestamps need a recvmsg, which places its
+    // control messages in front of the packet in the buffer.
+    if (rxq->op == OP_CAN_RECV && b->cfg->use_timestamps) {
+        sqe->opcode = IORING_OP_RECVMSG;
+        sqe->addr = (uint64_t)(uintptr_t)&b->can_rx_msg;
+        sqe->len = 1;
+    } else {
+        sqe->opcode = IORING_OP_RECV;
+    }
+    sqe->fd = rxq->fd;
+    sqe->ioprio = IORING_RECV_MULTISHOT;
+    sqe->flags = IOSQE_BUFFER_SELECT;
+    sqe->buf_group = rxq->br.bgid;
+    sqe->user_data = URING_UD(rxq->op, 0);
+    rxq->armed = 1;
+}
+
+static void arm_deadline(uring_bridge_t* b) {
+
+    struct io_uring_sqe* sqe = get_sqe(b);
+
+    b->deadline_gen++;
+    sqe->opcode = IORING_OP_TIMEOUT;
+    sqe->addr = (uint64_t)(uintptr_t)&b->deadline_ts;
+    sqe->len = 1;
+    sqe->user_data = URING_UD(OP_DEADLINE, b->deadline_gen);
+    b->deadline_armed = 1;
+}
+
+static void cancel_deadline(uring_bridge_t* b) {
+
+    struct io_uring_sqe* sqe = get_sqe(b);
+
+    sqe->opcode = IORING_OP_TIMEOUT_REMOVE;
+    sqe->addr = URING_UD(OP_DEADLINE, b->deadline_gen);
+    sqe->user_data = URING_UD(OP_DEADLINE_REMOVE, 0);
+    b->deadline_armed = 0;
+}
+
+/* Packs the pending CAN frames into the next free PDU slot. */
+static void flush_frames(uring_bridge_t* b, can_flush_reason_t reason) {
+
+    const acf_can_uring_config_t* cfg = b->cfg;
+    uint8_t stream = b->pending_stream;
+    uint32_t slot;
+    int res;
+
+    if (fifo_space(&b->eth_tx) == 0) {
+        b->stats.drops += b->num_pending;
+    } else {
+        slot = b->eth_tx.queued % ETH_TX_SLOTS;
+        res = can_to_avtp_multi_bus(b->pending, NULL, b->pending_timestamps,
+                                    cfg->can_variant, b->eth_tx_pdus[slot],
+                                    cfg->use_udp, cfg->use_brief,
+                                    cfg->talker_streams, stream,
+                                    b->num_pending, b->cf_seq_nums[stream]++,
+                                    b->udp_seq_nums[stream]++);
+        if (res < 0) {
+            b->stats.drops += b->num_pending;
+        } else {
+            b->eth_tx_iovs[slot].iov_len = res;
+            b->eth_tx.queued++;
+        }
+    }
+
+    b->num_pending = 0;
+    b->pending_length = 0;
+    b->can_stats.flushes[reason]++;
+    if (b->deadline_armed && reason != CAN_FLUSH_DEADLINE) {
+        cancel_deadline(b);
+    }
+    b->deadline_armed = 0;
+}
+
+static void handle_can_frame(uring_bridge_t* b, const uint8_t* buf, int len) {
+
+    const acf_can_uring_config_t* cfg = b->cfg;
+    const can_route_t* route = NULL;
+    uint64_t timestamp = 0;
+    uint8_t stream = 0;
+    frame_t frame;
+    uint16_t length;
+
+    // A multishot recvmsg buffer holds a header, the control messages in the
+    // space of can_rx_msg and then the frame
+    if (cfg->use_timestamps) {
+        const struct io_uring_recvmsg_out* out = (const void*)buf;
+        struct msghdr msg;
+
+        if (len < (int)(sizeof(*out) + b->can_rx_msg.msg_controllen)) {
+            return;
+        }
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_control = (void*)(buf + sizeof(*out));
+        msg.msg_controllen = out->controllen;
+        timestamp = can_rx_timestamp(&msg);
+        len = out->payloadlen;
+        buf += sizeof(*out) + b->can_rx_msg.msg_controllen;
+    }
+
+    memset(&frame, 0, sizeof(frame));
+    memcpy(&frame, buf, len < (int)sizeof(frame) ? len : (int)sizeof(frame));
+    b->can_stats.frames++;
+
+    if (cfg->routes) {
+        route = can_route_lookup(cfg->routes, &frame);
+        if (route->action == CAN_ROUTE_DROP) {
+            b->can_stats.dropped++;
+            return;
+        }
+        stream = route->stream;
+    }
+
+    // A PDU only carries the frames of one talker stream
+    if (b->num_pending && stream != b->pending_stream) {
+        flush_frames(b, CAN_FLUSH_STREAM);
+    }
+    length = acf_can_msg_length(&frame, cfg->can_variant, cfg->use_brief);
+    if (b->num_pending && b->pending_length + length > b->max_payload) {
+        flush_frames(b, CAN_FLUSH_MTU);
+    }
+
+    b->pending_timestamps[b->num_pending] = timestamp;
+    b->pending[b->num_pending++] = frame;
+    b->pending_stream = stream;
+    b->pending_length += length;
+    if (route && route->action == CAN_ROUTE_PRIORITY) {
+        flush_frames(b, CAN_FLUSH_PRIORITY);
+    } else if (b->num_pending == cfg->num_acf_msgs) {
+        flush_frames(b, CAN_FLUSH_COUNT);
+    } else if (b->num_pending == 1 && cfg->deadline_us) {
+        arm_deadline(b);
+    }
+}
+
+static void handle_pdu(uring_bridge_t* b, uint8_t* pdu, int len) {
+
+    const acf_can_uring_config_t* cfg = b->cfg;
+    frame_t can_frames[MAX_CAN_FRAMES_IN_ACF];
+    Avtp_StreamEntry_t* stream;
+    int num_can_msgs;
+
+    if (len <= 0 || len > MAX_ETH_PDU_SIZE) {
+        return;
+    }
+
+    num_can_msgs = avtp_to_can_stream_table(pdu, len, can_frames, NULL,
+                                            cfg->can_variant, cfg->use_udp,
+                                            cfg->listener_streams, &stream);
+    if (num_can_msgs <= 0) {
+        return;
+    }
+    b->stats.pdus_rx++;
+
+    for (int i = 0; i < num_can_msgs; i++) {
+        if (fifo_space(&b->can_tx) == 0) {
+            b->stats.drops++;
+            continue;
+        }
+        b->can_tx_frames[b->can_tx.queued % CAN_TX_SLOTS] = can_frames[i];
+        b->can_tx.queued++;
+    }
+}
+
+/*
+ * Submits the queued CAN frames or PDUs as one chain of hard linked SQEs. The
+ * kernel executes them in order and a failed write does not cancel the rest.
+ */
+static void submit_chain(uring_bridge_t* b, tx_fifo_t* fifo, int op) {
+
+    uint32_t num = fifo->queued - fifo->submitted;
+    unsigned space = uring_sq_space(&b->ring);
+    struct io_uring_sqe* sqe = NULL;
+
+    if (fifo->submitted != fifo->done || num == 0) {
+        return;
+    }
+    // The chain must not be split by a submission in between
+    if (space <= SQE_RESERVE) {
+        return;
+    }
+    if (num > space - SQE_RESERVE) {
+        num = space - SQE_RESERVE;
+    }
+
+    for (uint32_t i = 0; i < num; i++) {
+        uint32_t slot = (fifo->submitted + i) % fifo->num_slots;
+
+        sqe = uring_get_sqe(&b->ring);
+        if (op == OP_CAN_WRITE) {
+            sqe->opcode = IORING_OP_WRITE_FIXED;
+            sqe->fd = b->cfg->can_socket;
+            sqe->addr = (uint64_t)(uintptr_t)&b->can_tx_frames[slot];
+            sqe->len = b->can_frame_size;
+            sqe->buf_index = 0;
+        } else {
+            sqe->opcode = IORING_OP_SENDMSG;
+            sqe->fd = b->cfg->eth_socket;
+            sqe->addr = (uint64_t)(uintptr_t)&b->eth_tx_msgs[slot];
+        }
+        sqe->flags = IOSQE_IO_HARDLINK;
+        sqe->user_data = URING_UD(op, slot);
+    }
+    sqe->flags &= ~IOSQE_IO_HARDLINK;
+    fifo->submitted += num;
+}
+
+static void handle_tx_completion(uring_bridge_t* b, tx_fifo_t* fifo,
+                                 uint64_t* count, int res) {
+
+    fifo->done++;
+    if (res < 0) {
+        b->stats.tx_errors++;
+    } else {
+        (*count)++;
+    }
+}
+
+static void handle_recv_completion(rx_queue_t* rxq, struct io_uring_cqe* cqe) {
+
+    if (cqe->res > 0 && (cqe->flags & IORING_CQE_F_BUFFER)) {
+        uint32_t index = rxq->tail % rxq->br.num_bufs;
+
+        rxq->backlog_flags[index] = cqe->flags;
+        rxq->backlog_len[index] = cqe->res;
+        rxq->tail++;
+    } else if (cqe->res < 0 && cqe->res != -ENOBUFS) {
+        fprintf(stderr, "Failed to receive %s: %s\n",
+                rxq->op == OP_ETH_RECV ? "AVTP PDU" : "CAN frame",
+                strerror(-cqe->res));
+    }
+
+    if (!(cqe->flags & IORING_CQE_F_MORE)) {
+        rxq->armed = 0;
+    }
+}
+
+/*
+ * Processes received buffers as long as the TX side has room for the result.
+ * An AVTP PDU turns into up to MAX_CAN_FRAMES_IN_ACF CAN frames, a CAN frame
+ * completes at most two PDUs (MTU and count flush).
+ */
+static void process_backlog(uring_bridge_t* b, rx_queue_t* rxq) {
+
+    while (rxq->head != rxq->tail) {
+        uint32_t index = rxq->head % rxq->br.num_bufs;
+        uint32_t flags = rxq->backlog_flags[index];
+        uint8_t* buf = uring_buf_ring_get(&rxq->br, flags);
+
+        if (rxq->op == OP_ETH_RECV) {
+            if (fifo_space(&b->can_tx) < MAX_CAN_FRAMES_IN_ACF) {
+                break;
+            }
+            handle_pdu(b, buf, rxq->backlog_len[index]);
+        } else {
+            if (fifo_space(&b->eth_tx) < 2) {
+                break;
+            }
+            handle_can_frame(b, buf, rxq->backlog_len[index]);
+        }
+        uring_buf_ring_recycle(&rxq->br, flags);
+        rxq->head++;
+    }
+
+    // Re-arm an ended multishot receive once buffers are available again
+    if (!rxq->armed && rxq->tail - rxq->head < rxq->br.num_bufs) {
+        arm_recv(b, rxq);
+    }
+}
+
+static void handle_completion(uring_bridge_t* b, struct io_uring_cqe* cqe) {
+
+    switch (URING_UD_TYPE(cqe->user_data)) {
+    case OP_ETH_RECV:
+        handle_recv_completion(&b->eth_rx, cqe);
+        break;
+    case OP_CAN_RECV:
+        handle_recv_completion(&b->can_rx, cqe);
+        break;
+    case OP_CAN_WRITE:
+        handle_tx_completion(b, &b->can_tx, &b->stats.can_tx, cqe->res);
+        break;
+    case OP_ETH_SEND:
+        handle_tx_completion(b, &b->eth_tx, &b->stats.pdus_tx, cqe->res);
+        break;
+    case OP_DEADLINE:
+        // Removed timers complete with -ECANCELED and older generations
+        // belong to frames that were sent already
+        if (cqe->res == -ETIME && b->deadline_armed &&
+            URING_UD_INDEX(cqe->user_data) == b->deadline_gen) {
+            b->deadline_armed = 0;
+            flush_frames(b, CAN_FLUSH_DEADLINE);
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+static void print_stats(uring_bridge_t* b, uint32_t interval_s) {
+
+    struct timespec now;
+    uint64_t now_ns;
+
+    b->can_stats.syscalls = b->ring.enters;
+    print_can_rx_stats(&b->can_stats, interval_s);
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    now_ns = now.tv_sec * NSEC_PER_SEC + now.tv_nsec;
+    if (b->stats.last_print_ns == 0) {
+        b->stats.last_print_ns = now_ns;
+        return;
+    }
+    if (now_ns - b->stats.last_print_ns < interval_s * NSEC_PER_SEC) {
+        return;
+    }
+    b->stats.last_print_ns = now_ns;
+
+    fprintf(stderr, "[INFO]io_uring: %" PRIu64 " enters, %" PRIu64
+            " PDUs received, %" PRIu64 " CAN frames written, %" PRIu64
+            " PDUs sent, %" PRIu64 " TX errors, %" PRIu64 " dropped\n",
+            b->ring.enters, b->stats.pdus_rx, b->stats.can_tx,
+            b->stats.pdus_tx, b->stats.tx_errors, b->stats.drops);
+}
+
+int acf_can_uring_run(const acf_can_uring_config_t* cfg) {
+
+    uring_bridge_t* b = &bridge;
+    struct io_uring_cqe* cqe;
+    struct iovec can_tx_iov;
+    int res;
+
+    memset(b, 0, sizeof(*b));
+    b->cfg = cfg;
+    b->can_tx.num_slots = CAN_TX_SLOTS;
+    b->eth_tx.num_slots = ETH_TX_SLOTS;
+    if (cfg->can_variant == AVTP_CAN_FD) {
+        b->can_frame_size = sizeof(struct canfd_frame);
+    } else {
+        b->can_frame_size = sizeof(struct can_frame);
+    }
+    b->max_payload = MAX_ETH_PDU_SIZE -
+            (cfg->use_tscf ? AVTP_TSCF_HEADER_LEN : AVTP_NTSCF_HEADER_LEN) -
+            (cfg->use_udp ? AVTP_UDP_HEADER_LEN : 0);
+    b->deadline_ts.tv_sec = cfg->deadline_us / USEC_PER_SEC;
+    b->deadline_ts.tv_nsec = (cfg->deadline_us % USEC_PER_SEC) * NSEC_PER_USEC;
+
+    for (int i = 0; i < ETH_TX_SLOTS; i++) {
+        b->eth_tx_iovs[i].iov_base = b->eth_tx_pdus[i];
+        b->eth_tx_msgs[i].msg_name = (void*)cfg->dest_addr;
+        b->eth_tx_msgs[i].msg_namelen = cfg->dest_addr_len;
+        b->eth_tx_msgs[i].msg_iov = &b->eth_tx_iovs[i];
+        b->eth_tx_msgs[i].msg_iovlen = 1;
+    }
+
+    res = uring_init(&b->ring, URING_SQ_ENTRIES, URING_CQ_ENTRIES);
+    if (res < 0) {
+        return -1;
+    }
+
+    b->eth_rx.fd = cfg->eth_socket;
+    b->eth_rx.op = OP_ETH_RECV;
+    res = uring_buf_ring_init(&b->ring, &b->eth_rx.br, ETH_RX_BGID, ETH_RX_BUFS,
+                              MAX_ETH_PDU_SIZE);
+    if (res < 0) {
+        goto err;
+    }
+    b->can_rx.fd = cfg->can_socket;
+    b->can_rx.op = OP_CAN_RECV;
+    b->can_rx_msg.msg_controllen = cfg->use_timestamps ?
+                                   CAN_TIMESTAMP_CMSG_SPACE : 0;
+    res = uring_buf_ring_init(&b->ring, &b->can_rx.br, CAN_RX_BGID, CAN_RX_BUFS,
+                              sizeof(struct io_uring_recvmsg_out) +
+                              b->can_rx_msg.msg_controllen +
+                              sizeof(struct canfd_frame));
+    if (res < 0) {
+        goto err;
+    }
+
+    // The CAN frames are written with IORING_OP_WRITE_FIXED, which saves
+    // pinning the pages for every write
+    can_tx_iov.iov_base = b->can_tx_frames;
+    can_tx_iov.iov_len = sizeof(b->can_tx_frames);
+    res = uring_register_buffers(&b->ring, &can_tx_iov, 1);
+    if (res < 0) {
+        goto err;
+    }
+
+    for (;;) {
+        process_backlog(b, &b->eth_rx);
+        process_backlog(b, &b->can_rx);
+        submit_chain(b, &b->can_tx, OP_CAN_WRITE);
+        submit_chain(b, &b->eth_tx, OP_ETH_SEND);
+
+        res = uring_submit(&b->ring, 1);
+        if (res < 0 && res != -EINTR && res != -EBUSY && res != -EAGAIN) {
+            fprintf(stderr, "Failed to submit to io_uring: %s\n", strerror(-res));
+            break;
+        }
+
+        while ((cqe = uring_peek_cqe(&b->ring)) != NULL) {
+            handle_completion(b, cqe);
+            uring_cqe_seen(&b->ring);
+        }
+
+        if (cfg->stats_interval) {
+            print_stats(b, cfg->stats_interval);
+        }
+        if (cfg->listener_streams) {
+            print_stream_seq_stats(cfg->listener_streams, &b->seq_timer,
+                                   cfg->stats_interval);
+        }
+    }
+
+err:
+    uring_buf_ring_close(&b->ring, &b->can_rx.br);
+    uring_buf_ring_close(&b->ring, &b->eth_rx.br);
+    uring_close(&b->ring);
+    return -1;
+}
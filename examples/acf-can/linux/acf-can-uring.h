@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2025, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <sys/socket.h>
+
+#include "avtp/acf/Can.h"
+#include "avtp/StreamTable.h"
+
+/* Configuration of the io_uring engine of acf-can-bridge */
+typedef struct {
+    /* Ethernet (AF_PACKET) or UDP socket, receives the listener stream */
+    int eth_socket;
+    /* CAN socket created with setup_can_socket() */
+    int can_socket;
+    const struct sockaddr* dest_addr;
+    socklen_t dest_addr_len;
+    Avtp_CanVariant_t can_variant;
+    int use_udp;
+    int use_tscf;
+    /* Send ACF CAN Brief messages, both types are accepted on receive */
+    int use_brief;
+    /* Number of CAN frames per AVTP PDU */
+    uint8_t num_acf_msgs;
+    /* Max. time a CAN frame waits for aggregation, 0 for no limit */
+    uint32_t deadline_us;
+    /* Talker streams, in the format given by use_tscf */
+    const can_talker_streams_t* talker_streams;
+    /* Routes of the received CAN frames to the talker streams, all go to
+       stream 0 if NULL */
+    const can_route_table_t* routes;
+    /* Receive the CAN frames with their RX timestamps, which have to be
+       enabled on can_socket with set_can_timestamping() */
+    int use_timestamps;
+    /* Accepted streams, which also keep their sequence trackers */
+    const Avtp_StreamTable_t* listener_streams;
+    /* Interval for printing statistics in seconds, 0 to disable */
+    uint32_t stats_interval;
+} acf_can_uring_config_t;
+
+/**
+ * Runs both directions of the bridge in a single thread on top of io_uring.
+ * AVTP PDUs and CAN frames are received with multishot receives into
+ * provided buffer rings, CAN frames are written from registered buffers and
+ * each batch of writes and sends is submitted as a linked chain, so the order
+ * of frames is preserved. All of this costs one io_uring_enter() call per
+ * loop iteration.
+ *
+ * @param cfg Configuration of the bridge
+ * @returns -1, only returns on error
+ */
+int acf_can_uring_run(const acf_can_uring_config_t* cfg);
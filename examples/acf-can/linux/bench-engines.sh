@@ -0,0 +1,98 @@
+#!/bin/bash
+#
+# Copyright (c) 2025, COVESA
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+#    # Redistributions of source code must retain the above copyright notice,
+#      this list of conditions and the following disclaimer.
+#    # Redistributions in binary form must reproduce the above copyright
+#      notice, this list of conditions and the following disclaimer in the
+#      documentation and/or other materials provided with the distribution.
+#    # Neither the name of COVESA nor the names of its contributors may be
+#      used to endorse or promote products derived from this software without
+#      specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+# DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+# FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+# DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+# SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+# CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+# OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+# Compares the threads and io_uring engines of acf-can-bridge on virtual
+# interfaces:
+#
+#   cangen -> vcan0 -> acf-can-bridge -> veth0 -> veth1 -> acf-can-listener -> vcan1 -> candump
+#
+# For each engine the CPU time and the context switches of the bridge and the
+# number of CAN frames arriving on vcan1 are printed. Needs root, the vcan
+# module and can-utils.
+#
+# Usage: bench-engines.sh [BUILD_DIR] [DURATION_S] [GAP_MS] [COUNT]
+
+BUILD_DIR=${1:-build}
+DURATION=${2:-10}
+GAP_MS=${3:-0}
+COUNT=${4:-8}
+BIN=$BUILD_DIR/examples/acf-can/linux
+MAC=aa:bb:cc:dd:ee:ff
+
+set -e
+
+setup() {
+    modprobe vcan
+    for dev in vcan0 vcan1; do
+        ip link show $dev > /dev/null 2>&1 || ip link add $dev type vcan
+        ip link set $dev up
+    done
+    ip link show veth0 > /dev/null 2>&1 || ip link add veth0 type veth peer name veth1
+    ip link set veth0 up
+    ip link set veth1 up
+}
+
+# Sums a field of /proc/PID/task/*/status over all threads of PID
+sum_status() {
+    cat /proc/$1/task/*/status | awk -v field="$2:" '$1 == field { sum += $2 } END { print sum }'
+}
+
+run_engine() {
+    local engine=$1
+
+    $BIN/acf-can-listener -i veth1 -d $MAC --canif vcan1 > /dev/null 2>&1 &
+    local listener=$!
+    $BIN/acf-can-bridge -i veth0 -d $MAC --canif vcan0 -c $COUNT \
+        --engine=$engine > /dev/null 2>&1 &
+    local bridge=$!
+    candump -n 0 vcan1 2> /dev/null | wc -l > /tmp/bench-engines.frames &
+    local dump=$!
+    sleep 1
+
+    timeout $DURATION cangen vcan0 -g $GAP_MS -L 8 -I i -D i || true
+    sleep 1
+
+    # utime and stime in clock ticks, fields 14 and 15 of /proc/PID/stat
+    local ticks=$(awk '{ print $14 + $15 }' /proc/$bridge/stat)
+    local hz=$(getconf CLK_TCK)
+    local voluntary=$(sum_status $bridge voluntary_ctxt_switches)
+    local involuntary=$(sum_status $bridge nonvoluntary_ctxt_switches)
+
+    kill $bridge $listener
+    pkill -f "candump -n 0 vcan1" || true
+    wait $dump 2> /dev/null || true
+
+    printf "%-8s cpu %6.2f s  ctx switches %8d voluntary %8d involuntary  frames %d\n" \
+        $engine $(echo "$ticks / $hz" | bc -l) $voluntary $involuntary \
+        $(cat /tmp/bench-engines.frames)
+}
+
+setup
+run_engine threads
+run_engine uring
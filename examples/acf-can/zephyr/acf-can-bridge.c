@@ -60,10 +60,12 @@ LOG_MODULE_REGISTER(acf_can_bridge, LOG_LEVEL_DBG);
 #define THREAD_STACK_SIZE 3000
 #define THREAD_PRIORITY_CAN_TO_AVTP -1
 #define THREAD_PRIORITY_AVTP_TO_CAN -2
+#define SEQ_STATS_INTERVAL_MS 10000
 
 static uint8_t macaddr[NET_ETH_ADDR_LEN];
 static struct in_addr ip_addr;
 static uint8_t use_tscf = CONFIG_ACF_CAN_BRIDGE_USE_TSCF;
+static uint8_t use_brief = CONFIG_ACF_CAN_BRIDGE_USE_BRIEF;
 static uint8_t use_udp = CONFIG_ACF_CAN_BRIDGE_USE_UDP;
 static uint32_t udp_listen_port = CONFIG_ACF_CAN_BRIDGE_RECV_UDP_PORT;
 static uint32_t udp_send_port = CONFIG_ACF_CAN_BRIDGE_SEND_UDP_PORT;
@@ -71,6 +73,8 @@ static uint8_t num_acf_msgs = CONFIG_ACF_CAN_BRIDGE_NUM_ACF_MSGS;
 static uint64_t listener_stream_id;
 static uint64_t talker_stream_id;
 static Avtp_CanVariant_t can_variant = AVTP_CAN_CLASSIC;
+static can_route_table_t routes;
+static can_talker_streams_t talker_streams;
 
 int eth_socket = 0;
 struct sockaddr* dest_addr;
@@ -105,12 +109,53 @@ static int init_can_dev()
     return ret;
 }
 
+static int add_can_rx_filters(const can_route_filter_t* filters, int num_filters)
+{
+    int filter_ids[CAN_ROUTE_MAX_RULES];
+    int filter_id = 0;
+    int i;
+
+    for (i = 0; i < num_filters; i++) {
+        struct can_filter rx_filter = {
+            .id = filters[i].id & CAN_EFF_MASK,
+            .mask = filters[i].mask & CAN_EFF_MASK,
+            .flags = (filters[i].id & CAN_EFF_FLAG) ? CAN_FILTER_IDE : 0,
+        };
+        filter_id = can_add_rx_filter_msgq(can_dev, &rx_msgq, &rx_filter);
+        if (filter_id < 0) {
+            break;
+        }
+        filter_ids[i] = filter_id;
+    }
+    if (filter_id < 0) {
+        // Leave no partial set of filters behind
+        while (i-- > 0) {
+            can_remove_rx_filter(can_dev, filter_ids[i]);
+        }
+    }
+    return filter_id;
+}
+
 static int init_can_rx()
 {
-    // This is a generic receive filter that will accept all frames
-    struct can_filter rx_filter={.id=1,.mask=0,.flags=0};
+    // Receive filters passing the frames the routing table does not drop,
+    // falling back to filters accepting all frames if the controller runs
+    // out of them. Routing then drops the unwanted frames in software.
+    can_route_filter_t filters[CAN_ROUTE_MAX_RULES];
+    can_route_filter_t pass_all[2] = {
+        {.id = 0, .mask = 0},
+        {.id = CAN_EFF_FLAG, .mask = 0},
+    };
+    int num_filters;
     int filter_id;
-    filter_id = can_add_rx_filter_msgq(can_dev, &rx_msgq, &rx_filter);
+
+    num_filters = can_route_filters(&routes, filters, CAN_ROUTE_MAX_RULES);
+    filter_id = add_can_rx_filters(filters, num_filters);
+    if(filter_id == -ENOSPC) {
+        printf("ENOSPC: no free filters for %d routes, accepting all frames\n",
+               num_filters);
+        filter_id = add_can_rx_filters(pass_all, 2);
+    }
     if(filter_id == -ENOSPC) {
         printf("ENOSPC: there are no free filters\n");
     }
@@ -251,12 +296,21 @@ void can_to_avtp_runnable(void* p1, void* p2, void* p3) {
                 printf("%d\n", res);
                 continue;
             }
+            const can_route_t* route = can_route_lookup(&routes, &can_frames[i]);
+            if (route->action == CAN_ROUTE_DROP) {
+                continue;
+            }
             i++;
+            // Priority frames are sent without waiting for more frames
+            if (route->action == CAN_ROUTE_PRIORITY) {
+                break;
+            }
         }
 
         // Pack all the read frames into an AVTP frame
         pdu_length = can_to_avtp(can_frames, can_variant, pdu, use_udp, use_tscf,
-                                    talker_stream_id, num_acf_msgs, cf_seq_num++, udp_seq_num++);
+                                    use_brief, &talker_streams, talker_stream_id,
+                                    i, cf_seq_num++, udp_seq_num++);
 
         // Send the packed frame out over Ethernet
         if (use_udp) {
@@ -278,8 +332,8 @@ void avtp_to_can_runnable(void* p1, void* p2, void* p3) {
 
     uint16_t pdu_length = 0;
     int8_t num_can_msgs = 0;
-    uint8_t exp_cf_seqnum = 0;
-    uint32_t exp_udp_seqnum = 0;
+    static Avtp_SeqTracker_t cf_seq, udp_seq;
+    int64_t last_stats_ms = k_uptime_get();
     uint8_t pdu[MAX_ETH_PDU_SIZE];
     static frame_t can_frames[MAX_CAN_FRAMES_IN_ACF];
     struct pollfd fds[1];
@@ -318,13 +372,19 @@ void avtp_to_can_runnable(void* p1, void* p2, void* p3) {
                 continue;
             }
 
-            num_can_msgs = avtp_to_can(pdu, can_frames, can_variant, use_udp,
-                                listener_stream_id, &exp_cf_seqnum, &exp_udp_seqnum);
+            num_can_msgs = avtp_to_can(pdu, pdu_length, can_frames, can_variant, use_udp,
+                                listener_stream_id, &cf_seq, &udp_seq);
+            if (k_uptime_get() - last_stats_ms >= SEQ_STATS_INTERVAL_MS) {
+                last_stats_ms = k_uptime_get();
+                LOG_INF("AVTP seq: received %" PRIu64 " lost %" PRIu64
+                        " reordered %" PRIu64 " duplicates %" PRIu64
+                        " late %" PRIu64, cf_seq.stats.received,
+                        cf_seq.stats.lost, cf_seq.stats.reordered,
+                        cf_seq.stats.duplicates, cf_seq.stats.late);
+            }
             if (num_can_msgs <= 0) {
                 continue;
             }
-            exp_cf_seqnum++;
-            exp_udp_seqnum++;
 
             for (int8_t i = 0; i < num_can_msgs; i++) {
                 int res;
@@ -352,12 +412,37 @@ int main(void)
     uint64_str = CONFIG_ACF_CAN_BRIDGE_LISTENER_STREAM_ID;
     listener_stream_id = strtoull(uint64_str, NULL, 16);
 
+    // CAN ID routes, separated by spaces
+    uint8_t default_action, default_stream;
+    if (can_route_parse_action(CONFIG_ACF_CAN_BRIDGE_DEFAULT_ROUTE,
+                               &default_action, &default_stream) < 0) {
+        fprintf(stderr, "Invalid default route\n");
+        exit(EXIT_FAILURE);
+    }
+    can_route_table_init(&routes, default_action, default_stream);
+    static char route_str[] = CONFIG_ACF_CAN_BRIDGE_ROUTES;
+    char* save_ptr;
+    for (char* rule = strtok_r(route_str, " ", &save_ptr); rule != NULL;
+         rule = strtok_r(NULL, " ", &save_ptr)) {
+        if (can_route_parse(&routes, rule) < 0) {
+            fprintf(stderr, "Invalid route %s\n", rule);
+            exit(EXIT_FAILURE);
+        }
+    }
+    // There is a single talker stream
+    if (can_route_check_streams(&routes, 1) < 0) {
+        fprintf(stderr, "Routes must send to stream 0\n");
+        exit(EXIT_FAILURE);
+    }
+
     // Print current configuration
     printf("acf-can-bridge configuration:\n");
     if(use_tscf)
         printf("\tUsing TSCF\n");
     else
         printf("\tUsing NTSCF\n");
+    if(use_brief)
+        printf("\tSending ACF CAN Brief messages\n");
     if(can_variant == AVTP_CAN_CLASSIC)
         printf("\tUsing Classic CAN\n");
     else if(can_variant == AVTP_CAN_FD)
@@ -380,6 +465,8 @@ int main(void)
     }
     printf("\tListener Stream ID: 0x%"PRIx64", Talker Stream ID: 0x%"PRIx64"\n", listener_stream_id, talker_stream_id);
     printf("\tNumber of ACF messages per AVTP frame in talker stream: %d\n", num_acf_msgs);
+    printf("\tCAN routes: %d, default route: %s\n", routes.num_rules,
+           CONFIG_ACF_CAN_BRIDGE_DEFAULT_ROUTE);
 
     // Open a CAN socket for reading frames
     // init CAN Dev
@@ -29,11 +29,15 @@
  */
 
 #ifdef __linux__
+#define _GNU_SOURCE
 #include <arpa/inet.h>
 #include <linux/if.h>
 #include <linux/if_ether.h>
 #include <linux/if_packet.h>
+#include <linux/filter.h>
+#include <poll.h>
 #include <sys/ioctl.h>
+#include <sys/mman.h>
 #include <sys/socket.h>
 #include <sys/timerfd.h>
 #include <sys/types.h>
@@ -41,12 +45,18 @@
 #include <zephyr/net/socket.h>
 #endif
 
+#include <errno.h>
+#include <inttypes.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <time.h>
 #include <unistd.h>
 
 #include "common.h"
+#ifdef __linux__
+#include "xdp.h"
+#endif
 
 #ifdef __linux__
 #define NSEC_PER_SEC		1000000000ULL
@@ -133,6 +143,485 @@ int present_data(uint8_t *data, size_t len)
 
     return 0;
 }
+
+int tx_batch_init(tx_batch_t *batch, int fd, const struct sockaddr *dest_addr,
+                socklen_t addr_len, unsigned int max_pdus)
+{
+    if (max_pdus < 1 || max_pdus > TX_BATCH_MAX_PDUS) {
+        fprintf(stderr, "Invalid transmit batch size %u\n", max_pdus);
+        return -1;
+    }
+
+    batch->fd = fd;
+    batch->ring = NULL;
+    batch->xsk = NULL;
+    batch->dest_addr = dest_addr;
+    batch->addr_len = addr_len;
+    batch->max_pdus = max_pdus;
+    batch->num_pdus = 0;
+    batch->syscalls = 0;
+    batch->packets = 0;
+    batch->last_print_ns = 0;
+
+    return 0;
+}
+
+int tx_batch_init_ring(tx_batch_t *batch, packet_ring_t *ring,
+                const struct sockaddr *dest_addr, socklen_t addr_len,
+                unsigned int max_pdus)
+{
+    int res;
+
+    res = tx_batch_init(batch, ring->fd, dest_addr, addr_len, max_pdus);
+    if (res < 0)
+        return -1;
+
+    batch->ring = ring;
+
+    return 0;
+}
+
+uint8_t *tx_batch_next(tx_batch_t *batch)
+{
+    if (batch->ring)
+        return packet_ring_tx_next(batch->ring);
+    if (batch->xsk)
+        return xdp_socket_tx_next(batch->xsk);
+
+    return batch->pdus[batch->num_pdus];
+}
+
+int tx_batch_queue(tx_batch_t *batch, size_t len)
+{
+    if (batch->ring)
+        packet_ring_tx_queue(batch->ring, len);
+    else if (batch->xsk)
+        xdp_socket_tx_queue(batch->xsk, len);
+    else
+        batch->lengths[batch->num_pdus] = len;
+    batch->num_pdus++;
+
+    if (batch->num_pdus == batch->max_pdus)
+        return tx_batch_flush(batch);
+
+    return 0;
+}
+
+int tx_batch_flush(tx_batch_t *batch)
+{
+    struct mmsghdr msgs[TX_BATCH_MAX_PDUS];
+    struct iovec iovs[TX_BATCH_MAX_PDUS];
+    unsigned int sent = 0;
+    int res;
+
+    if (batch->ring) {
+        if (batch->num_pdus == 0)
+            return 0;
+        res = packet_ring_tx_flush(batch->ring, batch->dest_addr,
+                                   batch->addr_len);
+        if (res == 0) {
+            batch->syscalls++;
+            batch->packets += batch->num_pdus;
+        }
+        batch->num_pdus = 0;
+        return res;
+    }
+
+    if (batch->xsk) {
+        uint64_t kicks = batch->xsk->kicks;
+
+        if (batch->num_pdus == 0)
+            return 0;
+        res = xdp_socket_tx_flush(batch->xsk);
+        batch->syscalls += batch->xsk->kicks - kicks;
+        if (res == 0)
+            batch->packets += batch->num_pdus;
+        batch->num_pdus = 0;
+        return res;
+    }
+
+    memset(msgs, 0, batch->num_pdus * sizeof(msgs[0]));
+    for (unsigned int i = 0; i < batch->num_pdus; i++) {
+        iovs[i].iov_base = batch->pdus[i];
+        iovs[i].iov_len = batch->lengths[i];
+        msgs[i].msg_hdr.msg_name = (void *) batch->dest_addr;
+        msgs[i].msg_hdr.msg_namelen = batch->addr_len;
+        msgs[i].msg_hdr.msg_iov = &iovs[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    /* sendmmsg() may send fewer PDUs than requested. */
+    while (sent < batch->num_pdus) {
+        res = sendmmsg(batch->fd, &msgs[sent], batch->num_pdus - sent, 0);
+        if (res < 0) {
+            if (errno == EINTR)
+                continue;
+            perror("Failed to send data");
+            batch->num_pdus = 0;
+            return -1;
+        }
+        batch->syscalls++;
+        batch->packets += res;
+        sent += res;
+    }
+    batch->num_pdus = 0;
+
+    return 0;
+}
+
+void tx_batch_print_stats(tx_batch_t *batch, uint32_t interval_s)
+{
+    struct timespec now;
+    uint64_t now_ns;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    now_ns = now.tv_sec * NSEC_PER_SEC + now.tv_nsec;
+    if (interval_s) {
+        if (batch->last_print_ns == 0) {
+            batch->last_print_ns = now_ns;
+            return;
+        }
+        if (now_ns - batch->last_print_ns < interval_s * NSEC_PER_SEC)
+            return;
+    }
+    batch->last_print_ns = now_ns;
+
+    fprintf(stderr, "TX: %" PRIu64 " packets in %" PRIu64 " syscalls "
+            "(%.2f syscalls/packet)\n", batch->packets, batch->syscalls,
+            batch->packets ? (double) batch->syscalls / batch->packets : 0.0);
+}
+
+/* Map the ring set up with the given socket option into user space. */
+static int map_packet_ring(packet_ring_t *ring, int option, void *req,
+                socklen_t req_len, unsigned int num_slots,
+                unsigned int slot_size, size_t map_size)
+{
+    int res;
+
+    res = setsockopt(ring->fd, SOL_PACKET, option, req, req_len);
+    if (res < 0) {
+        perror("Failed to set up packet ring");
+        return -1;
+    }
+
+    ring->map = mmap(NULL, map_size, PROT_READ | PROT_WRITE,
+                     MAP_SHARED | MAP_LOCKED | MAP_POPULATE, ring->fd, 0);
+    if (ring->map == MAP_FAILED) {
+        /* MAP_LOCKED fails if RLIMIT_MEMLOCK is too low. */
+        ring->map = mmap(NULL, map_size, PROT_READ | PROT_WRITE,
+                         MAP_SHARED | MAP_POPULATE, ring->fd, 0);
+    }
+    if (ring->map == MAP_FAILED) {
+        perror("Failed to map packet ring");
+        ring->map = NULL;
+        return -1;
+    }
+
+    ring->map_size = map_size;
+    ring->num_slots = num_slots;
+    ring->slot_size = slot_size;
+    ring->current = 0;
+    ring->block = NULL;
+    ring->packet = NULL;
+    ring->packets_left = 0;
+    ring->queued = 0;
+
+    return 0;
+}
+
+int create_listener_ring(packet_ring_t *ring, char *ifname, uint8_t macaddr[],
+                int protocol)
+{
+    int res, version = TPACKET_V3;
+    struct tpacket_req3 req;
+
+    ring->fd = create_listener_socket(ifname, macaddr, protocol);
+    if (ring->fd < 0)
+        return -1;
+
+    res = setsockopt(ring->fd, SOL_PACKET, PACKET_VERSION, &version,
+                     sizeof(version));
+    if (res < 0) {
+        perror("Failed to set TPACKET_V3");
+        goto err;
+    }
+
+    /* A block is passed to user space when it is full or when the oldest
+     * packet in it waited for PACKET_RING_RX_TIMEOUT.
+     */
+    memset(&req, 0, sizeof(req));
+    req.tp_block_size = PACKET_RING_BLOCK_SIZE;
+    req.tp_block_nr = PACKET_RING_RX_BLOCKS;
+    req.tp_frame_size = PACKET_RING_FRAME_SIZE;
+    req.tp_frame_nr = (PACKET_RING_BLOCK_SIZE / PACKET_RING_FRAME_SIZE) *
+                      PACKET_RING_RX_BLOCKS;
+    req.tp_retire_blk_tov = PACKET_RING_RX_TIMEOUT;
+
+    res = map_packet_ring(ring, PACKET_RX_RING, &req, sizeof(req),
+                          PACKET_RING_RX_BLOCKS, PACKET_RING_BLOCK_SIZE,
+                          (size_t) PACKET_RING_BLOCK_SIZE *
+                          PACKET_RING_RX_BLOCKS);
+    if (res < 0)
+        goto err;
+
+    return 0;
+
+err:
+    close(ring->fd);
+    return -1;
+}
+
+int create_talker_ring(packet_ring_t *ring, int priority)
+{
+    int res, version = TPACKET_V2;
+    struct tpacket_req req;
+    unsigned int num_frames;
+
+    ring->fd = create_talker_socket(priority);
+    if (ring->fd < 0)
+        return -1;
+
+    /* TPACKET_V3 only adds block based reception, so the TX ring uses the
+     * frame based TPACKET_V2 layout.
+     */
+    res = setsockopt(ring->fd, SOL_PACKET, PACKET_VERSION, &version,
+                     sizeof(version));
+    if (res < 0) {
+        perror("Failed to set TPACKET_V2");
+        goto err;
+    }
+
+    num_frames = (PACKET_RING_BLOCK_SIZE / PACKET_RING_FRAME_SIZE) *
+                 PACKET_RING_TX_BLOCKS;
+    memset(&req, 0, sizeof(req));
+    req.tp_block_size = PACKET_RING_BLOCK_SIZE;
+    req.tp_block_nr = PACKET_RING_TX_BLOCKS;
+    req.tp_frame_size = PACKET_RING_FRAME_SIZE;
+    req.tp_frame_nr = num_frames;
+
+    res = map_packet_ring(ring, PACKET_TX_RING, &req, sizeof(req),
+                          num_frames, PACKET_RING_FRAME_SIZE,
+                          (size_t) PACKET_RING_BLOCK_SIZE *
+                          PACKET_RING_TX_BLOCKS);
+    if (res < 0)
+        goto err;
+
+    return 0;
+
+err:
+    close(ring->fd);
+    return -1;
+}
+
+int packet_ring_recv(packet_ring_t *ring, uint8_t **pdu, int timeout_ms)
+{
+    struct tpacket_block_desc *block;
+    struct tpacket3_hdr *packet;
+    struct pollfd pfd;
+    int res;
+
+    for (;;) {
+        /* Give the block back to the kernel once all its packets have been
+         * consumed. The last packet was valid until this call.
+         */
+        if (ring->block && ring->packets_left == 0) {
+            block = (struct tpacket_block_desc *) ring->block;
+            __atomic_store_n(&block->hdr.bh1.block_status, TP_STATUS_KERNEL,
+                             __ATOMIC_RELEASE);
+            ring->current = (ring->current + 1) % ring->num_slots;
+            ring->block = NULL;
+        }
+
+        if (ring->block) {
+            packet = (struct tpacket3_hdr *) ring->packet;
+            *pdu = ring->packet + packet->tp_mac;
+            ring->packet += packet->tp_next_offset;
+            ring->packets_left--;
+            return packet->tp_snaplen;
+        }
+
+        block = (struct tpacket_block_desc *)
+                (ring->map + (size_t) ring->current * ring->slot_size);
+        if (__atomic_load_n(&block->hdr.bh1.block_status, __ATOMIC_ACQUIRE) &
+                TP_STATUS_USER) {
+            ring->block = (uint8_t *) block;
+            ring->packet = ring->block + block->hdr.bh1.offset_to_first_pkt;
+            ring->packets_left = block->hdr.bh1.num_pkts;
+            continue;
+        }
+
+        pfd.fd = ring->fd;
+        pfd.events = POLLIN | POLLERR;
+        pfd.revents = 0;
+        res = poll(&pfd, 1, timeout_ms);
+        if (res == 0)
+            return 0;
+        if (res < 0) {
+            if (errno == EINTR)
+                continue;
+            perror("Failed to poll packet ring");
+            return -1;
+        }
+    }
+}
+
+/* Frame data of a TX ring starts behind the TPACKET_V2 header. */
+#define TX_FRAME_DATA_OFFSET	(TPACKET2_HDRLEN - sizeof(struct sockaddr_ll))
+
+uint8_t *packet_ring_tx_next(packet_ring_t *ring)
+{
+    struct tpacket2_hdr *hdr;
+    struct pollfd pfd;
+    uint32_t status;
+    int res;
+
+    hdr = (struct tpacket2_hdr *)
+          (ring->map + (size_t) ring->current * ring->slot_size);
+
+    for (;;) {
+        status = __atomic_load_n(&hdr->tp_status, __ATOMIC_ACQUIRE);
+        if (status == TP_STATUS_AVAILABLE)
+            break;
+        if (status & TP_STATUS_WRONG_FORMAT) {
+            fprintf(stderr, "Frame dropped by the kernel\n");
+            break;
+        }
+        if (ring->queued == ring->num_slots) {
+            fprintf(stderr, "TX ring full, frames have to be flushed\n");
+            return NULL;
+        }
+
+        /* The kernel has not sent the frame of an earlier flush yet. */
+        pfd.fd = ring->fd;
+        pfd.events = POLLOUT;
+        pfd.revents = 0;
+        res = poll(&pfd, 1, -1);
+        if (res < 0 && errno != EINTR) {
+            perror("Failed to poll packet ring");
+            return NULL;
+        }
+    }
+
+    return (uint8_t *) hdr + TX_FRAME_DATA_OFFSET;
+}
+
+void packet_ring_tx_queue(packet_ring_t *ring, size_t len)
+{
+    struct tpacket2_hdr *hdr;
+
+    hdr = (struct tpacket2_hdr *)
+          (ring->map + (size_t) ring->current * ring->slot_size);
+    hdr->tp_len = len;
+    __atomic_store_n(&hdr->tp_status, TP_STATUS_SEND_REQUEST,
+                     __ATOMIC_RELEASE);
+
+    ring->current = (ring->current + 1) % ring->num_slots;
+    ring->queued++;
+}
+
+int packet_ring_tx_flush(packet_ring_t *ring, const struct sockaddr *dest_addr,
+                socklen_t addr_len)
+{
+    ssize_t res;
+
+    if (ring->queued == 0)
+        return 0;
+
+    /* A single call sends every frame marked with TP_STATUS_SEND_REQUEST. */
+    do {
+        res = sendto(ring->fd, NULL, 0, 0, dest_addr, addr_len);
+    } while (res < 0 && errno == EINTR);
+    ring->queued = 0;
+    if (res < 0) {
+        perror("Failed to send data");
+        return -1;
+    }
+
+    return 0;
+}
+
+void packet_ring_close(packet_ring_t *ring)
+{
+    if (ring->map)
+        munmap(ring->map, ring->map_size);
+    close(ring->fd);
+}
+
+/* Offset of the AVTP PDU as seen by the socket filter. Filters of packet
+ * sockets start at the network header, filters of UDP sockets at the UDP
+ * header, which is followed by the encapsulation sequence number.
+ */
+#define FILTER_UDP_OFFSET	(8 + 4)
+#define FILTER_STREAM_ID_OFFSET	4
+#define FILTER_ACCEPT		0xFFFFFFFF
+#define FILTER_DROP		0
+
+int attach_stream_filter(int fd, int udp, const uint8_t subtypes[],
+                size_t num_subtypes, const uint64_t stream_ids[],
+                size_t num_stream_ids)
+{
+    uint32_t offset = udp ? FILTER_UDP_OFFSET : 0;
+    struct sock_fprog fprog;
+    struct sock_filter *prog;
+    size_t len = 0;
+    int res;
+
+    if (num_subtypes < 1 || num_subtypes > 255) {
+        fprintf(stderr, "Invalid number of subtypes %zu\n", num_subtypes);
+        return -1;
+    }
+
+    prog = calloc(2 + 1 + num_subtypes + 1 + 5 * num_stream_ids + 1,
+                  sizeof(*prog));
+    if (prog == NULL) {
+        perror("Failed to allocate socket filter");
+        return -1;
+    }
+
+    /* Packet sockets listening to ETH_P_ALL also see non-AVTP traffic. */
+    if (!udp) {
+        prog[len++] = (struct sock_filter) BPF_STMT(BPF_LD | BPF_H | BPF_ABS,
+                SKF_AD_OFF + SKF_AD_PROTOCOL);
+        prog[len++] = (struct sock_filter) BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K,
+                ETH_P_TSN, 0, num_subtypes + 1);
+    }
+
+    /* Jump to the stream ID checks if one of the subtypes matches. */
+    prog[len++] = (struct sock_filter) BPF_STMT(BPF_LD | BPF_B | BPF_ABS,
+            offset);
+    for (size_t i = 0; i < num_subtypes; i++) {
+        prog[len++] = (struct sock_filter) BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K,
+                subtypes[i], num_subtypes - i, 0);
+    }
+    prog[len++] = (struct sock_filter) BPF_STMT(BPF_RET | BPF_K, FILTER_DROP);
+
+    /* Compare both halves of the stream ID, which are loaded in host order. */
+    for (size_t i = 0; i < num_stream_ids; i++) {
+        prog[len++] = (struct sock_filter) BPF_STMT(BPF_LD | BPF_W | BPF_ABS,
+                offset + FILTER_STREAM_ID_OFFSET);
+        prog[len++] = (struct sock_filter) BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K,
+                (uint32_t) (stream_ids[i] >> 32), 0, 3);
+        prog[len++] = (struct sock_filter) BPF_STMT(BPF_LD | BPF_W | BPF_ABS,
+                offset + FILTER_STREAM_ID_OFFSET + 4);
+        prog[len++] = (struct sock_filter) BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K,
+                (uint32_t) stream_ids[i], 0, 1);
+        prog[len++] = (struct sock_filter) BPF_STMT(BPF_RET | BPF_K,
+                FILTER_ACCEPT);
+    }
+    prog[len++] = (struct sock_filter) BPF_STMT(BPF_RET | BPF_K,
+            num_stream_ids ? FILTER_DROP : FILTER_ACCEPT);
+
+    fprog.len = len;
+    fprog.filter = prog;
+    res = setsockopt(fd, SOL_SOCKET, SO_ATTACH_FILTER, &fprog, sizeof(fprog));
+    free(prog);
+    if (res < 0) {
+        perror("Failed to attach socket filter");
+        return -1;
+    }
+
+    return 0;
+}
 #endif
 
 int setup_socket_address(int fd, const char *ifname, uint8_t macaddr[],
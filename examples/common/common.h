@@ -28,9 +28,12 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+#pragma once
+
 #include <stdint.h>
 #ifdef __linux__
 #include <netinet/in.h>
+#include <sys/socket.h>
 #elif defined(__ZEPHYR__)
 #include <zephyr/net/socket.h>
 #include <zephyr/net/ethernet.h>
@@ -80,6 +83,218 @@ int present_data(uint8_t *data, size_t len);
  *    -1: Could not arm timer.
  */
 int arm_timer(int fd, struct timespec *tspec);
+
+#define TX_BATCH_MAX_PDUS	32
+#define TX_BATCH_PDU_SIZE	1500
+
+#define PACKET_RING_FRAME_SIZE	2048
+#define PACKET_RING_BLOCK_SIZE	(1 << 16)
+#define PACKET_RING_RX_BLOCKS	32
+#define PACKET_RING_TX_BLOCKS	8
+/* Max. time in ms a received packet waits in a partially filled block. */
+#define PACKET_RING_RX_TIMEOUT	1
+
+/* PACKET_MMAP ring shared with the kernel. Listeners use a block based
+ * TPACKET_V3 RX ring, talkers a frame based TPACKET_V2 TX ring.
+ */
+typedef struct {
+    int fd;
+    uint8_t *map;
+    size_t map_size;
+    unsigned int num_slots;     /* RX: blocks, TX: frames */
+    unsigned int slot_size;     /* RX: block size, TX: frame size */
+    unsigned int current;
+    /* RX ring: packets left in the current block */
+    uint8_t *block;
+    uint8_t *packet;
+    uint32_t packets_left;
+    /* TX ring: frames handed to the kernel but not sent yet */
+    unsigned int queued;
+} packet_ring_t;
+
+struct xdp_socket;
+
+/* PDUs queued for transmission with a single sendmmsg() call, or with a
+ * single send() on a TX ring or AF_XDP socket.
+ */
+typedef struct {
+    int fd;
+    packet_ring_t *ring;
+    struct xdp_socket *xsk;
+    const struct sockaddr *dest_addr;
+    socklen_t addr_len;
+    unsigned int max_pdus;
+    unsigned int num_pdus;
+    size_t lengths[TX_BATCH_MAX_PDUS];
+    uint8_t pdus[TX_BATCH_MAX_PDUS][TX_BATCH_PDU_SIZE];
+    /* Statistics */
+    uint64_t syscalls;
+    uint64_t packets;
+    uint64_t last_print_ns;
+} tx_batch_t;
+
+/* Initialize a transmit batch for a raw AF_PACKET or UDP socket.
+ * @batch: Batch to be initialized.
+ * @fd: Socket file descriptor.
+ * @dest_addr: Destination address of all PDUs, e.g. set up with
+ *             setup_socket_address() or setup_udp_socket_address().
+ * @addr_len: Size of the destination address.
+ * @max_pdus: PDUs queued before the batch is flushed, at most
+ *            TX_BATCH_MAX_PDUS.
+ *
+ * Returns:
+ *    0: Success.
+ *    -1: Invalid number of PDUs.
+ */
+int tx_batch_init(tx_batch_t *batch, int fd, const struct sockaddr *dest_addr,
+        socklen_t addr_len, unsigned int max_pdus);
+
+/* Get the buffer for the next PDU. The PDU has to be queued with
+ * tx_batch_queue() once it is complete.
+ * @batch: Transmit batch.
+ *
+ * Returns:
+ *    Buffer of TX_BATCH_PDU_SIZE bytes, NULL if the TX ring or AF_XDP
+ *    socket of the batch failed.
+ */
+uint8_t *tx_batch_next(tx_batch_t *batch);
+
+/* Queue the PDU written to the buffer returned by tx_batch_next(). The batch
+ * is flushed if it is full.
+ * @batch: Transmit batch.
+ * @len: Length of the PDU.
+ *
+ * Returns:
+ *    0: Success.
+ *    -1: Could not send the PDUs.
+ */
+int tx_batch_queue(tx_batch_t *batch, size_t len);
+
+/* Send all queued PDUs with sendmmsg(), or with send() on a TX ring or
+ * AF_XDP socket.
+ * @batch: Transmit batch.
+ *
+ * Returns:
+ *    0: Success.
+ *    -1: Could not send the PDUs.
+ */
+int tx_batch_flush(tx_batch_t *batch);
+
+/* Print the number of syscalls per packet of a transmit batch if at least
+ * interval_s seconds have passed since the last print. An interval of 0
+ * prints unconditionally.
+ * @batch: Transmit batch.
+ * @interval_s: Minimum interval between two prints in seconds.
+ */
+void tx_batch_print_stats(tx_batch_t *batch, uint32_t interval_s);
+
+/* Initialize a transmit batch on a TX ring. The PDUs are written directly
+ * into the ring and sent with one syscall per batch.
+ * @batch: Batch to be initialized.
+ * @ring: TX ring created with create_talker_ring().
+ * @dest_addr: Destination address of all PDUs, set up with
+ *             setup_socket_address().
+ * @addr_len: Size of the destination address.
+ * @max_pdus: PDUs queued before the batch is flushed, at most
+ *            TX_BATCH_MAX_PDUS.
+ *
+ * Returns:
+ *    0: Success.
+ *    -1: Invalid number of PDUs.
+ */
+int tx_batch_init_ring(tx_batch_t *batch, packet_ring_t *ring,
+        const struct sockaddr *dest_addr, socklen_t addr_len,
+        unsigned int max_pdus);
+
+/* Create TSN socket with a TPACKET_V3 RX ring to listen for incoming packets.
+ * @ring: Ring to be set up. Should be released with packet_ring_close().
+ * @ifname: Network interface name where to create the socket.
+ * @macaddr: Stream destination MAC address.
+ * @protocol: Protocol to listen to.
+ *
+ * Returns:
+ *    0: Success.
+ *    -1: Could not create socket or ring.
+ */
+int create_listener_ring(packet_ring_t *ring, char *ifname, uint8_t macaddr[],
+        int protocol);
+
+/* Create TSN socket with a TPACKET_V2 TX ring to send packets.
+ * @ring: Ring to be set up. Should be released with packet_ring_close().
+ * @priority: SO_PRIORITY to be set in socket.
+ *
+ * Returns:
+ *    0: Success.
+ *    -1: Could not create socket or ring.
+ */
+int create_talker_ring(packet_ring_t *ring, int priority);
+
+/* Get the next packet from an RX ring, waiting for it if necessary. The
+ * packet stays in the ring and is valid until the next call.
+ * @ring: RX ring.
+ * @pdu: Set to the start of the AVTP PDU (or UDP encapsulation) in the ring.
+ * @timeout_ms: Max. time to wait for a packet, -1 waits forever.
+ *
+ * Returns:
+ *    > 0: Length of the packet.
+ *    0: Timeout.
+ *    -1: Could not poll the socket.
+ */
+int packet_ring_recv(packet_ring_t *ring, uint8_t **pdu, int timeout_ms);
+
+/* Get the next free frame of a TX ring, waiting for the kernel to release
+ * one if necessary.
+ * @ring: TX ring.
+ *
+ * Returns:
+ *    Buffer of TX_BATCH_PDU_SIZE bytes, NULL if no frame could be obtained.
+ */
+uint8_t *packet_ring_tx_next(packet_ring_t *ring);
+
+/* Hand the frame returned by packet_ring_tx_next() to the kernel. It is sent
+ * by the next packet_ring_tx_flush().
+ * @ring: TX ring.
+ * @len: Length of the PDU.
+ */
+void packet_ring_tx_queue(packet_ring_t *ring, size_t len);
+
+/* Send all queued frames of a TX ring.
+ * @ring: TX ring.
+ * @dest_addr: Destination address.
+ * @addr_len: Size of the destination address.
+ *
+ * Returns:
+ *    0: Success.
+ *    -1: Could not send the frames.
+ */
+int packet_ring_tx_flush(packet_ring_t *ring, const struct sockaddr *dest_addr,
+        socklen_t addr_len);
+
+/* Unmap a ring and close its socket.
+ * @ring: RX or TX ring.
+ */
+void packet_ring_close(packet_ring_t *ring);
+
+/* Attach a classic BPF socket filter that only passes AVTP PDUs of the given
+ * subtypes and stream IDs, so other streams are dropped in the kernel before
+ * they are copied to user space. It works for the NTSCF, TSCF, AAF, CRF and
+ * CVF formats, which all carry the stream ID in octets 4 to 11.
+ * @fd: Socket from create_listener_socket() or create_listener_ring(), or
+ *      from create_listener_socket_udp() if udp is set.
+ * @udp: Non-zero if the PDUs are encapsulated in UDP, i.e. prefixed by the
+ *       4 octet encapsulation sequence number.
+ * @subtypes: Accepted AVTP subtypes.
+ * @num_subtypes: Number of accepted subtypes, at least 1.
+ * @stream_ids: Accepted stream IDs.
+ * @num_stream_ids: Number of accepted stream IDs, 0 accepts every stream.
+ *
+ * Returns:
+ *    0: Success.
+ *    -1: Could not attach the filter.
+ */
+int attach_stream_filter(int fd, int udp, const uint8_t subtypes[],
+        size_t num_subtypes, const uint64_t stream_ids[],
+        size_t num_stream_ids);
 #endif
 
 /* Create UDP socket to listen for incomimg packets.
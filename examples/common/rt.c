@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2025, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#define _GNU_SOURCE
+#include <errno.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+
+#include "common/rt.h"
+
+#define NSEC_PER_SEC		1000000000ULL
+#define NSEC_PER_USEC		1000ULL
+/* Smallest page size of the supported platforms */
+#define RT_PREFAULT_STRIDE	4096
+
+int rt_lock_memory(void)
+{
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) < 0) {
+        perror("Failed to lock memory");
+        return -1;
+    }
+
+    rt_prefault_stack();
+
+    return 0;
+}
+
+int rt_setup_thread(int priority, int cpu)
+{
+    struct sched_param param;
+    cpu_set_t cpus;
+    int res;
+
+    if (cpu >= 0) {
+        CPU_ZERO(&cpus);
+        CPU_SET(cpu, &cpus);
+        res = pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+        if (res != 0) {
+            fprintf(stderr, "Failed to pin thread to CPU %d: %s\n", cpu,
+                    strerror(res));
+            return -1;
+        }
+    }
+
+    if (priority > 0) {
+        memset(&param, 0, sizeof(param));
+        param.sched_priority = priority;
+        res = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+        if (res != 0) {
+            fprintf(stderr, "Failed to set SCHED_FIFO priority %d: %s\n",
+                    priority, strerror(res));
+            return -1;
+        }
+    }
+
+    rt_prefault_stack();
+
+    return 0;
+}
+
+void __attribute__((noinline)) rt_prefault_stack(void)
+{
+    uint8_t stack[RT_STACK_PREFAULT_SIZE];
+    volatile uint8_t *page = stack;
+
+    /* One store per page, through a volatile pointer so it is not elided */
+    for (size_t i = 0; i < sizeof(stack); i += RT_PREFAULT_STRIDE)
+        page[i] = 0;
+}
+
+int rt_set_busy_poll(int fd, int usec)
+{
+    if (setsockopt(fd, SOL_SOCKET, SO_BUSY_POLL, &usec, sizeof(usec)) < 0) {
+        perror("Failed to set SO_BUSY_POLL");
+        return -1;
+    }
+
+    return 0;
+}
+
+uint64_t rt_now_ns(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return now.tv_sec * NSEC_PER_SEC + now.tv_nsec;
+}
+
+void latency_hist_init(latency_hist_t *hist)
+{
+    memset(hist, 0, sizeof(*hist));
+    hist->min_ns = UINT64_MAX;
+}
+
+void latency_hist_add(latency_hist_t *hist, uint64_t latency_ns)
+{
+    uint64_t latency_us = latency_ns / NSEC_PER_USEC;
+    int bucket = 0;
+
+    while (latency_us && bucket < LATENCY_HIST_BUCKETS - 1) {
+        latency_us >>= 1;
+        bucket++;
+    }
+
+    hist->buckets[bucket]++;
+    hist->count++;
+    hist->sum_ns += latency_ns;
+    if (latency_ns < hist->min_ns)
+        hist->min_ns = latency_ns;
+    if (latency_ns > hist->max_ns)
+        hist->max_ns = latency_ns;
+}
+
+/* Upper bound of the bucket holding the given fraction of all samples. */
+static uint64_t percentile_us(const latency_hist_t *hist, double fraction)
+{
+    uint64_t target = hist->count * fraction;
+    uint64_t sum = 0;
+
+    for (int i = 0; i < LATENCY_HIST_BUCKETS; i++) {
+        sum += hist->buckets[i];
+        if (sum > target)
+            return 1ULL << i;
+    }
+
+    return 1ULL << (LATENCY_HIST_BUCKETS - 1);
+}
+
+void latency_hist_print(latency_hist_t *hist, const char *name,
+                        uint32_t interval_s)
+{
+    uint64_t now_ns = rt_now_ns();
+
+    if (hist->last_print_ns == 0) {
+        hist->last_print_ns = now_ns;
+        return;
+    }
+    if (now_ns - hist->last_print_ns < interval_s * NSEC_PER_SEC)
+        return;
+    hist->last_print_ns = now_ns;
+
+    if (hist->count == 0) {
+        fprintf(stderr, "%s latency: no samples\n", name);
+        return;
+    }
+
+    fprintf(stderr, "%s latency: %" PRIu64 " samples, min %.1f us, "
+            "avg %.1f us, max %.1f us, p50 < %" PRIu64 " us, "
+            "p99 < %" PRIu64 " us, p99.9 < %" PRIu64 " us\n", name,
+            hist->count, hist->min_ns / (double)NSEC_PER_USEC,
+            hist->sum_ns / (double)hist->count / NSEC_PER_USEC,
+            hist->max_ns / (double)NSEC_PER_USEC,
+            percentile_us(hist, 0.5), percentile_us(hist, 0.99),
+            percentile_us(hist, 0.999));
+    for (int i = 0; i < LATENCY_HIST_BUCKETS; i++) {
+        if (hist->buckets[i] == 0)
+            continue;
+        fprintf(stderr, "  %8" PRIu64 " - %8" PRIu64 " us: %" PRIu64 "\n",
+                i ? (uint64_t)1 << (i - 1) : 0, (uint64_t)1 << i,
+                hist->buckets[i]);
+    }
+}
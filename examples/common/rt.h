@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2025, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Stack each real-time thread touches up front, so it does not page fault */
+#define RT_STACK_PREFAULT_SIZE	(256 * 1024)
+/* Default time a socket busy polls the device queue, see SO_BUSY_POLL */
+#define RT_BUSY_POLL_USEC	50
+
+/* Histogram buckets, bucket i counts latencies in [2^(i-1), 2^i) us and
+ * bucket 0 latencies below 1 us. The last bucket takes all larger values.
+ */
+#define LATENCY_HIST_BUCKETS	24
+
+/* Locks all current and future pages of the process into memory and
+ * prefaults the stack of the calling thread. With the pages locked, the
+ * statically allocated buffer pools (e.g. tx_batch_t) are resident as well.
+ *
+ * Returns:
+ *    0: Success.
+ *    -1: If an error occurs, e.g. without CAP_IPC_LOCK.
+ */
+int rt_lock_memory(void);
+
+/* Sets up the calling thread for real-time operation.
+ * @priority: SCHED_FIFO priority (1-99), 0 to keep the scheduling policy.
+ * @cpu: CPU the thread is pinned to, -1 to keep the affinity.
+ *
+ * Returns:
+ *    0: Success.
+ *    -1: If an error occurs, e.g. without CAP_SYS_NICE.
+ */
+int rt_setup_thread(int priority, int cpu);
+
+/* Touches RT_STACK_PREFAULT_SIZE bytes of the stack of the calling thread. */
+void rt_prefault_stack(void);
+
+/* Lets blocking receives on a socket busy poll the device queue instead of
+ * sleeping until the interrupt arrives.
+ * @fd: Socket file descriptor.
+ * @usec: Time to busy poll in microseconds.
+ *
+ * Returns:
+ *    0: Success.
+ *    -1: If an error occurs, e.g. without CAP_NET_ADMIN.
+ */
+int rt_set_busy_poll(int fd, int usec);
+
+/* Returns CLOCK_MONOTONIC in nanoseconds. */
+uint64_t rt_now_ns(void);
+
+/* Histogram of processing latencies */
+typedef struct {
+    uint64_t buckets[LATENCY_HIST_BUCKETS];
+    uint64_t count;
+    uint64_t sum_ns;
+    uint64_t min_ns;
+    uint64_t max_ns;
+    uint64_t last_print_ns;
+} latency_hist_t;
+
+/* Initializes an empty histogram. */
+void latency_hist_init(latency_hist_t *hist);
+
+/* Adds one latency sample in nanoseconds. */
+void latency_hist_add(latency_hist_t *hist, uint64_t latency_ns);
+
+/* Prints minimum, average, percentiles and the non-empty buckets if at
+ * least interval_s seconds have passed since the last print.
+ * @hist: Histogram.
+ * @name: Name of the measured path, printed in front.
+ * @interval_s: Minimum interval between two prints in seconds.
+ */
+void latency_hist_print(latency_hist_t *hist, const char *name,
+                        uint32_t interval_s);
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2025, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "common/rt.h"
+#include "common/seqstats.h"
+
+#define NSEC_PER_SEC		1000000000ULL
+
+static volatile sig_atomic_t seq_stats_signals;
+
+static void seq_stats_signal_handler(int signum)
+{
+    (void)signum;
+    seq_stats_signals++;
+}
+
+int seq_stats_init_signal(void)
+{
+    struct sigaction action;
+
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = seq_stats_signal_handler;
+    action.sa_flags = SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    if (sigaction(SIGUSR1, &action, NULL) < 0) {
+        perror("Failed to install SIGUSR1 handler");
+        return -1;
+    }
+
+    return 0;
+}
+
+int seq_stats_due(seq_stats_timer_t *timer, uint32_t interval_s)
+{
+    sig_atomic_t signals = seq_stats_signals;
+    uint64_t now_ns;
+
+    if (timer->signals != signals) {
+        timer->signals = signals;
+        timer->last_print_ns = interval_s ? rt_now_ns() : 0;
+        return 1;
+    }
+    if (interval_s == 0)
+        return 0;
+
+    // The first call starts the interval
+    now_ns = rt_now_ns();
+    if (timer->last_print_ns == 0) {
+        timer->last_print_ns = now_ns;
+        return 0;
+    }
+    if (now_ns - timer->last_print_ns < interval_s * NSEC_PER_SEC)
+        return 0;
+    timer->last_print_ns = now_ns;
+
+    return 1;
+}
+
+void seq_stats_print(const char *name, const Avtp_SeqStats_t *stats)
+{
+    fprintf(stderr, "%s: %" PRIu64 " received, %" PRIu64 " lost, %" PRIu64
+            " reordered, %" PRIu64 " duplicates, %" PRIu64 " late, %" PRIu64
+            " resyncs\n", name, stats->received, stats->lost,
+            stats->reordered, stats->duplicates, stats->late,
+            stats->resyncs);
+}
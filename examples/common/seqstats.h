@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2025, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include <signal.h>
+#include <stdint.h>
+
+#include "avtp/SeqTracker.h"
+
+/* Decides when the sequence number statistics are printed. Zero-initialize
+ * before use.
+ */
+typedef struct {
+    uint64_t last_print_ns;
+    sig_atomic_t signals;
+} seq_stats_timer_t;
+
+/* Installs a SIGUSR1 handler, which makes seq_stats_due() true at its next
+ * call. Blocking receives are restarted after the signal, poll() returns
+ * with EINTR.
+ *
+ * Returns:
+ *    0: Success.
+ *    -1: Could not install the handler.
+ */
+int seq_stats_init_signal(void);
+
+/* Checks if the statistics are to be printed, which is the case if
+ * interval_s seconds have passed since the last print or if a SIGUSR1
+ * arrived since then.
+ * @timer: Timer of the printed statistics.
+ * @interval_s: Interval between two prints in seconds, 0 to print on
+ *              SIGUSR1 only.
+ *
+ * Returns:
+ *    1: The statistics are to be printed now.
+ *    0: Otherwise.
+ */
+int seq_stats_due(seq_stats_timer_t *timer, uint32_t interval_s);
+
+/* Prints the counters of a sequence tracker in one line.
+ * @name: Name of the stream, printed in front.
+ * @stats: Counters of the tracker.
+ */
+void seq_stats_print(const char *name, const Avtp_SeqStats_t *stats);
@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) 2025, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+
+#include "common/spsc.h"
+
+#define NSEC_PER_SEC		1000000000ULL
+
+static long futex(uint32_t *addr, int op, uint32_t val,
+                  const struct timespec *timeout)
+{
+    return syscall(SYS_futex, addr, op, val, timeout, NULL, 0);
+}
+
+int spsc_ring_init(spsc_ring_t *ring, size_t elem_size, uint32_t capacity)
+{
+    void *elems;
+
+    if (capacity == 0 || (capacity & (capacity - 1)) != 0) {
+        fprintf(stderr, "SPSC ring capacity must be a power of 2\n");
+        return -1;
+    }
+
+    if (posix_memalign(&elems, SPSC_CACHE_LINE, elem_size * capacity) != 0) {
+        fprintf(stderr, "Failed to allocate SPSC ring\n");
+        return -1;
+    }
+
+    memset(ring, 0, sizeof(*ring));
+    ring->elems = elems;
+    ring->elem_size = elem_size;
+    ring->capacity = capacity;
+    ring->mask = capacity - 1;
+
+    return 0;
+}
+
+void spsc_ring_free(spsc_ring_t *ring)
+{
+    free(ring->elems);
+    ring->elems = NULL;
+}
+
+/* Copies num elements between the ring, starting at index, and a buffer. */
+static void copy_elems(spsc_ring_t *ring, uint32_t index, uint8_t *buf,
+                       unsigned num, int to_ring)
+{
+    uint32_t first = index & ring->mask;
+    unsigned num_first = ring->capacity - first;
+    uint8_t *slot = ring->elems + (size_t)first * ring->elem_size;
+
+    if (num_first > num)
+        num_first = num;
+
+    // Copy up to the end of the ring, then from its start
+    if (to_ring) {
+        memcpy(slot, buf, num_first * ring->elem_size);
+        memcpy(ring->elems, buf + num_first * ring->elem_size,
+               (num - num_first) * ring->elem_size);
+    } else {
+        memcpy(buf, slot, num_first * ring->elem_size);
+        memcpy(buf + num_first * ring->elem_size, ring->elems,
+               (num - num_first) * ring->elem_size);
+    }
+}
+
+unsigned spsc_ring_push(spsc_ring_t *ring, const void *elems, unsigned num)
+{
+    uint32_t tail = ring->tail;
+    uint32_t used = tail - ring->cached_head;
+    unsigned num_free;
+
+    // Only look at the consumer's index if the cached one says full
+    if (used + num > ring->capacity) {
+        ring->cached_head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+        used = tail - ring->cached_head;
+    }
+    num_free = ring->capacity - used;
+    if (num > num_free) {
+        ring->overflows += num - num_free;
+        num = num_free;
+    }
+    if (num == 0)
+        return 0;
+
+    copy_elems(ring, tail, (uint8_t *)elems, num, 1);
+    __atomic_store_n(&ring->tail, tail + num, __ATOMIC_RELEASE);
+
+    ring->pushed += num;
+    if (used + num > ring->high_water)
+        ring->high_water = used + num;
+
+    // Pairs with the fence in spsc_ring_wait(): either the consumer sees the
+    // new tail or we see that it sleeps
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&ring->waiting, __ATOMIC_RELAXED))
+        futex(&ring->tail, FUTEX_WAKE_PRIVATE, 1, NULL);
+
+    return num;
+}
+
+unsigned spsc_ring_pop(spsc_ring_t *ring, void *elems, unsigned max)
+{
+    uint32_t head = ring->head;
+    uint32_t avail = ring->cached_tail - head;
+
+    if (avail < max) {
+        ring->cached_tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+        avail = ring->cached_tail - head;
+    }
+    if (max > avail)
+        max = avail;
+    if (max == 0)
+        return 0;
+
+    copy_elems(ring, head, elems, max, 0);
+    __atomic_store_n(&ring->head, head + max, __ATOMIC_RELEASE);
+
+    return max;
+}
+
+int spsc_ring_wait(spsc_ring_t *ring, const struct timespec *timeout)
+{
+    uint32_t tail;
+    long res;
+
+    for (;;) {
+        tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+        if (tail != ring->head)
+            return 1;
+
+        __atomic_store_n(&ring->waiting, 1, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+        res = 0;
+        if (tail == ring->head)
+            res = futex(&ring->tail, FUTEX_WAIT_PRIVATE, tail, timeout);
+        __atomic_store_n(&ring->waiting, 0, __ATOMIC_RELAXED);
+
+        if (res < 0 && errno == ETIMEDOUT)
+            return __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE) != ring->head;
+    }
+}
+
+void spsc_ring_print_stats(spsc_ring_t *ring, const char *name,
+                           uint32_t interval_s)
+{
+    struct timespec now;
+    uint64_t now_ns;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    now_ns = now.tv_sec * NSEC_PER_SEC + now.tv_nsec;
+    if (ring->last_print_ns == 0) {
+        ring->last_print_ns = now_ns;
+        return;
+    }
+    if (now_ns - ring->last_print_ns < interval_s * NSEC_PER_SEC)
+        return;
+    ring->last_print_ns = now_ns;
+
+    fprintf(stderr, "%s ring: %" PRIu64 " queued, high-water mark %" PRIu32
+            "/%" PRIu32 ", %" PRIu64 " overflows\n", name, ring->pushed,
+            ring->high_water, ring->capacity, ring->overflows);
+}
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2025, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <time.h>
+
+#define SPSC_CACHE_LINE		64
+
+/* Lock-free single producer / single consumer ring of fixed size elements,
+ * e.g. frame_t or PDUs, to hand data from one thread to another. Producer
+ * and consumer indices live on separate cache lines and each side caches
+ * the index of the other, so the fast path does not bounce cache lines. A
+ * consumer finding the ring empty can sleep on a futex, which the producer
+ * only wakes if the consumer is actually sleeping.
+ */
+typedef struct {
+    /* Written by the consumer */
+    uint32_t head __attribute__((aligned(SPSC_CACHE_LINE)));
+    uint32_t cached_tail;
+
+    /* Set by the consumer while it sleeps, read by the producer */
+    uint32_t waiting __attribute__((aligned(SPSC_CACHE_LINE)));
+
+    /* Written by the producer */
+    uint32_t tail __attribute__((aligned(SPSC_CACHE_LINE)));
+    uint32_t cached_head;
+    /* Highest number of queued elements seen by the producer */
+    uint32_t high_water;
+    /* Elements dropped because the ring was full */
+    uint64_t overflows;
+    uint64_t pushed;
+    uint64_t last_print_ns;
+
+    /* Constant after spsc_ring_init() */
+    uint8_t *elems __attribute__((aligned(SPSC_CACHE_LINE)));
+    size_t elem_size;
+    uint32_t capacity;
+    uint32_t mask;
+} spsc_ring_t;
+
+/* Allocates the elements of a ring.
+ * @ring: ring to initialize.
+ * @elem_size: size of an element.
+ * @capacity: number of elements, a power of 2.
+ *
+ * Returns:
+ *    0: Success.
+ *    -1: Invalid capacity or out of memory.
+ */
+int spsc_ring_init(spsc_ring_t *ring, size_t elem_size, uint32_t capacity);
+
+/* Frees the elements of a ring. */
+void spsc_ring_free(spsc_ring_t *ring);
+
+/* Copies elements into the ring and wakes a sleeping consumer. Elements
+ * that do not fit are dropped and counted as overflows. Producer only.
+ * @ring: ring initialized with spsc_ring_init().
+ * @elems: array of num elements.
+ * @num: number of elements.
+ *
+ * Returns:
+ *    Number of elements queued.
+ */
+unsigned spsc_ring_push(spsc_ring_t *ring, const void *elems, unsigned num);
+
+/* Copies up to max elements out of the ring. Consumer only.
+ * @ring: ring initialized with spsc_ring_init().
+ * @elems: array of at least max elements.
+ * @max: maximum number of elements.
+ *
+ * Returns:
+ *    Number of elements copied, 0 if the ring is empty.
+ */
+unsigned spsc_ring_pop(spsc_ring_t *ring, void *elems, unsigned max);
+
+/* Sleeps until the ring is not empty. Consumer only.
+ * @ring: ring initialized with spsc_ring_init().
+ * @timeout: maximum time to wait, NULL to wait forever.
+ *
+ * Returns:
+ *    1: The ring is not empty.
+ *    0: Timeout.
+ */
+int spsc_ring_wait(spsc_ring_t *ring, const struct timespec *timeout);
+
+/* Prints the high-water mark and the number of overflows if at least
+ * interval_s seconds have passed since the last print. Producer only.
+ * @ring: ring initialized with spsc_ring_init().
+ * @name: name of the ring, printed in front.
+ * @interval_s: minimum interval between two prints in seconds.
+ */
+void spsc_ring_print_stats(spsc_ring_t *ring, const char *name,
+                           uint32_t interval_s);
@@ -0,0 +1,336 @@
+/*
+ * Copyright (c) 2025, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "common/uring.h"
+
+static int sys_io_uring_setup(unsigned entries, struct io_uring_params *p)
+{
+    return syscall(__NR_io_uring_setup, entries, p);
+}
+
+static int sys_io_uring_enter(int fd, unsigned to_submit, unsigned min_complete,
+                              unsigned flags)
+{
+    return syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags,
+                   NULL, 0);
+}
+
+static int sys_io_uring_register(int fd, unsigned opcode, const void *arg,
+                                 unsigned nr_args)
+{
+    return syscall(__NR_io_uring_register, fd, opcode, arg, nr_args);
+}
+
+/* Creates the instance with the cheapest task work mode the kernel offers.
+ * The event loop is single-threaded and always waits with
+ * IORING_ENTER_GETEVENTS, so completions can be deferred until then.
+ */
+static int setup_ring(unsigned entries, unsigned cq_entries,
+                      struct io_uring_params *p)
+{
+    static const uint32_t flag_sets[] = {
+        IORING_SETUP_SINGLE_ISSUER | IORING_SETUP_DEFER_TASKRUN,
+        IORING_SETUP_COOP_TASKRUN,
+        0,
+    };
+    int fd = -1;
+
+    for (size_t i = 0; i < sizeof(flag_sets) / sizeof(flag_sets[0]); i++) {
+        memset(p, 0, sizeof(*p));
+        p->flags = flag_sets[i];
+        if (cq_entries) {
+            p->flags |= IORING_SETUP_CQSIZE;
+            p->cq_entries = cq_entries;
+        }
+        fd = sys_io_uring_setup(entries, p);
+        if (fd >= 0 || errno != EINVAL)
+            break;
+    }
+
+    return fd;
+}
+
+int uring_init(uring_t *ring, unsigned entries, unsigned cq_entries)
+{
+    struct io_uring_params p;
+    uint8_t *sq_ptr, *cq_ptr;
+
+    memset(ring, 0, sizeof(*ring));
+    ring->fd = setup_ring(entries, cq_entries, &p);
+    if (ring->fd < 0) {
+        perror("Failed to set up io_uring");
+        return -1;
+    }
+
+    ring->sq_map_size = p.sq_off.array + p.sq_entries * sizeof(uint32_t);
+    ring->cq_map_size = p.cq_off.cqes +
+                        p.cq_entries * sizeof(struct io_uring_cqe);
+    if (p.features & IORING_FEAT_SINGLE_MMAP) {
+        if (ring->cq_map_size > ring->sq_map_size)
+            ring->sq_map_size = ring->cq_map_size;
+    }
+
+    ring->sq_map = mmap(NULL, ring->sq_map_size, PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_POPULATE, ring->fd,
+                        IORING_OFF_SQ_RING);
+    if (ring->sq_map == MAP_FAILED) {
+        perror("Failed to map io_uring submission queue");
+        goto err;
+    }
+
+    if (p.features & IORING_FEAT_SINGLE_MMAP) {
+        ring->cq_map = ring->sq_map;
+    } else {
+        ring->cq_map = mmap(NULL, ring->cq_map_size, PROT_READ | PROT_WRITE,
+                            MAP_SHARED | MAP_POPULATE, ring->fd,
+                            IORING_OFF_CQ_RING);
+        if (ring->cq_map == MAP_FAILED) {
+            ring->cq_map = NULL;
+            perror("Failed to map io_uring completion queue");
+            goto err;
+        }
+    }
+
+    ring->sqes_size = p.sq_entries * sizeof(struct io_uring_sqe);
+    ring->sqes = mmap(NULL, ring->sqes_size, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQES);
+    if (ring->sqes == MAP_FAILED) {
+        ring->sqes = NULL;
+        perror("Failed to map io_uring SQEs");
+        goto err;
+    }
+
+    sq_ptr = ring->sq_map;
+    ring->sq_head = (uint32_t *)(sq_ptr + p.sq_off.head);
+    ring->sq_tail = (uint32_t *)(sq_ptr + p.sq_off.tail);
+    ring->sq_array = (uint32_t *)(sq_ptr + p.sq_off.array);
+    ring->sq_mask = *(uint32_t *)(sq_ptr + p.sq_off.ring_mask);
+    ring->sq_entries = p.sq_entries;
+    ring->sqe_tail = *ring->sq_tail;
+
+    cq_ptr = ring->cq_map;
+    ring->cq_head = (uint32_t *)(cq_ptr + p.cq_off.head);
+    ring->cq_tail = (uint32_t *)(cq_ptr + p.cq_off.tail);
+    ring->cq_mask = *(uint32_t *)(cq_ptr + p.cq_off.ring_mask);
+    ring->cqes = (struct io_uring_cqe *)(cq_ptr + p.cq_off.cqes);
+
+    return 0;
+
+err:
+    uring_close(ring);
+    return -1;
+}
+
+struct io_uring_sqe *uring_get_sqe(uring_t *ring)
+{
+    struct io_uring_sqe *sqe;
+    uint32_t index;
+
+    if (uring_sq_space(ring) == 0)
+        return NULL;
+
+    index = ring->sqe_tail & ring->sq_mask;
+    sqe = &ring->sqes[index];
+    memset(sqe, 0, sizeof(*sqe));
+    ring->sq_array[index] = index;
+    ring->sqe_tail++;
+    ring->sqe_pending++;
+
+    return sqe;
+}
+
+unsigned uring_sq_space(const uring_t *ring)
+{
+    uint32_t head = __atomic_load_n(ring->sq_head, __ATOMIC_ACQUIRE);
+
+    return ring->sq_entries - (ring->sqe_tail - head);
+}
+
+int uring_submit(uring_t *ring, unsigned wait_nr)
+{
+    unsigned flags = wait_nr ? IORING_ENTER_GETEVENTS : 0;
+    unsigned to_submit = ring->sqe_pending;
+    int res;
+
+    // Publish the SQEs before the kernel looks at the tail
+    __atomic_store_n(ring->sq_tail, ring->sqe_tail, __ATOMIC_RELEASE);
+
+    res = sys_io_uring_enter(ring->fd, to_submit, wait_nr, flags);
+    ring->enters++;
+    if (res < 0)
+        return -errno;
+
+    ring->sqe_pending -= res;
+
+    return res;
+}
+
+struct io_uring_cqe *uring_peek_cqe(uring_t *ring)
+{
+    uint32_t head = *ring->cq_head;
+
+    if (head == __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE))
+        return NULL;
+
+    return &ring->cqes[head & ring->cq_mask];
+}
+
+void uring_cqe_seen(uring_t *ring)
+{
+    __atomic_store_n(ring->cq_head, *ring->cq_head + 1, __ATOMIC_RELEASE);
+}
+
+int uring_register_buffers(uring_t *ring, const struct iovec *iovs,
+                           unsigned num_iovs)
+{
+    if (sys_io_uring_register(ring->fd, IORING_REGISTER_BUFFERS, iovs,
+                              num_iovs) < 0) {
+        perror("Failed to register io_uring buffers");
+        return -1;
+    }
+
+    return 0;
+}
+
+int uring_buf_ring_init(uring_t *ring, uring_buf_ring_t *br, uint16_t bgid,
+                        uint16_t num_bufs, uint32_t buf_size)
+{
+    struct io_uring_buf_reg reg;
+    long page_size = sysconf(_SC_PAGESIZE);
+
+    memset(br, 0, sizeof(*br));
+    br->bgid = bgid;
+    br->num_bufs = num_bufs;
+    br->buf_size = buf_size;
+
+    // The ring must be page aligned, so it gets its own mapping
+    br->ring_size = num_bufs * sizeof(struct io_uring_buf);
+    br->ring_size = (br->ring_size + page_size - 1) & ~(page_size - 1);
+    br->ring = mmap(NULL, br->ring_size, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (br->ring == MAP_FAILED) {
+        br->ring = NULL;
+        perror("Failed to allocate io_uring buffer ring");
+        return -1;
+    }
+
+    br->bufs = mmap(NULL, (size_t)num_bufs * buf_size, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (br->bufs == MAP_FAILED) {
+        br->bufs = NULL;
+        perror("Failed to allocate io_uring buffers");
+        goto err;
+    }
+
+    memset(&reg, 0, sizeof(reg));
+    reg.ring_addr = (uint64_t)(uintptr_t)br->ring;
+    reg.ring_entries = num_bufs;
+    reg.bgid = bgid;
+    if (sys_io_uring_register(ring->fd, IORING_REGISTER_PBUF_RING, &reg, 1) < 0) {
+        perror("Failed to register io_uring buffer ring");
+        goto err;
+    }
+
+    for (uint16_t bid = 0; bid < num_bufs; bid++) {
+        struct io_uring_buf *buf = &br->ring->bufs[bid];
+
+        buf->addr = (uint64_t)(uintptr_t)(br->bufs + (size_t)bid * buf_size);
+        buf->len = buf_size;
+        buf->bid = bid;
+    }
+    br->tail = num_bufs;
+    __atomic_store_n(&br->ring->tail, br->tail, __ATOMIC_RELEASE);
+
+    return 0;
+
+err:
+    if (br->bufs)
+        munmap(br->bufs, (size_t)num_bufs * buf_size);
+    munmap(br->ring, br->ring_size);
+    br->ring = NULL;
+    br->bufs = NULL;
+    return -1;
+}
+
+uint8_t *uring_buf_ring_get(uring_buf_ring_t *br, uint32_t cqe_flags)
+{
+    uint16_t bid = cqe_flags >> IORING_CQE_BUFFER_SHIFT;
+
+    return br->bufs + (size_t)bid * br->buf_size;
+}
+
+void uring_buf_ring_recycle(uring_buf_ring_t *br, uint32_t cqe_flags)
+{
+    uint16_t bid = cqe_flags >> IORING_CQE_BUFFER_SHIFT;
+    struct io_uring_buf *buf;
+
+    buf = &br->ring->bufs[br->tail & (br->num_bufs - 1)];
+    buf->addr = (uint64_t)(uintptr_t)(br->bufs + (size_t)bid * br->buf_size);
+    buf->len = br->buf_size;
+    buf->bid = bid;
+    br->tail++;
+    __atomic_store_n(&br->ring->tail, br->tail, __ATOMIC_RELEASE);
+}
+
+void uring_buf_ring_close(uring_t *ring, uring_buf_ring_t *br)
+{
+    struct io_uring_buf_reg reg;
+
+    if (!br->ring)
+        return;
+
+    memset(&reg, 0, sizeof(reg));
+    reg.bgid = br->bgid;
+    sys_io_uring_register(ring->fd, IORING_UNREGISTER_PBUF_RING, &reg, 1);
+    munmap(br->bufs, (size_t)br->num_bufs * br->buf_size);
+    munmap(br->ring, br->ring_size);
+    br->ring = NULL;
+    br->bufs = NULL;
+}
+
+void uring_close(uring_t *ring)
+{
+    if (ring->sqes)
+        munmap(ring->sqes, ring->sqes_size);
+    if (ring->cq_map && ring->cq_map != ring->sq_map)
+        munmap(ring->cq_map, ring->cq_map_size);
+    if (ring->sq_map && ring->sq_map != MAP_FAILED)
+        munmap(ring->sq_map, ring->sq_map_size);
+    if (ring->fd >= 0)
+        close(ring->fd);
+    memset(ring, 0, sizeof(*ring));
+    ring->fd = -1;
+}
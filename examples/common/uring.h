@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2025, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/uio.h>
+#include <linux/io_uring.h>
+
+/* Minimal io_uring wrapper on top of the raw system calls, so the examples do
+ * not depend on liburing. It covers what a single-threaded event loop needs:
+ * submission and completion rings, registered buffers and provided buffer
+ * rings for multishot receives.
+ */
+typedef struct {
+    int fd;
+    /* Submission queue */
+    uint32_t *sq_head;
+    uint32_t *sq_tail;
+    uint32_t *sq_array;
+    uint32_t sq_mask;
+    uint32_t sq_entries;
+    struct io_uring_sqe *sqes;
+    /* SQEs prepared with uring_get_sqe() but not yet submitted */
+    uint32_t sqe_tail;
+    uint32_t sqe_pending;
+    /* Completion queue */
+    uint32_t *cq_head;
+    uint32_t *cq_tail;
+    uint32_t cq_mask;
+    struct io_uring_cqe *cqes;
+    void *sq_map;
+    size_t sq_map_size;
+    void *cq_map;
+    size_t cq_map_size;
+    size_t sqes_size;
+    /* Number of io_uring_enter() calls */
+    uint64_t enters;
+} uring_t;
+
+/* Ring of buffers provided to the kernel for receives with
+ * IOSQE_BUFFER_SELECT. The kernel picks a buffer per completion and reports
+ * its ID in the CQE flags.
+ */
+typedef struct {
+    struct io_uring_buf_ring *ring;
+    size_t ring_size;
+    uint8_t *bufs;
+    uint32_t buf_size;
+    uint16_t num_bufs;
+    uint16_t bgid;
+    uint16_t tail;
+} uring_buf_ring_t;
+
+/* Helpers to encode the kind of operation and an index in the user data */
+#define URING_UD(type, index)	(((uint64_t)(type) << 32) | (uint32_t)(index))
+#define URING_UD_TYPE(ud)	((uint32_t)((ud) >> 32))
+#define URING_UD_INDEX(ud)	((uint32_t)(ud))
+
+/* Initializes an io_uring instance.
+ * @ring: ring to initialize.
+ * @entries: number of submission queue entries, a power of 2.
+ * @cq_entries: number of completion queue entries, 0 for twice entries.
+ *
+ * Returns:
+ *    0: Success.
+ *    -1: If an error occurs.
+ */
+int uring_init(uring_t *ring, unsigned entries, unsigned cq_entries);
+
+/* Returns the next free SQE, cleared. The SQE is submitted with the next
+ * call of uring_submit().
+ * @ring: ring initialized with uring_init().
+ *
+ * Returns:
+ *    Pointer to the SQE or NULL if the submission queue is full.
+ */
+struct io_uring_sqe *uring_get_sqe(uring_t *ring);
+
+/* Number of SQEs that can still be prepared before the next submission. */
+unsigned uring_sq_space(const uring_t *ring);
+
+/* Submits the prepared SQEs with one io_uring_enter() call and optionally
+ * waits for completions.
+ * @ring: ring initialized with uring_init().
+ * @wait_nr: number of completions to wait for, 0 to return immediately.
+ *
+ * Returns:
+ *    Number of SQEs consumed by the kernel, or -errno on error. An
+ *    interrupted wait returns -EINTR.
+ */
+int uring_submit(uring_t *ring, unsigned wait_nr);
+
+/* Returns the next completion without blocking or NULL if there is none.
+ * It stays valid until uring_cqe_seen() is called.
+ * @ring: ring initialized with uring_init().
+ */
+struct io_uring_cqe *uring_peek_cqe(uring_t *ring);
+
+/* Marks the completion returned by uring_peek_cqe() as consumed. */
+void uring_cqe_seen(uring_t *ring);
+
+/* Registers buffers for IORING_OP_READ_FIXED and IORING_OP_WRITE_FIXED.
+ * @ring: ring initialized with uring_init().
+ * @iovs: buffers, the index in the array is the buf_index of the SQEs.
+ * @num_iovs: number of buffers.
+ *
+ * Returns:
+ *    0: Success.
+ *    -1: If an error occurs.
+ */
+int uring_register_buffers(uring_t *ring, const struct iovec *iovs,
+                           unsigned num_iovs);
+
+/* Allocates num_bufs buffers of buf_size bytes and provides them to the
+ * kernel as buffer group bgid.
+ * @ring: ring initialized with uring_init().
+ * @br: buffer ring to initialize.
+ * @bgid: buffer group ID used in sqe->buf_group.
+ * @num_bufs: number of buffers, a power of 2.
+ * @buf_size: size of each buffer.
+ *
+ * Returns:
+ *    0: Success.
+ *    -1: If an error occurs.
+ */
+int uring_buf_ring_init(uring_t *ring, uring_buf_ring_t *br, uint16_t bgid,
+                        uint16_t num_bufs, uint32_t buf_size);
+
+/* Returns the buffer a completion with IORING_CQE_F_BUFFER refers to. */
+uint8_t *uring_buf_ring_get(uring_buf_ring_t *br, uint32_t cqe_flags);
+
+/* Hands the buffer of a completion back to the kernel. */
+void uring_buf_ring_recycle(uring_buf_ring_t *br, uint32_t cqe_flags);
+
+/* Unregisters and frees a buffer ring. */
+void uring_buf_ring_close(uring_t *ring, uring_buf_ring_t *br);
+
+/* Unmaps the rings and closes the io_uring instance. */
+void uring_close(uring_t *ring);
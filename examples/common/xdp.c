@@ -0,0 +1,486 @@
+/*
+ * Copyright (c) 2025, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <linux/bpf.h>
+#include <linux/if.h>
+#include <linux/if_link.h>
+#include <linux/if_packet.h>
+#include <linux/if_xdp.h>
+#include <poll.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "common/xdp.h"
+
+#define XSKMAP_MAX_ENTRIES	64
+#define TX_RECLAIM_RETRIES	1000
+
+#define BPF_INSN(code, dst, src, off, imm) \
+        ((struct bpf_insn) { (code), (dst), (src), (off), (imm) })
+
+static long sys_bpf(int cmd, union bpf_attr *attr)
+{
+    return syscall(__NR_bpf, cmd, attr, sizeof(*attr));
+}
+
+/* Load the XDP program, which is equivalent to:
+ *
+ *   if (data + ETH_HLEN > data_end || eth->h_proto != htons(ETH_P_TSN))
+ *       return XDP_PASS;
+ *   return bpf_redirect_map(&xskmap, ctx->rx_queue_index, XDP_PASS);
+ *
+ * Frames of queues without a socket in the map are passed as well.
+ */
+static int load_xdp_program(xdp_socket_t *xsk)
+{
+    static char log[4096];
+    union bpf_attr attr;
+    uint32_t key = xsk->queue_id;
+    int res;
+
+    memset(&attr, 0, sizeof(attr));
+    attr.map_type = BPF_MAP_TYPE_XSKMAP;
+    attr.key_size = sizeof(uint32_t);
+    attr.value_size = sizeof(uint32_t);
+    attr.max_entries = XSKMAP_MAX_ENTRIES;
+    xsk->map_fd = sys_bpf(BPF_MAP_CREATE, &attr);
+    if (xsk->map_fd < 0) {
+        perror("Failed to create XSKMAP");
+        return -1;
+    }
+
+    struct bpf_insn prog[] = {
+        /* r2 = ctx->data, r3 = ctx->data_end */
+        BPF_INSN(BPF_LDX | BPF_MEM | BPF_W, BPF_REG_2, BPF_REG_1, 0, 0),
+        BPF_INSN(BPF_LDX | BPF_MEM | BPF_W, BPF_REG_3, BPF_REG_1, 4, 0),
+        BPF_INSN(BPF_ALU64 | BPF_MOV | BPF_X, BPF_REG_4, BPF_REG_2, 0, 0),
+        BPF_INSN(BPF_ALU64 | BPF_ADD | BPF_K, BPF_REG_4, 0, 0, ETH_HLEN),
+        BPF_INSN(BPF_JMP | BPF_JGT | BPF_X, BPF_REG_4, BPF_REG_3, 8, 0),
+        /* r4 = eth->h_proto */
+        BPF_INSN(BPF_LDX | BPF_MEM | BPF_H, BPF_REG_4, BPF_REG_2, 12, 0),
+        BPF_INSN(BPF_JMP | BPF_JNE | BPF_K, BPF_REG_4, 0, 6,
+                 htons(ETH_P_TSN)),
+        /* return bpf_redirect_map(&xskmap, ctx->rx_queue_index, XDP_PASS) */
+        BPF_INSN(BPF_LDX | BPF_MEM | BPF_W, BPF_REG_2, BPF_REG_1, 16, 0),
+        BPF_INSN(BPF_LD | BPF_DW | BPF_IMM, BPF_REG_1, BPF_PSEUDO_MAP_FD, 0,
+                 xsk->map_fd),
+        BPF_INSN(0, 0, 0, 0, 0),
+        BPF_INSN(BPF_ALU64 | BPF_MOV | BPF_K, BPF_REG_3, 0, 0, XDP_PASS),
+        BPF_INSN(BPF_JMP | BPF_CALL, 0, 0, 0, BPF_FUNC_redirect_map),
+        BPF_INSN(BPF_JMP | BPF_EXIT, 0, 0, 0, 0),
+        /* return XDP_PASS */
+        BPF_INSN(BPF_ALU64 | BPF_MOV | BPF_K, BPF_REG_0, 0, 0, XDP_PASS),
+        BPF_INSN(BPF_JMP | BPF_EXIT, 0, 0, 0, 0),
+    };
+
+    memset(&attr, 0, sizeof(attr));
+    attr.prog_type = BPF_PROG_TYPE_XDP;
+    attr.insns = (uintptr_t) prog;
+    attr.insn_cnt = sizeof(prog) / sizeof(prog[0]);
+    attr.license = (uintptr_t) "Dual BSD/GPL";
+    attr.log_buf = (uintptr_t) log;
+    attr.log_size = sizeof(log);
+    attr.log_level = 1;
+    xsk->prog_fd = sys_bpf(BPF_PROG_LOAD, &attr);
+    if (xsk->prog_fd < 0) {
+        perror("Failed to load XDP program");
+        fprintf(stderr, "%s", log);
+        return -1;
+    }
+
+    /* Generic (SKB) mode works with every driver. The program is detached
+     * when the link is closed.
+     */
+    memset(&attr, 0, sizeof(attr));
+    attr.link_create.prog_fd = xsk->prog_fd;
+    attr.link_create.target_ifindex = xsk->ifindex;
+    attr.link_create.attach_type = BPF_XDP;
+    attr.link_create.flags = XDP_FLAGS_SKB_MODE;
+    xsk->link_fd = sys_bpf(BPF_LINK_CREATE, &attr);
+    if (xsk->link_fd < 0) {
+        perror("Failed to attach XDP program");
+        return -1;
+    }
+
+    memset(&attr, 0, sizeof(attr));
+    attr.map_fd = xsk->map_fd;
+    attr.key = (uintptr_t) &key;
+    attr.value = (uintptr_t) &xsk->fd;
+    res = sys_bpf(BPF_MAP_UPDATE_ELEM, &attr);
+    if (res < 0) {
+        perror("Failed to add socket to XSKMAP");
+        return -1;
+    }
+
+    return 0;
+}
+
+static int map_xdp_ring(xdp_socket_t *xsk, xdp_ring_t *ring,
+                const struct xdp_ring_offset *off, size_t desc_size,
+                off_t pgoff)
+{
+    ring->map_size = off->desc + XDP_RING_SIZE * desc_size;
+    ring->map = mmap(NULL, ring->map_size, PROT_READ | PROT_WRITE,
+                     MAP_SHARED | MAP_POPULATE, xsk->fd, pgoff);
+    if (ring->map == MAP_FAILED) {
+        perror("Failed to map AF_XDP ring");
+        ring->map = NULL;
+        return -1;
+    }
+
+    ring->producer = (uint32_t *) ((uint8_t *) ring->map + off->producer);
+    ring->consumer = (uint32_t *) ((uint8_t *) ring->map + off->consumer);
+    ring->descs = (uint8_t *) ring->map + off->desc;
+    ring->mask = XDP_RING_SIZE - 1;
+
+    return 0;
+}
+
+/* User space produces to the fill and TX rings... */
+static void ring_produce(xdp_ring_t *ring)
+{
+    __atomic_store_n(ring->producer, ring->index, __ATOMIC_RELEASE);
+}
+
+/* ...and consumes from the RX and completion rings. */
+static uint32_t ring_available(xdp_ring_t *ring)
+{
+    return __atomic_load_n(ring->producer, __ATOMIC_ACQUIRE) - ring->index;
+}
+
+static void ring_consume(xdp_ring_t *ring, uint32_t n)
+{
+    ring->index += n;
+    __atomic_store_n(ring->consumer, ring->index, __ATOMIC_RELEASE);
+}
+
+static int get_interface(xdp_socket_t *xsk, const char *ifname)
+{
+    struct ifreq req;
+    int fd, res;
+
+    fd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd < 0) {
+        perror("Failed to open socket");
+        return -1;
+    }
+
+    snprintf(req.ifr_name, sizeof(req.ifr_name), "%s", ifname);
+    res = ioctl(fd, SIOCGIFINDEX, &req);
+    if (res < 0) {
+        perror("Failed to get interface index");
+        goto out;
+    }
+    xsk->ifindex = req.ifr_ifindex;
+
+    res = ioctl(fd, SIOCGIFHWADDR, &req);
+    if (res < 0) {
+        perror("Failed to get interface address");
+        goto out;
+    }
+    memcpy(xsk->src_addr, req.ifr_hwaddr.sa_data, ETH_ALEN);
+
+out:
+    close(fd);
+    return res;
+}
+
+int create_xdp_socket(xdp_socket_t *xsk, char *ifname, uint8_t macaddr[],
+                uint32_t queue_id, int rx)
+{
+    struct xdp_umem_reg umem_reg;
+    struct xdp_mmap_offsets off;
+    struct sockaddr_xdp sxdp;
+    socklen_t optlen = sizeof(off);
+    int res, ring_size = XDP_RING_SIZE;
+
+    memset(xsk, 0, sizeof(*xsk));
+    xsk->prog_fd = -1;
+    xsk->map_fd = -1;
+    xsk->link_fd = -1;
+    xsk->queue_id = queue_id;
+    memcpy(xsk->dst_addr, macaddr, ETH_ALEN);
+
+    xsk->fd = socket(AF_XDP, SOCK_RAW, 0);
+    if (xsk->fd < 0) {
+        perror("Failed to open AF_XDP socket");
+        return -1;
+    }
+
+    res = get_interface(xsk, ifname);
+    if (res < 0)
+        goto err;
+
+    xsk->umem = mmap(NULL, (size_t) XDP_NUM_FRAMES * XDP_FRAME_SIZE,
+                     PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE, -1, 0);
+    if (xsk->umem == MAP_FAILED) {
+        perror("Failed to allocate UMEM");
+        xsk->umem = NULL;
+        goto err;
+    }
+
+    memset(&umem_reg, 0, sizeof(umem_reg));
+    umem_reg.addr = (uintptr_t) xsk->umem;
+    umem_reg.len = (uint64_t) XDP_NUM_FRAMES * XDP_FRAME_SIZE;
+    umem_reg.chunk_size = XDP_FRAME_SIZE;
+    res = setsockopt(xsk->fd, SOL_XDP, XDP_UMEM_REG, &umem_reg,
+                     sizeof(umem_reg));
+    if (res < 0) {
+        perror("Failed to register UMEM");
+        goto err;
+    }
+
+    if (setsockopt(xsk->fd, SOL_XDP, XDP_UMEM_FILL_RING, &ring_size,
+                   sizeof(ring_size)) < 0 ||
+        setsockopt(xsk->fd, SOL_XDP, XDP_UMEM_COMPLETION_RING, &ring_size,
+                   sizeof(ring_size)) < 0 ||
+        setsockopt(xsk->fd, SOL_XDP, XDP_RX_RING, &ring_size,
+                   sizeof(ring_size)) < 0 ||
+        setsockopt(xsk->fd, SOL_XDP, XDP_TX_RING, &ring_size,
+                   sizeof(ring_size)) < 0) {
+        perror("Failed to set up AF_XDP rings");
+        goto err;
+    }
+
+    res = getsockopt(xsk->fd, SOL_XDP, XDP_MMAP_OFFSETS, &off, &optlen);
+    if (res < 0) {
+        perror("Failed to get AF_XDP ring offsets");
+        goto err;
+    }
+
+    if (map_xdp_ring(xsk, &xsk->fill, &off.fr, sizeof(uint64_t),
+                     XDP_UMEM_PGOFF_FILL_RING) < 0 ||
+        map_xdp_ring(xsk, &xsk->completion, &off.cr, sizeof(uint64_t),
+                     XDP_UMEM_PGOFF_COMPLETION_RING) < 0 ||
+        map_xdp_ring(xsk, &xsk->rx, &off.rx, sizeof(struct xdp_desc),
+                     XDP_PGOFF_RX_RING) < 0 ||
+        map_xdp_ring(xsk, &xsk->tx, &off.tx, sizeof(struct xdp_desc),
+                     XDP_PGOFF_TX_RING) < 0)
+        goto err;
+
+    /* Hand all RX frames to the kernel, keep the TX frames. */
+    for (uint32_t i = 0; i < XDP_RX_FRAMES; i++)
+        ((uint64_t *) xsk->fill.descs)[i] = (uint64_t) i * XDP_FRAME_SIZE;
+    xsk->fill.index = XDP_RX_FRAMES;
+    ring_produce(&xsk->fill);
+
+    for (uint32_t i = 0; i < XDP_TX_FRAMES; i++)
+        xsk->free_frames[i] = (uint64_t) (XDP_RX_FRAMES + i) *
+                              XDP_FRAME_SIZE;
+    xsk->num_free = XDP_TX_FRAMES;
+
+    memset(&sxdp, 0, sizeof(sxdp));
+    sxdp.sxdp_family = AF_XDP;
+    sxdp.sxdp_ifindex = xsk->ifindex;
+    sxdp.sxdp_queue_id = queue_id;
+    sxdp.sxdp_flags = XDP_COPY;
+    res = bind(xsk->fd, (struct sockaddr *) &sxdp, sizeof(sxdp));
+    if (res < 0) {
+        perror("Couldn't bind() AF_XDP socket");
+        goto err;
+    }
+
+    if (rx) {
+        res = load_xdp_program(xsk);
+        if (res < 0)
+            goto err;
+    }
+
+    return 0;
+
+err:
+    xdp_socket_close(xsk);
+    return -1;
+}
+
+int xdp_socket_recv(xdp_socket_t *xsk, uint8_t **pdu, int timeout_ms)
+{
+    struct xdp_desc *desc;
+    struct pollfd pfd;
+    int res;
+
+    for (;;) {
+        /* Return the frame handed out by the last call to the kernel. */
+        if (xsk->rx_pending) {
+            ((uint64_t *) xsk->fill.descs)[xsk->fill.index & xsk->fill.mask] =
+                    xsk->rx_addr;
+            xsk->fill.index++;
+            ring_produce(&xsk->fill);
+            ring_consume(&xsk->rx, 1);
+            xsk->rx_pending = 0;
+        }
+
+        if (ring_available(&xsk->rx)) {
+            desc = &((struct xdp_desc *) xsk->rx.descs)[xsk->rx.index &
+                                                        xsk->rx.mask];
+            /* In copy mode the address includes the headroom. */
+            xsk->rx_addr = desc->addr & ~((uint64_t) XDP_FRAME_SIZE - 1);
+            xsk->rx_pending = 1;
+            if (desc->len <= ETH_HLEN)
+                continue;
+            *pdu = xsk->umem + desc->addr + ETH_HLEN;
+            return desc->len - ETH_HLEN;
+        }
+
+        pfd.fd = xsk->fd;
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+        res = poll(&pfd, 1, timeout_ms);
+        if (res == 0)
+            return 0;
+        if (res < 0) {
+            if (errno == EINTR)
+                continue;
+            perror("Failed to poll AF_XDP socket");
+            return -1;
+        }
+    }
+}
+
+static void reclaim_tx_frames(xdp_socket_t *xsk)
+{
+    uint32_t n = ring_available(&xsk->completion);
+
+    for (uint32_t i = 0; i < n; i++)
+        xsk->free_frames[xsk->num_free++] =
+                ((uint64_t *) xsk->completion.descs)[(xsk->completion.index + i) &
+                                                     xsk->completion.mask];
+    if (n)
+        ring_consume(&xsk->completion, n);
+}
+
+/* Let the kernel process the TX ring. Copy mode sends frames in batches, so
+ * EAGAIN only means that frames are left.
+ */
+static int kick_tx(xdp_socket_t *xsk)
+{
+    int res;
+
+    xsk->kicks++;
+    res = sendto(xsk->fd, NULL, 0, MSG_DONTWAIT, NULL, 0);
+    if (res < 0 && errno != EAGAIN && errno != EBUSY && errno != ENOBUFS &&
+            errno != EINTR) {
+        perror("Failed to send data");
+        return -1;
+    }
+
+    return 0;
+}
+
+uint8_t *xdp_socket_tx_next(xdp_socket_t *xsk)
+{
+    struct pollfd pfd = { .fd = xsk->fd, .events = POLLOUT };
+
+    if (xsk->num_free == 0)
+        reclaim_tx_frames(xsk);
+
+    for (int i = 0; xsk->num_free == 0; i++) {
+        if (i == TX_RECLAIM_RETRIES) {
+            fprintf(stderr, "No AF_XDP TX frame available\n");
+            return NULL;
+        }
+        if (kick_tx(xsk) < 0)
+            return NULL;
+        poll(&pfd, 1, 1);
+        reclaim_tx_frames(xsk);
+    }
+
+    return xsk->umem + xsk->free_frames[xsk->num_free - 1] + ETH_HLEN;
+}
+
+void xdp_socket_tx_queue(xdp_socket_t *xsk, size_t len)
+{
+    uint64_t addr = xsk->free_frames[--xsk->num_free];
+    struct ethhdr *eth = (struct ethhdr *) (xsk->umem + addr);
+    struct xdp_desc *desc;
+
+    memcpy(eth->h_dest, xsk->dst_addr, ETH_ALEN);
+    memcpy(eth->h_source, xsk->src_addr, ETH_ALEN);
+    eth->h_proto = htons(ETH_P_TSN);
+
+    desc = &((struct xdp_desc *) xsk->tx.descs)[xsk->tx.index & xsk->tx.mask];
+    desc->addr = addr;
+    desc->len = ETH_HLEN + len;
+    desc->options = 0;
+    xsk->tx.index++;
+    ring_produce(&xsk->tx);
+}
+
+int xdp_socket_tx_flush(xdp_socket_t *xsk)
+{
+    while (__atomic_load_n(xsk->tx.consumer, __ATOMIC_ACQUIRE) !=
+            xsk->tx.index) {
+        if (kick_tx(xsk) < 0)
+            return -1;
+    }
+    reclaim_tx_frames(xsk);
+
+    return 0;
+}
+
+void xdp_socket_close(xdp_socket_t *xsk)
+{
+    xdp_ring_t *rings[] = { &xsk->fill, &xsk->completion, &xsk->rx, &xsk->tx };
+
+    if (xsk->link_fd >= 0)
+        close(xsk->link_fd);
+    if (xsk->prog_fd >= 0)
+        close(xsk->prog_fd);
+    if (xsk->map_fd >= 0)
+        close(xsk->map_fd);
+    for (unsigned int i = 0; i < sizeof(rings) / sizeof(rings[0]); i++) {
+        if (rings[i]->map)
+            munmap(rings[i]->map, rings[i]->map_size);
+    }
+    close(xsk->fd);
+    if (xsk->umem)
+        munmap(xsk->umem, (size_t) XDP_NUM_FRAMES * XDP_FRAME_SIZE);
+}
+
+int tx_batch_init_xdp(tx_batch_t *batch, xdp_socket_t *xsk,
+                unsigned int max_pdus)
+{
+    int res;
+
+    res = tx_batch_init(batch, xsk->fd, NULL, 0, max_pdus);
+    if (res < 0)
+        return -1;
+
+    batch->xsk = xsk;
+
+    return 0;
+}
@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2025, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <linux/if_ether.h>
+
+#include "common.h"
+
+#define XDP_FRAME_SIZE		2048
+#define XDP_NUM_FRAMES		4096
+/* The first half of the UMEM frames receives, the second half transmits. */
+#define XDP_RX_FRAMES		(XDP_NUM_FRAMES / 2)
+#define XDP_TX_FRAMES		(XDP_NUM_FRAMES / 2)
+#define XDP_RING_SIZE		2048
+
+/* Single producer / single consumer ring shared with the kernel. */
+typedef struct {
+    uint32_t *producer;
+    uint32_t *consumer;
+    void *descs;
+    uint32_t mask;
+    /* Local copy of the index owned by user space */
+    uint32_t index;
+    void *map;
+    size_t map_size;
+} xdp_ring_t;
+
+/* AF_XDP socket bound to one queue of a network interface. Received frames
+ * are redirected to it by a small XDP program that matches EtherType
+ * ETH_P_TSN. The socket runs in copy mode, so any driver (e.g. veth) works.
+ */
+typedef struct xdp_socket {
+    int fd;
+    int ifindex;
+    uint32_t queue_id;
+    uint8_t src_addr[ETH_ALEN];
+    uint8_t dst_addr[ETH_ALEN];
+    /* XDP program, XSKMAP and link attaching the program to the interface */
+    int prog_fd;
+    int map_fd;
+    int link_fd;
+    uint8_t *umem;
+    xdp_ring_t fill;
+    xdp_ring_t completion;
+    xdp_ring_t rx;
+    xdp_ring_t tx;
+    /* RX frame handed out by xdp_socket_recv() */
+    uint64_t rx_addr;
+    int rx_pending;
+    /* TX frames not owned by the kernel */
+    uint64_t free_frames[XDP_TX_FRAMES];
+    unsigned int num_free;
+    uint64_t kicks;
+} xdp_socket_t;
+
+/* Create an AF_XDP socket on a queue of a network interface.
+ * @xsk: Socket to be set up. Should be released with xdp_socket_close().
+ * @ifname: Network interface name.
+ * @macaddr: Stream destination MAC address of transmitted frames.
+ * @queue_id: Receive/transmit queue of the interface.
+ * @rx: If non-zero, an XDP program redirecting ETH_P_TSN frames of the
+ *      queue to the socket is attached to the interface. All other frames
+ *      are passed to the network stack.
+ *
+ * Returns:
+ *    0: Success.
+ *    -1: Could not create the socket or load the XDP program.
+ */
+int create_xdp_socket(xdp_socket_t *xsk, char *ifname, uint8_t macaddr[],
+        uint32_t queue_id, int rx);
+
+/* Get the next ETH_P_TSN frame, waiting for it if necessary. The frame stays
+ * in the UMEM and is valid until the next call.
+ * @xsk: AF_XDP socket.
+ * @pdu: Set to the start of the AVTP PDU behind the Ethernet header.
+ * @timeout_ms: Max. time to wait for a frame, -1 waits forever.
+ *
+ * Returns:
+ *    > 0: Length of the AVTP PDU.
+ *    0: Timeout.
+ *    -1: Could not poll the socket.
+ */
+int xdp_socket_recv(xdp_socket_t *xsk, uint8_t **pdu, int timeout_ms);
+
+/* Get a free TX frame, reclaiming frames sent by the kernel if necessary.
+ * @xsk: AF_XDP socket.
+ *
+ * Returns:
+ *    Buffer of TX_BATCH_PDU_SIZE bytes for the AVTP PDU, NULL if no frame
+ *    could be reclaimed.
+ */
+uint8_t *xdp_socket_tx_next(xdp_socket_t *xsk);
+
+/* Put the frame returned by xdp_socket_tx_next() on the TX ring. The
+ * Ethernet header is added here. The frame is sent by the next
+ * xdp_socket_tx_flush().
+ * @xsk: AF_XDP socket.
+ * @len: Length of the AVTP PDU.
+ */
+void xdp_socket_tx_queue(xdp_socket_t *xsk, size_t len);
+
+/* Kick the kernel until all frames on the TX ring have been sent.
+ * @xsk: AF_XDP socket.
+ *
+ * Returns:
+ *    0: Success.
+ *    -1: Could not send the frames.
+ */
+int xdp_socket_tx_flush(xdp_socket_t *xsk);
+
+/* Detach the XDP program and release the socket.
+ * @xsk: AF_XDP socket.
+ */
+void xdp_socket_close(xdp_socket_t *xsk);
+
+/* Initialize a transmit batch on an AF_XDP socket.
+ * @batch: Batch to be initialized.
+ * @xsk: AF_XDP socket created with create_xdp_socket().
+ * @max_pdus: PDUs queued before the batch is flushed, at most
+ *            TX_BATCH_MAX_PDUS.
+ *
+ * Returns:
+ *    0: Success.
+ *    -1: Invalid number of PDUs.
+ */
+int tx_batch_init_xdp(tx_batch_t *batch, xdp_socket_t *xsk,
+        unsigned int max_pdus);
@@ -48,6 +48,8 @@
  *
  * TSN stream parameters (e.g. destination mac address and mode) are passed
  * via command-line arguments. Run 'crf-listener --help' for more information.
+ * The lost, reordered and duplicated PDUs are printed on SIGUSR1 or with the
+ * statistics.
  *
  * This example relies on the system clock to keep the transmission interval
  * when operating in AAF talker mode. So make sure the system clock is
@@ -81,6 +83,7 @@
 
 #include <assert.h>
 #include <argp.h>
+#include <errno.h>
 #include <arpa/inet.h>
 #include <linux/if.h>
 #include <linux/if_ether.h>
@@ -102,6 +105,7 @@
 #include "avtp/Crf.h"
 #include "avtp/aaf/Pcm.h"
 #include "common/common.h"
+#include "common/seqstats.h"
 #include "avtp/CommonHeader.h"
 
 #define AAF_STREAM_ID		0xAABBCCDDEEFF0001
@@ -147,10 +151,14 @@ static int mtt;
 static bool prev_state;
 static bool first_aaf_pdu = true;
 static bool need_mclk_lookup = true;
-static uint8_t crf_seq_num;
+static Avtp_SeqTracker_t crf_seq;
+static Avtp_SeqTracker_t aaf_rx_seq;
 static uint8_t aaf_seq_num;
+static seq_stats_timer_t seq_stats_timer;
 static uint64_t prev_mclk_timestamp, rounded_mtt;
 static STAILQ_HEAD(timestamp_queue, media_clock_entry) mclk_timestamps;
+static uint32_t stats_interval;
+static tx_batch_t tx_batch;
 
 static struct argp_option options[] = {
     {"crf-addr", 'c', "MACADDR", 0, "CRF Stream Destination MAC address" },
@@ -159,6 +167,7 @@ static struct argp_option options[] = {
     {"prio", 'p', "NUM", 0, "SO_PRIORITY to be set in AAF stream" },
     {"mtt", 'm', "MSEC", 0, "Max Transit time from AAF stream (in ms)" },
     {"mode", 'o', "talker|listener", 0, "AAF operation mode"},
+    {"stats", 's', "SECONDS", 0, "Print AAF TX batching and sequence number statistics every SECONDS" },
     { 0 }
 };
 
@@ -196,6 +205,9 @@ static error_t parser(int key, char *arg, struct argp_state *state)
     case 'p':
         priority = atoi(arg);
         break;
+    case 's':
+        stats_interval = atoi(arg);
+        break;
     case 'o':
         if (strcmp(arg, "talker") == 0)
             mode = MODE_TALKER;
@@ -268,262 +280,122 @@ static uint64_t mclk_lookup(uint32_t avtp_time)
     return mclk_timestamp;
 }
 
-static bool is_valid_crf_pdu(struct avtp_crf_pdu *pdu)
+static bool is_valid_crf_pdu(const Avtp_CrfHeader_t *hdr)
 {
-    int res;
-    uint32_t val32;
-    uint64_t val64;
-    struct avtp_common_pdu *common = (struct avtp_common_pdu *) pdu;
-
-    res = avtp_pdu_get(common, AVTP_FIELD_SUBTYPE, &val32);
-    if (res < 0) {
-        fprintf(stderr, "Failed to get CRF subtype field: %d\n", res);
-        return false;
-    }
-    if (val32 != AVTP_SUBTYPE_CRF)
+    if (hdr->subtype != AVTP_SUBTYPE_CRF)
         return false;
 
-    res = avtp_pdu_get(common, AVTP_FIELD_VERSION, &val32);
-    if (res < 0) {
-        fprintf(stderr, "Failed to get CRF version field: %d\n", res);
-        return false;
-    }
-    if (val32 != 0) {
+    if (hdr->version != 0) {
         fprintf(stderr, "CRF: Version mismatch: expected %u, got %u\n",
-                                0, val32);
-        return false;
-    }
-
-    res = avtp_crf_pdu_get(pdu, AVTP_CRF_FIELD_SV, &val64);
-    if (res < 0) {
-        fprintf(stderr, "Failed to get CRF sv field: %d\n", res);
-        return false;
-    }
-    if (val64 != 1) {
-        fprintf(stderr, "CRF: sv mismatch: expected %u, got %" PRIu64 "\n",
-                                1, val64);
+                                0, hdr->version);
         return false;
     }
 
-    res = avtp_crf_pdu_get(pdu, AVTP_CRF_FIELD_FS, &val64);
-    if (res < 0) {
-        fprintf(stderr, "Failed to get CRF fs field: %d\n", res);
-        return false;
-    }
-    if (val64 != 0) {
-        fprintf(stderr, "CRF: fs mismatch: expected %u, got %" PRIu64 "\n",
-                                0, val64);
+    if (hdr->sv != 1) {
+        fprintf(stderr, "CRF: sv mismatch: expected %u, got %u\n",
+                                1, hdr->sv);
         return false;
     }
 
-    res = avtp_crf_pdu_get(pdu, AVTP_CRF_FIELD_SEQ_NUM, &val64);
-    if (res < 0) {
-        fprintf(stderr, "Failed to get CRF sequence num field: %d\n",
-                                    res);
+    if (hdr->fs != 0) {
+        fprintf(stderr, "CRF: fs mismatch: expected %u, got %u\n",
+                                0, hdr->fs);
         return false;
     }
-    if (val64 != crf_seq_num) {
-        /* If we have a sequence number mismatch, we simply log the
-         * issue and continue to process the packet. We don't want to
-         * invalidate it since it is a valid packet after all.
-         */
-        fprintf(stderr, "CRF: Sequence number mismatch: expected %u, got %" PRIu64 "\n",
-                            crf_seq_num, val64);
 
-        crf_seq_num = val64;
-    }
-
-    crf_seq_num++;
+    /* Sequence number mismatches are only counted, the PDU is valid
+     * after all.
+     */
+    Avtp_SeqTracker_Update(&crf_seq, hdr->sequence_num);
 
-    res = avtp_crf_pdu_get(pdu, AVTP_CRF_FIELD_TYPE, &val64);
-    if (res < 0) {
-        fprintf(stderr, "Failed to get CRF format field: %d\n", res);
-        return false;
-    }
-    if (val64 != AVTP_CRF_TYPE_AUDIO_SAMPLE) {
-        fprintf(stderr, "CRF: Format mismatch: expected %u, got %" PRIu64 "\n",
-                    AVTP_CRF_TYPE_AUDIO_SAMPLE, val64);
+    if (hdr->type != AVTP_CRF_TYPE_AUDIO_SAMPLE) {
+        fprintf(stderr, "CRF: Format mismatch: expected %u, got %u\n",
+                    AVTP_CRF_TYPE_AUDIO_SAMPLE, hdr->type);
         return false;
     }
 
-    res = avtp_crf_pdu_get(pdu, AVTP_CRF_FIELD_STREAM_ID, &val64);
-    if (res < 0) {
-        fprintf(stderr, "Failed to get CRF stream ID field: %d\n",
-                                    res);
-        return false;
-    }
-    if (val64 != CRF_STREAM_ID) {
+    if (hdr->stream_id != CRF_STREAM_ID) {
         fprintf(stderr, "CRF: Stream ID mismatch: expected %" PRIu64 ", got %" PRIu64 "\n",
-                            CRF_STREAM_ID, val64);
+                            CRF_STREAM_ID, hdr->stream_id);
         return false;
     }
 
-    res = avtp_crf_pdu_get(pdu, AVTP_CRF_FIELD_PULL, &val64);
-    if (res < 0) {
-        fprintf(stderr, "Failed to get CRF multiplier modifier field: %d\n",
-                                    res);
-        return false;
-    }
-    if (val64 != AVTP_CRF_PULL_MULT_BY_1) {
-        fprintf(stderr, "CRF Pull mismatch: expected %u, got %" PRIu64 "\n",
-                    AVTP_CRF_PULL_MULT_BY_1, val64);
+    if (hdr->pull != AVTP_CRF_PULL_MULT_BY_1) {
+        fprintf(stderr, "CRF Pull mismatch: expected %u, got %u\n",
+                    AVTP_CRF_PULL_MULT_BY_1, hdr->pull);
         return false;
     }
 
-    res = avtp_crf_pdu_get(pdu, AVTP_CRF_FIELD_BASE_FREQ, &val64);
-    if (res < 0) {
-        fprintf(stderr, "Failed to get CRF base frequency field: %d\n",
-                                    res);
-        return false;
-    }
-    if (val64 != CRF_SAMPLE_RATE) {
-        fprintf(stderr, "CRF Base frequency: expected %u, got %" PRIu64 "\n",
-                        CRF_SAMPLE_RATE, val64);
+    if (hdr->base_frequency != CRF_SAMPLE_RATE) {
+        fprintf(stderr, "CRF Base frequency: expected %u, got %u\n",
+                        CRF_SAMPLE_RATE, hdr->base_frequency);
         return false;
     }
 
-    res = avtp_crf_pdu_get(pdu, AVTP_CRF_FIELD_CRF_DATA_LEN, &val64);
-    if (res < 0) {
-        fprintf(stderr, "Failed to get CRF data length field: %d\n",
-                                    res);
-        return false;
-    }
-    if (val64 != CRF_DATA_LEN) {
-        fprintf(stderr, "CRF Data length mismatch: expected %zu, got %" PRIu64 "\n",
-                            CRF_DATA_LEN, val64);
+    if (hdr->crf_data_length != CRF_DATA_LEN) {
+        fprintf(stderr, "CRF Data length mismatch: expected %zu, got %u\n",
+                            CRF_DATA_LEN, hdr->crf_data_length);
         return false;
     }
 
     return true;
 }
 
-static bool is_valid_aaf_pdu(struct avtp_stream_pdu *pdu)
+static bool is_valid_aaf_pdu(const Avtp_PcmHeader_t *hdr)
 {
-    struct avtp_common_pdu *common = (struct avtp_common_pdu *) pdu;
-    uint64_t val64;
-    uint32_t val32;
-    int res;
-
-    res = avtp_pdu_get(common, AVTP_FIELD_VERSION, &val32);
-    if (res < 0) {
-        fprintf(stderr, "AAF: Failed to get version field: %d\n", res);
-        return false;
-    }
-    if (val32 != 0) {
+    if (hdr->version != 0) {
         fprintf(stderr, "AAF: Version mismatch: expected %u, got %u\n",
-                                0, val32);
+                                0, hdr->version);
         return false;
     }
 
-    res = avtp_aaf_pdu_get(pdu, AVTP_AAF_FIELD_TV, &val64);
-    if (res < 0) {
-        fprintf(stderr, "AAF: Failed to get tv field: %d\n", res);
-        return false;
-    }
-    if (val64 != 1) {
-        fprintf(stderr, "AAF: tv mismatch: expected %u, got %" PRIu64 "\n",
-                                1, val64);
+    if (hdr->tv != 1) {
+        fprintf(stderr, "AAF: tv mismatch: expected %u, got %u\n",
+                                1, hdr->tv);
         return false;
     }
 
-    res = avtp_aaf_pdu_get(pdu, AVTP_AAF_FIELD_SP, &val64);
-    if (res < 0) {
-        fprintf(stderr, "AAF: Failed to get sp field: %d\n", res);
-        return false;
-    }
-    if (val64 != AVTP_AAF_PCM_SP_NORMAL) {
-        fprintf(stderr, "AAF: tv mismatch: expected %u, got %" PRIu64 "\n",
-                                1, val64);
+    if (hdr->sp != AVTP_AAF_PCM_SP_NORMAL) {
+        fprintf(stderr, "AAF: sp mismatch: expected %u, got %u\n",
+                                AVTP_AAF_PCM_SP_NORMAL, hdr->sp);
         return false;
     }
 
-    res = avtp_aaf_pdu_get(pdu, AVTP_AAF_FIELD_STREAM_ID, &val64);
-    if (res < 0) {
-        fprintf(stderr, "AAF: Failed to get stream ID field: %d\n",
-                                    res);
-        return false;
-    }
-    if (val64 != AAF_STREAM_ID) {
+    if (hdr->stream_id != AAF_STREAM_ID) {
         fprintf(stderr, "AAF: Stream ID mismatch: expected %" PRIu64 ", got %" PRIu64 "\n",
-                            AAF_STREAM_ID, val64);
+                            AAF_STREAM_ID, hdr->stream_id);
         return false;
     }
 
-    res = avtp_aaf_pdu_get(pdu, AVTP_AAF_FIELD_SEQ_NUM, &val64);
-    if (res < 0) {
-        fprintf(stderr, "AAF: Failed to get sequence num field: %d\n",
-                                    res);
-        return false;
-    }
-
-    if (val64 != aaf_seq_num) {
-        /* If we have a sequence number mismatch, we simply log the
-         * issue and continue to process the packet. We don't want to
-         * invalidate it since it is a valid packet after all.
-         */
-        fprintf(stderr, "AAF Sequence number mismatch: expected %u, got %" PRIu64 "\n",
-                            aaf_seq_num, val64);
+    Avtp_SeqTracker_Update(&aaf_rx_seq, hdr->sequence_num);
 
-        aaf_seq_num = val64;
-    }
-
-    aaf_seq_num++;
-
-    res = avtp_aaf_pdu_get(pdu, AVTP_AAF_FIELD_FORMAT, &val64);
-    if (res < 0) {
-        fprintf(stderr, "AAF: Failed to get format field: %d\n", res);
-        return false;
-    }
-    if (val64 != AVTP_AAF_FORMAT_INT_16BIT) {
-        fprintf(stderr, "AAF: Format mismatch: expected %u, got %" PRIu64 "\n",
-                    AVTP_AAF_FORMAT_INT_16BIT, val64);
+    if (hdr->format != AVTP_AAF_FORMAT_INT_16BIT) {
+        fprintf(stderr, "AAF: Format mismatch: expected %u, got %u\n",
+                    AVTP_AAF_FORMAT_INT_16BIT, hdr->format);
         return false;
     }
 
-    res = avtp_aaf_pdu_get(pdu, AVTP_AAF_FIELD_NSR, &val64);
-    if (res < 0) {
-        fprintf(stderr, "AAF: Failed to get sample rate field: %d\n",
-                                    res);
-        return false;
-    }
-    if (val64 != AVTP_AAF_PCM_NSR_48KHZ) {
-        fprintf(stderr, "AAF: Sample rate mismatch: expected %u, got %" PRIu64 "\n",
-                        AVTP_AAF_PCM_NSR_48KHZ, val64);
+    if (hdr->nsr != AVTP_AAF_PCM_NSR_48KHZ) {
+        fprintf(stderr, "AAF: Sample rate mismatch: expected %u, got %u\n",
+                        AVTP_AAF_PCM_NSR_48KHZ, hdr->nsr);
         return false;
     }
 
-    res = avtp_aaf_pdu_get(pdu, AVTP_AAF_FIELD_CHAN_PER_FRAME, &val64);
-    if (res < 0) {
-        fprintf(stderr, "AAF: Failed to get channels field: %d\n",
-                                    res);
-        return false;
-    }
-    if (val64 != AAF_NUM_CHANNELS) {
-        fprintf(stderr, "AAF: Channels mismatch: expected %u, got %" PRIu64 "\n",
-                        AAF_NUM_CHANNELS, val64);
+    if (hdr->channels_per_frame != AAF_NUM_CHANNELS) {
+        fprintf(stderr, "AAF: Channels mismatch: expected %u, got %u\n",
+                        AAF_NUM_CHANNELS, hdr->channels_per_frame);
         return false;
     }
 
-    res = avtp_aaf_pdu_get(pdu, AVTP_AAF_FIELD_BIT_DEPTH, &val64);
-    if (res < 0) {
-        fprintf(stderr, "AAF: Failed to get depth field: %d\n", res);
-        return false;
-    }
-    if (val64 != 16) {
-        fprintf(stderr, "AAF: Depth mismatch: expected %u, got %" PRIu64 "\n",
-                                16, val64);
+    if (hdr->bit_depth != 16) {
+        fprintf(stderr, "AAF: Depth mismatch: expected %u, got %u\n",
+                                16, hdr->bit_depth);
         return false;
     }
 
-    res = avtp_aaf_pdu_get(pdu, AVTP_AAF_FIELD_STREAM_DATA_LEN, &val64);
-    if (res < 0) {
-        fprintf(stderr, "AAF: Failed to get data_len field: %d\n",
-                                    res);
-        return false;
-    }
-    if (val64 != AAF_DATA_LEN) {
-        fprintf(stderr, "AAF: Data len mismatch: expected %u, got %" PRIu64 "\n",
-                            AAF_DATA_LEN, val64);
+    if (hdr->stream_data_length != AAF_DATA_LEN) {
+        fprintf(stderr, "AAF: Data len mismatch: expected %u, got %u\n",
+                            AAF_DATA_LEN, hdr->stream_data_length);
         return false;
     }
 
@@ -578,14 +450,13 @@ static int init_aaf_pdu(struct avtp_stream_pdu *pdu)
     return 0;
 }
 
-static int aaf_talker_tx_timeout(int fd_timer, int fd_sk,
-                        const struct sockaddr_ll *addr,
-                        struct avtp_stream_pdu *pdu)
+static int aaf_talker_tx_timeout(int fd_timer, struct avtp_stream_pdu *pdu)
 {
     int res;
     ssize_t n;
     uint64_t expirations;
     uint32_t avtp_time = 0;
+    struct avtp_stream_pdu *tx_pdu;
 
     n = read(fd_timer, &expirations, sizeof(uint64_t));
     if (n < 0) {
@@ -593,32 +464,35 @@ static int aaf_talker_tx_timeout(int fd_timer, int fd_sk,
         return -1;
     }
 
+    /* All PDUs due are queued and sent with as few syscalls as possible. */
     while (expirations--) {
         avtp_time = get_next_mclk_timestamp();
 
-        res = avtp_aaf_pdu_set(pdu, AVTP_AAF_FIELD_TIMESTAMP,
+        tx_pdu = (struct avtp_stream_pdu *) tx_batch_next(&tx_batch);
+        memcpy(tx_pdu, pdu, AAF_PDU_SIZE);
+
+        res = avtp_aaf_pdu_set(tx_pdu, AVTP_AAF_FIELD_TIMESTAMP,
                                 avtp_time);
         if (res < 0)
             return res;
 
-        res = avtp_aaf_pdu_set(pdu, AVTP_AAF_FIELD_SEQ_NUM,
+        res = avtp_aaf_pdu_set(tx_pdu, AVTP_AAF_FIELD_SEQ_NUM,
                                 aaf_seq_num++);
         if (res < 0)
             return res;
 
-        n = sendto(fd_sk, pdu, AAF_PDU_SIZE, 0,
-                    (struct sockaddr *) addr,
-                    sizeof(*addr));
-        if (n < 0) {
-            perror("Failed to send data");
+        res = tx_batch_queue(&tx_batch, AAF_PDU_SIZE);
+        if (res < 0)
             return -1;
-        }
-        if (n != AAF_PDU_SIZE) {
-            fprintf(stderr, "AAF: wrote %zd bytes, expected %zd\n",
-                            n, AAF_PDU_SIZE);
-        }
     }
 
+    res = tx_batch_flush(&tx_batch);
+    if (res < 0)
+        return -1;
+
+    if (stats_interval)
+        tx_batch_print_stats(&tx_batch, stats_interval);
+
     return 0;
 }
 
@@ -689,7 +563,11 @@ static int is_ts_aligned(uint32_t mclk_ts, uint32_t avtp_ts)
 
 static int handle_crf_pdu(struct avtp_crf_pdu *pdu)
 {
-    if (!is_valid_crf_pdu(pdu))
+    Avtp_CrfHeader_t hdr;
+
+    Avtp_Crf_Unpack((Avtp_Crf_t*)pdu, &hdr);
+
+    if (!is_valid_crf_pdu(&hdr))
         return 0;
 
     return recover_mclk(pdu);
@@ -697,20 +575,16 @@ static int handle_crf_pdu(struct avtp_crf_pdu *pdu)
 
 static int handle_aaf_pdu(struct avtp_stream_pdu *pdu)
 {
-    int res;
     bool state;
-    uint64_t val;
+    Avtp_PcmHeader_t hdr;
     uint32_t avtp_time, mclk_time;
 
-    if (!is_valid_aaf_pdu(pdu))
+    Avtp_Pcm_Unpack((Avtp_Pcm_t*)pdu, &hdr);
+
+    if (!is_valid_aaf_pdu(&hdr))
         return 0;
 
-    res = avtp_aaf_pdu_get(pdu, AVTP_AAF_FIELD_TIMESTAMP, &val);
-    if (res < 0) {
-        fprintf(stderr, "Failed to get AVTP time from PDU\n");
-        return res;
-    }
-    avtp_time = val;
+    avtp_time = hdr.avtp_timestamp;
 
     if (need_mclk_lookup) {
         mclk_time = mclk_lookup(avtp_time);
@@ -731,6 +605,16 @@ static int handle_aaf_pdu(struct avtp_stream_pdu *pdu)
     return 0;
 }
 
+static void print_seq_stats(void)
+{
+    if (!seq_stats_due(&seq_stats_timer, stats_interval))
+        return;
+
+    seq_stats_print("CRF", &crf_seq.stats);
+    if (mode == MODE_LISTENER)
+        seq_stats_print("AAF", &aaf_rx_seq.stats);
+}
+
 static int aaf_talker_recv_pdu(int fd_sk, int fd_timer)
 {
     int res;
@@ -745,10 +629,8 @@ static int aaf_talker_recv_pdu(int fd_sk, int fd_timer)
         return -1;
     }
 
-    /* The protocol type from rx socket is set to ETH_P_ALL so we receive
-     * non-AVTP packets as well. In order to filter out those packets, we
-     * check the number of bytes received. If it doesn't match the CRF pdu
-     * size we drop the packet.
+    /* The socket filter only passes the CRF stream, but PDUs of an
+     * unexpected size are dropped.
      */
     if (n != CRF_PDU_SIZE)
         return 0;
@@ -794,10 +676,8 @@ static int aaf_listener_recv_pdu(int fd)
         return -1;
     }
 
-    /* The protocol type from rx socket is set to ETH_P_ALL so we receive
-     * non-AVTP packets as well. In order to filter out those packets, we
-     * check the number of bytes received. If it doesn't match the CRF or
-     * AAF pdu size we drop the packet.
+    /* The socket filter only passes the CRF and AAF streams, but PDUs of an
+     * unexpected size are dropped.
      */
     if (n != AAF_PDU_SIZE && n != CRF_PDU_SIZE)
         return 0;
@@ -825,6 +705,9 @@ static int setup_rx_socket(void)
     int res, fd;
     struct ifreq req = {0};
     struct packet_mreq mreq = {0};
+    uint8_t subtypes[] = { AVTP_SUBTYPE_CRF, AVTP_SUBTYPE_AAF };
+    uint64_t stream_ids[] = { CRF_STREAM_ID, AAF_STREAM_ID };
+    size_t num_streams = (mode == MODE_LISTENER) ? 2 : 1;
 
     /* In case this example is running on the same host where crf-talker is
      * running, we set protocol type to ETH_P_ALL to allow CRF traffic to
@@ -836,6 +719,15 @@ static int setup_rx_socket(void)
         return -1;
     }
 
+    /* ETH_P_ALL also delivers non-AVTP traffic. It is dropped in the kernel
+     * along with other streams, so only the CRF stream (and the AAF stream
+     * in listener mode) is copied to user space.
+     */
+    res = attach_stream_filter(fd, 0, subtypes, num_streams, stream_ids,
+                               num_streams);
+    if (res < 0)
+        goto err;
+
     if (mode == MODE_LISTENER) {
         snprintf(req.ifr_name, sizeof(req.ifr_name), "%s", ifname);
         res = ioctl(fd, SIOCGIFINDEX, &req);
@@ -900,6 +792,11 @@ static int aaf_talker(int fd_rx)
     sk_addr.sll_ifindex = req.ifr_ifindex;
     memcpy(&sk_addr.sll_addr, aaf_macaddr, ETH_ALEN);
 
+    res = tx_batch_init(&tx_batch, fd_tx, (struct sockaddr *) &sk_addr,
+                        sizeof(sk_addr), TX_BATCH_MAX_PDUS);
+    if (res < 0)
+        goto fd_tx_close;
+
     fd_timer = timerfd_create(CLOCK_REALTIME, 0);
     if (fd_timer < 0)
         goto fd_tx_close;
@@ -917,7 +814,10 @@ static int aaf_talker(int fd_rx)
 
     while (1) {
         res = poll(poll_fd, 2, -1);
+        print_seq_stats();
         if (res < 0) {
+            if (errno == EINTR)
+                continue;
             perror("Failed to poll() fds");
             goto fd_timer_close;
         }
@@ -929,8 +829,7 @@ static int aaf_talker(int fd_rx)
         }
 
         if (poll_fd[1].revents & POLLIN) {
-            res = aaf_talker_tx_timeout(fd_timer, fd_tx, &sk_addr,
-                                    pdu);
+            res = aaf_talker_tx_timeout(fd_timer, pdu);
             if (res < 0)
                 goto fd_timer_close;
         }
@@ -955,6 +854,7 @@ static int aaf_listener(int fd_rx)
         res = aaf_listener_recv_pdu(fd_rx);
         if (res < 0)
             return -1;
+        print_seq_stats();
     }
 }
 
@@ -965,6 +865,9 @@ int main(int argc, char *argv[])
     argp_parse(&argp, argc, argv, 0, NULL, NULL);
 
     STAILQ_INIT(&mclk_timestamps);
+
+    if (seq_stats_init_signal() < 0)
+        return 1;
     rounded_mtt = ceil((double)mtt / MCLK_PERIOD) * MCLK_PERIOD;
 
     fd_rx = setup_rx_socket();
@@ -152,7 +152,7 @@ static uint64_t calculate_crf_timestamp(struct timespec tspec, uint64_t rounded_
     return crf_time;
 }
 
-static int init_pdu(struct avtp_crf_pdu *pdu)
+static int init_pdu(struct avtp_crf_pdu *pdu, Avtp_StreamTemplate_t *tmpl)
 {
     int res;
 
@@ -192,6 +192,10 @@ static int init_pdu(struct avtp_crf_pdu *pdu)
     if (res < 0)
         return -1;
 
+    res = Avtp_Crf_InitTemplate(tmpl, (Avtp_Crf_t *) pdu);
+    if (res < 0)
+        return -1;
+
     return 0;
 }
 
@@ -203,6 +207,7 @@ int main(int argc, char *argv[])
     struct timespec clksrc_ts = {0};
     struct sockaddr_ll sk_addr = {0};
     struct avtp_crf_pdu *pdu = alloca(PDU_SIZE);
+    Avtp_StreamTemplate_t tmpl;
 
     argp_parse(&argp, argc, argv, 0, NULL, NULL);
 
@@ -215,7 +220,7 @@ int main(int argc, char *argv[])
     if (res < 0)
         goto err;
 
-    res = init_pdu(pdu);
+    res = init_pdu(pdu, &tmpl);
     if (res < 0)
         goto err;
 
@@ -234,9 +239,9 @@ int main(int argc, char *argv[])
         for (idx = 0; idx < TIMESTAMPS_PER_PKT; idx++)
             pdu->crf_data[idx] = htobe64(crf_time + (CRF_PERIOD * idx));
 
-        res = avtp_crf_pdu_set(pdu, AVTP_CRF_FIELD_SEQ_NUM, seq_num++);
-        if (res < 0)
-            goto err;
+        /* CRF has no avtp_timestamp, the timestamps are in crf_data. */
+        Avtp_StreamTemplate_Patch(&tmpl, (uint8_t *) pdu, seq_num++, 0,
+                                DATA_LEN);
 
         n = sendto(sk_fd, pdu, PDU_SIZE, 0,
                 (struct sockaddr *) &sk_addr, sizeof(sk_addr));
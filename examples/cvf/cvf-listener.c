@@ -41,6 +41,7 @@
  *
  * TSN stream parameters such as destination mac address are passed via
  * command-line arguments. Run 'cvf-listener --help' for more information.
+ * Sending SIGUSR1 prints the lost, reordered and duplicated packets.
  *
  * This example relies on the system clock to schedule video data samples for
  * presentation. So make sure the system clock is synchronized with the PTP
@@ -59,6 +60,7 @@
 
 #include <assert.h>
 #include <argp.h>
+#include <errno.h>
 #include <arpa/inet.h>
 #include <linux/if.h>
 #include <linux/if_ether.h>
@@ -76,6 +78,7 @@
 #include "avtp/cvf/H264.h"
 #include "avtp/CommonHeader.h"
 #include "common/common.h"
+#include "common/seqstats.h"
 
 #define STREAM_ID				0xAABBCCDDEEFF0001
 #define DATA_LEN				1400
@@ -94,7 +97,8 @@ struct nal_entry {
 static STAILQ_HEAD(nal_queue, nal_entry) nals;
 static char ifname[IFNAMSIZ];
 static uint8_t macaddr[ETH_ALEN];
-static uint8_t expected_seq;
+static Avtp_SeqTracker_t seq_tracker;
+static seq_stats_timer_t stats_timer;
 
 static struct argp_option options[] = {
     {"dst-addr", 'd', "MACADDR", 0, "Stream Destination MAC address" },
@@ -192,12 +196,7 @@ static bool is_valid_packet(Avtp_Cvf_t* cvf)
     }
 
     uint8_t sequence_num = Avtp_Cvf_GetSequenceNum(cvf);
-    if (sequence_num != expected_seq) {
-        fprintf(stderr, "Sequence number mismatch: expected %"PRIu8", "
-                "got %"PRIu8"\n", expected_seq, sequence_num);
-        expected_seq = sequence_num;
-    }
-    expected_seq++;
+    Avtp_SeqTracker_Update(&seq_tracker, sequence_num);
 
     uint8_t format = Avtp_Cvf_GetFormat(cvf);
     if (format != AVTP_CVF_FORMAT_RFC) {
@@ -306,10 +305,20 @@ int main(int argc, char *argv[])
 
     STAILQ_INIT(&nals);
 
+    if (seq_stats_init_signal() < 0)
+        return 1;
+
     sk_fd = create_listener_socket(ifname, macaddr, ETH_P_TSN);
     if (sk_fd < 0)
         return 1;
 
+    res = attach_stream_filter(sk_fd, 0, (uint8_t[]) { AVTP_SUBTYPE_CVF }, 1,
+                               (uint64_t[]) { STREAM_ID }, 1);
+    if (res < 0) {
+        close(sk_fd);
+        return 1;
+    }
+
     timer_fd = timerfd_create(CLOCK_REALTIME, 0);
     if (timer_fd < 0) {
         close(sk_fd);
@@ -323,7 +332,11 @@ int main(int argc, char *argv[])
 
     while (1) {
         res = poll(fds, 2, -1);
+        if (seq_stats_due(&stats_timer, 0))
+            seq_stats_print("CVF", &seq_tracker.stats);
         if (res < 0) {
+            if (errno == EINTR)
+                continue;
             perror("Failed to poll() fds");
             goto err;
         }
@@ -95,6 +95,7 @@ static char buffer[MAX_PDU_SIZE * 2];
 static size_t buffer_level;
 
 static uint8_t seq_num;
+static Avtp_StreamTemplate_t cvf_template;
 
 enum process_result {PROCESS_OK, PROCESS_NONE, PROCESS_ERROR};
 
@@ -151,7 +152,7 @@ static int init_pdu(Avtp_Cvf_t* cvf)
     Avtp_H264_Init(h264);
     Avtp_H264_SetField(h264, AVTP_H264_FIELD_TIMESTAMP, 0);
 
-    return 0;
+    return Avtp_Cvf_InitTemplate(&cvf_template, cvf);
 }
 
 static ssize_t fill_buffer(void)
@@ -202,9 +203,8 @@ static int prepare_packet(Avtp_Cvf_t* cvfHeader, char *nal_data, size_t nal_data
         return -1;
     }
 
-    Avtp_Cvf_SetField(cvfHeader, AVTP_CVF_FIELD_AVTP_TIMESTAMP, avtp_time);
-    Avtp_Cvf_SetField(cvfHeader, AVTP_CVF_FIELD_SEQUENCE_NUM, seq_num++);
-    Avtp_Cvf_SetField(cvfHeader, AVTP_CVF_FIELD_STREAM_DATA_LENGTH, nal_data_len + AVTP_H264_HEADER_LEN);
+    Avtp_StreamTemplate_Patch(&cvf_template, (uint8_t*)cvfHeader, seq_num++,
+                    avtp_time, nal_data_len + AVTP_H264_HEADER_LEN);
 
     memcpy(h264Payload, nal_data, nal_data_len);
 
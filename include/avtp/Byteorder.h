@@ -30,14 +30,44 @@
 
 #ifdef LINUX_KERNEL1722
 #include <linux/types.h>
+#include <linux/string.h>
 #else
 #include <stdint.h>
+#include <string.h>
 #endif
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+#if defined(__GNUC__) || defined(__clang__)
+
+/**
+ * Swap byteorder of 16bit integer
+ */
+static inline uint16_t Avtp_Bswap16(uint16_t x)
+{
+    return __builtin_bswap16(x);
+}
+
+/**
+ * Swap byteorder of 32bit integer
+ */
+static inline uint32_t Avtp_Bswap32(uint32_t x)
+{
+    return __builtin_bswap32(x);
+}
+
+/**
+ * Swap byteorder of 64bit integer
+ */
+static inline uint64_t Avtp_Bswap64(uint64_t x)
+{
+    return __builtin_bswap64(x);
+}
+
+#else
+
 /**
  * Swap byteorder of 16bit integer
  */
@@ -73,6 +103,8 @@ static inline uint64_t Avtp_Bswap64(uint64_t x)
             | ((x & 0x00000000000000ffu) << 56u);
 }
 
+#endif
+
 #if(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
 /* System uses little-endian */
 static inline uint16_t Avtp_CpuToLe16(uint16_t x) { return x; }
@@ -103,6 +135,52 @@ static inline uint32_t Avtp_BeToCpu32(uint32_t x) { return x; }
 static inline uint64_t Avtp_BeToCpu64(uint64_t x) { return x; }
 #endif
 
+/*
+ * Unaligned-safe loads and stores of big-endian integers. The memcpy() has a
+ * constant size, so compilers emit a single (unaligned) load/store plus a
+ * byte swap (e.g. movbe on x86-64, ldr + rev on ARMv8) and the accesses do not
+ * violate strict aliasing rules. Use these instead of casting PDU pointers to
+ * wider integer types.
+ */
+static inline uint16_t Avtp_LoadBe16(const void* ptr)
+{
+    uint16_t x;
+    memcpy(&x, ptr, sizeof(x));
+    return Avtp_BeToCpu16(x);
+}
+
+static inline uint32_t Avtp_LoadBe32(const void* ptr)
+{
+    uint32_t x;
+    memcpy(&x, ptr, sizeof(x));
+    return Avtp_BeToCpu32(x);
+}
+
+static inline uint64_t Avtp_LoadBe64(const void* ptr)
+{
+    uint64_t x;
+    memcpy(&x, ptr, sizeof(x));
+    return Avtp_BeToCpu64(x);
+}
+
+static inline void Avtp_StoreBe16(void* ptr, uint16_t x)
+{
+    x = Avtp_CpuToBe16(x);
+    memcpy(ptr, &x, sizeof(x));
+}
+
+static inline void Avtp_StoreBe32(void* ptr, uint32_t x)
+{
+    x = Avtp_CpuToBe32(x);
+    memcpy(ptr, &x, sizeof(x));
+}
+
+static inline void Avtp_StoreBe64(void* ptr, uint64_t x)
+{
+    x = Avtp_CpuToBe64(x);
+    memcpy(ptr, &x, sizeof(x));
+}
+
 #ifdef __cplusplus
 }
 #endif
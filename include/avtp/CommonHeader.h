@@ -86,6 +86,15 @@ typedef enum {
     AVTP_SUBTYPE_EF_CONTROL        = 0xFF,
 } Avtp_AvtpSubtype_t;
 
+/**
+ * Native representation of all AVTP common header fields.
+ */
+typedef struct {
+    uint8_t subtype;
+    uint8_t h;
+    uint8_t version;
+} Avtp_CommonHeaderHeader_t;
+
 /**
  * Returns the value of an an AVTP common header field as specified in the IEEE 1722 Specification.
  *
@@ -110,6 +119,15 @@ uint8_t Avtp_CommonHeader_GetH(const Avtp_CommonHeader_t* const pdu);
  */
 uint8_t Avtp_CommonHeader_GetVersion(const Avtp_CommonHeader_t* const pdu);
 
+/**
+ * Reads all fields of an AVTP common header. Each header quadlet is read
+ * only once.
+ *
+ * @param pdu Pointer to the first bit of an 1722 AVTP PDU.
+ * @param header Structure that receives the values of the header fields.
+ */
+void Avtp_CommonHeader_Unpack(const Avtp_CommonHeader_t* const pdu, Avtp_CommonHeaderHeader_t* header);
+
 /**
  * Sets the value of an an AVTP common header field as specified in the IEEE 1722 Specification.
  *
@@ -33,6 +33,7 @@
 #include <stdint.h>
 
 #include "avtp/Utils.h"
+#include "avtp/StreamTemplate.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -40,7 +41,7 @@ extern "C" {
 
 #define AVTP_CRF_HEADER_LEN     (5 * AVTP_QUADLET_SIZE)
 
-typedef struct Avtp_Cvf {
+typedef struct Avtp_Crf {
     uint8_t header[AVTP_CRF_HEADER_LEN];
     uint8_t payload[0];
 } Avtp_Crf_t;
@@ -80,6 +81,25 @@ typedef enum Avtp_CrfField {
     AVTP_CRF_FIELD_MAX,
 }Avtp_CrfField_t;
 
+/**
+ * Native representation of all CRF header fields.
+ */
+typedef struct {
+    uint8_t subtype;
+    uint8_t sv;
+    uint8_t version;
+    uint8_t mr;
+    uint8_t fs;
+    uint8_t tu;
+    uint8_t sequence_num;
+    uint8_t type;
+    uint64_t stream_id;
+    uint8_t pull;
+    uint32_t base_frequency;
+    uint16_t crf_data_length;
+    uint16_t timestamp_interval;
+} Avtp_CrfHeader_t;
+
 void Avtp_Crf_Init(Avtp_Crf_t* pdu);
 
 uint64_t Avtp_Crf_GetField(const Avtp_Crf_t* const pdu, Avtp_CrfField_t field);
@@ -98,6 +118,26 @@ uint32_t Avtp_Crf_GetBaseFrequency(const Avtp_Crf_t* const pdu);
 uint16_t Avtp_Crf_GetCrfDataLength(const Avtp_Crf_t* const pdu);
 uint16_t Avtp_Crf_GetTimestampInterval(const Avtp_Crf_t* const pdu);
 
+/**
+ * Reads all fields of a CRF header. Each header quadlet is read
+ * only once.
+ *
+ * @param pdu Pointer to the first bit of an 1722 AVTP PDU.
+ * @param header Structure that receives the values of the header fields.
+ */
+void Avtp_Crf_Unpack(const Avtp_Crf_t* const pdu, Avtp_CrfHeader_t* header);
+
+/**
+ * Initializes a stream template for a CRF stream. The template takes a copy
+ * of the given header. Only sequence_num and crf_data_length
+ * are patched per packet.
+ *
+ * @param tmpl Template to initialize.
+ * @param pdu Pointer to the first bit of a completely initialized header.
+ * @returns 0 on success, -EINVAL otherwise.
+ */
+int Avtp_Crf_InitTemplate(Avtp_StreamTemplate_t* tmpl, const Avtp_Crf_t* const pdu);
+
 void Avtp_Crf_SetField(Avtp_Crf_t* pdu, Avtp_CrfField_t field, uint64_t value);
 
 void Avtp_Crf_SetSubtype(Avtp_Crf_t* pdu, uint8_t value);
@@ -64,6 +64,15 @@ typedef struct Avtp_FieldDescriptor {
     uint8_t bits;
 } Avtp_FieldDescriptor_t;
 
+/**
+ * A field identifier together with the value to be written. Used to set
+ * several fields of a PDU at once (see Avtp_SetFields()).
+ */
+typedef struct Avtp_FieldValue {
+    uint8_t field;
+    uint64_t value;
+} Avtp_FieldValue_t;
+
 #define TRUE 1
 #define FALSE 0
 
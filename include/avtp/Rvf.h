@@ -34,6 +34,7 @@
 #include <stdint.h>
 
 #include "avtp/Utils.h"
+#include "avtp/StreamTemplate.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -144,6 +145,37 @@ typedef enum Avtp_RvfColorspace {
     AVTP_RVF_COLORSPACE_USER            = 0x0F
 } Avtp_RvfColorspace_t;
 
+/**
+ * Native representation of all RVF header fields.
+ */
+typedef struct {
+    uint8_t subtype;
+    uint8_t sv;
+    uint8_t version;
+    uint8_t mr;
+    uint8_t tv;
+    uint8_t sequence_num;
+    uint8_t tu;
+    uint64_t stream_id;
+    uint32_t avtp_timestamp;
+    uint16_t active_pixels;
+    uint16_t total_lines;
+    uint16_t stream_data_length;
+    uint8_t ap;
+    uint8_t f;
+    uint8_t ef;
+    uint8_t evt;
+    uint8_t pd;
+    uint8_t i;
+    Avtp_RvfPixelDepth_t pixel_depth;
+    Avtp_RvfPixelFormat_t pixel_format;
+    Avtp_RvfFrameRate_t frame_rate;
+    Avtp_RvfColorspace_t colorspace;
+    uint8_t num_lines;
+    uint8_t i_seq_num;
+    uint16_t line_number;
+} Avtp_RvfHeader_t;
+
 void Avtp_Rvf_Init(Avtp_Rvf_t* pdu);
 
 uint64_t Avtp_Rvf_GetField(const Avtp_Rvf_t* const pdu, Avtp_RvfField_t field);
@@ -174,6 +206,26 @@ uint8_t Avtp_Rvf_GetNumLines(const Avtp_Rvf_t* const pdu);
 uint8_t Avtp_Rvf_GetISeqNum(const Avtp_Rvf_t* const pdu);
 uint16_t Avtp_Rvf_GetLineNumber(const Avtp_Rvf_t* const pdu);
 
+/**
+ * Reads all fields of a RVF header. Each header quadlet is read
+ * only once.
+ *
+ * @param pdu Pointer to the first bit of an 1722 AVTP PDU.
+ * @param header Structure that receives the values of the header fields.
+ */
+void Avtp_Rvf_Unpack(const Avtp_Rvf_t* const pdu, Avtp_RvfHeader_t* header);
+
+/**
+ * Initializes a stream template for an RVF stream. The template takes a copy
+ * of the given header. Only sequence_num, avtp_timestamp and stream_data_length
+ * are patched per packet.
+ *
+ * @param tmpl Template to initialize.
+ * @param pdu Pointer to the first bit of a completely initialized header.
+ * @returns 0 on success, -EINVAL otherwise.
+ */
+int Avtp_Rvf_InitTemplate(Avtp_StreamTemplate_t* tmpl, const Avtp_Rvf_t* const pdu);
+
 void Avtp_Rvf_SetField(Avtp_Rvf_t* pdu, Avtp_RvfField_t field, uint64_t value);
 
 void Avtp_Rvf_SetSubtype(Avtp_Rvf_t* pdu, uint8_t value);
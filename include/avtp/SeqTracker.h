@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2025, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file
+ * Sequence trackers classify the sequence numbers of the received PDUs of a
+ * stream. A sliding window over the last AVTP_SEQ_TRACKER_WINDOW sequence
+ * numbers tells lost PDUs from reordered and duplicated ones. Every PDU is
+ * only counted, so that listeners can report the statistics periodically
+ * instead of logging every mismatch.
+ *
+ * The 8 bit AVTP sequence numbers and the 32 bit UDP encapsulation sequence
+ * numbers are supported. A zeroed tracker is a valid initial tracker.
+ */
+
+#pragma once
+
+#include "avtp/Defines.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Number of sequence numbers covered by the sliding window. */
+#define AVTP_SEQ_TRACKER_WINDOW         64U
+
+/**
+ * Distance behind the highest sequence number from which a PDU is taken as
+ * a restart of the talker instead of a late PDU. Only reachable with 32 bit
+ * sequence numbers.
+ */
+#define AVTP_SEQ_TRACKER_RESYNC         (4 * AVTP_SEQ_TRACKER_WINDOW)
+
+/** Classification of a received sequence number. */
+typedef enum {
+    /** The sequence number directly follows the highest one so far. */
+    AVTP_SEQ_IN_ORDER = 0,
+    /** Sequence numbers were skipped, which are counted as lost. */
+    AVTP_SEQ_GAP,
+    /** A sequence number counted as lost arrived within the window. */
+    AVTP_SEQ_REORDERED,
+    /** The sequence number was already received within the window. */
+    AVTP_SEQ_DUPLICATE,
+    /** The sequence number is older than the window. */
+    AVTP_SEQ_LATE,
+    /** The sequence number is far behind, the tracker restarted from it. */
+    AVTP_SEQ_RESYNC,
+} Avtp_SeqResult_t;
+
+/** Counters of a sequence tracker. */
+typedef struct {
+    /** PDUs received, including reordered ones. */
+    uint64_t received;
+    /** Skipped sequence numbers, minus the ones received later. */
+    uint64_t lost;
+    uint64_t reordered;
+    uint64_t duplicates;
+    uint64_t late;
+    /** Restarts of the tracker, e.g. after the talker restarted. */
+    uint64_t resyncs;
+} Avtp_SeqStats_t;
+
+typedef struct {
+    /** Highest sequence number received so far. */
+    uint32_t highest;
+    /** Bit i is set if sequence number highest - i was received. */
+    uint64_t window;
+    /** Sequence numbers covered by the window, 0 before the first PDU. */
+    uint8_t span;
+    Avtp_SeqStats_t stats;
+} Avtp_SeqTracker_t;
+
+/**
+ * Initializes a sequence tracker and its counters.
+ *
+ * @param tracker Tracker to initialize.
+ */
+void Avtp_SeqTracker_Init(Avtp_SeqTracker_t* tracker);
+
+/**
+ * Counts the 8 bit AVTP sequence number of a received PDU. Gaps of more than
+ * 127 sequence numbers cannot be told from late PDUs.
+ *
+ * @param tracker Tracker of the stream.
+ * @param seqNum Sequence number of the received PDU.
+ * @returns Classification of the sequence number.
+ */
+Avtp_SeqResult_t Avtp_SeqTracker_Update(Avtp_SeqTracker_t* tracker,
+        uint8_t seqNum);
+
+/**
+ * Counts the 32 bit UDP encapsulation sequence number of a received PDU.
+ * A sequence number more than AVTP_SEQ_TRACKER_RESYNC behind the highest one
+ * restarts the tracking from it, keeping the counters.
+ *
+ * @param tracker Tracker of the stream.
+ * @param seqNum Encapsulation sequence number of the received PDU.
+ * @returns Classification of the sequence number.
+ */
+Avtp_SeqResult_t Avtp_SeqTracker_UpdateUdp(Avtp_SeqTracker_t* tracker,
+        uint32_t seqNum);
+
+#ifdef __cplusplus
+}
+#endif
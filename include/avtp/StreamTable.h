@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2025, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file
+ * Stream tables map AVTP stream IDs to the state of a stream at a listener,
+ * i.e. the sequence number trackers and where the payload of the stream
+ * goes. The table uses open addressing with linear probing, so a
+ * lookup costs a hash and usually a single cache line. Every slot has a one
+ * byte tag derived from the hash, which is compared before the stream ID.
+ * Probing therefore mostly scans the dense tag array.
+ *
+ * The table does not allocate memory. The caller provides the tag and entry
+ * arrays, which makes it usable in the kernel and on microcontrollers.
+ */
+
+#pragma once
+
+#ifdef LINUX_KERNEL1722
+#include <linux/stddef.h>
+#endif
+
+#include "avtp/Defines.h"
+#include "avtp/SeqTracker.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Tag of an empty slot. Tags of used slots have the MSB set. */
+#define AVTP_STREAM_TABLE_EMPTY         0
+
+/** State of a stream at a listener. */
+typedef struct {
+    uint64_t streamId;
+    /** Tracks the AVTP sequence numbers. */
+    Avtp_SeqTracker_t seq;
+    /** Tracks the UDP encapsulation sequence numbers. */
+    Avtp_SeqTracker_t udpSeq;
+    /** Output of the stream, e.g. a socket or a device. */
+    void* handle;
+} Avtp_StreamEntry_t;
+
+typedef struct {
+    /** One tag per slot, AVTP_STREAM_TABLE_EMPTY for unused slots. */
+    uint8_t* tags;
+    Avtp_StreamEntry_t* entries;
+    /** Number of slots minus one. */
+    uint32_t mask;
+    /** Number of streams in the table. */
+    uint32_t count;
+} Avtp_StreamTable_t;
+
+/**
+ * Returns the number of streams a table can hold. At least 1/8 of the slots
+ * stay empty, so that probe sequences are short and end at an empty slot.
+ *
+ * @param numSlots Number of slots of the table.
+ * @returns Maximum number of streams.
+ */
+static inline uint32_t Avtp_StreamTable_MaxStreams(uint32_t numSlots)
+{
+    return numSlots - (numSlots >= 16 ? numSlots / 8 : 1);
+}
+
+/**
+ * Returns the number of slots a table needs to hold a number of streams.
+ *
+ * @param streams Number of streams.
+ * @returns Power of two number of slots.
+ */
+static inline uint32_t Avtp_StreamTable_Slots(uint32_t streams)
+{
+    uint32_t slots = 2;
+
+    while (Avtp_StreamTable_MaxStreams(slots) < streams) {
+        slots *= 2;
+    }
+
+    return slots;
+}
+
+/**
+ * Initializes an empty stream table.
+ *
+ * @param table Table to initialize.
+ * @param tags Array of numSlots tags.
+ * @param entries Array of numSlots entries.
+ * @param numSlots Number of slots, a power of two, see
+ * Avtp_StreamTable_Slots().
+ * @returns 0 on success, -EINVAL if an argument is invalid.
+ */
+int Avtp_StreamTable_Init(Avtp_StreamTable_t* table, uint8_t* tags,
+        Avtp_StreamEntry_t* entries, uint32_t numSlots);
+
+/**
+ * Mixes all bits of a stream ID. Stream IDs of one talker only differ in
+ * the last 16 bits, which must spread over all slots.
+ */
+static inline uint64_t Avtp_StreamTable_Hash(uint64_t streamId)
+{
+    streamId ^= streamId >> 33;
+    streamId *= 0xFF51AFD7ED558CCDULL;
+    streamId ^= streamId >> 33;
+    streamId *= 0xC4CEB9FE1A85EC53ULL;
+    streamId ^= streamId >> 33;
+
+    return streamId;
+}
+
+/** Returns the tag of a hash, taken from the bits not used for the slot. */
+static inline uint8_t Avtp_StreamTable_Tag(uint64_t hash)
+{
+    return (uint8_t)(hash >> 57) | 0x80;
+}
+
+/**
+ * Looks up a stream.
+ *
+ * @param table Initialized table.
+ * @param streamId Stream ID to look up.
+ * @returns Entry of the stream or NULL if the stream is not in the table.
+ */
+static inline Avtp_StreamEntry_t* Avtp_StreamTable_Find(
+        const Avtp_StreamTable_t* const table, uint64_t streamId)
+{
+    uint64_t hash = Avtp_StreamTable_Hash(streamId);
+    uint8_t tag = Avtp_StreamTable_Tag(hash);
+    uint32_t slot = (uint32_t)hash & table->mask;
+
+    // The load limit guarantees an empty slot, which ends the probing
+    while (table->tags[slot] != AVTP_STREAM_TABLE_EMPTY) {
+        if (table->tags[slot] == tag &&
+                table->entries[slot].streamId == streamId) {
+            return &table->entries[slot];
+        }
+        slot = (slot + 1) & table->mask;
+    }
+
+    return NULL;
+}
+
+/**
+ * Adds a stream to a table. The entry of a new stream is zeroed except for
+ * the stream ID.
+ *
+ * @param table Initialized table.
+ * @param streamId Stream ID to add.
+ * @returns Entry of the stream, which may have been in the table already, or
+ * NULL if the table holds Avtp_StreamTable_MaxStreams() streams already.
+ */
+Avtp_StreamEntry_t* Avtp_StreamTable_Add(Avtp_StreamTable_t* table,
+        uint64_t streamId);
+
+/**
+ * Removes a stream from a table. Pointers to entries of other streams may
+ * be invalid afterwards, as entries are moved to close the gap.
+ *
+ * @param table Initialized table.
+ * @param streamId Stream ID to remove.
+ * @returns 0 on success, -ENOENT if the stream is not in the table.
+ */
+int Avtp_StreamTable_Remove(Avtp_StreamTable_t* table, uint64_t streamId);
+
+#ifdef __cplusplus
+}
+#endif
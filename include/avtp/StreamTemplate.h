@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2025, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file
+ * Stream templates hold the pre-rendered header of an AVTP stream. Header
+ * fields that do not change during the lifetime of a stream (subtype,
+ * stream_id, format, ...) are written once. For every packet the template is
+ * copied and only the sequence number, the timestamp and the length field are
+ * patched.
+ */
+
+#pragma once
+
+#ifdef LINUX_KERNEL1722
+#include <linux/errno.h>
+#include <linux/string.h>
+#else
+#include <string.h>
+#endif
+
+#include "avtp/Defines.h"
+#include "avtp/Byteorder.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Maximum header length that can be stored in a stream template. This covers
+ * the headers of all AVTP stream formats.
+ */
+#define AVTP_STREAM_TEMPLATE_MAX_LEN        (8 * AVTP_QUADLET_SIZE)
+
+/**
+ * Precomputed location of a header field which is patched for every packet.
+ */
+typedef struct {
+    /** Byte offset of the quadlet containing the field. */
+    uint16_t offset;
+    /** Number of bits between the field LSB and the end of the quadlet. */
+    uint8_t shift;
+    /** Field mask in network byte-order. A zero mask disables the field. */
+    uint32_t mask;
+} Avtp_TemplateField_t;
+
+typedef struct {
+    uint8_t header[AVTP_STREAM_TEMPLATE_MAX_LEN];
+    uint16_t len;
+    Avtp_TemplateField_t sequenceNum;
+    Avtp_TemplateField_t timestamp;
+    Avtp_TemplateField_t length;
+} Avtp_StreamTemplate_t;
+
+/**
+ * Initializes a stream template from a completely rendered header. The
+ * per-packet fields are described by field descriptors. A field descriptor
+ * can be NULL if the format does not have the respective field.
+ *
+ * Most users want one of the format specific initializers instead, e.g.
+ * Avtp_Pcm_InitTemplate().
+ *
+ * @param tmpl Template to initialize.
+ * @param header Pointer to the first bit of the rendered header.
+ * @param len Length of the header in bytes.
+ * @param sequenceNum Position of the sequence number field or NULL.
+ * @param timestamp Position of the timestamp field or NULL.
+ * @param length Position of the length field or NULL.
+ * @returns 0 on success, -EINVAL if the header is too long or a field is
+ * outside the header, wider than 32 bits or crosses a quadlet boundary.
+ */
+int Avtp_StreamTemplate_Init(Avtp_StreamTemplate_t* tmpl,
+        const uint8_t* const header, uint16_t len,
+        const Avtp_FieldDescriptor_t* const sequenceNum,
+        const Avtp_FieldDescriptor_t* const timestamp,
+        const Avtp_FieldDescriptor_t* const length);
+
+/**
+ * Writes a value into a precomputed field location.
+ *
+ * @param pdu Pointer to the first bit of the rendered header.
+ * @param field Precomputed field location.
+ * @param value Value to set. Bits beyond the field width are discarded.
+ */
+static inline void Avtp_StreamTemplate_PatchField(uint8_t* pdu,
+        const Avtp_TemplateField_t* const field, uint32_t value)
+{
+    uint32_t quadlet;
+
+    if (field->mask == 0) {
+        return;
+    }
+
+    memcpy(&quadlet, pdu + field->offset, sizeof(quadlet));
+    quadlet = (quadlet & ~field->mask) | (Avtp_CpuToBe32(value << field->shift) & field->mask);
+    memcpy(pdu + field->offset, &quadlet, sizeof(quadlet));
+}
+
+/**
+ * Patches the per-packet fields of a header that has already been rendered
+ * from the template. Use this if the buffer still holds the header of the
+ * previous packet.
+ *
+ * @param tmpl Initialized stream template.
+ * @param pdu Pointer to the first bit of the rendered header.
+ * @param sequenceNum Value of the sequence number field.
+ * @param timestamp Value of the timestamp field.
+ * @param length Value of the length field.
+ */
+static inline void Avtp_StreamTemplate_Patch(const Avtp_StreamTemplate_t* const tmpl,
+        uint8_t* pdu, uint8_t sequenceNum, uint32_t timestamp, uint16_t length)
+{
+    Avtp_StreamTemplate_PatchField(pdu, &tmpl->sequenceNum, sequenceNum);
+    Avtp_StreamTemplate_PatchField(pdu, &tmpl->timestamp, timestamp);
+    Avtp_StreamTemplate_PatchField(pdu, &tmpl->length, length);
+}
+
+/**
+ * Copies the template header into a PDU and patches the per-packet fields.
+ *
+ * @param tmpl Initialized stream template.
+ * @param pdu Pointer to the first bit of the PDU. The buffer must hold at
+ * least tmpl->len bytes.
+ * @param sequenceNum Value of the sequence number field.
+ * @param timestamp Value of the timestamp field.
+ * @param length Value of the length field.
+ */
+static inline void Avtp_StreamTemplate_Render(const Avtp_StreamTemplate_t* const tmpl,
+        uint8_t* pdu, uint8_t sequenceNum, uint32_t timestamp, uint16_t length)
+{
+    memcpy(pdu, tmpl->header, tmpl->len);
+    Avtp_StreamTemplate_Patch(tmpl, pdu, sequenceNum, timestamp, length);
+}
+
+#ifdef __cplusplus
+}
+#endif
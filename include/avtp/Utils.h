@@ -36,6 +36,12 @@
 
 #pragma once
 
+#ifdef LINUX_KERNEL1722
+#include <linux/string.h>
+#else
+#include <string.h>
+#endif
+
 #include "avtp/Defines.h"
 #include "avtp/Byteorder.h"
 
@@ -67,6 +73,231 @@ uint64_t Avtp_GetField(const Avtp_FieldDescriptor_t* fieldDescriptors,
 void Avtp_SetField(const Avtp_FieldDescriptor_t* fieldDescriptors,
         uint8_t numFields, uint8_t* pdu, uint8_t field, uint64_t value);
 
+/**
+ * Sets several data fields in a 1722 frame. The writes are grouped by quadlet,
+ * i.e. every quadlet touched by the given fields is loaded, byte-swapped and
+ * stored only once. The result is identical to calling Avtp_SetField() for
+ * each entry in order.
+ *
+ * @param fieldDescriptors Table describing the fields of the PDU.
+ * @param numFields Number of entries in fieldDescriptors.
+ * @param pdu Pointer to the first bit of a 1722 PDU.
+ * @param values Fields and the values to set. Entries with an invalid field
+ * are ignored.
+ * @param numValues Number of entries in values.
+ */
+void Avtp_SetFields(const Avtp_FieldDescriptor_t* fieldDescriptors,
+        uint8_t numFields, uint8_t* pdu, const Avtp_FieldValue_t* values,
+        uint8_t numValues);
+
+/**
+ * Returns a mask with the lower bits set. Valid for 0 < bits <= 64.
+ */
+static inline uint64_t Avtp_FieldMask(uint8_t bits)
+{
+    return (bits >= 64) ? ~0ULL : ((1ULL << bits) - 1ULL);
+}
+
+/**
+ * Inline variant of Avtp_GetField(). Instead of walking the field quadlet by
+ * quadlet, the field is read with one 32 bit load (field within a quadlet),
+ * one 64 bit load (field spans two quadlets) or a 64 and a 32 bit load (field
+ * spans three quadlets). When called with a static const descriptor table and
+ * a constant field index, the compiler folds the descriptor lookup so that
+ * the access turns into a constant shift and mask.
+ *
+ * The result is bit-exact with Avtp_GetField().
+ *
+ * @param fieldDescriptors Table describing the fields of the PDU.
+ * @param numFields Number of entries in fieldDescriptors.
+ * @param pdu Pointer to the first bit of an 1722 PDU.
+ * @param field Specifies the position of the data field to be read
+ * @returns This function returns the field value from the PDU.
+ */
+static inline uint64_t Avtp_GetFieldInline(
+        const Avtp_FieldDescriptor_t* fieldDescriptors, uint8_t numFields,
+        const uint8_t* const pdu, uint8_t field)
+{
+    const Avtp_FieldDescriptor_t* desc;
+    const uint8_t* quadletPtr;
+    uint8_t end;
+
+    if (fieldDescriptors == NULL || pdu == NULL || field >= numFields) {
+        return 0;
+    }
+
+    desc = &fieldDescriptors[field];
+    if (desc->bits == 0) {
+        return 0;
+    }
+    quadletPtr = pdu + desc->quadlet * AVTP_QUADLET_SIZE;
+    end = desc->offset + desc->bits;
+
+    if (end <= 32) {
+        uint32_t quadlet = Avtp_LoadBe32(quadletPtr);
+        return (quadlet >> (32 - end)) & Avtp_FieldMask(desc->bits);
+    } else if (end <= 64) {
+        uint64_t quadlets = Avtp_LoadBe64(quadletPtr);
+        return (quadlets >> (64 - end)) & Avtp_FieldMask(desc->bits);
+    } else {
+        uint8_t tailBits = end - 64;
+        uint64_t head = Avtp_LoadBe64(quadletPtr) &
+                Avtp_FieldMask(desc->bits - tailBits);
+        uint32_t tail = Avtp_LoadBe32(quadletPtr + 2 * AVTP_QUADLET_SIZE) >>
+                (32 - tailBits);
+        return (head << tailBits) | tail;
+    }
+}
+
+/**
+ * Inline variant of Avtp_SetField(). See Avtp_GetFieldInline() for details.
+ *
+ * The resulting PDU is bit-exact with Avtp_SetField().
+ *
+ * @param fieldDescriptors Table describing the fields of the PDU.
+ * @param numFields Number of entries in fieldDescriptors.
+ * @param pdu Pointer to the first bit of a 1722 PDU.
+ * @param field Specifies the position of the data field to be written
+ * @param value The value to set.
+ */
+static inline void Avtp_SetFieldInline(
+        const Avtp_FieldDescriptor_t* fieldDescriptors, uint8_t numFields,
+        uint8_t* pdu, uint8_t field, uint64_t value)
+{
+    const Avtp_FieldDescriptor_t* desc;
+    uint8_t* quadletPtr;
+    uint8_t end;
+
+    if (fieldDescriptors == NULL || pdu == NULL || field >= numFields) {
+        return;
+    }
+
+    desc = &fieldDescriptors[field];
+    if (desc->bits == 0) {
+        return;
+    }
+    quadletPtr = pdu + desc->quadlet * AVTP_QUADLET_SIZE;
+    end = desc->offset + desc->bits;
+
+    if (end <= 32) {
+        uint32_t mask = (uint32_t)Avtp_FieldMask(desc->bits) << (32 - end);
+        uint32_t quadlet = Avtp_LoadBe32(quadletPtr);
+        quadlet = (quadlet & ~mask) | (((uint32_t)value << (32 - end)) & mask);
+        Avtp_StoreBe32(quadletPtr, quadlet);
+    } else if (end <= 64) {
+        uint64_t mask = Avtp_FieldMask(desc->bits) << (64 - end);
+        uint64_t quadlets = Avtp_LoadBe64(quadletPtr);
+        quadlets = (quadlets & ~mask) | ((value << (64 - end)) & mask);
+        Avtp_StoreBe64(quadletPtr, quadlets);
+    } else {
+        uint8_t tailBits = end - 64;
+        uint64_t headMask = Avtp_FieldMask(desc->bits - tailBits);
+        uint32_t tailMask = (uint32_t)Avtp_FieldMask(tailBits) << (32 - tailBits);
+        uint64_t head = Avtp_LoadBe64(quadletPtr);
+        uint32_t tail = Avtp_LoadBe32(quadletPtr + 2 * AVTP_QUADLET_SIZE);
+        head = (head & ~headMask) | ((value >> tailBits) & headMask);
+        tail = (tail & ~tailMask) | (((uint32_t)value << (32 - tailBits)) & tailMask);
+        Avtp_StoreBe64(quadletPtr, head);
+        Avtp_StoreBe32(quadletPtr + 2 * AVTP_QUADLET_SIZE, tail);
+    }
+}
+
+/**
+ * Loads consecutive quadlets of a PDU into an array in host byte-order.
+ *
+ * @param pdu Pointer to the first quadlet to load.
+ * @param quadlets Destination array.
+ * @param numQuadlets Number of quadlets to load.
+ */
+static inline void Avtp_LoadQuadlets(const uint8_t* const pdu,
+        uint32_t* quadlets, uint8_t numQuadlets)
+{
+    for (uint8_t i = 0; i < numQuadlets; i++) {
+        quadlets[i] = Avtp_LoadBe32(pdu + i * AVTP_QUADLET_SIZE);
+    }
+}
+
+/**
+ * Stores an array of host byte-order quadlets into a PDU.
+ *
+ * @param pdu Pointer to the first quadlet to store.
+ * @param quadlets Source array.
+ * @param numQuadlets Number of quadlets to store.
+ */
+static inline void Avtp_StoreQuadlets(uint8_t* pdu,
+        const uint32_t* const quadlets, uint8_t numQuadlets)
+{
+    for (uint8_t i = 0; i < numQuadlets; i++) {
+        Avtp_StoreBe32(pdu + i * AVTP_QUADLET_SIZE, quadlets[i]);
+    }
+}
+
+/**
+ * Reads a data field from quadlets previously loaded with Avtp_LoadQuadlets().
+ * This allows to decode several fields with a single load per quadlet.
+ *
+ * @param quadlets Header quadlets in host byte-order, starting at quadlet 0.
+ * @param desc Position of the data field.
+ * @returns The field value.
+ */
+static inline uint64_t Avtp_GetFieldFromQuadlets(const uint32_t* const quadlets,
+        const Avtp_FieldDescriptor_t* const desc)
+{
+    uint8_t end = desc->offset + desc->bits;
+    const uint32_t* q = quadlets + desc->quadlet;
+
+    if (desc->bits == 0) {
+        return 0;
+    } else if (end <= 32) {
+        return (q[0] >> (32 - end)) & Avtp_FieldMask(desc->bits);
+    } else if (end <= 64) {
+        uint64_t value = ((uint64_t)q[0] << 32) | q[1];
+        return (value >> (64 - end)) & Avtp_FieldMask(desc->bits);
+    } else {
+        uint8_t tailBits = end - 64;
+        uint64_t head = (((uint64_t)q[0] << 32) | q[1]) & Avtp_FieldMask(desc->bits - tailBits);
+        return (head << tailBits) | (q[2] >> (32 - tailBits));
+    }
+}
+
+/**
+ * Writes a data field into quadlets previously loaded with
+ * Avtp_LoadQuadlets(). This allows to set several fields with a single
+ * load/store per quadlet (see Avtp_StoreQuadlets()).
+ *
+ * @param quadlets Header quadlets in host byte-order, starting at quadlet 0.
+ * @param desc Position of the data field.
+ * @param value The value to set.
+ */
+static inline void Avtp_SetFieldInQuadlets(uint32_t* quadlets,
+        const Avtp_FieldDescriptor_t* const desc, uint64_t value)
+{
+    uint8_t end = desc->offset + desc->bits;
+    uint32_t* q = quadlets + desc->quadlet;
+
+    if (desc->bits == 0) {
+        return;
+    } else if (end <= 32) {
+        uint32_t mask = (uint32_t)Avtp_FieldMask(desc->bits) << (32 - end);
+        q[0] = (q[0] & ~mask) | (((uint32_t)value << (32 - end)) & mask);
+    } else if (end <= 64) {
+        uint64_t mask = Avtp_FieldMask(desc->bits) << (64 - end);
+        uint64_t word = ((uint64_t)q[0] << 32) | q[1];
+        word = (word & ~mask) | ((value << (64 - end)) & mask);
+        q[0] = (uint32_t)(word >> 32);
+        q[1] = (uint32_t)word;
+    } else {
+        uint8_t tailBits = end - 64;
+        uint64_t headMask = Avtp_FieldMask(desc->bits - tailBits);
+        uint32_t tailMask = (uint32_t)Avtp_FieldMask(tailBits) << (32 - tailBits);
+        uint64_t word = ((uint64_t)q[0] << 32) | q[1];
+        word = (word & ~headMask) | ((value >> tailBits) & headMask);
+        q[0] = (uint32_t)(word >> 32);
+        q[1] = (uint32_t)word;
+        q[2] = (q[2] & ~tailMask) | (((uint32_t)value << (32 - tailBits)) & tailMask);
+    }
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -33,6 +33,7 @@
 #include <stdint.h>
 
 #include "avtp/Defines.h"
+#include "avtp/StreamTemplate.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -102,6 +103,28 @@ typedef enum {
  */
 void Avtp_Pcm_Init(Avtp_Pcm_t* pdu);
 
+/**
+ * Native representation of all AAF PCM stream header fields.
+ */
+typedef struct {
+    uint8_t subtype;
+    uint8_t sv;
+    uint8_t version;
+    uint8_t mr;
+    uint8_t tv;
+    uint8_t sequence_num;
+    uint8_t tu;
+    uint64_t stream_id;
+    uint32_t avtp_timestamp;
+    Avtp_AafFormat_t format;
+    Avtp_AafNsr_t nsr;
+    uint16_t channels_per_frame;
+    uint8_t bit_depth;
+    uint16_t stream_data_length;
+    Avtp_AafSp_t sp;
+    uint8_t evt;
+} Avtp_PcmHeader_t;
+
 /**
  * Returns the value of an an AVTP AAF PCM stream field as specified in the IEEE 1722 Specification.
  *
@@ -130,6 +153,26 @@ uint16_t Avtp_Pcm_GetStreamDataLength(const Avtp_Pcm_t* const pdu);
 Avtp_AafSp_t Avtp_Pcm_GetSp(const Avtp_Pcm_t* const pdu);
 uint8_t Avtp_Pcm_GetEvt(const Avtp_Pcm_t* const pdu);
 
+/**
+ * Reads all fields of an AAF PCM stream header. Each header quadlet is read
+ * only once.
+ *
+ * @param pdu Pointer to the first bit of an 1722 AVTP PDU.
+ * @param header Structure that receives the values of the header fields.
+ */
+void Avtp_Pcm_Unpack(const Avtp_Pcm_t* const pdu, Avtp_PcmHeader_t* header);
+
+/**
+ * Initializes a stream template for an AAF PCM stream. The template takes a copy
+ * of the given header. Only sequence_num, avtp_timestamp and stream_data_length
+ * are patched per packet.
+ *
+ * @param tmpl Template to initialize.
+ * @param pdu Pointer to the first bit of a completely initialized header.
+ * @returns 0 on success, -EINVAL otherwise.
+ */
+int Avtp_Pcm_InitTemplate(Avtp_StreamTemplate_t* tmpl, const Avtp_Pcm_t* const pdu);
+
 /**
  * Sets the value of an an AVTP AAF PCM stream field as specified in the IEEE 1722 Specification.
  *
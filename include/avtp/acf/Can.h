@@ -77,6 +77,24 @@ typedef enum  {
     AVTP_CAN_FIELD_MAX
 } Avtp_CanFields_t;
 
+/**
+ * Native representation of all ACF CAN header fields.
+ */
+typedef struct {
+    uint8_t acf_msg_type;
+    uint16_t acf_msg_length;
+    uint8_t pad;
+    uint8_t mtv;
+    uint8_t rtr;
+    uint8_t eff;
+    uint8_t brs;
+    uint8_t fdf;
+    uint8_t esi;
+    uint8_t can_bus_id;
+    uint64_t message_timestamp;
+    uint32_t can_identifier;
+} Avtp_CanHeader_t;
+
 /**
  * Initializes an ACF CAN PDU header as specified in the IEEE 1722 Specification.
  *
@@ -104,6 +122,15 @@ uint8_t Avtp_Can_GetCanBusId(const Avtp_Can_t* const pdu);
 uint64_t Avtp_Can_GetMessageTimestamp(const Avtp_Can_t* const pdu);
 uint32_t Avtp_Can_GetCanIdentifier(const Avtp_Can_t* const pdu);
 
+/**
+ * Reads all fields of an ACF CAN header. Each header quadlet is read
+ * only once.
+ *
+ * @param pdu Pointer to the first bit of an 1722 ACF CAN PDU.
+ * @param header Structure that receives the values of the header fields.
+ */
+void Avtp_Can_Unpack(const Avtp_Can_t* const pdu, Avtp_CanHeader_t* header);
+
 /**
  * Set the values of an an ACF CAN PDU field as specified in the IEEE 1722 Specification.
  *
@@ -137,6 +164,15 @@ void Avtp_Can_DisableFdf(Avtp_Can_t* pdu);
 void Avtp_Can_EnableEsi(Avtp_Can_t* pdu);
 void Avtp_Can_DisableEsi(Avtp_Can_t* pdu);
 
+/**
+ * Sets all fields of an ACF CAN header. Each header quadlet is read and
+ * written only once.
+ *
+ * @param pdu Pointer to the first bit of an 1722 ACF CAN PDU.
+ * @param header Values of the header fields.
+ */
+void Avtp_Can_SetHeader(Avtp_Can_t* pdu, const Avtp_CanHeader_t* const header);
+
 
 /**
  * Copies the payload data and CAN frame ID into the ACF CAN frame. This function will
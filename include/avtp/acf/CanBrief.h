@@ -78,6 +78,23 @@ typedef enum {
  */
 void Avtp_CanBrief_Init(Avtp_CanBrief_t* pdu);
 
+/**
+ * Native representation of all ACF Abbreviated CAN header fields.
+ */
+typedef struct {
+    uint8_t acf_msg_type;
+    uint16_t acf_msg_length;
+    uint8_t pad;
+    uint8_t mtv;
+    uint8_t rtr;
+    uint8_t eff;
+    uint8_t brs;
+    uint8_t fdf;
+    uint8_t esi;
+    uint8_t can_bus_id;
+    uint32_t can_identifier;
+} Avtp_CanBriefHeader_t;
+
 /**
  * Returns the value of an an ACF Abbreviated CAN PDU field as specified in the IEEE 1722 Specification.
  *
@@ -99,6 +116,15 @@ uint8_t Avtp_CanBrief_GetEsi(const Avtp_CanBrief_t* const pdu);
 uint8_t Avtp_CanBrief_GetCanBusId(const Avtp_CanBrief_t* const pdu);
 uint32_t Avtp_CanBrief_GetCanIdentifier(const Avtp_CanBrief_t* const pdu);
 
+/**
+ * Reads all fields of an ACF Abbreviated CAN header. Each header quadlet is read
+ * only once.
+ *
+ * @param pdu Pointer to the first bit of an 1722 ACF Abbreviated CAN PDU.
+ * @param header Structure that receives the values of the header fields.
+ */
+void Avtp_CanBrief_Unpack(const Avtp_CanBrief_t* const pdu, Avtp_CanBriefHeader_t* header);
+
 /**
  * Sets the value of an an ACF Abbreviated CAN PDU field as specified in the IEEE 1722 Specification.
  *
@@ -126,6 +152,15 @@ void Avtp_CanBrief_DisableEsi(Avtp_CanBrief_t* pdu);
 void Avtp_CanBrief_SetCanBusId(Avtp_CanBrief_t* pdu, uint8_t value);
 void Avtp_CanBrief_SetCanIdentifier(Avtp_CanBrief_t* pdu, uint32_t value);
 
+/**
+ * Sets all fields of an ACF Abbreviated CAN header. Each header quadlet is read
+ * and written only once.
+ *
+ * @param pdu Pointer to the first bit of an 1722 ACF Abbreviated CAN PDU.
+ * @param header Values of the header fields.
+ */
+void Avtp_CanBrief_SetHeader(Avtp_CanBrief_t* pdu, const Avtp_CanBriefHeader_t* const header);
+
 /**
  * Copies the payload data and CAN frame ID into the ACF CAN Brief frame. This function will
  * also set the length and pad fields while inserting the padded bytes.
@@ -36,6 +36,7 @@
 #pragma once
 
 #include "avtp/Defines.h"
+#include "avtp/StreamTemplate.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -60,6 +61,18 @@ typedef enum {
     AVTP_NTSCF_FIELD_MAX
 } Avtp_NtscfFields_t;
 
+/**
+ * Native representation of all NTSCF header fields.
+ */
+typedef struct {
+    uint8_t subtype;
+    uint8_t sv;
+    uint8_t version;
+    uint16_t ntscf_data_length;
+    uint8_t sequence_num;
+    uint64_t stream_id;
+} Avtp_NtscfHeader_t;
+
 /**
  * Initializes a NTSCF PDU as specified in the IEEE 1722-2016 Specification.
  *
@@ -84,6 +97,26 @@ uint16_t Avtp_Ntscf_GetNtscfDataLength(const Avtp_Ntscf_t* const pdu);
 uint8_t Avtp_Ntscf_GetSequenceNum(const Avtp_Ntscf_t* const pdu);
 uint64_t Avtp_Ntscf_GetStreamId(const Avtp_Ntscf_t* const pdu);
 
+/**
+ * Reads all fields of a NTSCF header. Each header quadlet is read
+ * only once.
+ *
+ * @param pdu Pointer to the first bit of an 1722 AVTP PDU.
+ * @param header Structure that receives the values of the header fields.
+ */
+void Avtp_Ntscf_Unpack(const Avtp_Ntscf_t* const pdu, Avtp_NtscfHeader_t* header);
+
+/**
+ * Initializes a stream template for an NTSCF stream. The template takes a copy
+ * of the given header. Only sequence_num and ntscf_data_length
+ * are patched per packet.
+ *
+ * @param tmpl Template to initialize.
+ * @param pdu Pointer to the first bit of a completely initialized header.
+ * @returns 0 on success, -EINVAL otherwise.
+ */
+int Avtp_Ntscf_InitTemplate(Avtp_StreamTemplate_t* tmpl, const Avtp_Ntscf_t* const pdu);
+
 /**
  * Sets the value of an an AVTP NTSCF field as specified in the IEEE 1722 Specification.
  *
@@ -101,6 +134,15 @@ void Avtp_Ntscf_SetNtscfDataLength(Avtp_Ntscf_t* pdu, uint16_t value);
 void Avtp_Ntscf_SetSequenceNum(Avtp_Ntscf_t* pdu, uint8_t value);
 void Avtp_Ntscf_SetStreamId(Avtp_Ntscf_t* pdu, uint64_t value);
 
+/**
+ * Sets all fields of an NTSCF header. Each header quadlet is read and written
+ * only once.
+ *
+ * @param pdu Pointer to the first bit of an 1722 AVTP PDU.
+ * @param header Values of the header fields.
+ */
+void Avtp_Ntscf_SetHeader(Avtp_Ntscf_t* pdu, const Avtp_NtscfHeader_t* const header);
+
 /**
  * Checks if the ACF Ntscf frame is valid by checking:
  *     1) if the length field of AVTP/ACF messages contains a value larger than the actual size of the buffer that contains the AVTP message.
@@ -36,6 +36,7 @@
 #pragma once
 
 #include "avtp/Defines.h"
+#include "avtp/StreamTemplate.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -68,6 +69,22 @@ typedef enum {
     AVTP_TSCF_FIELD_MAX
 } Avtp_TscfFields_t;
 
+/**
+ * Native representation of all TSCF header fields.
+ */
+typedef struct {
+    uint8_t subtype;
+    uint8_t sv;
+    uint8_t version;
+    uint8_t mr;
+    uint8_t tv;
+    uint8_t sequence_num;
+    uint8_t tu;
+    uint64_t stream_id;
+    uint32_t avtp_timestamp;
+    uint16_t stream_data_length;
+} Avtp_TscfHeader_t;
+
 
 /**
  * Initializes a TSCF PDU as specified in the IEEE 1722-2016 Specification.
@@ -97,6 +114,26 @@ uint64_t Avtp_Tscf_GetStreamId(const Avtp_Tscf_t* const pdu);
 uint32_t Avtp_Tscf_GetAvtpTimestamp(const Avtp_Tscf_t* const pdu);
 uint16_t Avtp_Tscf_GetStreamDataLength(const Avtp_Tscf_t* const pdu);
 
+/**
+ * Reads all fields of a TSCF header. Each header quadlet is read
+ * only once.
+ *
+ * @param pdu Pointer to the first bit of an 1722 AVTP PDU.
+ * @param header Structure that receives the values of the header fields.
+ */
+void Avtp_Tscf_Unpack(const Avtp_Tscf_t* const pdu, Avtp_TscfHeader_t* header);
+
+/**
+ * Initializes a stream template for a TSCF stream. The template takes a copy
+ * of the given header. Only sequence_num, avtp_timestamp and stream_data_length
+ * are patched per packet.
+ *
+ * @param tmpl Template to initialize.
+ * @param pdu Pointer to the first bit of a completely initialized header.
+ * @returns 0 on success, -EINVAL otherwise.
+ */
+int Avtp_Tscf_InitTemplate(Avtp_StreamTemplate_t* tmpl, const Avtp_Tscf_t* const pdu);
+
 /**
  * Sets the value of an an AVTP TSCF field as specified in the IEEE 1722 Specification.
  *
@@ -121,6 +158,15 @@ void Avtp_Tscf_SetStreamId(Avtp_Tscf_t* pdu, uint64_t value);
 void Avtp_Tscf_SetAvtpTimestamp(Avtp_Tscf_t* pdu, uint32_t value);
 void Avtp_Tscf_SetStreamDataLength(Avtp_Tscf_t* pdu, uint16_t value);
 
+/**
+ * Sets all fields of a TSCF header. Each header quadlet is read and written
+ * only once.
+ *
+ * @param pdu Pointer to the first bit of an 1722 AVTP PDU.
+ * @param header Values of the header fields.
+ */
+void Avtp_Tscf_SetHeader(Avtp_Tscf_t* pdu, const Avtp_TscfHeader_t* const header);
+
 /**
  * Checks if the ACF Tscf frame is valid by checking:
  *     1) if the length field of AVTP/ACF messages contains a value larger than the actual size of the buffer that contains the AVTP message.
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2025, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file
+ * C++ field types for the Clock Reference Format (CRF) header.
+ * The layout matches Avtp_CrfField_t of the C API in avtp/Crf.h.
+ */
+
+#pragma once
+
+#include "avtp/Crf.h"
+#include "avtp/cpp/Field.hpp"
+
+namespace avtp {
+
+struct Crf {
+    static constexpr size_t headerLen = AVTP_CRF_HEADER_LEN;
+
+    using Subtype           = Field<Crf, 0,  0,  8>;
+    using Sv                = Field<Crf, 0,  8,  1>;
+    using Version           = Field<Crf, 0,  9,  3>;
+    using Mr                = Field<Crf, 0, 12,  1>;
+    using Reserved          = Field<Crf, 0, 13,  1>;
+    using Fs                = Field<Crf, 0, 14,  1>;
+    using Tu                = Field<Crf, 0, 15,  1>;
+    using SequenceNum       = Field<Crf, 0, 16,  8>;
+    using Type              = Field<Crf, 0, 24,  8>;
+    using StreamId          = Field<Crf, 1,  0, 64>;
+    using Pull              = Field<Crf, 3,  0,  3>;
+    using BaseFrequency     = Field<Crf, 3,  3, 29>;
+    using CrfDataLength     = Field<Crf, 4,  0, 16>;
+    using TimestampInterval = Field<Crf, 4, 16, 16>;
+};
+
+using CrfView = PduView<Crf>;
+using ConstCrfView = PduView<Crf, const uint8_t>;
+
+} // namespace avtp
@@ -0,0 +1,231 @@
+/*
+ * Copyright (c) 2025, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file
+ * Header-only C++17 front-end for the IEEE 1722 PDU formats.
+ *
+ * Every header field is a distinct type Field<Format, Quadlet, Offset, Bits>
+ * whose position is known at compile time, so reading or writing a field
+ * compiles down to a load, a shift and a mask without calling into the
+ * library. The resulting bytes are identical to the C API.
+ *
+ * A PduView wraps a byte buffer and gives typed access to the fields of a
+ * single format:
+ *
+ *     avtp::PcmView pcm(buffer, sizeof(buffer));
+ *     pcm.Set<avtp::Pcm::SequenceNum>(seq);
+ *     uint32_t ts = pcm.Get<avtp::Pcm::AvtpTimestamp>();
+ */
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "avtp/Defines.h"
+#include "avtp/Byteorder.h"
+
+namespace avtp {
+
+/**
+ * Smallest unsigned integer type that holds a field of the given width.
+ */
+template <uint8_t Bits>
+using FieldValue_t = std::conditional_t<(Bits <= 8), uint8_t,
+                     std::conditional_t<(Bits <= 16), uint16_t,
+                     std::conditional_t<(Bits <= 32), uint32_t, uint64_t>>>;
+
+/**
+ * Compile-time descriptor of a header field. Mirrors Avtp_FieldDescriptor_t.
+ *
+ * @tparam Format Format the field belongs to (e.g. avtp::Pcm).
+ * @tparam Quadlet Number of the quadlet containing the first bit of the field.
+ * @tparam Offset Bit position of the field within that quadlet.
+ * @tparam Bits Width of the field in bits.
+ */
+template <typename Format, uint8_t Quadlet, uint8_t Offset, uint8_t Bits>
+struct Field {
+    static_assert(Offset < 32, "Field offset must be within a quadlet");
+    static_assert(Bits > 0 && Bits <= AVTP_FIELD_MAX_BITS,
+                  "Field width not supported by the parser");
+
+    using FormatType = Format;
+    using ValueType = FieldValue_t<Bits>;
+
+    static constexpr uint8_t quadlet = Quadlet;
+    static constexpr uint8_t offset = Offset;
+    static constexpr uint8_t bits = Bits;
+    static constexpr uint64_t max = (Bits == 64) ? ~0ULL : ((1ULL << Bits) - 1);
+
+    /** First byte after the quadlets touched by the field. */
+    static constexpr size_t end =
+            (Quadlet + (Offset + Bits + 31) / 32) * AVTP_QUADLET_SIZE;
+
+    /**
+     * Reads the field from a PDU. Equivalent to Avtp_GetFieldInline().
+     *
+     * @param pdu Pointer to the first bit of a 1722 PDU.
+     */
+    static ValueType Get(const uint8_t* pdu)
+    {
+        const uint8_t* ptr = pdu + Quadlet * AVTP_QUADLET_SIZE;
+        constexpr uint8_t last = Offset + Bits;
+
+        if constexpr (last <= 32) {
+            return static_cast<ValueType>((Avtp_LoadBe32(ptr) >> (32 - last)) & max);
+        } else if constexpr (last <= 64) {
+            return static_cast<ValueType>((Avtp_LoadBe64(ptr) >> (64 - last)) & max);
+        } else {
+            constexpr uint8_t tailBits = last - 64;
+            uint64_t head = Avtp_LoadBe64(ptr) & ((1ULL << (Bits - tailBits)) - 1);
+            uint32_t tail = Avtp_LoadBe32(ptr + 2 * AVTP_QUADLET_SIZE) >> (32 - tailBits);
+            return static_cast<ValueType>((head << tailBits) | tail);
+        }
+    }
+
+    /**
+     * Writes the field into a PDU. Bits of the value exceeding the field width
+     * are discarded. Equivalent to Avtp_SetFieldInline().
+     *
+     * @param pdu Pointer to the first bit of a 1722 PDU.
+     * @param value The value to set.
+     */
+    static void Set(uint8_t* pdu, ValueType value)
+    {
+        uint8_t* ptr = pdu + Quadlet * AVTP_QUADLET_SIZE;
+        constexpr uint8_t last = Offset + Bits;
+
+        if constexpr (last <= 32) {
+            constexpr uint32_t mask = static_cast<uint32_t>(max << (32 - last));
+            uint32_t quadlet = Avtp_LoadBe32(ptr);
+            quadlet = (quadlet & ~mask) | ((static_cast<uint32_t>(value) << (32 - last)) & mask);
+            Avtp_StoreBe32(ptr, quadlet);
+        } else if constexpr (last <= 64) {
+            constexpr uint64_t mask = max << (64 - last);
+            uint64_t quadlets = Avtp_LoadBe64(ptr);
+            quadlets = (quadlets & ~mask) | ((static_cast<uint64_t>(value) << (64 - last)) & mask);
+            Avtp_StoreBe64(ptr, quadlets);
+        } else {
+            constexpr uint8_t tailBits = last - 64;
+            constexpr uint64_t headMask = (1ULL << (Bits - tailBits)) - 1;
+            constexpr uint32_t tailMask = ((1U << tailBits) - 1) << (32 - tailBits);
+            uint64_t head = Avtp_LoadBe64(ptr);
+            uint32_t tail = Avtp_LoadBe32(ptr + 2 * AVTP_QUADLET_SIZE);
+            head = (head & ~headMask) | ((static_cast<uint64_t>(value) >> tailBits) & headMask);
+            tail = (tail & ~tailMask) | ((static_cast<uint32_t>(value) << (32 - tailBits)) & tailMask);
+            Avtp_StoreBe64(ptr, head);
+            Avtp_StoreBe32(ptr + 2 * AVTP_QUADLET_SIZE, tail);
+        }
+    }
+};
+
+/**
+ * Non-owning view of a PDU of a given format. Fields of other formats are
+ * rejected at compile time. Use a const Byte type for read-only access.
+ *
+ * @tparam Format Format of the PDU (e.g. avtp::Pcm).
+ * @tparam Byte uint8_t or const uint8_t.
+ */
+template <typename Format, typename Byte = uint8_t>
+class PduView {
+    static_assert(std::is_same_v<std::remove_const_t<Byte>, uint8_t>,
+                  "PDU views operate on uint8_t buffers");
+
+public:
+    static constexpr size_t headerLen = Format::headerLen;
+
+    /**
+     * @param data Pointer to the first bit of the PDU.
+     * @param size Size of the buffer, at least the header length of the format.
+     */
+    PduView(Byte* data, size_t size) : data_(data), size_(size)
+    {
+        assert(data != nullptr && size >= headerLen);
+    }
+
+    template <size_t N>
+    PduView(Byte (&data)[N]) : data_(data), size_(N)
+    {
+        static_assert(N >= headerLen, "Buffer smaller than the PDU header");
+    }
+
+    /** A writable view converts to a read-only one. */
+    operator PduView<Format, const uint8_t>() const
+    {
+        return PduView<Format, const uint8_t>(data_, size_);
+    }
+
+    Byte* Data() const { return data_; }
+    size_t Size() const { return size_; }
+    Byte* Payload() const { return data_ + headerLen; }
+    size_t PayloadSize() const { return size_ - headerLen; }
+
+    template <typename F>
+    typename F::ValueType Get() const
+    {
+        CheckField<F>();
+        return F::Get(data_);
+    }
+
+    template <typename F>
+    void Set(typename F::ValueType value) const
+    {
+        static_assert(!std::is_const_v<Byte>, "Cannot set fields of a const view");
+        CheckField<F>();
+        F::Set(data_, value);
+    }
+
+    /**
+     * Sets a field to a constant. Values exceeding the field width are
+     * rejected at compile time.
+     */
+    template <typename F, uint64_t Value>
+    void Set() const
+    {
+        static_assert(Value <= F::max, "Value does not fit into the field");
+        Set<F>(static_cast<typename F::ValueType>(Value));
+    }
+
+private:
+    template <typename F>
+    static constexpr void CheckField()
+    {
+        static_assert(std::is_same_v<typename F::FormatType, Format>,
+                      "Field does not belong to this PDU format");
+        static_assert(F::end <= headerLen, "Field exceeds the PDU header");
+    }
+
+    Byte* data_;
+    size_t size_;
+};
+
+} // namespace avtp
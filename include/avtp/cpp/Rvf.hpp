@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2025, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file
+ * C++ field types for the Raw Video Format (RVF) header.
+ * The layout matches Avtp_RvfField_t of the C API in avtp/Rvf.h.
+ */
+
+#pragma once
+
+#include "avtp/Rvf.h"
+#include "avtp/cpp/Field.hpp"
+
+namespace avtp {
+
+struct Rvf {
+    static constexpr size_t headerLen = AVTP_RVF_HEADER_LEN;
+
+    using Subtype          = Field<Rvf, 0,  0,  8>;
+    using Sv               = Field<Rvf, 0,  8,  1>;
+    using Version          = Field<Rvf, 0,  9,  3>;
+    using Mr               = Field<Rvf, 0, 12,  1>;
+    using Reserved         = Field<Rvf, 0, 13,  2>;
+    using Tv               = Field<Rvf, 0, 15,  1>;
+    using SequenceNum      = Field<Rvf, 0, 16,  8>;
+    using Reserved2        = Field<Rvf, 0, 24,  7>;
+    using Tu               = Field<Rvf, 0, 31,  1>;
+    using StreamId         = Field<Rvf, 1,  0, 64>;
+    using AvtpTimestamp    = Field<Rvf, 3,  0, 32>;
+    using ActivePixels     = Field<Rvf, 4,  0, 16>;
+    using TotalLines       = Field<Rvf, 4, 16, 16>;
+    using StreamDataLength = Field<Rvf, 5,  0, 16>;
+    using Ap               = Field<Rvf, 5, 16,  1>;
+    using Reserved3        = Field<Rvf, 5, 17,  1>;
+    using F                = Field<Rvf, 5, 18,  1>;
+    using Ef               = Field<Rvf, 5, 19,  1>;
+    using Evt              = Field<Rvf, 5, 20,  4>;
+    using Pd               = Field<Rvf, 5, 24,  1>;
+    using I                = Field<Rvf, 5, 25,  1>;
+    using Reserved4        = Field<Rvf, 5, 26,  6>;
+    using Reserved5        = Field<Rvf, 6,  0,  8>;
+    using PixelDepth       = Field<Rvf, 6,  8,  4>;
+    using PixelFormat      = Field<Rvf, 6, 12,  4>;
+    using FrameRate        = Field<Rvf, 6, 16,  8>;
+    using Colorspace       = Field<Rvf, 6, 24,  4>;
+    using NumLines         = Field<Rvf, 6, 28,  4>;
+    using Reserved6        = Field<Rvf, 7,  0,  8>;
+    using ISeqNum          = Field<Rvf, 7,  8,  8>;
+    using LineNumber       = Field<Rvf, 7, 16, 16>;
+};
+
+using RvfView = PduView<Rvf>;
+using ConstRvfView = PduView<Rvf, const uint8_t>;
+
+} // namespace avtp
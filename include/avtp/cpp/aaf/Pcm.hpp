@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2025, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file
+ * C++ field types for the AAF PCM header.
+ * The layout matches Avtp_PcmFields_t of the C API in avtp/aaf/Pcm.h.
+ */
+
+#pragma once
+
+#include "avtp/aaf/Pcm.h"
+#include "avtp/cpp/Field.hpp"
+
+namespace avtp {
+
+struct Pcm {
+    static constexpr size_t headerLen = AVTP_PCM_HEADER_LEN;
+
+    using Subtype          = Field<Pcm, 0,  0,  8>;
+    using Sv               = Field<Pcm, 0,  8,  1>;
+    using Version          = Field<Pcm, 0,  9,  3>;
+    using Mr               = Field<Pcm, 0, 12,  1>;
+    using Tv               = Field<Pcm, 0, 15,  1>;
+    using SequenceNum      = Field<Pcm, 0, 16,  8>;
+    using Tu               = Field<Pcm, 0, 31,  1>;
+    using StreamId         = Field<Pcm, 1,  0, 64>;
+    using AvtpTimestamp    = Field<Pcm, 3,  0, 32>;
+    using Format           = Field<Pcm, 4,  0,  8>;
+    using Nsr              = Field<Pcm, 4,  8,  4>;
+    using ChannelsPerFrame = Field<Pcm, 4, 14, 10>;
+    using BitDepth         = Field<Pcm, 4, 24,  8>;
+    using StreamDataLength = Field<Pcm, 5,  0, 16>;
+    using Sp               = Field<Pcm, 5, 19,  1>;
+    using Evt              = Field<Pcm, 5, 20,  4>;
+};
+
+using PcmView = PduView<Pcm>;
+using ConstPcmView = PduView<Pcm, const uint8_t>;
+
+} // namespace avtp
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2025, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file
+ * C++ field types for the ACF Abbreviated CAN message header.
+ * The layout matches Avtp_CanBriefFields_t of the C API in avtp/acf/CanBrief.h.
+ */
+
+#pragma once
+
+#include "avtp/acf/CanBrief.h"
+#include "avtp/cpp/Field.hpp"
+
+namespace avtp {
+
+struct CanBrief {
+    static constexpr size_t headerLen = AVTP_CAN_BRIEF_HEADER_LEN;
+
+    /* ACF common header fields */
+    using AcfMsgType    = Field<CanBrief, 0,  0,  7>;
+    using AcfMsgLength  = Field<CanBrief, 0,  7,  9>;
+
+    /* ACF Abbreviated CAN header fields */
+    using Pad           = Field<CanBrief, 0, 16,  2>;
+    using Mtv           = Field<CanBrief, 0, 18,  1>;
+    using Rtr           = Field<CanBrief, 0, 19,  1>;
+    using Eff           = Field<CanBrief, 0, 20,  1>;
+    using Brs           = Field<CanBrief, 0, 21,  1>;
+    using Fdf           = Field<CanBrief, 0, 22,  1>;
+    using Esi           = Field<CanBrief, 0, 23,  1>;
+    using CanBusId      = Field<CanBrief, 0, 27,  5>;
+    using CanIdentifier = Field<CanBrief, 1,  3, 29>;
+};
+
+using CanBriefView = PduView<CanBrief>;
+using ConstCanBriefView = PduView<CanBrief, const uint8_t>;
+
+} // namespace avtp
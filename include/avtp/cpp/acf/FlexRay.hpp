@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2025, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file
+ * C++ field types for the ACF FlexRay message header.
+ * The layout matches Avtp_FlexRayFields_t of the C API in avtp/acf/FlexRay.h.
+ */
+
+#pragma once
+
+#include "avtp/acf/FlexRay.h"
+#include "avtp/cpp/Field.hpp"
+
+namespace avtp {
+
+struct FlexRay {
+    static constexpr size_t headerLen = AVTP_FLEXRAY_HEADER_LEN;
+
+    /* ACF common header fields */
+    using AcfMsgType       = Field<FlexRay, 0,  0,  7>;
+    using AcfMsgLength     = Field<FlexRay, 0,  7,  9>;
+
+    /* ACF Flexray header fields */
+    using Pad              = Field<FlexRay, 0, 16,  2>;
+    using Mtv              = Field<FlexRay, 0, 18,  1>;
+    using FrBusId          = Field<FlexRay, 0, 19,  5>;
+    using Reserved         = Field<FlexRay, 0, 24,  2>;
+    using Chan             = Field<FlexRay, 0, 26,  2>;
+    using Str              = Field<FlexRay, 0, 28,  1>;
+    using Syn              = Field<FlexRay, 0, 29,  1>;
+    using Pre              = Field<FlexRay, 0, 30,  1>;
+    using Nfi              = Field<FlexRay, 0, 31,  1>;
+    using MessageTimestamp = Field<FlexRay, 1,  0, 64>;
+    using FrFrameId        = Field<FlexRay, 3,  0, 11>;
+    using Reserved2        = Field<FlexRay, 3, 11, 15>;
+    using Cycle            = Field<FlexRay, 3, 26,  6>;
+};
+
+using FlexRayView = PduView<FlexRay>;
+using ConstFlexRayView = PduView<FlexRay, const uint8_t>;
+
+} // namespace avtp
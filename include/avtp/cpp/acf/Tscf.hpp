@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2025, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file
+ * C++ field types for the Time-Synchronous Control Format (TSCF) header.
+ * The layout matches Avtp_TscfFields_t of the C API in avtp/acf/Tscf.h.
+ */
+
+#pragma once
+
+#include "avtp/acf/Tscf.h"
+#include "avtp/cpp/Field.hpp"
+
+namespace avtp {
+
+struct Tscf {
+    static constexpr size_t headerLen = AVTP_TSCF_HEADER_LEN;
+
+    /* Common AVTP header */
+    using Subtype          = Field<Tscf, 0,  0,  8>;
+    using Sv               = Field<Tscf, 0,  8,  1>;
+    using Version          = Field<Tscf, 0,  9,  3>;
+
+    /* TSCF header */
+    using Mr               = Field<Tscf, 0, 12,  1>;
+    using Tv               = Field<Tscf, 0, 15,  1>;
+    using SequenceNum      = Field<Tscf, 0, 16,  8>;
+    using Tu               = Field<Tscf, 0, 31,  1>;
+    using StreamId         = Field<Tscf, 1,  0, 64>;
+    using AvtpTimestamp    = Field<Tscf, 3,  0, 32>;
+    using StreamDataLength = Field<Tscf, 5,  0, 16>;
+};
+
+using TscfView = PduView<Tscf>;
+using ConstTscfView = PduView<Tscf, const uint8_t>;
+
+} // namespace avtp
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2025, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file
+ * C++ field types for the ACF Abbreviated VSS message header.
+ * The layout matches Avtp_VssBriefFields_t of the C API in avtp/acf/custom/VssBrief.h.
+ */
+
+#pragma once
+
+#include "avtp/acf/custom/VssBrief.h"
+#include "avtp/cpp/Field.hpp"
+
+namespace avtp {
+
+struct VssBrief {
+    static constexpr size_t headerLen = AVTP_VSS_BRIEF_HEADER_LEN;
+
+    /* ACF common header fields */
+    using AcfMsgType   = Field<VssBrief, 0,  0,  7>;
+    using AcfMsgLength = Field<VssBrief, 0,  7,  9>;
+
+    /* ACF VSS header fields */
+    using Pad          = Field<VssBrief, 0, 16,  2>;
+    using Mtv          = Field<VssBrief, 0, 18,  1>;
+    using AddrMode     = Field<VssBrief, 0, 19,  2>;
+    using VssOp        = Field<VssBrief, 0, 21,  3>;
+    using VssDatatype  = Field<VssBrief, 0, 24,  8>;
+};
+
+using VssBriefView = PduView<VssBrief>;
+using ConstVssBriefView = PduView<VssBrief, const uint8_t>;
+
+} // namespace avtp
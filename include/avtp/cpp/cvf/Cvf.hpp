@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2025, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file
+ * C++ field types for the Compressed Video Format (CVF) header.
+ * The layout matches Avtp_CvfField_t of the C API in avtp/cvf/Cvf.h.
+ */
+
+#pragma once
+
+#include "avtp/cvf/Cvf.h"
+#include "avtp/cpp/Field.hpp"
+
+namespace avtp {
+
+struct Cvf {
+    static constexpr size_t headerLen = AVTP_CVF_HEADER_LEN;
+
+    using Subtype          = Field<Cvf, 0,  0,  8>;
+    using Sv               = Field<Cvf, 0,  8,  1>;
+    using Version          = Field<Cvf, 0,  9,  3>;
+    using Mr               = Field<Cvf, 0, 12,  1>;
+    using Reserved         = Field<Cvf, 0, 13,  2>;
+    using Tv               = Field<Cvf, 0, 15,  1>;
+    using SequenceNum      = Field<Cvf, 0, 16,  8>;
+    using Reserved2        = Field<Cvf, 0, 24,  7>;
+    using Tu               = Field<Cvf, 0, 31,  1>;
+    using StreamId         = Field<Cvf, 1,  0, 64>;
+    using AvtpTimestamp    = Field<Cvf, 3,  0, 32>;
+    using Format           = Field<Cvf, 4,  0,  8>;
+    using FormatSubtype    = Field<Cvf, 4,  8,  8>;
+    using Reserved3        = Field<Cvf, 4, 16, 16>;
+    using StreamDataLength = Field<Cvf, 5,  0, 16>;
+    using Reserved4        = Field<Cvf, 5, 16,  2>;
+    using Ptv              = Field<Cvf, 5, 18,  1>;
+    using M                = Field<Cvf, 5, 19,  1>;
+    using Evt              = Field<Cvf, 5, 20,  4>;
+    using Reserved5        = Field<Cvf, 5, 24,  8>;
+};
+
+using CvfView = PduView<Cvf>;
+using ConstCvfView = PduView<Cvf, const uint8_t>;
+
+} // namespace avtp
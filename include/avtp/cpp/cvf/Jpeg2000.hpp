@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2025, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file
+ * C++ field types for the CVF JPEG 2000 payload header.
+ * The layout matches Avtp_Jpeg2000Field_t of the C API in avtp/cvf/Jpeg2000.h.
+ */
+
+#pragma once
+
+#include "avtp/cvf/Jpeg2000.h"
+#include "avtp/cpp/Field.hpp"
+
+namespace avtp {
+
+struct Jpeg2000 {
+    static constexpr size_t headerLen = AVTP_JPEG2000_HEADER_LEN;
+
+    using Tp             = Field<Jpeg2000, 0,  0,  2>;
+    using Mhf            = Field<Jpeg2000, 0,  2,  2>;
+    using MhId           = Field<Jpeg2000, 0,  4,  3>;
+    using T              = Field<Jpeg2000, 0,  7,  1>;
+    using Priority       = Field<Jpeg2000, 0,  8,  8>;
+    using TileNumber     = Field<Jpeg2000, 0, 16, 16>;
+    using Reserved       = Field<Jpeg2000, 1,  0,  8>;
+    using FragmentOffset = Field<Jpeg2000, 1,  8, 24>;
+};
+
+using Jpeg2000View = PduView<Jpeg2000>;
+using ConstJpeg2000View = PduView<Jpeg2000, const uint8_t>;
+
+} // namespace avtp
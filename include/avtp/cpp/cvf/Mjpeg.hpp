@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2025, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file
+ * C++ field types for the CVF MJPEG payload header.
+ * The layout matches Avtp_MjpegField_t of the C API in avtp/cvf/Mjpeg.h.
+ */
+
+#pragma once
+
+#include "avtp/cvf/Mjpeg.h"
+#include "avtp/cpp/Field.hpp"
+
+namespace avtp {
+
+struct Mjpeg {
+    static constexpr size_t headerLen = AVTP_MJPEG_HEADER_LEN;
+
+    using TypeSpecific   = Field<Mjpeg, 0,  0,  8>;
+    using FragmentOffset = Field<Mjpeg, 0,  8, 24>;
+    using Type           = Field<Mjpeg, 1,  0,  8>;
+    using Q              = Field<Mjpeg, 1,  8,  8>;
+    using Width          = Field<Mjpeg, 1, 16,  8>;
+    using Height         = Field<Mjpeg, 1, 24,  8>;
+};
+
+using MjpegView = PduView<Mjpeg>;
+using ConstMjpegView = PduView<Mjpeg, const uint8_t>;
+
+} // namespace avtp
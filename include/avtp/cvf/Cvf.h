@@ -32,6 +32,7 @@
 #include <stdint.h>
 
 #include "avtp/Utils.h"
+#include "avtp/StreamTemplate.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -80,6 +81,27 @@ typedef enum Avtp_CvfFormatSubtype {
     AVTP_CVF_FORMAT_SUBTYPE_JPEG2000    = 0x2
 } Avtp_CvfFormatSubtype_t;
 
+/**
+ * Native representation of all CVF header fields.
+ */
+typedef struct {
+    uint8_t subtype;
+    uint8_t sv;
+    uint8_t version;
+    uint8_t mr;
+    uint8_t tv;
+    uint8_t sequence_num;
+    uint8_t tu;
+    uint64_t stream_id;
+    uint32_t avtp_timestamp;
+    Avtp_CvfFormat_t format;
+    Avtp_CvfFormatSubtype_t format_subtype;
+    uint16_t stream_data_length;
+    uint8_t ptv;
+    uint8_t m;
+    uint8_t evt;
+} Avtp_CvfHeader_t;
+
 void Avtp_Cvf_Init(Avtp_Cvf_t* pdu);
 
 uint64_t Avtp_Cvf_GetField(const Avtp_Cvf_t* const pdu, Avtp_CvfField_t field);
@@ -100,6 +122,26 @@ uint8_t Avtp_Cvf_GetPtv(const Avtp_Cvf_t* const pdu);
 uint8_t Avtp_Cvf_GetM(const Avtp_Cvf_t* const pdu);
 uint8_t Avtp_Cvf_GetEvt(const Avtp_Cvf_t* const pdu);
 
+/**
+ * Reads all fields of a CVF header. Each header quadlet is read
+ * only once.
+ *
+ * @param pdu Pointer to the first bit of an 1722 AVTP PDU.
+ * @param header Structure that receives the values of the header fields.
+ */
+void Avtp_Cvf_Unpack(const Avtp_Cvf_t* const pdu, Avtp_CvfHeader_t* header);
+
+/**
+ * Initializes a stream template for a CVF stream. The template takes a copy
+ * of the given header. Only sequence_num, avtp_timestamp and stream_data_length
+ * are patched per packet.
+ *
+ * @param tmpl Template to initialize.
+ * @param pdu Pointer to the first bit of a completely initialized header.
+ * @returns 0 on success, -EINVAL otherwise.
+ */
+int Avtp_Cvf_InitTemplate(Avtp_StreamTemplate_t* tmpl, const Avtp_Cvf_t* const pdu);
+
 void Avtp_Cvf_SetField(Avtp_Cvf_t* pdu, Avtp_CvfField_t field, uint64_t value);
 
 void Avtp_Cvf_SetSubtype(Avtp_Cvf_t* pdu, uint8_t value);
@@ -40,9 +40,11 @@
 #include "avtp/Defines.h"
 
 #define GET_FIELD(field) \
-        (Avtp_GetField(Avtp_CommonHeaderFieldDesc, AVTP_COMMON_HEADER_FIELD_MAX, (uint8_t*)pdu, field))
+        (Avtp_GetFieldInline(Avtp_CommonHeaderFieldDesc, AVTP_COMMON_HEADER_FIELD_MAX, (uint8_t*)pdu, field))
 #define SET_FIELD(field, value) \
-        (Avtp_SetField(Avtp_CommonHeaderFieldDesc, AVTP_COMMON_HEADER_FIELD_MAX, (uint8_t*)pdu, field, value))
+        (Avtp_SetFieldInline(Avtp_CommonHeaderFieldDesc, AVTP_COMMON_HEADER_FIELD_MAX, (uint8_t*)pdu, field, value))
+#define GET_HEADER_FIELD(field) \
+        (Avtp_GetFieldFromQuadlets(quadlets, &Avtp_CommonHeaderFieldDesc[field]))
 
 /**
  * This table maps all IEEE 1722 common header fields to a descriptor.
@@ -75,6 +77,20 @@ uint8_t Avtp_CommonHeader_GetVersion(const Avtp_CommonHeader_t* const pdu)
     return GET_FIELD(AVTP_COMMON_HEADER_FIELD_VERSION);
 }
 
+void Avtp_CommonHeader_Unpack(const Avtp_CommonHeader_t* const pdu, Avtp_CommonHeaderHeader_t* header)
+{
+    uint32_t quadlets[AVTP_COMMON_HEADER_LEN / AVTP_QUADLET_SIZE];
+
+    if (pdu == NULL || header == NULL) {
+        return;
+    }
+
+    Avtp_LoadQuadlets((const uint8_t*)pdu, quadlets, AVTP_COMMON_HEADER_LEN / AVTP_QUADLET_SIZE);
+    header->subtype = GET_HEADER_FIELD(AVTP_COMMON_HEADER_FIELD_SUBTYPE);
+    header->h = GET_HEADER_FIELD(AVTP_COMMON_HEADER_FIELD_H);
+    header->version = GET_HEADER_FIELD(AVTP_COMMON_HEADER_FIELD_VERSION);
+}
+
 void Avtp_CommonHeader_SetField(Avtp_CommonHeader_t* pdu,
         Avtp_CommonHeaderField_t field, uint64_t value)
 {
@@ -36,9 +36,11 @@
 #include "avtp/CommonHeader.h"
 
 #define GET_FIELD(field) \
-        (Avtp_GetField(Avtp_CrfFieldDescriptors, AVTP_CRF_FIELD_MAX, (uint8_t*)pdu, field))
+        (Avtp_GetFieldInline(Avtp_CrfFieldDescriptors, AVTP_CRF_FIELD_MAX, (uint8_t*)pdu, field))
 #define SET_FIELD(field, value) \
-        (Avtp_SetField(Avtp_CrfFieldDescriptors, AVTP_CRF_FIELD_MAX, (uint8_t*)pdu, field, value))
+        (Avtp_SetFieldInline(Avtp_CrfFieldDescriptors, AVTP_CRF_FIELD_MAX, (uint8_t*)pdu, field, value))
+#define GET_HEADER_FIELD(field) \
+        (Avtp_GetFieldFromQuadlets(quadlets, &Avtp_CrfFieldDescriptors[field]))
 
 /**
  * This table maps all IEEE 1722 Clock Reference Format (CRF) specific header fields
@@ -141,6 +143,37 @@ uint16_t Avtp_Crf_GetTimestampInterval(const Avtp_Crf_t* const pdu)
     return GET_FIELD(AVTP_CRF_FIELD_TIMESTAMP_INTERVAL);
 }
 
+void Avtp_Crf_Unpack(const Avtp_Crf_t* const pdu, Avtp_CrfHeader_t* header)
+{
+    uint32_t quadlets[AVTP_CRF_HEADER_LEN / AVTP_QUADLET_SIZE];
+
+    if (pdu == NULL || header == NULL) {
+        return;
+    }
+
+    Avtp_LoadQuadlets((const uint8_t*)pdu, quadlets, AVTP_CRF_HEADER_LEN / AVTP_QUADLET_SIZE);
+    header->subtype = GET_HEADER_FIELD(AVTP_CRF_FIELD_SUBTYPE);
+    header->sv = GET_HEADER_FIELD(AVTP_CRF_FIELD_SV);
+    header->version = GET_HEADER_FIELD(AVTP_CRF_FIELD_VERSION);
+    header->mr = GET_HEADER_FIELD(AVTP_CRF_FIELD_MR);
+    header->fs = GET_HEADER_FIELD(AVTP_CRF_FIELD_FS);
+    header->tu = GET_HEADER_FIELD(AVTP_CRF_FIELD_TU);
+    header->sequence_num = GET_HEADER_FIELD(AVTP_CRF_FIELD_SEQUENCE_NUM);
+    header->type = GET_HEADER_FIELD(AVTP_CRF_FIELD_TYPE);
+    header->stream_id = GET_HEADER_FIELD(AVTP_CRF_FIELD_STREAM_ID);
+    header->pull = GET_HEADER_FIELD(AVTP_CRF_FIELD_PULL);
+    header->base_frequency = GET_HEADER_FIELD(AVTP_CRF_FIELD_BASE_FREQUENCY);
+    header->crf_data_length = GET_HEADER_FIELD(AVTP_CRF_FIELD_CRF_DATA_LENGTH);
+    header->timestamp_interval = GET_HEADER_FIELD(AVTP_CRF_FIELD_TIMESTAMP_INTERVAL);
+}
+
+int Avtp_Crf_InitTemplate(Avtp_StreamTemplate_t* tmpl, const Avtp_Crf_t* const pdu)
+{
+    return Avtp_StreamTemplate_Init(tmpl, (const uint8_t*)pdu, AVTP_CRF_HEADER_LEN,
+            &Avtp_CrfFieldDescriptors[AVTP_CRF_FIELD_SEQUENCE_NUM], NULL,
+            &Avtp_CrfFieldDescriptors[AVTP_CRF_FIELD_CRF_DATA_LENGTH]);
+}
+
 void Avtp_Crf_SetField(Avtp_Crf_t* pdu, Avtp_CrfField_t field, uint64_t value)
 {
     SET_FIELD(field, value);
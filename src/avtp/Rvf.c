@@ -37,9 +37,11 @@
 #include "avtp/CommonHeader.h"
 
 #define GET_FIELD(field) \
-        (Avtp_GetField(Avtp_RvfFieldDesc, AVTP_RVF_FIELD_MAX, (uint8_t*)pdu, field))
+        (Avtp_GetFieldInline(Avtp_RvfFieldDesc, AVTP_RVF_FIELD_MAX, (uint8_t*)pdu, field))
 #define SET_FIELD(field, value) \
-        (Avtp_SetField(Avtp_RvfFieldDesc, AVTP_RVF_FIELD_MAX, (uint8_t*)pdu, field, value))
+        (Avtp_SetFieldInline(Avtp_RvfFieldDesc, AVTP_RVF_FIELD_MAX, (uint8_t*)pdu, field, value))
+#define GET_HEADER_FIELD(field) \
+        (Avtp_GetFieldFromQuadlets(quadlets, &Avtp_RvfFieldDesc[field]))
 
 /**
  * This table maps all IEEE 1722 Raw Video Format (RVF) specific header fields
@@ -219,6 +221,49 @@ uint16_t Avtp_Rvf_GetLineNumber(const Avtp_Rvf_t* const pdu)
     return GET_FIELD(AVTP_RVF_FIELD_LINE_NUMBER);
 }
 
+void Avtp_Rvf_Unpack(const Avtp_Rvf_t* const pdu, Avtp_RvfHeader_t* header)
+{
+    uint32_t quadlets[AVTP_RVF_HEADER_LEN / AVTP_QUADLET_SIZE];
+
+    if (pdu == NULL || header == NULL) {
+        return;
+    }
+
+    Avtp_LoadQuadlets((const uint8_t*)pdu, quadlets, AVTP_RVF_HEADER_LEN / AVTP_QUADLET_SIZE);
+    header->subtype = GET_HEADER_FIELD(AVTP_RVF_FIELD_SUBTYPE);
+    header->sv = GET_HEADER_FIELD(AVTP_RVF_FIELD_SV);
+    header->version = GET_HEADER_FIELD(AVTP_RVF_FIELD_VERSION);
+    header->mr = GET_HEADER_FIELD(AVTP_RVF_FIELD_MR);
+    header->tv = GET_HEADER_FIELD(AVTP_RVF_FIELD_TV);
+    header->sequence_num = GET_HEADER_FIELD(AVTP_RVF_FIELD_SEQUENCE_NUM);
+    header->tu = GET_HEADER_FIELD(AVTP_RVF_FIELD_TU);
+    header->stream_id = GET_HEADER_FIELD(AVTP_RVF_FIELD_STREAM_ID);
+    header->avtp_timestamp = GET_HEADER_FIELD(AVTP_RVF_FIELD_AVTP_TIMESTAMP);
+    header->active_pixels = GET_HEADER_FIELD(AVTP_RVF_FIELD_ACTIVE_PIXELS);
+    header->total_lines = GET_HEADER_FIELD(AVTP_RVF_FIELD_TOTAL_LINES);
+    header->stream_data_length = GET_HEADER_FIELD(AVTP_RVF_FIELD_STREAM_DATA_LENGTH);
+    header->ap = GET_HEADER_FIELD(AVTP_RVF_FIELD_AP);
+    header->f = GET_HEADER_FIELD(AVTP_RVF_FIELD_F);
+    header->ef = GET_HEADER_FIELD(AVTP_RVF_FIELD_EF);
+    header->evt = GET_HEADER_FIELD(AVTP_RVF_FIELD_EVT);
+    header->pd = GET_HEADER_FIELD(AVTP_RVF_FIELD_PD);
+    header->i = GET_HEADER_FIELD(AVTP_RVF_FIELD_I);
+    header->pixel_depth = GET_HEADER_FIELD(AVTP_RVF_FIELD_PIXEL_DEPTH);
+    header->pixel_format = GET_HEADER_FIELD(AVTP_RVF_FIELD_PIXEL_FORMAT);
+    header->frame_rate = GET_HEADER_FIELD(AVTP_RVF_FIELD_FRAME_RATE);
+    header->colorspace = GET_HEADER_FIELD(AVTP_RVF_FIELD_COLORSPACE);
+    header->num_lines = GET_HEADER_FIELD(AVTP_RVF_FIELD_NUM_LINES);
+    header->i_seq_num = GET_HEADER_FIELD(AVTP_RVF_FIELD_I_SEQ_NUM);
+    header->line_number = GET_HEADER_FIELD(AVTP_RVF_FIELD_LINE_NUMBER);
+}
+
+int Avtp_Rvf_InitTemplate(Avtp_StreamTemplate_t* tmpl, const Avtp_Rvf_t* const pdu)
+{
+    return Avtp_StreamTemplate_Init(tmpl, (const uint8_t*)pdu, AVTP_RVF_HEADER_LEN,
+            &Avtp_RvfFieldDesc[AVTP_RVF_FIELD_SEQUENCE_NUM], &Avtp_RvfFieldDesc[AVTP_RVF_FIELD_AVTP_TIMESTAMP],
+            &Avtp_RvfFieldDesc[AVTP_RVF_FIELD_STREAM_DATA_LENGTH]);
+}
+
 void Avtp_Rvf_SetField(Avtp_Rvf_t* pdu, Avtp_RvfField_t field, uint64_t value)
 {
     SET_FIELD(field, value);
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2025, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifdef LINUX_KERNEL1722
+#include <linux/string.h>
+#else
+#include <string.h>
+#endif
+
+#include "avtp/SeqTracker.h"
+
+void Avtp_SeqTracker_Init(Avtp_SeqTracker_t* tracker)
+{
+    memset(tracker, 0, sizeof(*tracker));
+}
+
+/*
+ * Classifies a sequence number of the given width. Distances of less than
+ * half the sequence number space are ahead of the highest sequence number,
+ * all others behind it.
+ */
+static Avtp_SeqResult_t Update(Avtp_SeqTracker_t* tracker, uint32_t seqNum,
+        uint32_t mask)
+{
+    uint32_t ahead = (seqNum - tracker->highest) & mask;
+    uint32_t behind = (tracker->highest - seqNum) & mask;
+    uint64_t bit;
+
+    if (tracker->span == 0) {
+        tracker->span = 1;
+        tracker->highest = seqNum;
+        tracker->window = 1;
+        tracker->stats.received++;
+        return AVTP_SEQ_IN_ORDER;
+    }
+
+    // Far behind the highest sequence number the talker most likely
+    // restarted, which would otherwise make all further PDUs late
+    if (ahead > mask / 2 && behind > AVTP_SEQ_TRACKER_RESYNC) {
+        tracker->span = 1;
+        tracker->highest = seqNum;
+        tracker->window = 1;
+        tracker->stats.received++;
+        tracker->stats.resyncs++;
+        return AVTP_SEQ_RESYNC;
+    }
+
+    if (ahead == 0) {
+        tracker->stats.duplicates++;
+        return AVTP_SEQ_DUPLICATE;
+    }
+
+    if (ahead <= mask / 2) {
+        tracker->highest = seqNum;
+        tracker->window = ahead < AVTP_SEQ_TRACKER_WINDOW ?
+                (tracker->window << ahead) | 1 : 1;
+        tracker->span = ahead < AVTP_SEQ_TRACKER_WINDOW - tracker->span ?
+                tracker->span + ahead : AVTP_SEQ_TRACKER_WINDOW;
+        tracker->stats.received++;
+        tracker->stats.lost += ahead - 1;
+        return ahead == 1 ? AVTP_SEQ_IN_ORDER : AVTP_SEQ_GAP;
+    }
+
+    // Sequence numbers before the first PDU were never counted as lost
+    if (behind >= tracker->span) {
+        tracker->stats.late++;
+        return AVTP_SEQ_LATE;
+    }
+
+    bit = (uint64_t)1 << behind;
+    if (tracker->window & bit) {
+        tracker->stats.duplicates++;
+        return AVTP_SEQ_DUPLICATE;
+    }
+
+    // The sequence number was counted as lost when it was skipped
+    tracker->window |= bit;
+    tracker->stats.received++;
+    tracker->stats.reordered++;
+    tracker->stats.lost--;
+    return AVTP_SEQ_REORDERED;
+}
+
+Avtp_SeqResult_t Avtp_SeqTracker_Update(Avtp_SeqTracker_t* tracker,
+        uint8_t seqNum)
+{
+    return Update(tracker, seqNum, 0xFF);
+}
+
+Avtp_SeqResult_t Avtp_SeqTracker_UpdateUdp(Avtp_SeqTracker_t* tracker,
+        uint32_t seqNum)
+{
+    return Update(tracker, seqNum, 0xFFFFFFFF);
+}
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2025, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifdef LINUX_KERNEL1722
+#include <linux/errno.h>
+#include <linux/string.h>
+#else
+#include <errno.h>
+#include <stddef.h>
+#include <string.h>
+#endif
+
+#include "avtp/StreamTable.h"
+
+int Avtp_StreamTable_Init(Avtp_StreamTable_t* table, uint8_t* tags,
+        Avtp_StreamEntry_t* entries, uint32_t numSlots)
+{
+    if (table == NULL || tags == NULL || entries == NULL || numSlots < 2 ||
+            (numSlots & (numSlots - 1)) != 0) {
+        return -EINVAL;
+    }
+
+    memset(tags, AVTP_STREAM_TABLE_EMPTY, numSlots);
+    table->tags = tags;
+    table->entries = entries;
+    table->mask = numSlots - 1;
+    table->count = 0;
+
+    return 0;
+}
+
+Avtp_StreamEntry_t* Avtp_StreamTable_Add(Avtp_StreamTable_t* table,
+        uint64_t streamId)
+{
+    uint64_t hash = Avtp_StreamTable_Hash(streamId);
+    uint8_t tag = Avtp_StreamTable_Tag(hash);
+    uint32_t slot = (uint32_t)hash & table->mask;
+    Avtp_StreamEntry_t* entry;
+
+    while (table->tags[slot] != AVTP_STREAM_TABLE_EMPTY) {
+        if (table->tags[slot] == tag &&
+                table->entries[slot].streamId == streamId) {
+            return &table->entries[slot];
+        }
+        slot = (slot + 1) & table->mask;
+    }
+
+    if (table->count == Avtp_StreamTable_MaxStreams(table->mask + 1)) {
+        return NULL;
+    }
+
+    entry = &table->entries[slot];
+    memset(entry, 0, sizeof(*entry));
+    entry->streamId = streamId;
+    table->tags[slot] = tag;
+    table->count++;
+
+    return entry;
+}
+
+int Avtp_StreamTable_Remove(Avtp_StreamTable_t* table, uint64_t streamId)
+{
+    Avtp_StreamEntry_t* entry = Avtp_StreamTable_Find(table, streamId);
+    uint32_t hole, slot, home;
+
+    if (entry == NULL) {
+        return -ENOENT;
+    }
+
+    // Shift the following entries of the cluster back into the hole, unless
+    // that moves them before their home slot. No tombstones are needed then.
+    hole = entry - table->entries;
+    slot = hole;
+    for (;;) {
+        slot = (slot + 1) & table->mask;
+        if (table->tags[slot] == AVTP_STREAM_TABLE_EMPTY) {
+            break;
+        }
+        home = (uint32_t)Avtp_StreamTable_Hash(table->entries[slot].streamId)
+                & table->mask;
+        if (((slot - home) & table->mask) >= ((slot - hole) & table->mask)) {
+            table->entries[hole] = table->entries[slot];
+            table->tags[hole] = table->tags[slot];
+            hole = slot;
+        }
+    }
+    table->tags[hole] = AVTP_STREAM_TABLE_EMPTY;
+    table->count--;
+
+    return 0;
+}
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2025, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifdef LINUX_KERNEL1722
+#include <linux/errno.h>
+#include <linux/string.h>
+#else
+#include <errno.h>
+#include <stddef.h>
+#include <string.h>
+#endif
+
+#include "avtp/StreamTemplate.h"
+#include "avtp/Utils.h"
+
+static int InitTemplateField(Avtp_TemplateField_t* field,
+        const Avtp_FieldDescriptor_t* const desc, uint16_t len)
+{
+    uint8_t end;
+
+    memset(field, 0, sizeof(*field));
+    if (desc == NULL || desc->bits == 0) {
+        return 0;
+    }
+
+    end = desc->offset + desc->bits;
+    if (end > 32 || (desc->quadlet + 1) * AVTP_QUADLET_SIZE > len) {
+        return -EINVAL;
+    }
+
+    field->offset = desc->quadlet * AVTP_QUADLET_SIZE;
+    field->shift = 32 - end;
+    field->mask = Avtp_CpuToBe32((uint32_t)Avtp_FieldMask(desc->bits) << field->shift);
+
+    return 0;
+}
+
+int Avtp_StreamTemplate_Init(Avtp_StreamTemplate_t* tmpl,
+        const uint8_t* const header, uint16_t len,
+        const Avtp_FieldDescriptor_t* const sequenceNum,
+        const Avtp_FieldDescriptor_t* const timestamp,
+        const Avtp_FieldDescriptor_t* const length)
+{
+    int res;
+
+    if (tmpl == NULL || header == NULL || len > AVTP_STREAM_TEMPLATE_MAX_LEN) {
+        return -EINVAL;
+    }
+
+    memset(tmpl, 0, sizeof(*tmpl));
+    memcpy(tmpl->header, header, len);
+    tmpl->len = len;
+
+    res = InitTemplateField(&tmpl->sequenceNum, sequenceNum, len);
+    if (res < 0) {
+        return res;
+    }
+
+    res = InitTemplateField(&tmpl->timestamp, timestamp, len);
+    if (res < 0) {
+        return res;
+    }
+
+    return InitTemplateField(&tmpl->length, length, len);
+}
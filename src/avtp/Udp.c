@@ -34,9 +34,9 @@
 #include "avtp/Defines.h"
 
 #define GET_FIELD(field) \
-        (Avtp_GetField(Avtp_UdpFieldDesc, AVTP_UDP_FIELD_MAX, (uint8_t*)pdu, field))
+        (Avtp_GetFieldInline(Avtp_UdpFieldDesc, AVTP_UDP_FIELD_MAX, (uint8_t*)pdu, field))
 #define SET_FIELD(field, value) \
-        (Avtp_SetField(Avtp_UdpFieldDesc, AVTP_UDP_FIELD_MAX, (uint8_t*)pdu, field, value))
+        (Avtp_SetFieldInline(Avtp_UdpFieldDesc, AVTP_UDP_FIELD_MAX, (uint8_t*)pdu, field, value))
 
 /**
  * This table maps all IEEE 1722 UDP-specific header fields to a descriptor.
@@ -29,9 +29,11 @@
 
 #ifdef LINUX_KERNEL1722
 #include <linux/errno.h>
+#include <linux/string.h>
 #else
 #include <errno.h>
 #include <stddef.h>
+#include <string.h>
 #endif
 
 
@@ -42,6 +44,12 @@
 #define MAX(x, y) (((x) > (y)) ? (x) : (y))
 #define MIN(x, y) (((x) < (y)) ? (x) : (y))
 
+/**
+ * Number of quadlets Avtp_SetFields() caches. This covers the headers of all
+ * formats. If the fields span more quadlets they are written one by one.
+ */
+#define SET_FIELDS_MAX_QUADLETS 16
+
 static int IsFieldDescriptorValid(const Avtp_FieldDescriptor_t* const fieldDescriptor)
 {
     return fieldDescriptor->bits <= 64 && fieldDescriptor->offset <= 31;
@@ -67,8 +75,7 @@ uint64_t Avtp_GetField(const Avtp_FieldDescriptor_t* fieldDescriptors,
                 quadletShift = 32 - quadletBits;
             }
             uint32_t quadletMask = ((1ULL << quadletBits) - 1ULL) << quadletShift;
-            const uint32_t* quadletPtr = (const uint32_t*)(pdu + quadletId * 4);
-            uint32_t quadletHostOrder = Avtp_BeToCpu32(*quadletPtr);
+            uint32_t quadletHostOrder = Avtp_LoadBe32(pdu + quadletId * 4);
             uint32_t partialValue = (quadletHostOrder & quadletMask) >> quadletShift;
             result |= (uint64_t)(partialValue) << (fieldDescriptor->bits - processedBits - quadletBits);
 
@@ -99,13 +106,59 @@ void Avtp_SetField(const Avtp_FieldDescriptor_t* fieldDescriptors,
             }
             uint32_t partialValue = value >> (fieldDescriptor->bits - processedBits - quadletBits);
             uint32_t quadletMask = ((1ULL << quadletBits) - 1ULL) << quadletShift;
-            uint32_t* quadletPtr = (uint32_t*)(pdu + quadletId * 4);
-            uint32_t quadletHostOrder = Avtp_BeToCpu32(*quadletPtr);
+            uint32_t quadletHostOrder = Avtp_LoadBe32(pdu + quadletId * 4);
             quadletHostOrder = (quadletHostOrder & ~quadletMask) | ((partialValue << quadletShift) & quadletMask);
-            *quadletPtr = Avtp_CpuToBe32(quadletHostOrder);
+            Avtp_StoreBe32(pdu + quadletId * 4, quadletHostOrder);
 
             quadletOffset += 1;
             processedBits += quadletBits;
         }
     }
 }
+
+void Avtp_SetFields(const Avtp_FieldDescriptor_t* fieldDescriptors,
+        uint8_t numFields, uint8_t* pdu, const Avtp_FieldValue_t* values,
+        uint8_t numValues)
+{
+    uint32_t quadlets[SET_FIELDS_MAX_QUADLETS];
+    uint8_t firstQuadlet = 0xFF;
+    uint8_t lastQuadlet = 0;
+
+    if (fieldDescriptors == NULL || pdu == NULL || values == NULL) {
+        return;
+    }
+
+    // Determine the range of quadlets touched by the fields
+    for (uint8_t i = 0; i < numValues; i++) {
+        if (values[i].field < numFields && fieldDescriptors[values[i].field].bits > 0) {
+            const Avtp_FieldDescriptor_t* fieldDescriptor = &fieldDescriptors[values[i].field];
+            uint8_t fieldLastQuadlet = fieldDescriptor->quadlet +
+                    (fieldDescriptor->offset + fieldDescriptor->bits - 1) / 32;
+            firstQuadlet = MIN(firstQuadlet, fieldDescriptor->quadlet);
+            lastQuadlet = MAX(lastQuadlet, fieldLastQuadlet);
+        }
+    }
+    if (firstQuadlet > lastQuadlet) {
+        return;
+    }
+
+    // Fall back to single writes if the range does not fit into the cache
+    if (lastQuadlet - firstQuadlet + 1 > SET_FIELDS_MAX_QUADLETS) {
+        for (uint8_t i = 0; i < numValues; i++) {
+            Avtp_SetField(fieldDescriptors, numFields, pdu, values[i].field, values[i].value);
+        }
+        return;
+    }
+
+    uint8_t numQuadlets = lastQuadlet - firstQuadlet + 1;
+    uint8_t* firstQuadletPtr = pdu + firstQuadlet * AVTP_QUADLET_SIZE;
+    Avtp_LoadQuadlets(firstQuadletPtr, quadlets, numQuadlets);
+    for (uint8_t i = 0; i < numValues; i++) {
+        if (values[i].field < numFields) {
+            Avtp_FieldDescriptor_t fieldDescriptor = fieldDescriptors[values[i].field];
+            fieldDescriptor.quadlet -= firstQuadlet;
+            Avtp_SetFieldInQuadlets(quadlets, &fieldDescriptor, values[i].value);
+        }
+    }
+    Avtp_StoreQuadlets(firstQuadletPtr, quadlets, numQuadlets);
+}
@@ -36,9 +36,11 @@
 #include "avtp/Utils.h"
 
 #define GET_FIELD(field) \
-        (Avtp_GetField(Avtp_PcmFieldDesc, AVTP_PCM_FIELD_MAX, (uint8_t*)pdu, field))
+        (Avtp_GetFieldInline(Avtp_PcmFieldDesc, AVTP_PCM_FIELD_MAX, (uint8_t*)pdu, field))
 #define SET_FIELD(field, value) \
-        (Avtp_SetField(Avtp_PcmFieldDesc, AVTP_PCM_FIELD_MAX, (uint8_t*)pdu, field, value))
+        (Avtp_SetFieldInline(Avtp_PcmFieldDesc, AVTP_PCM_FIELD_MAX, (uint8_t*)pdu, field, value))
+#define GET_HEADER_FIELD(field) \
+        (Avtp_GetFieldFromQuadlets(quadlets, &Avtp_PcmFieldDesc[field]))
 
 static const Avtp_FieldDescriptor_t Avtp_PcmFieldDesc[AVTP_PCM_FIELD_MAX] =
 {
@@ -154,6 +156,40 @@ uint8_t Avtp_Pcm_GetEvt(const Avtp_Pcm_t* const pdu)
     return GET_FIELD(AVTP_PCM_FIELD_EVT);
 }
 
+void Avtp_Pcm_Unpack(const Avtp_Pcm_t* const pdu, Avtp_PcmHeader_t* header)
+{
+    uint32_t quadlets[AVTP_PCM_HEADER_LEN / AVTP_QUADLET_SIZE];
+
+    if (pdu == NULL || header == NULL) {
+        return;
+    }
+
+    Avtp_LoadQuadlets((const uint8_t*)pdu, quadlets, AVTP_PCM_HEADER_LEN / AVTP_QUADLET_SIZE);
+    header->subtype = GET_HEADER_FIELD(AVTP_PCM_FIELD_SUBTYPE);
+    header->sv = GET_HEADER_FIELD(AVTP_PCM_FIELD_SV);
+    header->version = GET_HEADER_FIELD(AVTP_PCM_FIELD_VERSION);
+    header->mr = GET_HEADER_FIELD(AVTP_PCM_FIELD_MR);
+    header->tv = GET_HEADER_FIELD(AVTP_PCM_FIELD_TV);
+    header->sequence_num = GET_HEADER_FIELD(AVTP_PCM_FIELD_SEQUENCE_NUM);
+    header->tu = GET_HEADER_FIELD(AVTP_PCM_FIELD_TU);
+    header->stream_id = GET_HEADER_FIELD(AVTP_PCM_FIELD_STREAM_ID);
+    header->avtp_timestamp = GET_HEADER_FIELD(AVTP_PCM_FIELD_AVTP_TIMESTAMP);
+    header->format = GET_HEADER_FIELD(AVTP_PCM_FIELD_FORMAT);
+    header->nsr = GET_HEADER_FIELD(AVTP_PCM_FIELD_NSR);
+    header->channels_per_frame = GET_HEADER_FIELD(AVTP_PCM_FIELD_CHANNELS_PER_FRAME);
+    header->bit_depth = GET_HEADER_FIELD(AVTP_PCM_FIELD_BIT_DEPTH);
+    header->stream_data_length = GET_HEADER_FIELD(AVTP_PCM_FIELD_STREAM_DATA_LENGTH);
+    header->sp = GET_HEADER_FIELD(AVTP_PCM_FIELD_SP);
+    header->evt = GET_HEADER_FIELD(AVTP_PCM_FIELD_EVT);
+}
+
+int Avtp_Pcm_InitTemplate(Avtp_StreamTemplate_t* tmpl, const Avtp_Pcm_t* const pdu)
+{
+    return Avtp_StreamTemplate_Init(tmpl, (const uint8_t*)pdu, AVTP_PCM_HEADER_LEN,
+            &Avtp_PcmFieldDesc[AVTP_PCM_FIELD_SEQUENCE_NUM], &Avtp_PcmFieldDesc[AVTP_PCM_FIELD_AVTP_TIMESTAMP],
+            &Avtp_PcmFieldDesc[AVTP_PCM_FIELD_STREAM_DATA_LENGTH]);
+}
+
 void Avtp_Pcm_SetField(Avtp_Pcm_t* pdu, Avtp_PcmFields_t field, uint64_t value)
 {
     SET_FIELD(field, value);
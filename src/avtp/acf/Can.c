@@ -39,9 +39,13 @@
 #include "avtp/Defines.h"
 
 #define GET_FIELD(field) \
-        (Avtp_GetField(Avtp_CanFieldDesc, AVTP_CAN_FIELD_MAX, (uint8_t*)pdu, field))
+        (Avtp_GetFieldInline(Avtp_CanFieldDesc, AVTP_CAN_FIELD_MAX, (uint8_t*)pdu, field))
 #define SET_FIELD(field, value) \
-        (Avtp_SetField(Avtp_CanFieldDesc, AVTP_CAN_FIELD_MAX, (uint8_t*)pdu, field, value))
+        (Avtp_SetFieldInline(Avtp_CanFieldDesc, AVTP_CAN_FIELD_MAX, (uint8_t*)pdu, field, value))
+#define SET_HEADER_FIELD(field, value) \
+        (Avtp_SetFieldInQuadlets(quadlets, &Avtp_CanFieldDesc[field], value))
+#define GET_HEADER_FIELD(field) \
+        (Avtp_GetFieldFromQuadlets(quadlets, &Avtp_CanFieldDesc[field]))
 
 /**
  * This table maps all IEEE 1722 ACF CAN header fields to a descriptor.
@@ -132,6 +136,29 @@ uint32_t Avtp_Can_GetCanIdentifier(const Avtp_Can_t* const pdu)
     return GET_FIELD(AVTP_CAN_FIELD_CAN_IDENTIFIER);
 }
 
+void Avtp_Can_Unpack(const Avtp_Can_t* const pdu, Avtp_CanHeader_t* header)
+{
+    uint32_t quadlets[AVTP_CAN_HEADER_LEN / AVTP_QUADLET_SIZE];
+
+    if (pdu == NULL || header == NULL) {
+        return;
+    }
+
+    Avtp_LoadQuadlets((const uint8_t*)pdu, quadlets, AVTP_CAN_HEADER_LEN / AVTP_QUADLET_SIZE);
+    header->acf_msg_type = GET_HEADER_FIELD(AVTP_CAN_FIELD_ACF_MSG_TYPE);
+    header->acf_msg_length = GET_HEADER_FIELD(AVTP_CAN_FIELD_ACF_MSG_LENGTH);
+    header->pad = GET_HEADER_FIELD(AVTP_CAN_FIELD_PAD);
+    header->mtv = GET_HEADER_FIELD(AVTP_CAN_FIELD_MTV);
+    header->rtr = GET_HEADER_FIELD(AVTP_CAN_FIELD_RTR);
+    header->eff = GET_HEADER_FIELD(AVTP_CAN_FIELD_EFF);
+    header->brs = GET_HEADER_FIELD(AVTP_CAN_FIELD_BRS);
+    header->fdf = GET_HEADER_FIELD(AVTP_CAN_FIELD_FDF);
+    header->esi = GET_HEADER_FIELD(AVTP_CAN_FIELD_ESI);
+    header->can_bus_id = GET_HEADER_FIELD(AVTP_CAN_FIELD_CAN_BUS_ID);
+    header->message_timestamp = GET_HEADER_FIELD(AVTP_CAN_FIELD_MESSAGE_TIMESTAMP);
+    header->can_identifier = GET_HEADER_FIELD(AVTP_CAN_FIELD_CAN_IDENTIFIER);
+}
+
 /*
 void Avtp_Can_SetField(Avtp_Can_t* pdu, Avtp_CanFields_t field, uint64_t value)
 {
@@ -228,6 +255,30 @@ void Avtp_Can_SetCanIdentifier(Avtp_Can_t* pdu, uint32_t value)
     SET_FIELD(AVTP_CAN_FIELD_CAN_IDENTIFIER, value);
 }
 
+void Avtp_Can_SetHeader(Avtp_Can_t* pdu, const Avtp_CanHeader_t* const header)
+{
+    uint32_t quadlets[AVTP_CAN_HEADER_LEN / AVTP_QUADLET_SIZE];
+
+    if (pdu == NULL || header == NULL) {
+        return;
+    }
+
+    Avtp_LoadQuadlets((uint8_t*)pdu, quadlets, AVTP_CAN_HEADER_LEN / AVTP_QUADLET_SIZE);
+    SET_HEADER_FIELD(AVTP_CAN_FIELD_ACF_MSG_TYPE,      header->acf_msg_type);
+    SET_HEADER_FIELD(AVTP_CAN_FIELD_ACF_MSG_LENGTH,    header->acf_msg_length);
+    SET_HEADER_FIELD(AVTP_CAN_FIELD_PAD,               header->pad);
+    SET_HEADER_FIELD(AVTP_CAN_FIELD_MTV,               header->mtv);
+    SET_HEADER_FIELD(AVTP_CAN_FIELD_RTR,               header->rtr);
+    SET_HEADER_FIELD(AVTP_CAN_FIELD_EFF,               header->eff);
+    SET_HEADER_FIELD(AVTP_CAN_FIELD_BRS,               header->brs);
+    SET_HEADER_FIELD(AVTP_CAN_FIELD_FDF,               header->fdf);
+    SET_HEADER_FIELD(AVTP_CAN_FIELD_ESI,               header->esi);
+    SET_HEADER_FIELD(AVTP_CAN_FIELD_CAN_BUS_ID,        header->can_bus_id);
+    SET_HEADER_FIELD(AVTP_CAN_FIELD_MESSAGE_TIMESTAMP, header->message_timestamp);
+    SET_HEADER_FIELD(AVTP_CAN_FIELD_CAN_IDENTIFIER,    header->can_identifier);
+    Avtp_StoreQuadlets((uint8_t*)pdu, quadlets, AVTP_CAN_HEADER_LEN / AVTP_QUADLET_SIZE);
+}
+
 void Avtp_Can_CreateAcfMessage(Avtp_Can_t* pdu, uint32_t frame_id, uint8_t* payload,
                         uint16_t payload_length, Avtp_CanVariant_t can_variant)
 {
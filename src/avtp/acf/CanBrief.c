@@ -27,17 +27,26 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+#ifdef LINUX_KERNEL1722
+#include <linux/errno.h>
+#include <linux/string.h>
+#else
 #include <errno.h>
 #include <string.h>
+#endif
 
 #include "avtp/acf/CanBrief.h"
 #include "avtp/Utils.h"
 #include "avtp/Defines.h"
 
 #define GET_FIELD(field) \
-        (Avtp_GetField(Avtp_CanBriefFieldDesc, AVTP_CAN_BRIEF_FIELD_MAX, (uint8_t*)pdu, field))
+        (Avtp_GetFieldInline(Avtp_CanBriefFieldDesc, AVTP_CAN_BRIEF_FIELD_MAX, (uint8_t*)pdu, field))
 #define SET_FIELD(field, value) \
-        (Avtp_SetField(Avtp_CanBriefFieldDesc, AVTP_CAN_BRIEF_FIELD_MAX, (uint8_t*)pdu, field, value))
+        (Avtp_SetFieldInline(Avtp_CanBriefFieldDesc, AVTP_CAN_BRIEF_FIELD_MAX, (uint8_t*)pdu, field, value))
+#define SET_HEADER_FIELD(field, value) \
+        (Avtp_SetFieldInQuadlets(quadlets, &Avtp_CanBriefFieldDesc[field], value))
+#define GET_HEADER_FIELD(field) \
+        (Avtp_GetFieldFromQuadlets(quadlets, &Avtp_CanBriefFieldDesc[field]))
 
 /**
  * This table maps all IEEE 1722 ACF Abbreviated CAN header fields to a descriptor.
@@ -127,6 +136,51 @@ uint32_t Avtp_CanBrief_GetCanIdentifier(const Avtp_CanBrief_t* const pdu)
     return GET_FIELD(AVTP_CAN_BRIEF_FIELD_CAN_IDENTIFIER);
 }
 
+void Avtp_CanBrief_Unpack(const Avtp_CanBrief_t* const pdu, Avtp_CanBriefHeader_t* header)
+{
+    uint32_t quadlets[AVTP_CAN_BRIEF_HEADER_LEN / AVTP_QUADLET_SIZE];
+
+    if (pdu == NULL || header == NULL) {
+        return;
+    }
+
+    Avtp_LoadQuadlets((const uint8_t*)pdu, quadlets, AVTP_CAN_BRIEF_HEADER_LEN / AVTP_QUADLET_SIZE);
+    header->acf_msg_type = GET_HEADER_FIELD(AVTP_CAN_BRIEF_FIELD_ACF_MSG_TYPE);
+    header->acf_msg_length = GET_HEADER_FIELD(AVTP_CAN_BRIEF_FIELD_ACF_MSG_LENGTH);
+    header->pad = GET_HEADER_FIELD(AVTP_CAN_BRIEF_FIELD_PAD);
+    header->mtv = GET_HEADER_FIELD(AVTP_CAN_BRIEF_FIELD_MTV);
+    header->rtr = GET_HEADER_FIELD(AVTP_CAN_BRIEF_FIELD_RTR);
+    header->eff = GET_HEADER_FIELD(AVTP_CAN_BRIEF_FIELD_EFF);
+    header->brs = GET_HEADER_FIELD(AVTP_CAN_BRIEF_FIELD_BRS);
+    header->fdf = GET_HEADER_FIELD(AVTP_CAN_BRIEF_FIELD_FDF);
+    header->esi = GET_HEADER_FIELD(AVTP_CAN_BRIEF_FIELD_ESI);
+    header->can_bus_id = GET_HEADER_FIELD(AVTP_CAN_BRIEF_FIELD_CAN_BUS_ID);
+    header->can_identifier = GET_HEADER_FIELD(AVTP_CAN_BRIEF_FIELD_CAN_IDENTIFIER);
+}
+
+void Avtp_CanBrief_SetHeader(Avtp_CanBrief_t* pdu, const Avtp_CanBriefHeader_t* const header)
+{
+    uint32_t quadlets[AVTP_CAN_BRIEF_HEADER_LEN / AVTP_QUADLET_SIZE];
+
+    if (pdu == NULL || header == NULL) {
+        return;
+    }
+
+    Avtp_LoadQuadlets((uint8_t*)pdu, quadlets, AVTP_CAN_BRIEF_HEADER_LEN / AVTP_QUADLET_SIZE);
+    SET_HEADER_FIELD(AVTP_CAN_BRIEF_FIELD_ACF_MSG_TYPE,   header->acf_msg_type);
+    SET_HEADER_FIELD(AVTP_CAN_BRIEF_FIELD_ACF_MSG_LENGTH, header->acf_msg_length);
+    SET_HEADER_FIELD(AVTP_CAN_BRIEF_FIELD_PAD,            header->pad);
+    SET_HEADER_FIELD(AVTP_CAN_BRIEF_FIELD_MTV,            header->mtv);
+    SET_HEADER_FIELD(AVTP_CAN_BRIEF_FIELD_RTR,            header->rtr);
+    SET_HEADER_FIELD(AVTP_CAN_BRIEF_FIELD_EFF,            header->eff);
+    SET_HEADER_FIELD(AVTP_CAN_BRIEF_FIELD_BRS,            header->brs);
+    SET_HEADER_FIELD(AVTP_CAN_BRIEF_FIELD_FDF,            header->fdf);
+    SET_HEADER_FIELD(AVTP_CAN_BRIEF_FIELD_ESI,            header->esi);
+    SET_HEADER_FIELD(AVTP_CAN_BRIEF_FIELD_CAN_BUS_ID,     header->can_bus_id);
+    SET_HEADER_FIELD(AVTP_CAN_BRIEF_FIELD_CAN_IDENTIFIER, header->can_identifier);
+    Avtp_StoreQuadlets((uint8_t*)pdu, quadlets, AVTP_CAN_BRIEF_HEADER_LEN / AVTP_QUADLET_SIZE);
+}
+
 void Avtp_CanBrief_SetField(Avtp_CanBrief_t* pdu, Avtp_CanBriefFields_t field, uint64_t value)
 {
     SET_FIELD(field, value);
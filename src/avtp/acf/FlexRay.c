@@ -34,9 +34,9 @@
 #include "avtp/Utils.h"
 
 #define GET_FIELD(field) \
-    (Avtp_GetField(Avtp_FlexRayFieldDesc, AVTP_FLEXRAY_FIELD_MAX, (uint8_t *)pdu, field))
+    (Avtp_GetFieldInline(Avtp_FlexRayFieldDesc, AVTP_FLEXRAY_FIELD_MAX, (uint8_t *)pdu, field))
 #define SET_FIELD(field, value) \
-    (Avtp_SetField(Avtp_FlexRayFieldDesc, AVTP_FLEXRAY_FIELD_MAX, (uint8_t *)pdu, field, value))
+    (Avtp_SetFieldInline(Avtp_FlexRayFieldDesc, AVTP_FLEXRAY_FIELD_MAX, (uint8_t *)pdu, field, value))
 
 /**
  * This table describes all the offsets of the ACF FlexRay header fields.
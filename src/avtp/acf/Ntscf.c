@@ -41,9 +41,13 @@
 #include "avtp/CommonHeader.h"
 
 #define GET_FIELD(field) \
-        (Avtp_GetField(Avtp_NtscfFieldDesc, AVTP_NTSCF_FIELD_MAX, (uint8_t*)pdu, field))
+        (Avtp_GetFieldInline(Avtp_NtscfFieldDesc, AVTP_NTSCF_FIELD_MAX, (uint8_t*)pdu, field))
 #define SET_FIELD(field, value) \
-        (Avtp_SetField(Avtp_NtscfFieldDesc, AVTP_NTSCF_FIELD_MAX, (uint8_t*)pdu, field, value))
+        (Avtp_SetFieldInline(Avtp_NtscfFieldDesc, AVTP_NTSCF_FIELD_MAX, (uint8_t*)pdu, field, value))
+#define SET_HEADER_FIELD(field, value) \
+        (Avtp_SetFieldInQuadlets(quadlets, &Avtp_NtscfFieldDesc[field], value))
+#define GET_HEADER_FIELD(field) \
+        (Avtp_GetFieldFromQuadlets(quadlets, &Avtp_NtscfFieldDesc[field]))
 
 /**
  * This table maps all IEEE 1722 NTSCF-specific header fields to a descriptor.
@@ -104,6 +108,30 @@ uint64_t Avtp_Ntscf_GetStreamId(const Avtp_Ntscf_t* const pdu)
     return GET_FIELD(AVTP_NTSCF_FIELD_STREAM_ID);
 }
 
+void Avtp_Ntscf_Unpack(const Avtp_Ntscf_t* const pdu, Avtp_NtscfHeader_t* header)
+{
+    uint32_t quadlets[AVTP_NTSCF_HEADER_LEN / AVTP_QUADLET_SIZE];
+
+    if (pdu == NULL || header == NULL) {
+        return;
+    }
+
+    Avtp_LoadQuadlets((const uint8_t*)pdu, quadlets, AVTP_NTSCF_HEADER_LEN / AVTP_QUADLET_SIZE);
+    header->subtype = GET_HEADER_FIELD(AVTP_NTSCF_FIELD_SUBTYPE);
+    header->sv = GET_HEADER_FIELD(AVTP_NTSCF_FIELD_SV);
+    header->version = GET_HEADER_FIELD(AVTP_NTSCF_FIELD_VERSION);
+    header->ntscf_data_length = GET_HEADER_FIELD(AVTP_NTSCF_FIELD_NTSCF_DATA_LENGTH);
+    header->sequence_num = GET_HEADER_FIELD(AVTP_NTSCF_FIELD_SEQUENCE_NUM);
+    header->stream_id = GET_HEADER_FIELD(AVTP_NTSCF_FIELD_STREAM_ID);
+}
+
+int Avtp_Ntscf_InitTemplate(Avtp_StreamTemplate_t* tmpl, const Avtp_Ntscf_t* const pdu)
+{
+    return Avtp_StreamTemplate_Init(tmpl, (const uint8_t*)pdu, AVTP_NTSCF_HEADER_LEN,
+            &Avtp_NtscfFieldDesc[AVTP_NTSCF_FIELD_SEQUENCE_NUM], NULL,
+            &Avtp_NtscfFieldDesc[AVTP_NTSCF_FIELD_NTSCF_DATA_LENGTH]);
+}
+
 void Avtp_Ntscf_SetField(Avtp_Ntscf_t* pdu, Avtp_NtscfFields_t field, uint64_t value)
 {
     SET_FIELD(field, value);
@@ -144,6 +172,24 @@ void Avtp_Ntscf_SetStreamId(Avtp_Ntscf_t* pdu, uint64_t value)
     SET_FIELD(AVTP_NTSCF_FIELD_STREAM_ID, value);
 }
 
+void Avtp_Ntscf_SetHeader(Avtp_Ntscf_t* pdu, const Avtp_NtscfHeader_t* const header)
+{
+    uint32_t quadlets[AVTP_NTSCF_HEADER_LEN / AVTP_QUADLET_SIZE];
+
+    if (pdu == NULL || header == NULL) {
+        return;
+    }
+
+    Avtp_LoadQuadlets((uint8_t*)pdu, quadlets, AVTP_NTSCF_HEADER_LEN / AVTP_QUADLET_SIZE);
+    SET_HEADER_FIELD(AVTP_NTSCF_FIELD_SUBTYPE,           header->subtype);
+    SET_HEADER_FIELD(AVTP_NTSCF_FIELD_SV,                header->sv);
+    SET_HEADER_FIELD(AVTP_NTSCF_FIELD_VERSION,           header->version);
+    SET_HEADER_FIELD(AVTP_NTSCF_FIELD_NTSCF_DATA_LENGTH, header->ntscf_data_length);
+    SET_HEADER_FIELD(AVTP_NTSCF_FIELD_SEQUENCE_NUM,      header->sequence_num);
+    SET_HEADER_FIELD(AVTP_NTSCF_FIELD_STREAM_ID,         header->stream_id);
+    Avtp_StoreQuadlets((uint8_t*)pdu, quadlets, AVTP_NTSCF_HEADER_LEN / AVTP_QUADLET_SIZE);
+}
+
 uint8_t Avtp_Ntscf_IsValid(const Avtp_Ntscf_t* const pdu, size_t bufferSize)
 {
     if (pdu == NULL) {
@@ -41,9 +41,13 @@
 #include "avtp/CommonHeader.h"
 
 #define GET_FIELD(field) \
-        (Avtp_GetField(Avtp_TscfFieldDesc, AVTP_TSCF_FIELD_MAX, (uint8_t*)pdu, field))
+        (Avtp_GetFieldInline(Avtp_TscfFieldDesc, AVTP_TSCF_FIELD_MAX, (uint8_t*)pdu, field))
 #define SET_FIELD(field, value) \
-        (Avtp_SetField(Avtp_TscfFieldDesc, AVTP_TSCF_FIELD_MAX, (uint8_t*)pdu, field, value))
+        (Avtp_SetFieldInline(Avtp_TscfFieldDesc, AVTP_TSCF_FIELD_MAX, (uint8_t*)pdu, field, value))
+#define SET_HEADER_FIELD(field, value) \
+        (Avtp_SetFieldInQuadlets(quadlets, &Avtp_TscfFieldDesc[field], value))
+#define GET_HEADER_FIELD(field) \
+        (Avtp_GetFieldFromQuadlets(quadlets, &Avtp_TscfFieldDesc[field]))
 
 /**
  * This table maps all IEEE 1722 TSCF-specific header fields to a descriptor.
@@ -128,6 +132,34 @@ uint16_t Avtp_Tscf_GetStreamDataLength(const Avtp_Tscf_t* const pdu)
     return GET_FIELD(AVTP_TSCF_FIELD_STREAM_DATA_LENGTH);
 }
 
+void Avtp_Tscf_Unpack(const Avtp_Tscf_t* const pdu, Avtp_TscfHeader_t* header)
+{
+    uint32_t quadlets[AVTP_TSCF_HEADER_LEN / AVTP_QUADLET_SIZE];
+
+    if (pdu == NULL || header == NULL) {
+        return;
+    }
+
+    Avtp_LoadQuadlets((const uint8_t*)pdu, quadlets, AVTP_TSCF_HEADER_LEN / AVTP_QUADLET_SIZE);
+    header->subtype = GET_HEADER_FIELD(AVTP_TSCF_FIELD_SUBTYPE);
+    header->sv = GET_HEADER_FIELD(AVTP_TSCF_FIELD_SV);
+    header->version = GET_HEADER_FIELD(AVTP_TSCF_FIELD_VERSION);
+    header->mr = GET_HEADER_FIELD(AVTP_TSCF_FIELD_MR);
+    header->tv = GET_HEADER_FIELD(AVTP_TSCF_FIELD_TV);
+    header->sequence_num = GET_HEADER_FIELD(AVTP_TSCF_FIELD_SEQUENCE_NUM);
+    header->tu = GET_HEADER_FIELD(AVTP_TSCF_FIELD_TU);
+    header->stream_id = GET_HEADER_FIELD(AVTP_TSCF_FIELD_STREAM_ID);
+    header->avtp_timestamp = GET_HEADER_FIELD(AVTP_TSCF_FIELD_AVTP_TIMESTAMP);
+    header->stream_data_length = GET_HEADER_FIELD(AVTP_TSCF_FIELD_STREAM_DATA_LENGTH);
+}
+
+int Avtp_Tscf_InitTemplate(Avtp_StreamTemplate_t* tmpl, const Avtp_Tscf_t* const pdu)
+{
+    return Avtp_StreamTemplate_Init(tmpl, (const uint8_t*)pdu, AVTP_TSCF_HEADER_LEN,
+            &Avtp_TscfFieldDesc[AVTP_TSCF_FIELD_SEQUENCE_NUM], &Avtp_TscfFieldDesc[AVTP_TSCF_FIELD_AVTP_TIMESTAMP],
+            &Avtp_TscfFieldDesc[AVTP_TSCF_FIELD_STREAM_DATA_LENGTH]);
+}
+
 void Avtp_Tscf_SetField(Avtp_Tscf_t* pdu, Avtp_TscfFields_t field, uint64_t value)
 {
     SET_FIELD(field, value);
@@ -203,6 +235,28 @@ void Avtp_Tscf_SetStreamDataLength(Avtp_Tscf_t* pdu, uint16_t value)
     SET_FIELD(AVTP_TSCF_FIELD_STREAM_DATA_LENGTH, value);
 }
 
+void Avtp_Tscf_SetHeader(Avtp_Tscf_t* pdu, const Avtp_TscfHeader_t* const header)
+{
+    uint32_t quadlets[AVTP_TSCF_HEADER_LEN / AVTP_QUADLET_SIZE];
+
+    if (pdu == NULL || header == NULL) {
+        return;
+    }
+
+    Avtp_LoadQuadlets((uint8_t*)pdu, quadlets, AVTP_TSCF_HEADER_LEN / AVTP_QUADLET_SIZE);
+    SET_HEADER_FIELD(AVTP_TSCF_FIELD_SUBTYPE,            header->subtype);
+    SET_HEADER_FIELD(AVTP_TSCF_FIELD_SV,                 header->sv);
+    SET_HEADER_FIELD(AVTP_TSCF_FIELD_VERSION,            header->version);
+    SET_HEADER_FIELD(AVTP_TSCF_FIELD_MR,                 header->mr);
+    SET_HEADER_FIELD(AVTP_TSCF_FIELD_TV,                 header->tv);
+    SET_HEADER_FIELD(AVTP_TSCF_FIELD_SEQUENCE_NUM,       header->sequence_num);
+    SET_HEADER_FIELD(AVTP_TSCF_FIELD_TU,                 header->tu);
+    SET_HEADER_FIELD(AVTP_TSCF_FIELD_STREAM_ID,          header->stream_id);
+    SET_HEADER_FIELD(AVTP_TSCF_FIELD_AVTP_TIMESTAMP,     header->avtp_timestamp);
+    SET_HEADER_FIELD(AVTP_TSCF_FIELD_STREAM_DATA_LENGTH, header->stream_data_length);
+    Avtp_StoreQuadlets((uint8_t*)pdu, quadlets, AVTP_TSCF_HEADER_LEN / AVTP_QUADLET_SIZE);
+}
+
 uint8_t Avtp_Tscf_IsValid(const Avtp_Tscf_t* const pdu, size_t bufferSize)
 {
     if (pdu == NULL) {
@@ -35,9 +35,11 @@
 #include "avtp/CommonHeader.h"
 
 #define GET_FIELD(field) \
-        (Avtp_GetField(fieldDescriptors, AVTP_CVF_FIELD_MAX, (uint8_t*)pdu, field))
+        (Avtp_GetFieldInline(fieldDescriptors, AVTP_CVF_FIELD_MAX, (uint8_t*)pdu, field))
 #define SET_FIELD(field, value) \
-        (Avtp_SetField(fieldDescriptors, AVTP_CVF_FIELD_MAX, (uint8_t*)pdu, field, value))
+        (Avtp_SetFieldInline(fieldDescriptors, AVTP_CVF_FIELD_MAX, (uint8_t*)pdu, field, value))
+#define GET_HEADER_FIELD(field) \
+        (Avtp_GetFieldFromQuadlets(quadlets, &fieldDescriptors[field]))
 
 static const Avtp_FieldDescriptor_t fieldDescriptors[AVTP_CVF_FIELD_MAX] =
 {
@@ -153,6 +155,39 @@ uint8_t Avtp_Cvf_GetEvt(const Avtp_Cvf_t* const pdu)
     return GET_FIELD(AVTP_CVF_FIELD_EVT);
 }
 
+void Avtp_Cvf_Unpack(const Avtp_Cvf_t* const pdu, Avtp_CvfHeader_t* header)
+{
+    uint32_t quadlets[AVTP_CVF_HEADER_LEN / AVTP_QUADLET_SIZE];
+
+    if (pdu == NULL || header == NULL) {
+        return;
+    }
+
+    Avtp_LoadQuadlets((const uint8_t*)pdu, quadlets, AVTP_CVF_HEADER_LEN / AVTP_QUADLET_SIZE);
+    header->subtype = GET_HEADER_FIELD(AVTP_CVF_FIELD_SUBTYPE);
+    header->sv = GET_HEADER_FIELD(AVTP_CVF_FIELD_SV);
+    header->version = GET_HEADER_FIELD(AVTP_CVF_FIELD_VERSION);
+    header->mr = GET_HEADER_FIELD(AVTP_CVF_FIELD_MR);
+    header->tv = GET_HEADER_FIELD(AVTP_CVF_FIELD_TV);
+    header->sequence_num = GET_HEADER_FIELD(AVTP_CVF_FIELD_SEQUENCE_NUM);
+    header->tu = GET_HEADER_FIELD(AVTP_CVF_FIELD_TU);
+    header->stream_id = GET_HEADER_FIELD(AVTP_CVF_FIELD_STREAM_ID);
+    header->avtp_timestamp = GET_HEADER_FIELD(AVTP_CVF_FIELD_AVTP_TIMESTAMP);
+    header->format = GET_HEADER_FIELD(AVTP_CVF_FIELD_FORMAT);
+    header->format_subtype = GET_HEADER_FIELD(AVTP_CVF_FIELD_FORMAT_SUBTYPE);
+    header->stream_data_length = GET_HEADER_FIELD(AVTP_CVF_FIELD_STREAM_DATA_LENGTH);
+    header->ptv = GET_HEADER_FIELD(AVTP_CVF_FIELD_PTV);
+    header->m = GET_HEADER_FIELD(AVTP_CVF_FIELD_M);
+    header->evt = GET_HEADER_FIELD(AVTP_CVF_FIELD_EVT);
+}
+
+int Avtp_Cvf_InitTemplate(Avtp_StreamTemplate_t* tmpl, const Avtp_Cvf_t* const pdu)
+{
+    return Avtp_StreamTemplate_Init(tmpl, (const uint8_t*)pdu, AVTP_CVF_HEADER_LEN,
+            &fieldDescriptors[AVTP_CVF_FIELD_SEQUENCE_NUM], &fieldDescriptors[AVTP_CVF_FIELD_AVTP_TIMESTAMP],
+            &fieldDescriptors[AVTP_CVF_FIELD_STREAM_DATA_LENGTH]);
+}
+
 void Avtp_Cvf_SetField(Avtp_Cvf_t* pdu, Avtp_CvfField_t field, uint64_t value)
 {
     SET_FIELD(field, value);
@@ -35,9 +35,9 @@
 #include "avtp/CommonHeader.h"
 
 #define GET_FIELD(field) \
-        (Avtp_GetField(fieldDescriptors, AVTP_H264_FIELD_MAX, (uint8_t*)pdu, field))
+        (Avtp_GetFieldInline(fieldDescriptors, AVTP_H264_FIELD_MAX, (uint8_t*)pdu, field))
 #define SET_FIELD(field, value) \
-        (Avtp_SetField(fieldDescriptors, AVTP_H264_FIELD_MAX, (uint8_t*)pdu, field, value))
+        (Avtp_SetFieldInline(fieldDescriptors, AVTP_H264_FIELD_MAX, (uint8_t*)pdu, field, value))
 
 static const Avtp_FieldDescriptor_t fieldDescriptors[AVTP_H264_FIELD_MAX] =
 {
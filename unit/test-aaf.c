@@ -532,6 +532,41 @@ static void aaf_pdu_init(void **state)
     assert_true(pdu.packet_info == 0);
 }
 
+static void aaf_unpack(void **state)
+{
+    uint8_t pdu[AVTP_PCM_HEADER_LEN];
+    Avtp_PcmHeader_t header;
+
+    // Every unpacked field must match its single field getter
+    for (int pattern = 0; pattern < 3; pattern++) {
+        for (int i = 0; i < AVTP_PCM_HEADER_LEN; i++) {
+            pdu[i] = (pattern == 0) ? 0xFF : (uint8_t)(i * 37 + pattern * 0x5A);
+        }
+
+        Avtp_Pcm_Unpack((Avtp_Pcm_t*)pdu, &header);
+        assert_int_equal(header.subtype, Avtp_Pcm_GetSubtype((Avtp_Pcm_t*)pdu));
+        assert_int_equal(header.sv, Avtp_Pcm_GetSv((Avtp_Pcm_t*)pdu));
+        assert_int_equal(header.version, Avtp_Pcm_GetVersion((Avtp_Pcm_t*)pdu));
+        assert_int_equal(header.mr, Avtp_Pcm_GetMr((Avtp_Pcm_t*)pdu));
+        assert_int_equal(header.tv, Avtp_Pcm_GetTv((Avtp_Pcm_t*)pdu));
+        assert_int_equal(header.sequence_num, Avtp_Pcm_GetSequenceNum((Avtp_Pcm_t*)pdu));
+        assert_int_equal(header.tu, Avtp_Pcm_GetTu((Avtp_Pcm_t*)pdu));
+        assert_int_equal(header.stream_id, Avtp_Pcm_GetStreamId((Avtp_Pcm_t*)pdu));
+        assert_int_equal(header.avtp_timestamp, Avtp_Pcm_GetAvtpTimestamp((Avtp_Pcm_t*)pdu));
+        assert_int_equal(header.format, Avtp_Pcm_GetFormat((Avtp_Pcm_t*)pdu));
+        assert_int_equal(header.nsr, Avtp_Pcm_GetNsr((Avtp_Pcm_t*)pdu));
+        assert_int_equal(header.channels_per_frame, Avtp_Pcm_GetChannelsPerFrame((Avtp_Pcm_t*)pdu));
+        assert_int_equal(header.bit_depth, Avtp_Pcm_GetBitDepth((Avtp_Pcm_t*)pdu));
+        assert_int_equal(header.stream_data_length, Avtp_Pcm_GetStreamDataLength((Avtp_Pcm_t*)pdu));
+        assert_int_equal(header.sp, Avtp_Pcm_GetSp((Avtp_Pcm_t*)pdu));
+        assert_int_equal(header.evt, Avtp_Pcm_GetEvt((Avtp_Pcm_t*)pdu));
+    }
+
+    // Null pointers must be ignored
+    Avtp_Pcm_Unpack(NULL, &header);
+    Avtp_Pcm_Unpack((Avtp_Pcm_t*)pdu, NULL);
+}
+
 int main(void)
 {
     const struct CMUnitTest tests[] = {
@@ -570,6 +605,7 @@ int main(void)
         cmocka_unit_test(aaf_set_field_evt),
         cmocka_unit_test(aaf_pdu_init_null_pdu),
         cmocka_unit_test(aaf_pdu_init),
+        cmocka_unit_test(aaf_unpack),
     };
 
     return cmocka_run_group_tests(tests, NULL, NULL);
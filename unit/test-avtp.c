@@ -136,6 +136,28 @@ static void set_field_version(void **state)
     assert_true(ntohl(pdu.subtype_data) == 0x00500000);
 }
 
+static void common_header_unpack(void **state)
+{
+    uint8_t pdu[AVTP_COMMON_HEADER_LEN];
+    Avtp_CommonHeaderHeader_t header;
+
+    // Every unpacked field must match its single field getter
+    for (int pattern = 0; pattern < 3; pattern++) {
+        for (int i = 0; i < AVTP_COMMON_HEADER_LEN; i++) {
+            pdu[i] = (pattern == 0) ? 0xFF : (uint8_t)(i * 37 + pattern * 0x5A);
+        }
+
+        Avtp_CommonHeader_Unpack((Avtp_CommonHeader_t*)pdu, &header);
+        assert_int_equal(header.subtype, Avtp_CommonHeader_GetSubtype((Avtp_CommonHeader_t*)pdu));
+        assert_int_equal(header.h, Avtp_CommonHeader_GetH((Avtp_CommonHeader_t*)pdu));
+        assert_int_equal(header.version, Avtp_CommonHeader_GetVersion((Avtp_CommonHeader_t*)pdu));
+    }
+
+    // Null pointers must be ignored
+    Avtp_CommonHeader_Unpack(NULL, &header);
+    Avtp_CommonHeader_Unpack((Avtp_CommonHeader_t*)pdu, NULL);
+}
+
 int main(void)
 {
     const struct CMUnitTest tests[] = {
@@ -148,6 +170,7 @@ int main(void)
         cmocka_unit_test(set_field_invalid_field),
         cmocka_unit_test(set_field_subtype),
         cmocka_unit_test(set_field_version),
+        cmocka_unit_test(common_header_unpack),
     };
 
     return cmocka_run_group_tests(tests, NULL, NULL);
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2025, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <string.h>
+
+#include "avtp/Byteorder.h"
+
+#define MAX_MISALIGNMENT    8
+
+static void byteorder_bswap(void **state) {
+
+    assert_int_equal(Avtp_Bswap16(0x0102), 0x0201);
+    assert_int_equal(Avtp_Bswap32(0x01020304), 0x04030201);
+    assert_int_equal(Avtp_Bswap64(0x0102030405060708ULL), 0x0807060504030201ULL);
+}
+
+static void byteorder_load_be(void **state) {
+
+    // Leave room so every access size fits at every misalignment
+    uint64_t storage[3];
+    uint8_t* buf = (uint8_t*)storage;
+    const uint8_t bytes[8] = {0x01, 0x23, 0x45, 0x67, 0x89, 0xAB, 0xCD, 0xEF};
+
+    for (int offset = 0; offset < MAX_MISALIGNMENT; offset++) {
+        memset(storage, 0, sizeof(storage));
+        memcpy(buf + offset, bytes, sizeof(bytes));
+
+        assert_int_equal(Avtp_LoadBe16(buf + offset), 0x0123);
+        assert_int_equal(Avtp_LoadBe32(buf + offset), 0x01234567);
+        assert_int_equal(Avtp_LoadBe64(buf + offset), 0x0123456789ABCDEFULL);
+    }
+}
+
+static void byteorder_store_be(void **state) {
+
+    uint64_t storage[3];
+    uint64_t expected[3];
+    uint8_t* buf = (uint8_t*)storage;
+    const uint8_t bytes[8] = {0xFE, 0xDC, 0xBA, 0x98, 0x76, 0x54, 0x32, 0x10};
+
+    for (int offset = 0; offset < MAX_MISALIGNMENT; offset++) {
+        // Only the accessed bytes may change
+        memset(storage, 0x5A, sizeof(storage));
+        memset(expected, 0x5A, sizeof(expected));
+        memcpy((uint8_t*)expected + offset, bytes, 2);
+        Avtp_StoreBe16(buf + offset, 0xFEDC);
+        assert_memory_equal(storage, expected, sizeof(storage));
+
+        memset(storage, 0x5A, sizeof(storage));
+        memset(expected, 0x5A, sizeof(expected));
+        memcpy((uint8_t*)expected + offset, bytes, 4);
+        Avtp_StoreBe32(buf + offset, 0xFEDCBA98);
+        assert_memory_equal(storage, expected, sizeof(storage));
+
+        memset(storage, 0x5A, sizeof(storage));
+        memset(expected, 0x5A, sizeof(expected));
+        memcpy((uint8_t*)expected + offset, bytes, 8);
+        Avtp_StoreBe64(buf + offset, 0xFEDCBA9876543210ULL);
+        assert_memory_equal(storage, expected, sizeof(storage));
+    }
+}
+
+static void byteorder_load_store_roundtrip(void **state) {
+
+    uint64_t storage[3];
+    uint8_t* buf = (uint8_t*)storage;
+
+    for (int offset = 0; offset < MAX_MISALIGNMENT; offset++) {
+        Avtp_StoreBe16(buf + offset, 0x8001);
+        assert_int_equal(Avtp_LoadBe16(buf + offset), 0x8001);
+        Avtp_StoreBe32(buf + offset, 0x80000001);
+        assert_int_equal(Avtp_LoadBe32(buf + offset), 0x80000001);
+        Avtp_StoreBe64(buf + offset, 0x8000000000000001ULL);
+        assert_int_equal(Avtp_LoadBe64(buf + offset), 0x8000000000000001ULL);
+    }
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(byteorder_bswap),
+        cmocka_unit_test(byteorder_load_be),
+        cmocka_unit_test(byteorder_store_be),
+        cmocka_unit_test(byteorder_load_store_roundtrip)
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -116,6 +116,89 @@ static void can_set_payload(void **state) {
     }
 }
 
+static void can_set_header(void **state) {
+
+    uint8_t pdu[AVTP_CAN_HEADER_LEN];
+    uint8_t ref_pdu[AVTP_CAN_HEADER_LEN];
+    Avtp_CanHeader_t header = {
+        .acf_msg_type = AVTP_ACF_TYPE_CAN,
+        .acf_msg_length = 6,
+        .pad = 3,
+        .mtv = 1,
+        .rtr = 0,
+        .eff = 1,
+        .brs = 1,
+        .fdf = 1,
+        .esi = 0,
+        .can_bus_id = 0x15,
+        .message_timestamp = 0x0102030405060708,
+        .can_identifier = 0x1ABCDEF5,
+    };
+
+    // Reference built with the single field setters
+    memset(ref_pdu, 0, AVTP_CAN_HEADER_LEN);
+    Avtp_Can_Init((Avtp_Can_t*)ref_pdu);
+    Avtp_Can_SetAcfMsgLength((Avtp_Can_t*)ref_pdu, 6);
+    Avtp_Can_SetPad((Avtp_Can_t*)ref_pdu, 3);
+    Avtp_Can_EnableMtv((Avtp_Can_t*)ref_pdu);
+    Avtp_Can_EnableEff((Avtp_Can_t*)ref_pdu);
+    Avtp_Can_EnableBrs((Avtp_Can_t*)ref_pdu);
+    Avtp_Can_EnableFdf((Avtp_Can_t*)ref_pdu);
+    Avtp_Can_SetCanBusId((Avtp_Can_t*)ref_pdu, 0x15);
+    Avtp_Can_SetMessageTimestamp((Avtp_Can_t*)ref_pdu, 0x0102030405060708);
+    Avtp_Can_SetCanIdentifier((Avtp_Can_t*)ref_pdu, 0x1ABCDEF5);
+
+    memset(pdu, 0, AVTP_CAN_HEADER_LEN);
+    Avtp_Can_SetHeader((Avtp_Can_t*)pdu, &header);
+    assert_memory_equal(ref_pdu, pdu, AVTP_CAN_HEADER_LEN);
+
+    // Null pointers must be ignored
+    Avtp_Can_SetHeader(NULL, &header);
+    Avtp_Can_SetHeader((Avtp_Can_t*)pdu, NULL);
+    assert_memory_equal(ref_pdu, pdu, AVTP_CAN_HEADER_LEN);
+}
+
+static void can_brief_set_header(void **state) {
+
+    uint8_t pdu[AVTP_CAN_BRIEF_HEADER_LEN];
+    uint8_t ref_pdu[AVTP_CAN_BRIEF_HEADER_LEN];
+    Avtp_CanBriefHeader_t header = {
+        .acf_msg_type = AVTP_ACF_TYPE_CAN_BRIEF,
+        .acf_msg_length = 4,
+        .pad = 3,
+        .mtv = 0,
+        .rtr = 1,
+        .eff = 1,
+        .brs = 1,
+        .fdf = 1,
+        .esi = 1,
+        .can_bus_id = 0x0A,
+        .can_identifier = 0x1ABCDEF5,
+    };
+
+    // Reference built with the single field setters
+    memset(ref_pdu, 0, AVTP_CAN_BRIEF_HEADER_LEN);
+    Avtp_CanBrief_Init((Avtp_CanBrief_t*)ref_pdu);
+    Avtp_CanBrief_SetAcfMsgLength((Avtp_CanBrief_t*)ref_pdu, 4);
+    Avtp_CanBrief_SetPad((Avtp_CanBrief_t*)ref_pdu, 3);
+    Avtp_CanBrief_EnableRtr((Avtp_CanBrief_t*)ref_pdu);
+    Avtp_CanBrief_EnableEff((Avtp_CanBrief_t*)ref_pdu);
+    Avtp_CanBrief_EnableBrs((Avtp_CanBrief_t*)ref_pdu);
+    Avtp_CanBrief_EnableFdf((Avtp_CanBrief_t*)ref_pdu);
+    Avtp_CanBrief_EnableEsi((Avtp_CanBrief_t*)ref_pdu);
+    Avtp_CanBrief_SetCanBusId((Avtp_CanBrief_t*)ref_pdu, 0x0A);
+    Avtp_CanBrief_SetCanIdentifier((Avtp_CanBrief_t*)ref_pdu, 0x1ABCDEF5);
+
+    memset(pdu, 0, AVTP_CAN_BRIEF_HEADER_LEN);
+    Avtp_CanBrief_SetHeader((Avtp_CanBrief_t*)pdu, &header);
+    assert_memory_equal(ref_pdu, pdu, AVTP_CAN_BRIEF_HEADER_LEN);
+
+    // Null pointers must be ignored
+    Avtp_CanBrief_SetHeader(NULL, &header);
+    Avtp_CanBrief_SetHeader((Avtp_CanBrief_t*)pdu, NULL);
+    assert_memory_equal(ref_pdu, pdu, AVTP_CAN_BRIEF_HEADER_LEN);
+}
+
 static void can_is_valid(void **state) {
 
     uint8_t pdu[MAX_PDU_SIZE], result;
@@ -140,13 +223,78 @@ static void can_is_valid(void **state) {
 
 }
 
+static void can_brief_unpack(void **state)
+{
+    uint8_t pdu[AVTP_CAN_BRIEF_HEADER_LEN];
+    Avtp_CanBriefHeader_t header;
+
+    // Every unpacked field must match its single field getter
+    for (int pattern = 0; pattern < 3; pattern++) {
+        for (int i = 0; i < AVTP_CAN_BRIEF_HEADER_LEN; i++) {
+            pdu[i] = (pattern == 0) ? 0xFF : (uint8_t)(i * 37 + pattern * 0x5A);
+        }
+
+        Avtp_CanBrief_Unpack((Avtp_CanBrief_t*)pdu, &header);
+        assert_int_equal(header.acf_msg_type, Avtp_CanBrief_GetAcfMsgType((Avtp_CanBrief_t*)pdu));
+        assert_int_equal(header.acf_msg_length, Avtp_CanBrief_GetAcfMsgLength((Avtp_CanBrief_t*)pdu));
+        assert_int_equal(header.pad, Avtp_CanBrief_GetPad((Avtp_CanBrief_t*)pdu));
+        assert_int_equal(header.mtv, Avtp_CanBrief_GetMtv((Avtp_CanBrief_t*)pdu));
+        assert_int_equal(header.rtr, Avtp_CanBrief_GetRtr((Avtp_CanBrief_t*)pdu));
+        assert_int_equal(header.eff, Avtp_CanBrief_GetEff((Avtp_CanBrief_t*)pdu));
+        assert_int_equal(header.brs, Avtp_CanBrief_GetBrs((Avtp_CanBrief_t*)pdu));
+        assert_int_equal(header.fdf, Avtp_CanBrief_GetFdf((Avtp_CanBrief_t*)pdu));
+        assert_int_equal(header.esi, Avtp_CanBrief_GetEsi((Avtp_CanBrief_t*)pdu));
+        assert_int_equal(header.can_bus_id, Avtp_CanBrief_GetCanBusId((Avtp_CanBrief_t*)pdu));
+        assert_int_equal(header.can_identifier, Avtp_CanBrief_GetCanIdentifier((Avtp_CanBrief_t*)pdu));
+    }
+
+    // Null pointers must be ignored
+    Avtp_CanBrief_Unpack(NULL, &header);
+    Avtp_CanBrief_Unpack((Avtp_CanBrief_t*)pdu, NULL);
+}
+
+static void can_unpack(void **state)
+{
+    uint8_t pdu[AVTP_CAN_HEADER_LEN];
+    Avtp_CanHeader_t header;
+
+    // Every unpacked field must match its single field getter
+    for (int pattern = 0; pattern < 3; pattern++) {
+        for (int i = 0; i < AVTP_CAN_HEADER_LEN; i++) {
+            pdu[i] = (pattern == 0) ? 0xFF : (uint8_t)(i * 37 + pattern * 0x5A);
+        }
+
+        Avtp_Can_Unpack((Avtp_Can_t*)pdu, &header);
+        assert_int_equal(header.acf_msg_type, Avtp_Can_GetAcfMsgType((Avtp_Can_t*)pdu));
+        assert_int_equal(header.acf_msg_length, Avtp_Can_GetAcfMsgLength((Avtp_Can_t*)pdu));
+        assert_int_equal(header.pad, Avtp_Can_GetPad((Avtp_Can_t*)pdu));
+        assert_int_equal(header.mtv, Avtp_Can_GetMtv((Avtp_Can_t*)pdu));
+        assert_int_equal(header.rtr, Avtp_Can_GetRtr((Avtp_Can_t*)pdu));
+        assert_int_equal(header.eff, Avtp_Can_GetEff((Avtp_Can_t*)pdu));
+        assert_int_equal(header.brs, Avtp_Can_GetBrs((Avtp_Can_t*)pdu));
+        assert_int_equal(header.fdf, Avtp_Can_GetFdf((Avtp_Can_t*)pdu));
+        assert_int_equal(header.esi, Avtp_Can_GetEsi((Avtp_Can_t*)pdu));
+        assert_int_equal(header.can_bus_id, Avtp_Can_GetCanBusId((Avtp_Can_t*)pdu));
+        assert_int_equal(header.message_timestamp, Avtp_Can_GetMessageTimestamp((Avtp_Can_t*)pdu));
+        assert_int_equal(header.can_identifier, Avtp_Can_GetCanIdentifier((Avtp_Can_t*)pdu));
+    }
+
+    // Null pointers must be ignored
+    Avtp_Can_Unpack(NULL, &header);
+    Avtp_Can_Unpack((Avtp_Can_t*)pdu, NULL);
+}
+
 int main(void)
 {
     const struct CMUnitTest tests[] = {
         cmocka_unit_test(can_init),
         cmocka_unit_test(can_brief_init),
         cmocka_unit_test(can_set_payload),
-        cmocka_unit_test(can_is_valid)
+        cmocka_unit_test(can_set_header),
+        cmocka_unit_test(can_brief_set_header),
+        cmocka_unit_test(can_is_valid),
+        cmocka_unit_test(can_unpack),
+        cmocka_unit_test(can_brief_unpack),
     };
 
     return cmocka_run_group_tests(tests, NULL, NULL);
@@ -0,0 +1,594 @@
+/*
+ * Copyright (c) 2025, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "avtp/cpp/CommonHeader.hpp"
+#include "avtp/cpp/Crf.hpp"
+#include "avtp/cpp/Rvf.hpp"
+#include "avtp/cpp/Udp.hpp"
+#include "avtp/cpp/aaf/Aaf.hpp"
+#include "avtp/cpp/aaf/Pcm.hpp"
+#include "avtp/cpp/acf/AcfCommon.hpp"
+#include "avtp/cpp/acf/Can.hpp"
+#include "avtp/cpp/acf/CanBrief.hpp"
+#include "avtp/cpp/acf/FlexRay.hpp"
+#include "avtp/cpp/acf/Gpc.hpp"
+#include "avtp/cpp/acf/Lin.hpp"
+#include "avtp/cpp/acf/Most.hpp"
+#include "avtp/cpp/acf/Ntscf.hpp"
+#include "avtp/cpp/acf/Sensor.hpp"
+#include "avtp/cpp/acf/SensorBrief.hpp"
+#include "avtp/cpp/acf/Tscf.hpp"
+#include "avtp/cpp/acf/custom/Vss.hpp"
+#include "avtp/cpp/acf/custom/VssBrief.hpp"
+#include "avtp/cpp/cvf/Cvf.hpp"
+#include "avtp/cpp/cvf/H264.hpp"
+#include "avtp/cpp/cvf/Jpeg2000.hpp"
+#include "avtp/cpp/cvf/Mjpeg.hpp"
+
+#define PDU_SIZE            64
+#define NUM_RUNS            100
+
+static int checkedFields;
+
+static void fill_random(uint8_t* buf, size_t len)
+{
+    for (size_t i = 0; i < len; i++) {
+        buf[i] = (uint8_t)rand();
+    }
+}
+
+static uint64_t random_value(void)
+{
+    return ((uint64_t)rand() << 48) ^ ((uint64_t)rand() << 24) ^ (uint64_t)rand();
+}
+
+/*
+ * Reads and writes a field through the C++ layer and through the generic
+ * accessors of the C API and compares the results.
+ */
+template <typename F, typename Pdu, typename Enum>
+static void check_field(uint64_t (*getField)(const Pdu*, Enum),
+                        void (*setField)(Pdu*, Enum, uint64_t), Enum field)
+{
+    uint8_t pdu_c[PDU_SIZE];
+    uint8_t pdu_cpp[PDU_SIZE];
+    avtp::PduView<typename F::FormatType> view(pdu_cpp);
+
+    for (int run = 0; run < NUM_RUNS; run++) {
+        uint64_t value = random_value();
+        fill_random(pdu_c, sizeof(pdu_c));
+        memcpy(pdu_cpp, pdu_c, sizeof(pdu_cpp));
+
+        assert_int_equal(view.template Get<F>(), getField((const Pdu*)pdu_c, field));
+
+        setField((Pdu*)pdu_c, field, value);
+        view.template Set<F>(static_cast<typename F::ValueType>(value));
+        assert_memory_equal(pdu_cpp, pdu_c, sizeof(pdu_c));
+    }
+    checkedFields++;
+}
+
+#define CHECK_FIELD(format, cField, cppField) \
+        check_field<avtp::format::cppField>(Avtp_##format##_GetField, \
+                Avtp_##format##_SetField, cField)
+
+/*
+ * ACF CAN has no generic field accessors in the C API, so go through
+ * Avtp_Can_Unpack() and Avtp_Can_SetHeader() instead.
+ */
+static uint64_t can_get_field(const Avtp_Can_t* pdu, Avtp_CanFields_t field)
+{
+    Avtp_CanHeader_t header;
+    Avtp_Can_Unpack(pdu, &header);
+
+    switch (field) {
+    case AVTP_CAN_FIELD_ACF_MSG_TYPE: return header.acf_msg_type;
+    case AVTP_CAN_FIELD_ACF_MSG_LENGTH: return header.acf_msg_length;
+    case AVTP_CAN_FIELD_PAD: return header.pad;
+    case AVTP_CAN_FIELD_MTV: return header.mtv;
+    case AVTP_CAN_FIELD_RTR: return header.rtr;
+    case AVTP_CAN_FIELD_EFF: return header.eff;
+    case AVTP_CAN_FIELD_BRS: return header.brs;
+    case AVTP_CAN_FIELD_FDF: return header.fdf;
+    case AVTP_CAN_FIELD_ESI: return header.esi;
+    case AVTP_CAN_FIELD_CAN_BUS_ID: return header.can_bus_id;
+    case AVTP_CAN_FIELD_MESSAGE_TIMESTAMP: return header.message_timestamp;
+    case AVTP_CAN_FIELD_CAN_IDENTIFIER: return header.can_identifier;
+    default: return 0;
+    }
+}
+
+static void can_set_field(Avtp_Can_t* pdu, Avtp_CanFields_t field, uint64_t value)
+{
+    Avtp_CanHeader_t header;
+    Avtp_Can_Unpack(pdu, &header);
+
+    // Header members are wider than the fields, so mask like Avtp_SetField()
+    switch (field) {
+    case AVTP_CAN_FIELD_ACF_MSG_TYPE: header.acf_msg_type = value & 0x7F; break;
+    case AVTP_CAN_FIELD_ACF_MSG_LENGTH: header.acf_msg_length = value & 0x1FF; break;
+    case AVTP_CAN_FIELD_PAD: header.pad = value & 0x3; break;
+    case AVTP_CAN_FIELD_MTV: header.mtv = value & 0x1; break;
+    case AVTP_CAN_FIELD_RTR: header.rtr = value & 0x1; break;
+    case AVTP_CAN_FIELD_EFF: header.eff = value & 0x1; break;
+    case AVTP_CAN_FIELD_BRS: header.brs = value & 0x1; break;
+    case AVTP_CAN_FIELD_FDF: header.fdf = value & 0x1; break;
+    case AVTP_CAN_FIELD_ESI: header.esi = value & 0x1; break;
+    case AVTP_CAN_FIELD_CAN_BUS_ID: header.can_bus_id = value & 0x1F; break;
+    case AVTP_CAN_FIELD_MESSAGE_TIMESTAMP: header.message_timestamp = value; break;
+    case AVTP_CAN_FIELD_CAN_IDENTIFIER: header.can_identifier = value & 0x1FFFFFFF; break;
+    default: break;
+    }
+    Avtp_Can_SetHeader(pdu, &header);
+}
+
+static void cpp_common_header(void **state) {
+
+    checkedFields = 0;
+    CHECK_FIELD(CommonHeader, AVTP_COMMON_HEADER_FIELD_SUBTYPE, Subtype);
+    CHECK_FIELD(CommonHeader, AVTP_COMMON_HEADER_FIELD_H, H);
+    CHECK_FIELD(CommonHeader, AVTP_COMMON_HEADER_FIELD_VERSION, Version);
+    assert_int_equal(checkedFields, AVTP_COMMON_HEADER_FIELD_MAX);
+}
+
+static void cpp_crf(void **state) {
+
+    checkedFields = 0;
+    CHECK_FIELD(Crf, AVTP_CRF_FIELD_SUBTYPE, Subtype);
+    CHECK_FIELD(Crf, AVTP_CRF_FIELD_SV, Sv);
+    CHECK_FIELD(Crf, AVTP_CRF_FIELD_VERSION, Version);
+    CHECK_FIELD(Crf, AVTP_CRF_FIELD_MR, Mr);
+    CHECK_FIELD(Crf, AVTP_CRF_FIELD_RESERVED, Reserved);
+    CHECK_FIELD(Crf, AVTP_CRF_FIELD_FS, Fs);
+    CHECK_FIELD(Crf, AVTP_CRF_FIELD_TU, Tu);
+    CHECK_FIELD(Crf, AVTP_CRF_FIELD_SEQUENCE_NUM, SequenceNum);
+    CHECK_FIELD(Crf, AVTP_CRF_FIELD_TYPE, Type);
+    CHECK_FIELD(Crf, AVTP_CRF_FIELD_STREAM_ID, StreamId);
+    CHECK_FIELD(Crf, AVTP_CRF_FIELD_PULL, Pull);
+    CHECK_FIELD(Crf, AVTP_CRF_FIELD_BASE_FREQUENCY, BaseFrequency);
+    CHECK_FIELD(Crf, AVTP_CRF_FIELD_CRF_DATA_LENGTH, CrfDataLength);
+    CHECK_FIELD(Crf, AVTP_CRF_FIELD_TIMESTAMP_INTERVAL, TimestampInterval);
+    assert_int_equal(checkedFields, AVTP_CRF_FIELD_MAX);
+}
+
+static void cpp_rvf(void **state) {
+
+    checkedFields = 0;
+    CHECK_FIELD(Rvf, AVTP_RVF_FIELD_SUBTYPE, Subtype);
+    CHECK_FIELD(Rvf, AVTP_RVF_FIELD_SV, Sv);
+    CHECK_FIELD(Rvf, AVTP_RVF_FIELD_VERSION, Version);
+    CHECK_FIELD(Rvf, AVTP_RVF_FIELD_MR, Mr);
+    CHECK_FIELD(Rvf, AVTP_RVF_FIELD_RESERVED, Reserved);
+    CHECK_FIELD(Rvf, AVTP_RVF_FIELD_TV, Tv);
+    CHECK_FIELD(Rvf, AVTP_RVF_FIELD_SEQUENCE_NUM, SequenceNum);
+    CHECK_FIELD(Rvf, AVTP_RVF_FIELD_RESERVED_2, Reserved2);
+    CHECK_FIELD(Rvf, AVTP_RVF_FIELD_TU, Tu);
+    CHECK_FIELD(Rvf, AVTP_RVF_FIELD_STREAM_ID, StreamId);
+    CHECK_FIELD(Rvf, AVTP_RVF_FIELD_AVTP_TIMESTAMP, AvtpTimestamp);
+    CHECK_FIELD(Rvf, AVTP_RVF_FIELD_ACTIVE_PIXELS, ActivePixels);
+    CHECK_FIELD(Rvf, AVTP_RVF_FIELD_TOTAL_LINES, TotalLines);
+    CHECK_FIELD(Rvf, AVTP_RVF_FIELD_STREAM_DATA_LENGTH, StreamDataLength);
+    CHECK_FIELD(Rvf, AVTP_RVF_FIELD_AP, Ap);
+    CHECK_FIELD(Rvf, AVTP_RVF_FIELD_RESERVED_3, Reserved3);
+    CHECK_FIELD(Rvf, AVTP_RVF_FIELD_F, F);
+    CHECK_FIELD(Rvf, AVTP_RVF_FIELD_EF, Ef);
+    CHECK_FIELD(Rvf, AVTP_RVF_FIELD_EVT, Evt);
+    CHECK_FIELD(Rvf, AVTP_RVF_FIELD_PD, Pd);
+    CHECK_FIELD(Rvf, AVTP_RVF_FIELD_I, I);
+    CHECK_FIELD(Rvf, AVTP_RVF_FIELD_RESERVED_4, Reserved4);
+    CHECK_FIELD(Rvf, AVTP_RVF_FIELD_RESERVED_5, Reserved5);
+    CHECK_FIELD(Rvf, AVTP_RVF_FIELD_PIXEL_DEPTH, PixelDepth);
+    CHECK_FIELD(Rvf, AVTP_RVF_FIELD_PIXEL_FORMAT, PixelFormat);
+    CHECK_FIELD(Rvf, AVTP_RVF_FIELD_FRAME_RATE, FrameRate);
+    CHECK_FIELD(Rvf, AVTP_RVF_FIELD_COLORSPACE, Colorspace);
+    CHECK_FIELD(Rvf, AVTP_RVF_FIELD_NUM_LINES, NumLines);
+    CHECK_FIELD(Rvf, AVTP_RVF_FIELD_RESERVED_6, Reserved6);
+    CHECK_FIELD(Rvf, AVTP_RVF_FIELD_I_SEQ_NUM, ISeqNum);
+    CHECK_FIELD(Rvf, AVTP_RVF_FIELD_LINE_NUMBER, LineNumber);
+    assert_int_equal(checkedFields, AVTP_RVF_FIELD_MAX);
+}
+
+static void cpp_udp(void **state) {
+
+    checkedFields = 0;
+    CHECK_FIELD(Udp, AVTP_UDP_FIELD_ENCAPSULATION_SEQ_NO, EncapsulationSeqNo);
+    assert_int_equal(checkedFields, AVTP_UDP_FIELD_MAX);
+}
+
+static void cpp_aaf(void **state) {
+
+    checkedFields = 0;
+    // Pcm.h redefines the AVTP_AAF_FIELD_* names as aliases of its own
+    // fields, so address the AAF fields by their index instead.
+    CHECK_FIELD(Aaf, static_cast<Avtp_AafFields_t>(0), Subtype);
+    CHECK_FIELD(Aaf, static_cast<Avtp_AafFields_t>(1), Sv);
+    CHECK_FIELD(Aaf, static_cast<Avtp_AafFields_t>(2), Version);
+    CHECK_FIELD(Aaf, static_cast<Avtp_AafFields_t>(3), Mr);
+    CHECK_FIELD(Aaf, static_cast<Avtp_AafFields_t>(4), Tv);
+    CHECK_FIELD(Aaf, static_cast<Avtp_AafFields_t>(5), SequenceNum);
+    CHECK_FIELD(Aaf, static_cast<Avtp_AafFields_t>(6), Tu);
+    CHECK_FIELD(Aaf, static_cast<Avtp_AafFields_t>(7), StreamId);
+    CHECK_FIELD(Aaf, static_cast<Avtp_AafFields_t>(8), AvtpTimestamp);
+    CHECK_FIELD(Aaf, static_cast<Avtp_AafFields_t>(9), Format);
+    CHECK_FIELD(Aaf, static_cast<Avtp_AafFields_t>(10), AafFormatSpecificData1);
+    CHECK_FIELD(Aaf, static_cast<Avtp_AafFields_t>(11), StreamDataLength);
+    CHECK_FIELD(Aaf, static_cast<Avtp_AafFields_t>(12), Afsd);
+    CHECK_FIELD(Aaf, static_cast<Avtp_AafFields_t>(13), Sp);
+    CHECK_FIELD(Aaf, static_cast<Avtp_AafFields_t>(14), Evt);
+    CHECK_FIELD(Aaf, static_cast<Avtp_AafFields_t>(15), AafFormatSpecificData2);
+    assert_int_equal(checkedFields, AVTP_AAF_FIELD_MAX);
+}
+
+static void cpp_pcm(void **state) {
+
+    checkedFields = 0;
+    CHECK_FIELD(Pcm, AVTP_PCM_FIELD_SUBTYPE, Subtype);
+    CHECK_FIELD(Pcm, AVTP_PCM_FIELD_SV, Sv);
+    CHECK_FIELD(Pcm, AVTP_PCM_FIELD_VERSION, Version);
+    CHECK_FIELD(Pcm, AVTP_PCM_FIELD_MR, Mr);
+    CHECK_FIELD(Pcm, AVTP_PCM_FIELD_TV, Tv);
+    CHECK_FIELD(Pcm, AVTP_PCM_FIELD_SEQUENCE_NUM, SequenceNum);
+    CHECK_FIELD(Pcm, AVTP_PCM_FIELD_TU, Tu);
+    CHECK_FIELD(Pcm, AVTP_PCM_FIELD_STREAM_ID, StreamId);
+    CHECK_FIELD(Pcm, AVTP_PCM_FIELD_AVTP_TIMESTAMP, AvtpTimestamp);
+    CHECK_FIELD(Pcm, AVTP_PCM_FIELD_FORMAT, Format);
+    CHECK_FIELD(Pcm, AVTP_PCM_FIELD_NSR, Nsr);
+    CHECK_FIELD(Pcm, AVTP_PCM_FIELD_CHANNELS_PER_FRAME, ChannelsPerFrame);
+    CHECK_FIELD(Pcm, AVTP_PCM_FIELD_BIT_DEPTH, BitDepth);
+    CHECK_FIELD(Pcm, AVTP_PCM_FIELD_STREAM_DATA_LENGTH, StreamDataLength);
+    CHECK_FIELD(Pcm, AVTP_PCM_FIELD_SP, Sp);
+    CHECK_FIELD(Pcm, AVTP_PCM_FIELD_EVT, Evt);
+    assert_int_equal(checkedFields, AVTP_PCM_FIELD_MAX);
+}
+
+static void cpp_acf_common(void **state) {
+
+    checkedFields = 0;
+    CHECK_FIELD(AcfCommon, AVTP_ACF_FIELD_ACF_MSG_TYPE, AcfMsgType);
+    CHECK_FIELD(AcfCommon, AVTP_ACF_FIELD_ACF_MSG_LENGTH, AcfMsgLength);
+    assert_int_equal(checkedFields, AVTP_ACF_COMMON_FIELD_MAX);
+}
+
+static void cpp_can(void **state) {
+
+    checkedFields = 0;
+    check_field<avtp::Can::AcfMsgType>(can_get_field, can_set_field, AVTP_CAN_FIELD_ACF_MSG_TYPE);
+    check_field<avtp::Can::AcfMsgLength>(can_get_field, can_set_field, AVTP_CAN_FIELD_ACF_MSG_LENGTH);
+    check_field<avtp::Can::Pad>(can_get_field, can_set_field, AVTP_CAN_FIELD_PAD);
+    check_field<avtp::Can::Mtv>(can_get_field, can_set_field, AVTP_CAN_FIELD_MTV);
+    check_field<avtp::Can::Rtr>(can_get_field, can_set_field, AVTP_CAN_FIELD_RTR);
+    check_field<avtp::Can::Eff>(can_get_field, can_set_field, AVTP_CAN_FIELD_EFF);
+    check_field<avtp::Can::Brs>(can_get_field, can_set_field, AVTP_CAN_FIELD_BRS);
+    check_field<avtp::Can::Fdf>(can_get_field, can_set_field, AVTP_CAN_FIELD_FDF);
+    check_field<avtp::Can::Esi>(can_get_field, can_set_field, AVTP_CAN_FIELD_ESI);
+    check_field<avtp::Can::CanBusId>(can_get_field, can_set_field, AVTP_CAN_FIELD_CAN_BUS_ID);
+    check_field<avtp::Can::MessageTimestamp>(can_get_field, can_set_field, AVTP_CAN_FIELD_MESSAGE_TIMESTAMP);
+    check_field<avtp::Can::CanIdentifier>(can_get_field, can_set_field, AVTP_CAN_FIELD_CAN_IDENTIFIER);
+    assert_int_equal(checkedFields, AVTP_CAN_FIELD_MAX);
+}
+
+static void cpp_can_brief(void **state) {
+
+    checkedFields = 0;
+    CHECK_FIELD(CanBrief, AVTP_CAN_BRIEF_FIELD_ACF_MSG_TYPE, AcfMsgType);
+    CHECK_FIELD(CanBrief, AVTP_CAN_BRIEF_FIELD_ACF_MSG_LENGTH, AcfMsgLength);
+    CHECK_FIELD(CanBrief, AVTP_CAN_BRIEF_FIELD_PAD, Pad);
+    CHECK_FIELD(CanBrief, AVTP_CAN_BRIEF_FIELD_MTV, Mtv);
+    CHECK_FIELD(CanBrief, AVTP_CAN_BRIEF_FIELD_RTR, Rtr);
+    CHECK_FIELD(CanBrief, AVTP_CAN_BRIEF_FIELD_EFF, Eff);
+    CHECK_FIELD(CanBrief, AVTP_CAN_BRIEF_FIELD_BRS, Brs);
+    CHECK_FIELD(CanBrief, AVTP_CAN_BRIEF_FIELD_FDF, Fdf);
+    CHECK_FIELD(CanBrief, AVTP_CAN_BRIEF_FIELD_ESI, Esi);
+    CHECK_FIELD(CanBrief, AVTP_CAN_BRIEF_FIELD_CAN_BUS_ID, CanBusId);
+    CHECK_FIELD(CanBrief, AVTP_CAN_BRIEF_FIELD_CAN_IDENTIFIER, CanIdentifier);
+    assert_int_equal(checkedFields, AVTP_CAN_BRIEF_FIELD_MAX);
+}
+
+static void cpp_flex_ray(void **state) {
+
+    checkedFields = 0;
+    CHECK_FIELD(FlexRay, AVTP_FLEXRAY_FIELD_ACF_MSG_TYPE, AcfMsgType);
+    CHECK_FIELD(FlexRay, AVTP_FLEXRAY_FIELD_ACF_MSG_LENGTH, AcfMsgLength);
+    CHECK_FIELD(FlexRay, AVTP_FLEXRAY_FIELD_PAD, Pad);
+    CHECK_FIELD(FlexRay, AVTP_FLEXRAY_FIELD_MTV, Mtv);
+    CHECK_FIELD(FlexRay, AVTP_FLEXRAY_FIELD_FR_BUS_ID, FrBusId);
+    CHECK_FIELD(FlexRay, AVTP_FLEXRAY_FIELD_RESERVED, Reserved);
+    CHECK_FIELD(FlexRay, AVTP_FLEXRAY_FIELD_CHAN, Chan);
+    CHECK_FIELD(FlexRay, AVTP_FLEXRAY_FIELD_STR, Str);
+    CHECK_FIELD(FlexRay, AVTP_FLEXRAY_FIELD_SYN, Syn);
+    CHECK_FIELD(FlexRay, AVTP_FLEXRAY_FIELD_PRE, Pre);
+    CHECK_FIELD(FlexRay, AVTP_FLEXRAY_FIELD_NFI, Nfi);
+    CHECK_FIELD(FlexRay, AVTP_FLEXRAY_FIELD_MESSAGE_TIMESTAMP, MessageTimestamp);
+    CHECK_FIELD(FlexRay, AVTP_FLEXRAY_FIELD_FR_FRAME_ID, FrFrameId);
+    CHECK_FIELD(FlexRay, AVTP_FLEXRAY_FIELD_RESERVED_2, Reserved2);
+    CHECK_FIELD(FlexRay, AVTP_FLEXRAY_FIELD_CYCLE, Cycle);
+    assert_int_equal(checkedFields, AVTP_FLEXRAY_FIELD_MAX);
+}
+
+static void cpp_gpc(void **state) {
+
+    checkedFields = 0;
+    CHECK_FIELD(Gpc, AVTP_GPC_FIELD_ACF_MSG_TYPE, AcfMsgType);
+    CHECK_FIELD(Gpc, AVTP_GPC_FIELD_ACF_MSG_LENGTH, AcfMsgLength);
+    CHECK_FIELD(Gpc, AVTP_GPC_FIELD_GPC_MSG_ID, GpcMsgId);
+    assert_int_equal(checkedFields, AVTP_GPC_FIELD_MAX);
+}
+
+static void cpp_lin(void **state) {
+
+    checkedFields = 0;
+    CHECK_FIELD(Lin, AVTP_LIN_FIELD_ACF_MSG_TYPE, AcfMsgType);
+    CHECK_FIELD(Lin, AVTP_LIN_FIELD_ACF_MSG_LENGTH, AcfMsgLength);
+    CHECK_FIELD(Lin, AVTP_LIN_FIELD_PAD, Pad);
+    CHECK_FIELD(Lin, AVTP_LIN_FIELD_MTV, Mtv);
+    CHECK_FIELD(Lin, AVTP_LIN_FIELD_LIN_BUS_ID, LinBusId);
+    CHECK_FIELD(Lin, AVTP_LIN_FIELD_LIN_IDENTIFIER, LinIdentifier);
+    CHECK_FIELD(Lin, AVTP_LIN_FIELD_MESSAGE_TIMESTAMP, MessageTimestamp);
+    assert_int_equal(checkedFields, AVTP_LIN_FIELD_MAX);
+}
+
+static void cpp_most(void **state) {
+
+    checkedFields = 0;
+    CHECK_FIELD(Most, AVTP_MOST_FIELD_ACF_MSG_TYPE, AcfMsgType);
+    CHECK_FIELD(Most, AVTP_MOST_FIELD_ACF_MSG_LENGTH, AcfMsgLength);
+    CHECK_FIELD(Most, AVTP_MOST_FIELD_PAD, Pad);
+    CHECK_FIELD(Most, AVTP_MOST_FIELD_MTV, Mtv);
+    CHECK_FIELD(Most, AVTP_MOST_FIELD_MOST_NET_ID, MostNetId);
+    CHECK_FIELD(Most, AVTP_MOST_FIELD_RESERVED, Reserved);
+    CHECK_FIELD(Most, AVTP_MOST_FIELD_MESSAGE_TIMESTAMP, MessageTimestamp);
+    CHECK_FIELD(Most, AVTP_MOST_FIELD_DEVICE_ID, DeviceId);
+    CHECK_FIELD(Most, AVTP_MOST_FIELD_FBLOCK_ID, FblockId);
+    CHECK_FIELD(Most, AVTP_MOST_FIELD_INST_ID, InstId);
+    CHECK_FIELD(Most, AVTP_MOST_FIELD_FUNC_ID, FuncId);
+    CHECK_FIELD(Most, AVTP_MOST_FIELD_OP_TYPE, OpType);
+    CHECK_FIELD(Most, AVTP_MOST_FIELD_RESERVED_2, Reserved2);
+    assert_int_equal(checkedFields, AVTP_MOST_FIELD_MAX);
+}
+
+static void cpp_ntscf(void **state) {
+
+    checkedFields = 0;
+    CHECK_FIELD(Ntscf, AVTP_NTSCF_FIELD_SUBTYPE, Subtype);
+    CHECK_FIELD(Ntscf, AVTP_NTSCF_FIELD_SV, Sv);
+    CHECK_FIELD(Ntscf, AVTP_NTSCF_FIELD_VERSION, Version);
+    CHECK_FIELD(Ntscf, AVTP_NTSCF_FIELD_NTSCF_DATA_LENGTH, NtscfDataLength);
+    CHECK_FIELD(Ntscf, AVTP_NTSCF_FIELD_SEQUENCE_NUM, SequenceNum);
+    CHECK_FIELD(Ntscf, AVTP_NTSCF_FIELD_STREAM_ID, StreamId);
+    assert_int_equal(checkedFields, AVTP_NTSCF_FIELD_MAX);
+}
+
+static void cpp_sensor(void **state) {
+
+    checkedFields = 0;
+    CHECK_FIELD(Sensor, AVTP_SENSOR_FIELD_ACF_MSG_TYPE, AcfMsgType);
+    CHECK_FIELD(Sensor, AVTP_SENSOR_FIELD_ACF_MSG_LENGTH, AcfMsgLength);
+    CHECK_FIELD(Sensor, AVTP_SENSOR_FIELD_MTV, Mtv);
+    CHECK_FIELD(Sensor, AVTP_SENSOR_FIELD_NUM_SENSOR, NumSensor);
+    CHECK_FIELD(Sensor, AVTP_SENSOR_FIELD_SZ, Sz);
+    CHECK_FIELD(Sensor, AVTP_SENSOR_FIELD_SENSOR_GROUP, SensorGroup);
+    CHECK_FIELD(Sensor, AVTP_SENSOR_FIELD_MESSAGE_TIMESTAMP, MessageTimestamp);
+    assert_int_equal(checkedFields, AVTP_SENSOR_FIELD_MAX);
+}
+
+static void cpp_sensor_brief(void **state) {
+
+    checkedFields = 0;
+    CHECK_FIELD(SensorBrief, AVTP_SENSOR_BRIEF_FIELD_ACF_MSG_TYPE, AcfMsgType);
+    CHECK_FIELD(SensorBrief, AVTP_SENSOR_BRIEF_FIELD_ACF_MSG_LENGTH, AcfMsgLength);
+    CHECK_FIELD(SensorBrief, AVTP_SENSOR_BRIEF_FIELD_MTV, Mtv);
+    CHECK_FIELD(SensorBrief, AVTP_SENSOR_BRIEF_FIELD_NUM_SENSOR, NumSensor);
+    CHECK_FIELD(SensorBrief, AVTP_SENSOR_BRIEF_FIELD_SZ, Sz);
+    CHECK_FIELD(SensorBrief, AVTP_SENSOR_BRIEF_FIELD_SENSOR_GROUP, SensorGroup);
+    assert_int_equal(checkedFields, AVTP_SENSOR_BRIEF_FIELD_MAX);
+}
+
+static void cpp_tscf(void **state) {
+
+    checkedFields = 0;
+    CHECK_FIELD(Tscf, AVTP_TSCF_FIELD_SUBTYPE, Subtype);
+    CHECK_FIELD(Tscf, AVTP_TSCF_FIELD_SV, Sv);
+    CHECK_FIELD(Tscf, AVTP_TSCF_FIELD_VERSION, Version);
+    CHECK_FIELD(Tscf, AVTP_TSCF_FIELD_MR, Mr);
+    CHECK_FIELD(Tscf, AVTP_TSCF_FIELD_TV, Tv);
+    CHECK_FIELD(Tscf, AVTP_TSCF_FIELD_SEQUENCE_NUM, SequenceNum);
+    CHECK_FIELD(Tscf, AVTP_TSCF_FIELD_TU, Tu);
+    CHECK_FIELD(Tscf, AVTP_TSCF_FIELD_STREAM_ID, StreamId);
+    CHECK_FIELD(Tscf, AVTP_TSCF_FIELD_AVTP_TIMESTAMP, AvtpTimestamp);
+    CHECK_FIELD(Tscf, AVTP_TSCF_FIELD_STREAM_DATA_LENGTH, StreamDataLength);
+    assert_int_equal(checkedFields, AVTP_TSCF_FIELD_MAX);
+}
+
+static void cpp_vss(void **state) {
+
+    checkedFields = 0;
+    CHECK_FIELD(Vss, AVTP_VSS_FIELD_ACF_MSG_TYPE, AcfMsgType);
+    CHECK_FIELD(Vss, AVTP_VSS_FIELD_ACF_MSG_LENGTH, AcfMsgLength);
+    CHECK_FIELD(Vss, AVTP_VSS_FIELD_PAD, Pad);
+    CHECK_FIELD(Vss, AVTP_VSS_FIELD_MTV, Mtv);
+    CHECK_FIELD(Vss, AVTP_VSS_FIELD_ADDR_MODE, AddrMode);
+    CHECK_FIELD(Vss, AVTP_VSS_FIELD_VSS_OP, VssOp);
+    CHECK_FIELD(Vss, AVTP_VSS_FIELD_VSS_DATATYPE, VssDatatype);
+    CHECK_FIELD(Vss, AVTP_VSS_FIELD_MSG_TIMESTAMP, MsgTimestamp);
+    assert_int_equal(checkedFields, AVTP_VSS_FIELD_MAX);
+}
+
+static void cpp_vss_brief(void **state) {
+
+    checkedFields = 0;
+    CHECK_FIELD(VssBrief, AVTP_VSS_BRIEF_FIELD_ACF_MSG_TYPE, AcfMsgType);
+    CHECK_FIELD(VssBrief, AVTP_VSS_BRIEF_FIELD_ACF_MSG_LENGTH, AcfMsgLength);
+    CHECK_FIELD(VssBrief, AVTP_VSS_BRIEF_FIELD_PAD, Pad);
+    CHECK_FIELD(VssBrief, AVTP_VSS_BRIEF_FIELD_MTV, Mtv);
+    CHECK_FIELD(VssBrief, AVTP_VSS_BRIEF_FIELD_ADDR_MODE, AddrMode);
+    CHECK_FIELD(VssBrief, AVTP_VSS_BRIEF_FIELD_VSS_OP, VssOp);
+    CHECK_FIELD(VssBrief, AVTP_VSS_BRIEF_FIELD_VSS_DATATYPE, VssDatatype);
+    // The remaining enumerators have no descriptor in the C implementation
+    assert_int_equal(checkedFields, AVTP_VSS_BRIEF_FIELD_VSS_DATATYPE + 1);
+}
+
+static void cpp_cvf(void **state) {
+
+    checkedFields = 0;
+    CHECK_FIELD(Cvf, AVTP_CVF_FIELD_SUBTYPE, Subtype);
+    CHECK_FIELD(Cvf, AVTP_CVF_FIELD_SV, Sv);
+    CHECK_FIELD(Cvf, AVTP_CVF_FIELD_VERSION, Version);
+    CHECK_FIELD(Cvf, AVTP_CVF_FIELD_MR, Mr);
+    CHECK_FIELD(Cvf, AVTP_CVF_FIELD_RESERVED, Reserved);
+    CHECK_FIELD(Cvf, AVTP_CVF_FIELD_TV, Tv);
+    CHECK_FIELD(Cvf, AVTP_CVF_FIELD_SEQUENCE_NUM, SequenceNum);
+    CHECK_FIELD(Cvf, AVTP_CVF_FIELD_RESERVED_2, Reserved2);
+    CHECK_FIELD(Cvf, AVTP_CVF_FIELD_TU, Tu);
+    CHECK_FIELD(Cvf, AVTP_CVF_FIELD_STREAM_ID, StreamId);
+    CHECK_FIELD(Cvf, AVTP_CVF_FIELD_AVTP_TIMESTAMP, AvtpTimestamp);
+    CHECK_FIELD(Cvf, AVTP_CVF_FIELD_FORMAT, Format);
+    CHECK_FIELD(Cvf, AVTP_CVF_FIELD_FORMAT_SUBTYPE, FormatSubtype);
+    CHECK_FIELD(Cvf, AVTP_CVF_FIELD_RESERVED_3, Reserved3);
+    CHECK_FIELD(Cvf, AVTP_CVF_FIELD_STREAM_DATA_LENGTH, StreamDataLength);
+    CHECK_FIELD(Cvf, AVTP_CVF_FIELD_RESERVED_4, Reserved4);
+    CHECK_FIELD(Cvf, AVTP_CVF_FIELD_PTV, Ptv);
+    CHECK_FIELD(Cvf, AVTP_CVF_FIELD_M, M);
+    CHECK_FIELD(Cvf, AVTP_CVF_FIELD_EVT, Evt);
+    CHECK_FIELD(Cvf, AVTP_CVF_FIELD_RESERVED_5, Reserved5);
+    assert_int_equal(checkedFields, AVTP_CVF_FIELD_MAX);
+}
+
+static void cpp_h264(void **state) {
+
+    checkedFields = 0;
+    CHECK_FIELD(H264, AVTP_H264_FIELD_TIMESTAMP, Timestamp);
+    assert_int_equal(checkedFields, AVTP_H264_FIELD_MAX);
+}
+
+static void cpp_jpeg2000(void **state) {
+
+    checkedFields = 0;
+    CHECK_FIELD(Jpeg2000, AVTP_JPEG2000_FIELD_TP, Tp);
+    CHECK_FIELD(Jpeg2000, AVTP_JPEG2000_FIELD_MHF, Mhf);
+    CHECK_FIELD(Jpeg2000, AVTP_JPEG2000_FIELD_MH_ID, MhId);
+    CHECK_FIELD(Jpeg2000, AVTP_JPEG2000_FIELD_T, T);
+    CHECK_FIELD(Jpeg2000, AVTP_JPEG2000_FIELD_PRIORITY, Priority);
+    CHECK_FIELD(Jpeg2000, AVTP_JPEG2000_FIELD_TILE_NUMBER, TileNumber);
+    CHECK_FIELD(Jpeg2000, AVTP_JPEG2000_FIELD_RESERVED, Reserved);
+    CHECK_FIELD(Jpeg2000, AVTP_JPEG2000_FIELD_FRAGMENT_OFFSET, FragmentOffset);
+    assert_int_equal(checkedFields, AVTP_JPEG2000_FIELD_MAX);
+}
+
+static void cpp_mjpeg(void **state) {
+
+    checkedFields = 0;
+    CHECK_FIELD(Mjpeg, AVTP_MJPEG_FIELD_TYPE_SPECIFIC, TypeSpecific);
+    CHECK_FIELD(Mjpeg, AVTP_MJPEG_FIELD_FRAGMENT_OFFSET, FragmentOffset);
+    CHECK_FIELD(Mjpeg, AVTP_MJPEG_FIELD_TYPE, Type);
+    CHECK_FIELD(Mjpeg, AVTP_MJPEG_FIELD_Q, Q);
+    CHECK_FIELD(Mjpeg, AVTP_MJPEG_FIELD_WIDTH, Width);
+    CHECK_FIELD(Mjpeg, AVTP_MJPEG_FIELD_HEIGHT, Height);
+    assert_int_equal(checkedFields, AVTP_MJPEG_FIELD_MAX);
+}
+
+static void cpp_view(void **state) {
+
+    uint8_t storage[PDU_SIZE + 1];
+    uint8_t* misaligned = storage + 1;
+
+    static_assert(std::is_same_v<avtp::Pcm::Sv::ValueType, uint8_t>);
+    static_assert(std::is_same_v<avtp::Pcm::StreamDataLength::ValueType, uint16_t>);
+    static_assert(std::is_same_v<avtp::Can::CanIdentifier::ValueType, uint32_t>);
+    static_assert(std::is_same_v<avtp::Ntscf::StreamId::ValueType, uint64_t>);
+
+    memset(storage, 0, sizeof(storage));
+    avtp::NtscfView ntscf(misaligned, PDU_SIZE);
+    ntscf.Set<avtp::Ntscf::Subtype, AVTP_SUBTYPE_NTSCF>();
+    ntscf.Set<avtp::Ntscf::Sv, 1>();
+    ntscf.Set<avtp::Ntscf::SequenceNum>(0xA5);
+    ntscf.Set<avtp::Ntscf::StreamId>(0x0123456789ABCDEFULL);
+    ntscf.Set<avtp::Ntscf::NtscfDataLength>(0x7FF);
+
+    // Same PDU through the C API
+    uint8_t pdu_c[PDU_SIZE];
+    Avtp_Ntscf_Init((Avtp_Ntscf_t*)pdu_c);
+    Avtp_Ntscf_SetSequenceNum((Avtp_Ntscf_t*)pdu_c, 0xA5);
+    Avtp_Ntscf_SetStreamId((Avtp_Ntscf_t*)pdu_c, 0x0123456789ABCDEFULL);
+    Avtp_Ntscf_SetNtscfDataLength((Avtp_Ntscf_t*)pdu_c, 0x7FF);
+    assert_memory_equal(misaligned, pdu_c, AVTP_NTSCF_HEADER_LEN);
+
+    // Read back through a read-only view
+    avtp::ConstNtscfView ro = ntscf;
+    assert_ptr_equal(ro.Data(), misaligned);
+    assert_int_equal(ro.Size(), PDU_SIZE);
+    assert_ptr_equal(ro.Payload(), misaligned + AVTP_NTSCF_HEADER_LEN);
+    assert_int_equal(ro.PayloadSize(), PDU_SIZE - AVTP_NTSCF_HEADER_LEN);
+    assert_int_equal(ro.Get<avtp::Ntscf::SequenceNum>(), 0xA5);
+    assert_int_equal(ro.Get<avtp::Ntscf::StreamId>(), 0x0123456789ABCDEFULL);
+    assert_int_equal(ro.Get<avtp::Ntscf::NtscfDataLength>(), 0x7FF);
+
+    // Values wider than the field are truncated like in the C API
+    ntscf.Set<avtp::Ntscf::NtscfDataLength>(0xFFFF);
+    assert_int_equal(ro.Get<avtp::Ntscf::NtscfDataLength>(), 0x7FF);
+    assert_int_equal(ro.Get<avtp::Ntscf::SequenceNum>(), 0xA5);
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(cpp_common_header),
+        cmocka_unit_test(cpp_crf),
+        cmocka_unit_test(cpp_rvf),
+        cmocka_unit_test(cpp_udp),
+        cmocka_unit_test(cpp_aaf),
+        cmocka_unit_test(cpp_pcm),
+        cmocka_unit_test(cpp_acf_common),
+        cmocka_unit_test(cpp_can),
+        cmocka_unit_test(cpp_can_brief),
+        cmocka_unit_test(cpp_flex_ray),
+        cmocka_unit_test(cpp_gpc),
+        cmocka_unit_test(cpp_lin),
+        cmocka_unit_test(cpp_most),
+        cmocka_unit_test(cpp_ntscf),
+        cmocka_unit_test(cpp_sensor),
+        cmocka_unit_test(cpp_sensor_brief),
+        cmocka_unit_test(cpp_tscf),
+        cmocka_unit_test(cpp_vss),
+        cmocka_unit_test(cpp_vss_brief),
+        cmocka_unit_test(cpp_cvf),
+        cmocka_unit_test(cpp_h264),
+        cmocka_unit_test(cpp_jpeg2000),
+        cmocka_unit_test(cpp_mjpeg),
+        cmocka_unit_test(cpp_view)
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
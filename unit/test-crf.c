@@ -419,6 +419,38 @@ static void crf_pdu_init(void **state)
     assert_true(pdu.packet_info == 0);
 }
 
+static void crf_unpack(void **state)
+{
+    uint8_t pdu[AVTP_CRF_HEADER_LEN];
+    Avtp_CrfHeader_t header;
+
+    // Every unpacked field must match its single field getter
+    for (int pattern = 0; pattern < 3; pattern++) {
+        for (int i = 0; i < AVTP_CRF_HEADER_LEN; i++) {
+            pdu[i] = (pattern == 0) ? 0xFF : (uint8_t)(i * 37 + pattern * 0x5A);
+        }
+
+        Avtp_Crf_Unpack((Avtp_Crf_t*)pdu, &header);
+        assert_int_equal(header.subtype, Avtp_Crf_GetSubtype((Avtp_Crf_t*)pdu));
+        assert_int_equal(header.sv, Avtp_Crf_GetSv((Avtp_Crf_t*)pdu));
+        assert_int_equal(header.version, Avtp_Crf_GetVersion((Avtp_Crf_t*)pdu));
+        assert_int_equal(header.mr, Avtp_Crf_GetMr((Avtp_Crf_t*)pdu));
+        assert_int_equal(header.fs, Avtp_Crf_GetFs((Avtp_Crf_t*)pdu));
+        assert_int_equal(header.tu, Avtp_Crf_GetTu((Avtp_Crf_t*)pdu));
+        assert_int_equal(header.sequence_num, Avtp_Crf_GetSequenceNum((Avtp_Crf_t*)pdu));
+        assert_int_equal(header.type, Avtp_Crf_GetType((Avtp_Crf_t*)pdu));
+        assert_int_equal(header.stream_id, Avtp_Crf_GetStreamId((Avtp_Crf_t*)pdu));
+        assert_int_equal(header.pull, Avtp_Crf_GetPull((Avtp_Crf_t*)pdu));
+        assert_int_equal(header.base_frequency, Avtp_Crf_GetBaseFrequency((Avtp_Crf_t*)pdu));
+        assert_int_equal(header.crf_data_length, Avtp_Crf_GetCrfDataLength((Avtp_Crf_t*)pdu));
+        assert_int_equal(header.timestamp_interval, Avtp_Crf_GetTimestampInterval((Avtp_Crf_t*)pdu));
+    }
+
+    // Null pointers must be ignored
+    Avtp_Crf_Unpack(NULL, &header);
+    Avtp_Crf_Unpack((Avtp_Crf_t*)pdu, NULL);
+}
+
 int main(void)
 {
     const struct CMUnitTest tests[] = {
@@ -451,6 +483,7 @@ int main(void)
         cmocka_unit_test(crf_set_field_timestamp_interval),
         cmocka_unit_test(crf_pdu_init_null_pdu),
         cmocka_unit_test(crf_pdu_init),
+        cmocka_unit_test(crf_unpack),
     };
 
     return cmocka_run_group_tests(tests, NULL, NULL);
@@ -528,6 +528,40 @@ static void cvf_set_field_h264_timestamp(void **state)
     assert_true(ntohl(*(uint32_t*)(&pdu.header)) == 0x80C0FFEE);
 }
 
+static void cvf_unpack(void **state)
+{
+    uint8_t pdu[AVTP_CVF_HEADER_LEN];
+    Avtp_CvfHeader_t header;
+
+    // Every unpacked field must match its single field getter
+    for (int pattern = 0; pattern < 3; pattern++) {
+        for (int i = 0; i < AVTP_CVF_HEADER_LEN; i++) {
+            pdu[i] = (pattern == 0) ? 0xFF : (uint8_t)(i * 37 + pattern * 0x5A);
+        }
+
+        Avtp_Cvf_Unpack((Avtp_Cvf_t*)pdu, &header);
+        assert_int_equal(header.subtype, Avtp_Cvf_GetSubtype((Avtp_Cvf_t*)pdu));
+        assert_int_equal(header.sv, Avtp_Cvf_GetSv((Avtp_Cvf_t*)pdu));
+        assert_int_equal(header.version, Avtp_Cvf_GetVersion((Avtp_Cvf_t*)pdu));
+        assert_int_equal(header.mr, Avtp_Cvf_GetMr((Avtp_Cvf_t*)pdu));
+        assert_int_equal(header.tv, Avtp_Cvf_GetTv((Avtp_Cvf_t*)pdu));
+        assert_int_equal(header.sequence_num, Avtp_Cvf_GetSequenceNum((Avtp_Cvf_t*)pdu));
+        assert_int_equal(header.tu, Avtp_Cvf_GetTu((Avtp_Cvf_t*)pdu));
+        assert_int_equal(header.stream_id, Avtp_Cvf_GetStreamId((Avtp_Cvf_t*)pdu));
+        assert_int_equal(header.avtp_timestamp, Avtp_Cvf_GetAvtpTimestamp((Avtp_Cvf_t*)pdu));
+        assert_int_equal(header.format, Avtp_Cvf_GetFormat((Avtp_Cvf_t*)pdu));
+        assert_int_equal(header.format_subtype, Avtp_Cvf_GetFormatSubtype((Avtp_Cvf_t*)pdu));
+        assert_int_equal(header.stream_data_length, Avtp_Cvf_GetStreamDataLength((Avtp_Cvf_t*)pdu));
+        assert_int_equal(header.ptv, Avtp_Cvf_GetPtv((Avtp_Cvf_t*)pdu));
+        assert_int_equal(header.m, Avtp_Cvf_GetM((Avtp_Cvf_t*)pdu));
+        assert_int_equal(header.evt, Avtp_Cvf_GetEvt((Avtp_Cvf_t*)pdu));
+    }
+
+    // Null pointers must be ignored
+    Avtp_Cvf_Unpack(NULL, &header);
+    Avtp_Cvf_Unpack((Avtp_Cvf_t*)pdu, NULL);
+}
+
 int main(void)
 {
     const struct CMUnitTest tests[] = {
@@ -566,6 +600,7 @@ int main(void)
         cmocka_unit_test(cvf_set_field_h264_timestamp),
         cmocka_unit_test(cvf_pdu_init_null_pdu),
         cmocka_unit_test(cvf_pdu_init),
+        cmocka_unit_test(cvf_unpack),
     };
 
     return cmocka_run_group_tests(tests, NULL, NULL);
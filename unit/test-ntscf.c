@@ -85,11 +85,61 @@ static void ntscf_is_valid(void **state) {
 
 }
 
+static void ntscf_set_header(void **state) {
+
+    uint8_t pdu[AVTP_NTSCF_HEADER_LEN];
+    uint8_t ref_pdu[AVTP_NTSCF_HEADER_LEN];
+    Avtp_NtscfHeader_t header = {
+        .subtype = AVTP_SUBTYPE_NTSCF,
+        .sv = 1,
+        .version = 0,
+        .ntscf_data_length = 0x5A5,
+        .sequence_num = 0xCD,
+        .stream_id = 0xAABBCCDDEEFF0001,
+    };
+
+    Avtp_Ntscf_Init((Avtp_Ntscf_t*)ref_pdu);
+    Avtp_Ntscf_SetNtscfDataLength((Avtp_Ntscf_t*)ref_pdu, 0x5A5);
+    Avtp_Ntscf_SetSequenceNum((Avtp_Ntscf_t*)ref_pdu, 0xCD);
+    Avtp_Ntscf_SetStreamId((Avtp_Ntscf_t*)ref_pdu, 0xAABBCCDDEEFF0001);
+
+    memset(pdu, 0, AVTP_NTSCF_HEADER_LEN);
+    Avtp_Ntscf_SetHeader((Avtp_Ntscf_t*)pdu, &header);
+    assert_memory_equal(ref_pdu, pdu, AVTP_NTSCF_HEADER_LEN);
+}
+
+static void ntscf_unpack(void **state)
+{
+    uint8_t pdu[AVTP_NTSCF_HEADER_LEN];
+    Avtp_NtscfHeader_t header;
+
+    // Every unpacked field must match its single field getter
+    for (int pattern = 0; pattern < 3; pattern++) {
+        for (int i = 0; i < AVTP_NTSCF_HEADER_LEN; i++) {
+            pdu[i] = (pattern == 0) ? 0xFF : (uint8_t)(i * 37 + pattern * 0x5A);
+        }
+
+        Avtp_Ntscf_Unpack((Avtp_Ntscf_t*)pdu, &header);
+        assert_int_equal(header.subtype, Avtp_Ntscf_GetSubtype((Avtp_Ntscf_t*)pdu));
+        assert_int_equal(header.sv, Avtp_Ntscf_GetSv((Avtp_Ntscf_t*)pdu));
+        assert_int_equal(header.version, Avtp_Ntscf_GetVersion((Avtp_Ntscf_t*)pdu));
+        assert_int_equal(header.ntscf_data_length, Avtp_Ntscf_GetNtscfDataLength((Avtp_Ntscf_t*)pdu));
+        assert_int_equal(header.sequence_num, Avtp_Ntscf_GetSequenceNum((Avtp_Ntscf_t*)pdu));
+        assert_int_equal(header.stream_id, Avtp_Ntscf_GetStreamId((Avtp_Ntscf_t*)pdu));
+    }
+
+    // Null pointers must be ignored
+    Avtp_Ntscf_Unpack(NULL, &header);
+    Avtp_Ntscf_Unpack((Avtp_Ntscf_t*)pdu, NULL);
+}
+
 int main(void)
 {
     const struct CMUnitTest tests[] = {
         cmocka_unit_test(ntscf_init),
-        cmocka_unit_test(ntscf_is_valid)
+        cmocka_unit_test(ntscf_is_valid),
+        cmocka_unit_test(ntscf_set_header),
+        cmocka_unit_test(ntscf_unpack),
     };
 
     return cmocka_run_group_tests(tests, NULL, NULL);
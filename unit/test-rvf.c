@@ -869,6 +869,50 @@ static void rvf_set_field_raw_line_number(void **state)
     assert_true(be64toh(pay->raw_header) == 0x0000000000000123);
 }
 
+static void rvf_unpack(void **state)
+{
+    uint8_t pdu[AVTP_RVF_HEADER_LEN];
+    Avtp_RvfHeader_t header;
+
+    // Every unpacked field must match its single field getter
+    for (int pattern = 0; pattern < 3; pattern++) {
+        for (int i = 0; i < AVTP_RVF_HEADER_LEN; i++) {
+            pdu[i] = (pattern == 0) ? 0xFF : (uint8_t)(i * 37 + pattern * 0x5A);
+        }
+
+        Avtp_Rvf_Unpack((Avtp_Rvf_t*)pdu, &header);
+        assert_int_equal(header.subtype, Avtp_Rvf_GetSubtype((Avtp_Rvf_t*)pdu));
+        assert_int_equal(header.sv, Avtp_Rvf_GetSv((Avtp_Rvf_t*)pdu));
+        assert_int_equal(header.version, Avtp_Rvf_GetVersion((Avtp_Rvf_t*)pdu));
+        assert_int_equal(header.mr, Avtp_Rvf_GetMr((Avtp_Rvf_t*)pdu));
+        assert_int_equal(header.tv, Avtp_Rvf_GetTv((Avtp_Rvf_t*)pdu));
+        assert_int_equal(header.sequence_num, Avtp_Rvf_GetSequenceNum((Avtp_Rvf_t*)pdu));
+        assert_int_equal(header.tu, Avtp_Rvf_GetTu((Avtp_Rvf_t*)pdu));
+        assert_int_equal(header.stream_id, Avtp_Rvf_GetStreamId((Avtp_Rvf_t*)pdu));
+        assert_int_equal(header.avtp_timestamp, Avtp_Rvf_GetAvtpTimestamp((Avtp_Rvf_t*)pdu));
+        assert_int_equal(header.active_pixels, Avtp_Rvf_GetActivePixels((Avtp_Rvf_t*)pdu));
+        assert_int_equal(header.total_lines, Avtp_Rvf_GetTotalLines((Avtp_Rvf_t*)pdu));
+        assert_int_equal(header.stream_data_length, Avtp_Rvf_GetStreamDataLength((Avtp_Rvf_t*)pdu));
+        assert_int_equal(header.ap, Avtp_Rvf_GetAp((Avtp_Rvf_t*)pdu));
+        assert_int_equal(header.f, Avtp_Rvf_GetF((Avtp_Rvf_t*)pdu));
+        assert_int_equal(header.ef, Avtp_Rvf_GetEf((Avtp_Rvf_t*)pdu));
+        assert_int_equal(header.evt, Avtp_Rvf_GetEvt((Avtp_Rvf_t*)pdu));
+        assert_int_equal(header.pd, Avtp_Rvf_GetPd((Avtp_Rvf_t*)pdu));
+        assert_int_equal(header.i, Avtp_Rvf_GetI((Avtp_Rvf_t*)pdu));
+        assert_int_equal(header.pixel_depth, Avtp_Rvf_GetPixelDepth((Avtp_Rvf_t*)pdu));
+        assert_int_equal(header.pixel_format, Avtp_Rvf_GetPixelFormat((Avtp_Rvf_t*)pdu));
+        assert_int_equal(header.frame_rate, Avtp_Rvf_GetFrameRate((Avtp_Rvf_t*)pdu));
+        assert_int_equal(header.colorspace, Avtp_Rvf_GetColorspace((Avtp_Rvf_t*)pdu));
+        assert_int_equal(header.num_lines, Avtp_Rvf_GetNumLines((Avtp_Rvf_t*)pdu));
+        assert_int_equal(header.i_seq_num, Avtp_Rvf_GetISeqNum((Avtp_Rvf_t*)pdu));
+        assert_int_equal(header.line_number, Avtp_Rvf_GetLineNumber((Avtp_Rvf_t*)pdu));
+    }
+
+    // Null pointers must be ignored
+    Avtp_Rvf_Unpack(NULL, &header);
+    Avtp_Rvf_Unpack((Avtp_Rvf_t*)pdu, NULL);
+}
+
 int main(void)
 {
     const struct CMUnitTest tests[] = {
@@ -925,6 +969,7 @@ int main(void)
         cmocka_unit_test(rvf_set_field_raw_line_number),
         cmocka_unit_test(rvf_pdu_init_null_pdu),
         cmocka_unit_test(rvf_pdu_init),
+        cmocka_unit_test(rvf_unpack),
     };
 
     return cmocka_run_group_tests(tests, NULL, NULL);
@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2025, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <string.h>
+
+#include "avtp/SeqTracker.h"
+
+static void seq_tracker_in_order(void **state)
+{
+    Avtp_SeqTracker_t tracker;
+
+    // The sequence number starts anywhere and wraps around
+    Avtp_SeqTracker_Init(&tracker);
+    for (int i = 0; i < 600; i++) {
+        assert_int_equal(Avtp_SeqTracker_Update(&tracker, (uint8_t)(200 + i)),
+                         AVTP_SEQ_IN_ORDER);
+    }
+    assert_int_equal(tracker.stats.received, 600);
+    assert_int_equal(tracker.stats.lost, 0);
+    assert_int_equal(tracker.stats.reordered, 0);
+    assert_int_equal(tracker.stats.duplicates, 0);
+    assert_int_equal(tracker.stats.late, 0);
+}
+
+static void seq_tracker_gap(void **state)
+{
+    Avtp_SeqTracker_t tracker;
+
+    Avtp_SeqTracker_Init(&tracker);
+    assert_int_equal(Avtp_SeqTracker_Update(&tracker, 250), AVTP_SEQ_IN_ORDER);
+    assert_int_equal(Avtp_SeqTracker_Update(&tracker, 3), AVTP_SEQ_GAP);
+    assert_int_equal(Avtp_SeqTracker_Update(&tracker, 4), AVTP_SEQ_IN_ORDER);
+    assert_int_equal(tracker.stats.received, 3);
+    assert_int_equal(tracker.stats.lost, 8);
+
+    // Gaps wider than the window still count every skipped number
+    assert_int_equal(Avtp_SeqTracker_Update(&tracker, 104), AVTP_SEQ_GAP);
+    assert_int_equal(tracker.stats.lost, 107);
+}
+
+static void seq_tracker_reorder(void **state)
+{
+    Avtp_SeqTracker_t tracker;
+
+    Avtp_SeqTracker_Init(&tracker);
+    assert_int_equal(Avtp_SeqTracker_Update(&tracker, 10), AVTP_SEQ_IN_ORDER);
+    assert_int_equal(Avtp_SeqTracker_Update(&tracker, 12), AVTP_SEQ_GAP);
+    assert_int_equal(Avtp_SeqTracker_Update(&tracker, 13), AVTP_SEQ_IN_ORDER);
+    assert_int_equal(Avtp_SeqTracker_Update(&tracker, 11), AVTP_SEQ_REORDERED);
+    assert_int_equal(tracker.stats.received, 4);
+    assert_int_equal(tracker.stats.lost, 0);
+    assert_int_equal(tracker.stats.reordered, 1);
+
+    // A PDU from before the first one was never counted as lost
+    assert_int_equal(Avtp_SeqTracker_Update(&tracker, 9), AVTP_SEQ_LATE);
+    assert_int_equal(tracker.stats.lost, 0);
+    assert_int_equal(tracker.stats.late, 1);
+}
+
+static void seq_tracker_duplicate(void **state)
+{
+    Avtp_SeqTracker_t tracker;
+
+    Avtp_SeqTracker_Init(&tracker);
+    assert_int_equal(Avtp_SeqTracker_Update(&tracker, 0), AVTP_SEQ_IN_ORDER);
+    assert_int_equal(Avtp_SeqTracker_Update(&tracker, 1), AVTP_SEQ_IN_ORDER);
+    assert_int_equal(Avtp_SeqTracker_Update(&tracker, 1), AVTP_SEQ_DUPLICATE);
+    assert_int_equal(Avtp_SeqTracker_Update(&tracker, 0), AVTP_SEQ_DUPLICATE);
+    assert_int_equal(Avtp_SeqTracker_Update(&tracker, 3), AVTP_SEQ_GAP);
+    assert_int_equal(Avtp_SeqTracker_Update(&tracker, 2), AVTP_SEQ_REORDERED);
+    assert_int_equal(Avtp_SeqTracker_Update(&tracker, 2), AVTP_SEQ_DUPLICATE);
+    assert_int_equal(tracker.stats.received, 4);
+    assert_int_equal(tracker.stats.duplicates, 3);
+    assert_int_equal(tracker.stats.lost, 0);
+}
+
+static void seq_tracker_late(void **state)
+{
+    Avtp_SeqTracker_t tracker;
+
+    Avtp_SeqTracker_Init(&tracker);
+    for (int i = 0; i < 100; i++) {
+        if (i != 20) {
+            Avtp_SeqTracker_Update(&tracker, i);
+        }
+    }
+    assert_int_equal(tracker.stats.lost, 1);
+
+    // 20 is behind the window now and cannot be told from a duplicate
+    assert_int_equal(Avtp_SeqTracker_Update(&tracker, 20), AVTP_SEQ_LATE);
+    assert_int_equal(tracker.stats.lost, 1);
+    assert_int_equal(tracker.stats.late, 1);
+    assert_int_equal(Avtp_SeqTracker_Update(&tracker, 40), AVTP_SEQ_DUPLICATE);
+}
+
+static void seq_tracker_udp(void **state)
+{
+    Avtp_SeqTracker_t tracker;
+
+    Avtp_SeqTracker_Init(&tracker);
+    assert_int_equal(Avtp_SeqTracker_UpdateUdp(&tracker, 0xFFFFFFFE), AVTP_SEQ_IN_ORDER);
+    assert_int_equal(Avtp_SeqTracker_UpdateUdp(&tracker, 0xFFFFFFFF), AVTP_SEQ_IN_ORDER);
+    assert_int_equal(Avtp_SeqTracker_UpdateUdp(&tracker, 1), AVTP_SEQ_GAP);
+    assert_int_equal(Avtp_SeqTracker_UpdateUdp(&tracker, 0), AVTP_SEQ_REORDERED);
+    assert_int_equal(Avtp_SeqTracker_UpdateUdp(&tracker, 1000), AVTP_SEQ_GAP);
+    assert_int_equal(tracker.stats.received, 5);
+    assert_int_equal(tracker.stats.lost, 998);
+    assert_int_equal(tracker.stats.reordered, 1);
+}
+
+static void seq_tracker_resync(void **state)
+{
+    Avtp_SeqTracker_t tracker;
+
+    Avtp_SeqTracker_Init(&tracker);
+    for (uint32_t i = 1000; i < 1010; i++) {
+        Avtp_SeqTracker_UpdateUdp(&tracker, i);
+    }
+
+    // Within a few windows behind, the PDU is late
+    assert_int_equal(Avtp_SeqTracker_UpdateUdp(&tracker, 1009 - AVTP_SEQ_TRACKER_RESYNC),
+                     AVTP_SEQ_LATE);
+
+    // The talker restarted, tracking continues from its sequence numbers
+    assert_int_equal(Avtp_SeqTracker_UpdateUdp(&tracker, 0), AVTP_SEQ_RESYNC);
+    assert_int_equal(Avtp_SeqTracker_UpdateUdp(&tracker, 1), AVTP_SEQ_IN_ORDER);
+    assert_int_equal(Avtp_SeqTracker_UpdateUdp(&tracker, 3), AVTP_SEQ_GAP);
+    assert_int_equal(Avtp_SeqTracker_UpdateUdp(&tracker, 2), AVTP_SEQ_REORDERED);
+    assert_int_equal(tracker.stats.received, 14);
+    assert_int_equal(tracker.stats.late, 1);
+    assert_int_equal(tracker.stats.resyncs, 1);
+    assert_int_equal(tracker.stats.lost, 0);
+
+    // 8 bit sequence numbers are never far enough behind to resync
+    Avtp_SeqTracker_Init(&tracker);
+    assert_int_equal(Avtp_SeqTracker_Update(&tracker, 200), AVTP_SEQ_IN_ORDER);
+    assert_int_equal(Avtp_SeqTracker_Update(&tracker, 72), AVTP_SEQ_LATE);
+    assert_int_equal(tracker.stats.resyncs, 0);
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(seq_tracker_in_order),
+        cmocka_unit_test(seq_tracker_gap),
+        cmocka_unit_test(seq_tracker_reorder),
+        cmocka_unit_test(seq_tracker_duplicate),
+        cmocka_unit_test(seq_tracker_late),
+        cmocka_unit_test(seq_tracker_udp),
+        cmocka_unit_test(seq_tracker_resync),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2025, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <errno.h>
+#include <string.h>
+
+#include "avtp/StreamTable.h"
+
+#define STREAM_ID       0xAABBCCDDEEFF0000
+#define NUM_SLOTS       64
+
+static uint8_t tags[NUM_SLOTS];
+static Avtp_StreamEntry_t entries[NUM_SLOTS];
+// Stand-ins for the output handles of the streams
+static int markers[NUM_SLOTS];
+
+static void stream_table_init_invalid(void **state)
+{
+    Avtp_StreamTable_t table;
+
+    assert_int_equal(Avtp_StreamTable_Init(NULL, tags, entries, NUM_SLOTS), -EINVAL);
+    assert_int_equal(Avtp_StreamTable_Init(&table, NULL, entries, NUM_SLOTS), -EINVAL);
+    assert_int_equal(Avtp_StreamTable_Init(&table, tags, NULL, NUM_SLOTS), -EINVAL);
+    assert_int_equal(Avtp_StreamTable_Init(&table, tags, entries, 0), -EINVAL);
+    assert_int_equal(Avtp_StreamTable_Init(&table, tags, entries, 48), -EINVAL);
+    assert_int_equal(Avtp_StreamTable_Init(&table, tags, entries, NUM_SLOTS), 0);
+    assert_int_equal(table.count, 0);
+    assert_null(Avtp_StreamTable_Find(&table, STREAM_ID));
+}
+
+static void stream_table_slots(void **state)
+{
+    assert_int_equal(Avtp_StreamTable_Slots(0), 2);
+    assert_int_equal(Avtp_StreamTable_Slots(1), 2);
+    assert_int_equal(Avtp_StreamTable_Slots(7), 8);
+    assert_int_equal(Avtp_StreamTable_Slots(8), 16);
+    assert_int_equal(Avtp_StreamTable_Slots(14), 16);
+    assert_int_equal(Avtp_StreamTable_Slots(15), 32);
+    assert_int_equal(Avtp_StreamTable_Slots(500), 1024);
+}
+
+static void stream_table_add_find(void **state)
+{
+    Avtp_StreamTable_t table;
+    Avtp_StreamEntry_t* entry;
+    uint32_t max = Avtp_StreamTable_MaxStreams(NUM_SLOTS);
+
+    assert_int_equal(Avtp_StreamTable_Init(&table, tags, entries, NUM_SLOTS), 0);
+
+    // Stream IDs of one talker only differ in the unique ID
+    for (uint32_t i = 0; i < max; i++) {
+        entry = Avtp_StreamTable_Add(&table, STREAM_ID + i);
+        assert_non_null(entry);
+        assert_true(entry->streamId == STREAM_ID + i);
+        assert_null(entry->handle);
+        entry->handle = &markers[i];
+    }
+    assert_int_equal(table.count, max);
+    assert_null(Avtp_StreamTable_Add(&table, STREAM_ID + max));
+
+    // Adding a stream again returns the existing entry
+    entry = Avtp_StreamTable_Add(&table, STREAM_ID + 3);
+    assert_non_null(entry);
+    assert_ptr_equal(entry->handle, &markers[3]);
+    assert_int_equal(table.count, max);
+
+    for (uint32_t i = 0; i < max; i++) {
+        entry = Avtp_StreamTable_Find(&table, STREAM_ID + i);
+        assert_non_null(entry);
+        assert_ptr_equal(entry->handle, &markers[i]);
+    }
+    assert_null(Avtp_StreamTable_Find(&table, STREAM_ID + max));
+    assert_null(Avtp_StreamTable_Find(&table, 0));
+}
+
+static void stream_table_remove(void **state)
+{
+    Avtp_StreamTable_t table;
+    Avtp_StreamEntry_t* entry;
+    uint32_t max = Avtp_StreamTable_MaxStreams(NUM_SLOTS);
+
+    assert_int_equal(Avtp_StreamTable_Init(&table, tags, entries, NUM_SLOTS), 0);
+    for (uint32_t i = 0; i < max; i++) {
+        entry = Avtp_StreamTable_Add(&table, STREAM_ID + i);
+        assert_non_null(entry);
+        entry->handle = &markers[i];
+    }
+
+    // Removing every other stream must keep the others reachable
+    assert_int_equal(Avtp_StreamTable_Remove(&table, STREAM_ID + max), -ENOENT);
+    for (uint32_t i = 0; i < max; i += 2) {
+        assert_int_equal(Avtp_StreamTable_Remove(&table, STREAM_ID + i), 0);
+    }
+    assert_int_equal(table.count, max / 2);
+    for (uint32_t i = 0; i < max; i++) {
+        entry = Avtp_StreamTable_Find(&table, STREAM_ID + i);
+        if (i % 2) {
+            assert_non_null(entry);
+            assert_ptr_equal(entry->handle, &markers[i]);
+        } else {
+            assert_null(entry);
+        }
+    }
+    assert_int_equal(Avtp_StreamTable_Remove(&table, STREAM_ID), -ENOENT);
+
+    // The freed slots are used again
+    for (uint32_t i = 0; i < max; i += 2) {
+        assert_non_null(Avtp_StreamTable_Add(&table, STREAM_ID + i));
+    }
+    assert_int_equal(table.count, max);
+    for (uint32_t i = 1; i < max; i += 2) {
+        assert_int_equal(Avtp_StreamTable_Remove(&table, STREAM_ID + i), 0);
+    }
+    for (uint32_t i = 0; i < max; i++) {
+        if (i % 2) {
+            assert_null(Avtp_StreamTable_Find(&table, STREAM_ID + i));
+        } else {
+            assert_non_null(Avtp_StreamTable_Find(&table, STREAM_ID + i));
+        }
+    }
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(stream_table_init_invalid),
+        cmocka_unit_test(stream_table_slots),
+        cmocka_unit_test(stream_table_add_find),
+        cmocka_unit_test(stream_table_remove),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2025, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <errno.h>
+#include <string.h>
+
+#include "avtp/StreamTemplate.h"
+#include "avtp/CommonHeader.h"
+#include "avtp/Crf.h"
+#include "avtp/aaf/Pcm.h"
+#include "avtp/acf/Ntscf.h"
+#include "avtp/acf/Tscf.h"
+#include "avtp/cvf/Cvf.h"
+
+#define STREAM_ID       0xAABBCCDDEEFF0001
+
+static void stream_template_init_invalid(void **state)
+{
+    Avtp_StreamTemplate_t tmpl;
+    uint8_t header[AVTP_STREAM_TEMPLATE_MAX_LEN + AVTP_QUADLET_SIZE] = { 0 };
+    Avtp_FieldDescriptor_t crossing = { .quadlet = 1, .offset = 24, .bits = 16 };
+    Avtp_FieldDescriptor_t outside = { .quadlet = 2, .offset = 0, .bits = 8 };
+    Avtp_FieldDescriptor_t valid = { .quadlet = 1, .offset = 24, .bits = 8 };
+
+    assert_int_equal(Avtp_StreamTemplate_Init(NULL, header, 8, NULL, NULL, NULL), -EINVAL);
+    assert_int_equal(Avtp_StreamTemplate_Init(&tmpl, NULL, 8, NULL, NULL, NULL), -EINVAL);
+    assert_int_equal(Avtp_StreamTemplate_Init(&tmpl, header, sizeof(header),
+                        NULL, NULL, NULL), -EINVAL);
+    assert_int_equal(Avtp_StreamTemplate_Init(&tmpl, header, 8,
+                        &crossing, NULL, NULL), -EINVAL);
+    assert_int_equal(Avtp_StreamTemplate_Init(&tmpl, header, 8,
+                        NULL, NULL, &outside), -EINVAL);
+    assert_int_equal(Avtp_StreamTemplate_Init(&tmpl, header, 8,
+                        &valid, NULL, NULL), 0);
+    assert_int_equal(tmpl.len, 8);
+    assert_int_equal(tmpl.timestamp.mask, 0);
+    assert_int_equal(tmpl.length.mask, 0);
+}
+
+static void stream_template_patch_field(void **state)
+{
+    Avtp_StreamTemplate_t tmpl;
+    uint8_t header[2 * AVTP_QUADLET_SIZE];
+    uint8_t pdu[2 * AVTP_QUADLET_SIZE];
+    Avtp_FieldDescriptor_t desc = { .quadlet = 1, .offset = 5, .bits = 11 };
+
+    // Bits around the patched field must be preserved, excess value bits dropped
+    memset(header, 0xFF, sizeof(header));
+    assert_int_equal(Avtp_StreamTemplate_Init(&tmpl, header, sizeof(header),
+                        NULL, NULL, &desc), 0);
+    Avtp_StreamTemplate_Render(&tmpl, pdu, 0, 0, 0xF800);
+    assert_int_equal(pdu[4], 0xF8);
+    assert_int_equal(pdu[5], 0x00);
+    assert_int_equal(pdu[6], 0xFF);
+    assert_int_equal(pdu[7], 0xFF);
+
+    Avtp_StreamTemplate_Patch(&tmpl, pdu, 0, 0, 0x2A5);
+    assert_int_equal(pdu[4], 0xFA);
+    assert_int_equal(pdu[5], 0xA5);
+    assert_memory_equal(pdu, header, AVTP_QUADLET_SIZE);
+}
+
+static void stream_template_pcm(void **state)
+{
+    Avtp_StreamTemplate_t tmpl;
+    uint8_t header[AVTP_PCM_HEADER_LEN];
+    uint8_t ref_pdu[AVTP_PCM_HEADER_LEN];
+    uint8_t pdu[AVTP_PCM_HEADER_LEN];
+
+    Avtp_Pcm_Init((Avtp_Pcm_t*)header);
+    Avtp_Pcm_EnableTv((Avtp_Pcm_t*)header);
+    Avtp_Pcm_SetStreamId((Avtp_Pcm_t*)header, STREAM_ID);
+    Avtp_Pcm_SetFormat((Avtp_Pcm_t*)header, AVTP_AAF_FORMAT_INT_16BIT);
+    Avtp_Pcm_SetNsr((Avtp_Pcm_t*)header, AVTP_AAF_PCM_NSR_48KHZ);
+    Avtp_Pcm_SetChannelsPerFrame((Avtp_Pcm_t*)header, 2);
+    Avtp_Pcm_SetBitDepth((Avtp_Pcm_t*)header, 16);
+    assert_int_equal(Avtp_Pcm_InitTemplate(&tmpl, (Avtp_Pcm_t*)header), 0);
+
+    for (int seq = 0; seq < 300; seq += 7) {
+        memcpy(ref_pdu, header, AVTP_PCM_HEADER_LEN);
+        Avtp_Pcm_SetSequenceNum((Avtp_Pcm_t*)ref_pdu, seq);
+        Avtp_Pcm_SetAvtpTimestamp((Avtp_Pcm_t*)ref_pdu, 0x80000001 + seq);
+        Avtp_Pcm_SetStreamDataLength((Avtp_Pcm_t*)ref_pdu, 4 * seq);
+
+        memset(pdu, 0xA5, sizeof(pdu));
+        Avtp_StreamTemplate_Render(&tmpl, pdu, seq, 0x80000001 + seq, 4 * seq);
+        assert_memory_equal(ref_pdu, pdu, AVTP_PCM_HEADER_LEN);
+    }
+}
+
+static void stream_template_crf(void **state)
+{
+    Avtp_StreamTemplate_t tmpl;
+    uint8_t header[AVTP_CRF_HEADER_LEN];
+    uint8_t ref_pdu[AVTP_CRF_HEADER_LEN];
+    uint8_t pdu[AVTP_CRF_HEADER_LEN];
+
+    Avtp_Crf_Init((Avtp_Crf_t*)header);
+    Avtp_Crf_SetType((Avtp_Crf_t*)header, AVTP_CRF_TYPE_AUDIO_SAMPLE);
+    Avtp_Crf_SetStreamId((Avtp_Crf_t*)header, STREAM_ID);
+    Avtp_Crf_SetBaseFrequency((Avtp_Crf_t*)header, 48000);
+    Avtp_Crf_SetTimestampInterval((Avtp_Crf_t*)header, 160);
+    assert_int_equal(Avtp_Crf_InitTemplate(&tmpl, (Avtp_Crf_t*)header), 0);
+
+    memcpy(ref_pdu, header, AVTP_CRF_HEADER_LEN);
+    Avtp_Crf_SetSequenceNum((Avtp_Crf_t*)ref_pdu, 0x42);
+    Avtp_Crf_SetCrfDataLength((Avtp_Crf_t*)ref_pdu, 48);
+
+    // CRF has no avtp_timestamp, the timestamp argument must be ignored
+    Avtp_StreamTemplate_Render(&tmpl, pdu, 0x42, 0xFFFFFFFF, 48);
+    assert_memory_equal(ref_pdu, pdu, AVTP_CRF_HEADER_LEN);
+}
+
+static void stream_template_cvf(void **state)
+{
+    Avtp_StreamTemplate_t tmpl;
+    uint8_t header[AVTP_CVF_HEADER_LEN];
+    uint8_t ref_pdu[AVTP_CVF_HEADER_LEN];
+    uint8_t pdu[AVTP_CVF_HEADER_LEN];
+
+    Avtp_Cvf_Init((Avtp_Cvf_t*)header);
+    Avtp_Cvf_SetFormat((Avtp_Cvf_t*)header, AVTP_CVF_FORMAT_RFC);
+    Avtp_Cvf_SetFormatSubtype((Avtp_Cvf_t*)header, AVTP_CVF_FORMAT_SUBTYPE_H264);
+    Avtp_Cvf_EnableTv((Avtp_Cvf_t*)header);
+    Avtp_Cvf_SetStreamId((Avtp_Cvf_t*)header, STREAM_ID);
+    Avtp_Cvf_EnableM((Avtp_Cvf_t*)header);
+    assert_int_equal(Avtp_Cvf_InitTemplate(&tmpl, (Avtp_Cvf_t*)header), 0);
+
+    memcpy(ref_pdu, header, AVTP_CVF_HEADER_LEN);
+    Avtp_Cvf_SetSequenceNum((Avtp_Cvf_t*)ref_pdu, 0xFE);
+    Avtp_Cvf_SetAvtpTimestamp((Avtp_Cvf_t*)ref_pdu, 0x12345678);
+    Avtp_Cvf_SetStreamDataLength((Avtp_Cvf_t*)ref_pdu, 1400);
+
+    Avtp_StreamTemplate_Render(&tmpl, pdu, 0xFE, 0x12345678, 1400);
+    assert_memory_equal(ref_pdu, pdu, AVTP_CVF_HEADER_LEN);
+}
+
+static void stream_template_ntscf(void **state)
+{
+    Avtp_StreamTemplate_t tmpl;
+    uint8_t header[AVTP_NTSCF_HEADER_LEN];
+    uint8_t ref_pdu[AVTP_NTSCF_HEADER_LEN];
+    uint8_t pdu[AVTP_NTSCF_HEADER_LEN];
+
+    Avtp_Ntscf_Init((Avtp_Ntscf_t*)header);
+    Avtp_Ntscf_SetStreamId((Avtp_Ntscf_t*)header, STREAM_ID);
+    assert_int_equal(Avtp_Ntscf_InitTemplate(&tmpl, (Avtp_Ntscf_t*)header), 0);
+
+    for (int len = 0; len < 0x800; len += 0x55) {
+        memcpy(ref_pdu, header, AVTP_NTSCF_HEADER_LEN);
+        Avtp_Ntscf_SetSequenceNum((Avtp_Ntscf_t*)ref_pdu, len & 0xFF);
+        Avtp_Ntscf_SetNtscfDataLength((Avtp_Ntscf_t*)ref_pdu, len);
+
+        Avtp_StreamTemplate_Render(&tmpl, pdu, len & 0xFF, 0, len);
+        assert_memory_equal(ref_pdu, pdu, AVTP_NTSCF_HEADER_LEN);
+    }
+}
+
+static void stream_template_tscf(void **state)
+{
+    Avtp_StreamTemplate_t tmpl;
+    uint8_t header[AVTP_TSCF_HEADER_LEN];
+    uint8_t ref_pdu[AVTP_TSCF_HEADER_LEN];
+    uint8_t pdu[AVTP_TSCF_HEADER_LEN];
+
+    Avtp_Tscf_Init((Avtp_Tscf_t*)header);
+    Avtp_Tscf_EnableTv((Avtp_Tscf_t*)header);
+    Avtp_Tscf_SetStreamId((Avtp_Tscf_t*)header, STREAM_ID);
+    assert_int_equal(Avtp_Tscf_InitTemplate(&tmpl, (Avtp_Tscf_t*)header), 0);
+
+    memcpy(ref_pdu, header, AVTP_TSCF_HEADER_LEN);
+    Avtp_Tscf_SetSequenceNum((Avtp_Tscf_t*)ref_pdu, 7);
+    Avtp_Tscf_SetAvtpTimestamp((Avtp_Tscf_t*)ref_pdu, 0xDEADBEEF);
+    Avtp_Tscf_SetStreamDataLength((Avtp_Tscf_t*)ref_pdu, 0xABCD);
+
+    Avtp_StreamTemplate_Render(&tmpl, pdu, 7, 0xDEADBEEF, 0xABCD);
+    assert_memory_equal(ref_pdu, pdu, AVTP_TSCF_HEADER_LEN);
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(stream_template_init_invalid),
+        cmocka_unit_test(stream_template_patch_field),
+        cmocka_unit_test(stream_template_pcm),
+        cmocka_unit_test(stream_template_crf),
+        cmocka_unit_test(stream_template_cvf),
+        cmocka_unit_test(stream_template_ntscf),
+        cmocka_unit_test(stream_template_tscf),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
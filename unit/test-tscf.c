@@ -85,11 +85,73 @@ static void tscf_is_valid(void **state) {
 
 }
 
+static void tscf_set_header(void **state) {
+
+    uint8_t pdu[AVTP_TSCF_HEADER_LEN];
+    uint8_t ref_pdu[AVTP_TSCF_HEADER_LEN];
+    Avtp_TscfHeader_t header = {
+        .subtype = AVTP_SUBTYPE_TSCF,
+        .sv = 1,
+        .version = 0,
+        .mr = 1,
+        .tv = 1,
+        .sequence_num = 0xCD,
+        .tu = 1,
+        .stream_id = 0xAABBCCDDEEFF0001,
+        .avtp_timestamp = 0x11223344,
+        .stream_data_length = 0xBEEF,
+    };
+
+    Avtp_Tscf_Init((Avtp_Tscf_t*)ref_pdu);
+    Avtp_Tscf_EnableMr((Avtp_Tscf_t*)ref_pdu);
+    Avtp_Tscf_EnableTv((Avtp_Tscf_t*)ref_pdu);
+    Avtp_Tscf_SetSequenceNum((Avtp_Tscf_t*)ref_pdu, 0xCD);
+    Avtp_Tscf_EnableTu((Avtp_Tscf_t*)ref_pdu);
+    Avtp_Tscf_SetStreamId((Avtp_Tscf_t*)ref_pdu, 0xAABBCCDDEEFF0001);
+    Avtp_Tscf_SetAvtpTimestamp((Avtp_Tscf_t*)ref_pdu, 0x11223344);
+    Avtp_Tscf_SetStreamDataLength((Avtp_Tscf_t*)ref_pdu, 0xBEEF);
+
+    memset(pdu, 0, AVTP_TSCF_HEADER_LEN);
+    Avtp_Tscf_SetHeader((Avtp_Tscf_t*)pdu, &header);
+    assert_memory_equal(ref_pdu, pdu, AVTP_TSCF_HEADER_LEN);
+}
+
+static void tscf_unpack(void **state)
+{
+    uint8_t pdu[AVTP_TSCF_HEADER_LEN];
+    Avtp_TscfHeader_t header;
+
+    // Every unpacked field must match its single field getter
+    for (int pattern = 0; pattern < 3; pattern++) {
+        for (int i = 0; i < AVTP_TSCF_HEADER_LEN; i++) {
+            pdu[i] = (pattern == 0) ? 0xFF : (uint8_t)(i * 37 + pattern * 0x5A);
+        }
+
+        Avtp_Tscf_Unpack((Avtp_Tscf_t*)pdu, &header);
+        assert_int_equal(header.subtype, Avtp_Tscf_GetSubtype((Avtp_Tscf_t*)pdu));
+        assert_int_equal(header.sv, Avtp_Tscf_GetSv((Avtp_Tscf_t*)pdu));
+        assert_int_equal(header.version, Avtp_Tscf_GetVersion((Avtp_Tscf_t*)pdu));
+        assert_int_equal(header.mr, Avtp_Tscf_GetMr((Avtp_Tscf_t*)pdu));
+        assert_int_equal(header.tv, Avtp_Tscf_GetTv((Avtp_Tscf_t*)pdu));
+        assert_int_equal(header.sequence_num, Avtp_Tscf_GetSequenceNum((Avtp_Tscf_t*)pdu));
+        assert_int_equal(header.tu, Avtp_Tscf_GetTu((Avtp_Tscf_t*)pdu));
+        assert_int_equal(header.stream_id, Avtp_Tscf_GetStreamId((Avtp_Tscf_t*)pdu));
+        assert_int_equal(header.avtp_timestamp, Avtp_Tscf_GetAvtpTimestamp((Avtp_Tscf_t*)pdu));
+        assert_int_equal(header.stream_data_length, Avtp_Tscf_GetStreamDataLength((Avtp_Tscf_t*)pdu));
+    }
+
+    // Null pointers must be ignored
+    Avtp_Tscf_Unpack(NULL, &header);
+    Avtp_Tscf_Unpack((Avtp_Tscf_t*)pdu, NULL);
+}
+
 int main(void)
 {
     const struct CMUnitTest tests[] = {
         cmocka_unit_test(tscf_init),
         cmocka_unit_test(tscf_is_valid),
+        cmocka_unit_test(tscf_set_header),
+        cmocka_unit_test(tscf_unpack),
     };
 
     return cmocka_run_group_tests(tests, NULL, NULL);
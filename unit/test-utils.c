@@ -0,0 +1,213 @@
+/*
+ * Copyright (c) 2025, COVESA
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of COVESA nor the names of its contributors may be
+ *      used to endorse or promote products derived from this software without
+ *      specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "avtp/Utils.h"
+
+#define NUM_QUADLETS        4
+#define PDU_SIZE            ((NUM_QUADLETS + 3) * AVTP_QUADLET_SIZE)
+
+static void fill_random(uint8_t* buf, size_t len)
+{
+    for (size_t i = 0; i < len; i++) {
+        buf[i] = (uint8_t)rand();
+    }
+}
+
+static uint64_t random_value(void)
+{
+    return ((uint64_t)rand() << 48) ^ ((uint64_t)rand() << 24) ^ (uint64_t)rand();
+}
+
+static void utils_get_field_inline(void **state) {
+
+    uint8_t pdu[PDU_SIZE];
+    Avtp_FieldDescriptor_t desc[1];
+
+    srand(1722);
+
+    // Compare against the generic parser for every possible field layout
+    for (uint8_t quadlet = 0; quadlet < NUM_QUADLETS; quadlet++) {
+        for (uint8_t offset = 0; offset < 32; offset++) {
+            for (uint8_t bits = 1; bits <= AVTP_FIELD_MAX_BITS; bits++) {
+                desc[0].quadlet = quadlet;
+                desc[0].offset = offset;
+                desc[0].bits = bits;
+                fill_random(pdu, sizeof(pdu));
+                assert_int_equal(Avtp_GetFieldInline(desc, 1, pdu, 0),
+                                 Avtp_GetField(desc, 1, pdu, 0));
+            }
+        }
+    }
+
+    // Invalid arguments
+    assert_int_equal(Avtp_GetFieldInline(NULL, 1, pdu, 0), 0);
+    assert_int_equal(Avtp_GetFieldInline(desc, 1, NULL, 0), 0);
+    assert_int_equal(Avtp_GetFieldInline(desc, 1, pdu, 1), 0);
+}
+
+static void utils_set_field_inline(void **state) {
+
+    uint8_t pdu_generic[PDU_SIZE];
+    uint8_t pdu_inline[PDU_SIZE];
+    Avtp_FieldDescriptor_t desc[1];
+
+    srand(1722);
+
+    // Compare against the generic parser for every possible field layout
+    for (uint8_t quadlet = 0; quadlet < NUM_QUADLETS; quadlet++) {
+        for (uint8_t offset = 0; offset < 32; offset++) {
+            for (uint8_t bits = 1; bits <= AVTP_FIELD_MAX_BITS; bits++) {
+                uint64_t value = random_value();
+                desc[0].quadlet = quadlet;
+                desc[0].offset = offset;
+                desc[0].bits = bits;
+                fill_random(pdu_generic, sizeof(pdu_generic));
+                memcpy(pdu_inline, pdu_generic, sizeof(pdu_inline));
+                Avtp_SetField(desc, 1, pdu_generic, 0, value);
+                Avtp_SetFieldInline(desc, 1, pdu_inline, 0, value);
+                assert_memory_equal(pdu_inline, pdu_generic, sizeof(pdu_inline));
+            }
+        }
+    }
+
+    // Invalid arguments must not touch the PDU
+    memcpy(pdu_inline, pdu_generic, sizeof(pdu_inline));
+    Avtp_SetFieldInline(NULL, 1, pdu_inline, 0, 0);
+    Avtp_SetFieldInline(desc, 1, pdu_inline, 1, 0);
+    assert_memory_equal(pdu_inline, pdu_generic, sizeof(pdu_inline));
+}
+
+static void utils_set_fields(void **state) {
+
+    uint8_t pdu_single[PDU_SIZE];
+    uint8_t pdu_multi[PDU_SIZE];
+    Avtp_FieldDescriptor_t desc[8];
+    Avtp_FieldValue_t values[12];
+
+    srand(1722);
+
+    // Random (possibly overlapping) fields must yield the same result as
+    // writing them one after another
+    for (int run = 0; run < 10000; run++) {
+        for (uint8_t i = 0; i < 8; i++) {
+            desc[i].quadlet = rand() % NUM_QUADLETS;
+            desc[i].offset = rand() % 32;
+            desc[i].bits = 1 + rand() % AVTP_FIELD_MAX_BITS;
+        }
+        for (uint8_t i = 0; i < 12; i++) {
+            // Include some invalid field indices
+            values[i].field = rand() % 9;
+            values[i].value = random_value();
+        }
+        fill_random(pdu_single, sizeof(pdu_single));
+        memcpy(pdu_multi, pdu_single, sizeof(pdu_multi));
+
+        for (uint8_t i = 0; i < 12; i++) {
+            Avtp_SetField(desc, 8, pdu_single, values[i].field, values[i].value);
+        }
+        Avtp_SetFields(desc, 8, pdu_multi, values, 12);
+        assert_memory_equal(pdu_multi, pdu_single, sizeof(pdu_multi));
+    }
+
+    // Fields beyond the quadlets cached by Avtp_SetFields
+    uint8_t pdu_large_single[128];
+    uint8_t pdu_large_multi[128];
+    desc[0] = (Avtp_FieldDescriptor_t){ .quadlet = 15, .offset = 20, .bits = 40 };
+    desc[1] = (Avtp_FieldDescriptor_t){ .quadlet = 15, .offset = 0, .bits = 24 };
+    desc[2] = (Avtp_FieldDescriptor_t){ .quadlet = 0, .offset = 4, .bits = 8 };
+    values[0] = (Avtp_FieldValue_t){ .field = 1, .value = 0xABCDEF };
+    values[1] = (Avtp_FieldValue_t){ .field = 0, .value = 0x123456789A };
+    values[2] = (Avtp_FieldValue_t){ .field = 2, .value = 0x5A };
+    fill_random(pdu_large_single, sizeof(pdu_large_single));
+    memcpy(pdu_large_multi, pdu_large_single, sizeof(pdu_large_multi));
+    for (uint8_t i = 0; i < 3; i++) {
+        Avtp_SetField(desc, 3, pdu_large_single, values[i].field, values[i].value);
+    }
+    Avtp_SetFields(desc, 3, pdu_large_multi, values, 3);
+    assert_memory_equal(pdu_large_multi, pdu_large_single, sizeof(pdu_large_multi));
+}
+
+static void utils_misaligned_pdu(void **state) {
+
+    uint8_t aligned[PDU_SIZE];
+    uint8_t storage_generic[PDU_SIZE + 8];
+    uint8_t storage_inline[PDU_SIZE + 8];
+    Avtp_FieldDescriptor_t desc[1];
+
+    srand(1722);
+
+    // PDUs inside receive buffers need not be aligned to a quadlet boundary.
+    // Accesses at every misalignment must match the aligned result.
+    for (uint8_t misalignment = 1; misalignment < 8; misalignment++) {
+        uint8_t* pdu_generic = storage_generic + misalignment;
+        uint8_t* pdu_inline = storage_inline + misalignment;
+        for (uint8_t quadlet = 0; quadlet < NUM_QUADLETS; quadlet++) {
+            for (uint8_t offset = 0; offset < 32; offset += 3) {
+                for (uint8_t bits = 1; bits <= AVTP_FIELD_MAX_BITS; bits += 7) {
+                    uint64_t value = random_value();
+                    desc[0].quadlet = quadlet;
+                    desc[0].offset = offset;
+                    desc[0].bits = bits;
+                    fill_random(aligned, sizeof(aligned));
+                    memcpy(pdu_generic, aligned, sizeof(aligned));
+                    memcpy(pdu_inline, aligned, sizeof(aligned));
+
+                    uint64_t expected = Avtp_GetField(desc, 1, aligned, 0);
+                    assert_int_equal(Avtp_GetField(desc, 1, pdu_generic, 0), expected);
+                    assert_int_equal(Avtp_GetFieldInline(desc, 1, pdu_inline, 0), expected);
+
+                    Avtp_SetField(desc, 1, aligned, 0, value);
+                    Avtp_SetField(desc, 1, pdu_generic, 0, value);
+                    Avtp_SetFieldInline(desc, 1, pdu_inline, 0, value);
+                    assert_memory_equal(pdu_generic, aligned, sizeof(aligned));
+                    assert_memory_equal(pdu_inline, aligned, sizeof(aligned));
+                }
+            }
+        }
+    }
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(utils_get_field_inline),
+        cmocka_unit_test(utils_set_field_inline),
+        cmocka_unit_test(utils_set_fields),
+        cmocka_unit_test(utils_misaligned_pdu)
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}